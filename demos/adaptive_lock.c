@@ -0,0 +1,216 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          adaptive_lock.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks the adaptive lock against a mutex and
+a spinlock, once with short critical sections and once with
+long ones, with more threads than there are CPUs, and prints
+the statistics that the adaptive lock tuned itself with.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+// Benchmark parameters; the long critical sections are a few microseconds
+#define SHORT_WORK 8
+#define LONG_WORK 4000
+#define BENCH_SECONDS 0.5
+
+// The data protected by the lock
+volatile uint64_m shared_data[8];
+volatile uint32_m stop = 0;
+
+// The locks being compared
+#define USE_MUTEX 0
+#define USE_SPINLOCK 1
+#define USE_ADAPTIVE_LOCK 2
+muMutex mutex = 0;
+muSpinlock spinlock = 0;
+muAdaptiveLock adaptive_lock = 0;
+
+int lock_type = USE_MUTEX;
+size_m work = SHORT_WORK;
+
+// Operations done by each thread
+#define MAX_THREADS 64
+uint64_m ops[MAX_THREADS];
+
+void bench_func(void* args) {
+	size_m index = (size_m)args;
+	uint64_m count = 0;
+
+	while (!stop) {
+		switch (lock_type) {
+			case USE_MUTEX: mu_mutex_lock(mutex); break;
+			case USE_SPINLOCK: mu_spinlock_lock(spinlock); break;
+			case USE_ADAPTIVE_LOCK: mu_adaptive_lock_lock(adaptive_lock); break;
+		}
+
+		for (size_m j = 0; j < work; j++) {
+			shared_data[j % 8]++;
+		}
+
+		switch (lock_type) {
+			case USE_MUTEX: mu_mutex_unlock(mutex); break;
+			case USE_SPINLOCK: mu_spinlock_unlock(spinlock); break;
+			case USE_ADAPTIVE_LOCK: mu_adaptive_lock_unlock(adaptive_lock); break;
+		}
+		count++;
+	}
+
+	ops[index] = count;
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs one benchmark and returns the millions of lock/unlock pairs per second
+double run(int type, size_m thread_count) {
+	muThread threads[MAX_THREADS];
+	lock_type = type;
+	stop = 0;
+
+	double start = now_seconds();
+	for (size_m i = 0; i < thread_count; i++) {
+		threads[i] = mu_thread_create(bench_func, (void*)i);
+		scall(mu_thread_create)
+	}
+	mu_thread_sleep((uint32_m)(BENCH_SECONDS * 1000.0));
+	stop = 1;
+	for (size_m i = 0; i < thread_count; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	double seconds = now_seconds() - start;
+
+	uint64_m total = 0;
+	for (size_m i = 0; i < thread_count; i++) {
+		total += ops[i];
+	}
+	return (double)total / seconds / 1000000.0;
+}
+
+void print_stats(void) {
+	uint64_m acquisitions, contended, spun, parked, hold, limit;
+	mu_adaptive_lock_stats(adaptive_lock, &acquisitions, &contended, &spun, &parked, &hold, &limit);
+	printf("  adaptive lock: %llu acquisitions, %llu contended (%llu spun, %llu parked), average hold %llu ns, spin limit %llu ns\n",
+		(unsigned long long)acquisitions, (unsigned long long)contended, (unsigned long long)spun,
+		(unsigned long long)parked, (unsigned long long)hold, (unsigned long long)limit
+	);
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Twice as many threads as CPUs, so that lock holders do get descheduled
+	size_m thread_count = (size_m)mu_topology_cpu_count() * 2;
+	thread_count = thread_count < 4 ? 4 : thread_count;
+	thread_count = thread_count > MAX_THREADS ? MAX_THREADS : thread_count;
+	printf("%u CPUs, %u threads:\n", (unsigned)mu_topology_cpu_count(), (unsigned)thread_count);
+
+	const size_m works[2] = { SHORT_WORK, LONG_WORK };
+	for (size_m i = 0; i < 2; i++) {
+		work = works[i];
+
+		// Fresh locks for each kind of critical section, so that the adaptive lock learns anew
+		mutex = mu_mutex_create();
+		scall(mu_mutex_create)
+		spinlock = mu_spinlock_create();
+		scall(mu_spinlock_create)
+		adaptive_lock = mu_adaptive_lock_create();
+		scall(mu_adaptive_lock_create)
+
+		printf("%s critical sections:\n", i == 0 ? "Short" : "Long");
+		printf("  muMutex:        %.3f Mops/s\n", run(USE_MUTEX, thread_count));
+		printf("  muSpinlock:     %.3f Mops/s\n", run(USE_SPINLOCK, thread_count));
+		printf("  muAdaptiveLock: %.3f Mops/s\n", run(USE_ADAPTIVE_LOCK, thread_count));
+		print_stats();
+
+		mutex = mu_mutex_destroy(mutex);
+		scall(mu_mutex_destroy)
+		spinlock = mu_spinlock_destroy(spinlock);
+		scall(mu_spinlock_destroy)
+		adaptive_lock = mu_adaptive_lock_destroy(adaptive_lock);
+		scall(mu_adaptive_lock_destroy)
+	}
+
+	// The numbers vary by machine; the adaptive lock should keep up with the spinlock when
+	// critical sections are short, and with the mutex when they're long.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,356 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          channels.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks passing values through buffered,
+unbuffered and unbounded channels, compares the round trip time of an
+unbuffered channel against a mutex that's polled, and then
+uses select with a timeout to stop a group of workers by
+closing a channel.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing, and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 4
+#define VALUES_PER_THREAD 200000
+#define ROUND_TRIPS 20000
+// Far fewer for the polled mutex, which is far slower
+#define POLLED_ROUND_TRIPS 200
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Throughput: producers send numbers, consumers add them up
+
+muChan numbers = 0;
+uint64_m sums[THREAD_COUNT];
+
+void producer(void* args) {
+	for (uint64_m i = 0; i < VALUES_PER_THREAD; i++) {
+		mu_chan_send(numbers, &i);
+	}
+	return; if (args) {}
+}
+
+void consumer(void* args) {
+	uint64_m sum = 0, value;
+	// Receiving stops once the channel is closed and empty
+	while (mu_chan_recv(numbers, &value) == MUM_CHAN_OK) {
+		sum += value;
+	}
+	sums[(size_m)args] = sum;
+}
+
+double run_throughput(size_m capacity) {
+	numbers = mu_chan_create(sizeof(uint64_m), capacity);
+	scall(mu_chan_create)
+
+	muThread threads[THREAD_COUNT * 2];
+	double start = now_seconds();
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(producer, 0);
+		scall(mu_thread_create)
+		threads[THREAD_COUNT + i] = mu_thread_create(consumer, (void*)i);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+	}
+	// Every producer is done, so the consumers can stop once they've taken what's left
+	mu_chan_close(numbers);
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[THREAD_COUNT + i]);
+		scall(mu_thread_wait)
+	}
+	double time = now_seconds() - start;
+
+	uint64_m total = 0;
+	for (size_m i = 0; i < THREAD_COUNT * 2; i++) {
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		total += sums[i];
+	}
+	uint64_m expected = (uint64_m)THREAD_COUNT * VALUES_PER_THREAD * (VALUES_PER_THREAD - 1) / 2;
+	if (total != expected) {
+		printf("WARNING: the consumers added up to %llu rather than %llu\n", (unsigned long long)total, (unsigned long long)expected);
+	}
+
+	numbers = mu_chan_destroy(numbers);
+	scall(mu_chan_destroy)
+	return time;
+}
+
+// Round trips: a value is sent to an echo thread and back
+
+muChan ping = 0;
+muChan pong = 0;
+
+void chan_echo(void* args) {
+	uint32_m value;
+	while (mu_chan_recv(ping, &value) == MUM_CHAN_OK) {
+		mu_chan_send(pong, &value);
+	}
+	return; if (args) {}
+}
+
+// The same, with a mailbox guarded by a mutex, checked over and over
+muMutex mailbox_mutex = 0;
+volatile uint32_m mailbox_full = 0;
+volatile uint32_m mailbox_reply = 0;
+volatile uint32_m mailbox_stop = 0;
+
+void mutex_echo(void* args) {
+	for (;;) {
+		mu_mutex_lock(mailbox_mutex);
+		if (mailbox_stop) {
+			mu_mutex_unlock(mailbox_mutex);
+			return;
+		}
+		if (mailbox_full) {
+			mailbox_full = 0;
+			mailbox_reply = 1;
+		}
+		mu_mutex_unlock(mailbox_mutex);
+		mu_thread_sleep(0);
+	}
+	if (args) {}
+}
+
+double run_chan_round_trips(void) {
+	ping = mu_chan_create(sizeof(uint32_m), 0);
+	scall(mu_chan_create)
+	pong = mu_chan_create(sizeof(uint32_m), 0);
+	scall(mu_chan_create)
+	muThread echo = mu_thread_create(chan_echo, 0);
+	scall(mu_thread_create)
+
+	double start = now_seconds();
+	for (uint32_m i = 0; i < ROUND_TRIPS; i++) {
+		uint32_m value = i;
+		mu_chan_send(ping, &value);
+		mu_chan_recv(pong, &value);
+	}
+	double time = now_seconds() - start;
+
+	mu_chan_close(ping);
+	mu_thread_wait(echo);
+	scall(mu_thread_wait)
+	mu_thread_destroy(echo);
+	scall(mu_thread_destroy)
+	ping = mu_chan_destroy(ping);
+	scall(mu_chan_destroy)
+	pong = mu_chan_destroy(pong);
+	scall(mu_chan_destroy)
+	return time;
+}
+
+double run_mutex_round_trips(void) {
+	mailbox_mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+	muThread echo = mu_thread_create(mutex_echo, 0);
+	scall(mu_thread_create)
+
+	double start = now_seconds();
+	for (uint32_m i = 0; i < POLLED_ROUND_TRIPS; i++) {
+		mu_mutex_lock(mailbox_mutex);
+		mailbox_full = 1;
+		mu_mutex_unlock(mailbox_mutex);
+		for (;;) {
+			mu_mutex_lock(mailbox_mutex);
+			uint32_m reply = mailbox_reply;
+			mailbox_reply = 0;
+			mu_mutex_unlock(mailbox_mutex);
+			if (reply) {
+				break;
+			}
+			mu_thread_sleep(0);
+		}
+	}
+	double time = now_seconds() - start;
+
+	mu_mutex_lock(mailbox_mutex);
+	mailbox_stop = 1;
+	mu_mutex_unlock(mailbox_mutex);
+	mu_thread_wait(echo);
+	scall(mu_thread_wait)
+	mu_thread_destroy(echo);
+	scall(mu_thread_destroy)
+	mailbox_mutex = mu_mutex_destroy(mailbox_mutex);
+	scall(mu_mutex_destroy)
+	return time;
+}
+
+// Select: workers take jobs until a quit channel is closed, reporting when they're idle
+
+muChan jobs = 0;
+muChan quit = 0;
+uint32_m jobs_done[THREAD_COUNT];
+uint32_m idle_timeouts[THREAD_COUNT];
+
+void worker(void* args) {
+	size_m id = (size_m)args;
+	uint32_m job;
+	muChanCase cases[2];
+	cases[0].chan = jobs;
+	cases[0].value = &job;
+	cases[0].send = MU_FALSE;
+	cases[1].chan = quit;
+	cases[1].value = 0;
+	cases[1].send = MU_FALSE;
+
+	for (;;) {
+		size_m index;
+		mumChanStatus status = mu_chan_select(cases, 2, 50, &index);
+		scall(mu_chan_select)
+		if (status == MUM_CHAN_TIMEOUT) {
+			idle_timeouts[id]++;
+		} else if (index == 1) {
+			// Nothing is ever sent on quit, so this is it being closed; both cases may have
+			// been ready, so finish any jobs left first
+			while (mu_chan_try_recv(jobs, &job) == MUM_CHAN_OK) {
+				jobs_done[id]++;
+			}
+			return;
+		} else {
+			jobs_done[id]++;
+		}
+	}
+}
+
+void run_select(void) {
+	jobs = mu_chan_create(sizeof(uint32_m), 16);
+	scall(mu_chan_create)
+	quit = mu_chan_create(0, 0);
+	scall(mu_chan_create)
+
+	muThread threads[THREAD_COUNT];
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(worker, (void*)i);
+		scall(mu_thread_create)
+	}
+
+	// A burst of jobs, a pause long enough for the workers to time out, then another burst
+	for (uint32_m i = 0; i < 1000; i++) {
+		mu_chan_send(jobs, &i);
+	}
+	mu_thread_sleep(200);
+	for (uint32_m i = 0; i < 1000; i++) {
+		mu_chan_send(jobs, &i);
+	}
+	mu_chan_close(quit);
+
+	uint32_m done = 0, timeouts = 0;
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+		done += jobs_done[i];
+		timeouts += idle_timeouts[i];
+	}
+	printf("  %u jobs done, %u idle timeouts, all workers quit\n", (unsigned)done, (unsigned)timeouts);
+
+	jobs = mu_chan_destroy(jobs);
+	scall(mu_chan_destroy)
+	quit = mu_chan_destroy(quit);
+	scall(mu_chan_destroy)
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	double values = (double)THREAD_COUNT * VALUES_PER_THREAD;
+	printf("%u producers and %u consumers:\n", (unsigned)THREAD_COUNT, (unsigned)THREAD_COUNT);
+	printf("  buffered (256):  %.2f ns per value\n", run_throughput(256) * 1000000000.0 / values);
+	printf("  unbuffered:      %.2f ns per value\n", run_throughput(0) * 1000000000.0 / values);
+	printf("  unbounded:       %.2f ns per value\n", run_throughput(MUM_CHAN_UNBOUNDED) * 1000000000.0 / values);
+
+	printf("Round trips to an echo thread:\n");
+	printf("  unbuffered channels:  %.2f us per round trip\n", run_chan_round_trips() * 1000000.0 / ROUND_TRIPS);
+	printf("  polled mutex:         %.2f us per round trip\n", run_mutex_round_trips() * 1000000.0 / POLLED_ROUND_TRIPS);
+
+	printf("Select:\n");
+	run_select();
+
+	// The numbers vary by machine; the polled mutex spends most of its time yielding and
+	// checking again, whereas a blocked channel operation sleeps until it's done for it.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
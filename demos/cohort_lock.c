@@ -0,0 +1,212 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          cohort_lock.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks the cohort lock against a mutex and a
+spinlock, with two groups of threads pinned to two
+different NUMA nodes (or last-level caches) fighting over
+one lock, like two sockets would.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Define _GNU_SOURCE, needed to bind threads to CPUs on Linux
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+// Benchmark parameters
+#define THREADS_PER_GROUP 4
+#define OPS_PER_THREAD 200000
+
+// The data protected by the lock, a few cache lines' worth, which is what actually has to move
+// between nodes whenever the lock does
+volatile uint64_m shared_data[32];
+
+// The locks being compared
+#define USE_MUTEX 0
+#define USE_SPINLOCK 1
+#define USE_COHORT_LOCK 2
+muMutex mutex = 0;
+muSpinlock spinlock = 0;
+muCohortLock cohort_lock = 0;
+
+void bench_func(void* args) {
+	int lock_type = *(int*)args;
+
+	for (size_m i = 0; i < OPS_PER_THREAD; i++) {
+		switch (lock_type) {
+			case USE_MUTEX: mu_mutex_lock(mutex); break;
+			case USE_SPINLOCK: mu_spinlock_lock(spinlock); break;
+			case USE_COHORT_LOCK: mu_cohort_lock_lock(cohort_lock); break;
+		}
+
+		for (size_m j = 0; j < 32; j++) {
+			shared_data[j]++;
+		}
+
+		switch (lock_type) {
+			case USE_MUTEX: mu_mutex_unlock(mutex); break;
+			case USE_SPINLOCK: mu_spinlock_unlock(spinlock); break;
+			case USE_COHORT_LOCK: mu_cohort_lock_unlock(cohort_lock); break;
+		}
+	}
+}
+
+// Which group a CPU belongs to, the same way that the cohort lock decides
+uint32_m group_of(uint32_m cpu) {
+	if (mu_topology_node_count() > 1) {
+		return mu_topology_cpu_node(cpu);
+	}
+	return mu_topology_cpu_llc(cpu);
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs one benchmark with each group's threads spread over the CPUs of their group, and returns
+// the millions of lock/unlock pairs per second
+double run(int lock_type) {
+	muThread threads[THREADS_PER_GROUP * 2];
+	uint32_m cpu_count = mu_topology_cpu_count();
+	muBool two_groups = (mu_topology_node_count() > 1) || (mu_topology_llc_count() > 1);
+
+	double start = now_seconds();
+	for (uint32_m group = 0; group < 2; group++) {
+		uint32_m cpu = 0;
+		for (size_m i = 0; i < THREADS_PER_GROUP; i++) {
+			muThread* thread = &threads[group * THREADS_PER_GROUP + i];
+
+			// Find the next CPU in the group; without two groups, the threads are just left unbound
+			if (two_groups) {
+				uint32_m tries = 0;
+				while (group_of(cpu % cpu_count) != group && tries++ < cpu_count) {
+					cpu++;
+				}
+				*thread = mu_thread_create_on_cpu(bench_func, &lock_type, cpu % cpu_count);
+				scall(mu_thread_create_on_cpu)
+				cpu++;
+			} else {
+				*thread = mu_thread_create(bench_func, &lock_type);
+				scall(mu_thread_create)
+			}
+		}
+	}
+	for (size_m i = 0; i < THREADS_PER_GROUP * 2; i++) {
+		if (threads[i]) {
+			threads[i] = mu_thread_destroy_mode(threads[i], MUM_THREAD_DESTROY_JOIN);
+			scall(mu_thread_destroy_mode)
+		}
+	}
+	double seconds = now_seconds() - start;
+
+	return (double)(THREADS_PER_GROUP * 2 * OPS_PER_THREAD) / seconds / 1000000.0;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create the locks
+	mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+	spinlock = mu_spinlock_create();
+	scall(mu_spinlock_create)
+	cohort_lock = mu_cohort_lock_create(0);
+	scall(mu_cohort_lock_create)
+
+	// Run the benchmarks
+	printf("%u NUMA nodes, %u last-level caches; 2 groups of %i threads, %i operations each:\n",
+		(unsigned)mu_topology_node_count(), (unsigned)mu_topology_llc_count(), THREADS_PER_GROUP, OPS_PER_THREAD
+	);
+	printf("muMutex:      %.2f Mops/s\n", run(USE_MUTEX));
+	printf("muSpinlock:   %.2f Mops/s\n", run(USE_SPINLOCK));
+	printf("muCohortLock: %.2f Mops/s\n", run(USE_COHORT_LOCK));
+
+	// Destroy the locks
+	mutex = mu_mutex_destroy(mutex);
+	scall(mu_mutex_destroy)
+	spinlock = mu_spinlock_destroy(spinlock);
+	scall(mu_spinlock_destroy)
+	cohort_lock = mu_cohort_lock_destroy(cohort_lock);
+	scall(mu_cohort_lock_destroy)
+
+	// The numbers vary by machine; the cohort lock should pull ahead once the two groups are on
+	// different nodes, since it moves the lock and its data between them far less often.
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
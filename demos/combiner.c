@@ -0,0 +1,245 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          combiner.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks a combiner against a mutex on two
+shared structures that every thread hammers: a counter, and
+a priority queue that threads push into and pop from. It
+checks that both end up in the state they should.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+// Benchmark parameters
+#define THREAD_COUNT 8
+#define OPS_PER_THREAD 100000
+#define QUEUE_CAPACITY (THREAD_COUNT * OPS_PER_THREAD)
+
+// The shared structures: a counter, and a binary min-heap
+uint64_m counter = 0;
+uint32_m heap[QUEUE_CAPACITY];
+size_m heap_size = 0;
+
+void heap_push(uint32_m value) {
+	size_m i = heap_size++;
+	while (i > 0 && heap[(i - 1) / 2] > value) {
+		heap[i] = heap[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	heap[i] = value;
+}
+
+uint32_m heap_pop(void) {
+	uint32_m top = heap[0];
+	uint32_m last = heap[--heap_size];
+	size_m i = 0;
+	for (;;) {
+		size_m child = i * 2 + 1;
+		if (child >= heap_size) {
+			break;
+		}
+		if (child + 1 < heap_size && heap[child + 1] < heap[child]) {
+			child++;
+		}
+		if (heap[child] >= last) {
+			break;
+		}
+		heap[i] = heap[child];
+		i = child;
+	}
+	heap[i] = last;
+	return top;
+}
+
+// Operations; a queue operation pushes a value, and pops the smallest one every other time
+typedef struct {
+	uint32_m value;
+	muBool pop;
+	uint32_m popped;
+} queue_op;
+
+void increment(void* args) {
+	counter++;
+	return; if (args) {}
+}
+
+void queue_operate(void* args) {
+	queue_op* op = (queue_op*)args;
+	heap_push(op->value);
+	if (op->pop) {
+		op->popped = heap_pop();
+	}
+}
+
+// The ways of running the operations being compared
+#define USE_MUTEX 0
+#define USE_COMBINER 1
+muMutex mutex = 0;
+muCombiner combiner = 0;
+int lock_type = USE_MUTEX;
+muBool use_queue = MU_FALSE;
+
+void run_op(void (*operation)(void* args), void* args) {
+	if (lock_type == USE_MUTEX) {
+		mu_mutex_lock(mutex);
+		operation(args);
+		mu_mutex_unlock(mutex);
+	} else {
+		mu_combiner_execute(combiner, operation, args);
+	}
+}
+
+void bench_func(void* args) {
+	uint32_m seed = (uint32_m)(size_m)args * 2654435761u + 1;
+	queue_op op;
+
+	for (size_m i = 0; i < OPS_PER_THREAD; i++) {
+		if (use_queue) {
+			seed = seed * 1103515245 + 12345;
+			op.value = seed >> 8;
+			op.pop = (i & 1) != 0;
+			run_op(queue_operate, &op);
+		} else {
+			run_op(increment, 0);
+		}
+	}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs one benchmark and returns the millions of operations per second
+double run(int type, muBool queue) {
+	lock_type = type;
+	use_queue = queue;
+	counter = 0;
+	heap_size = 0;
+
+	void* args[THREAD_COUNT];
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		args[i] = (void*)i;
+	}
+
+	double start = now_seconds();
+	muThreadGroup group = mu_thread_create_many(THREAD_COUNT, bench_func, args);
+	scall(mu_thread_create_many)
+	group = mu_thread_destroy_many(group, MUM_THREAD_DESTROY_JOIN);
+	scall(mu_thread_destroy_many)
+	double seconds = now_seconds() - start;
+
+	// Half of the pushes were popped again, and the heap should still be in order
+	if (queue) {
+		muBool ordered = heap_size == QUEUE_CAPACITY / 2;
+		for (size_m i = 1; i < heap_size; i++) {
+			if (heap[(i - 1) / 2] > heap[i]) {
+				ordered = MU_FALSE;
+			}
+		}
+		if (!ordered) {
+			printf("WARNING: priority queue is broken\n");
+		}
+	} else if (counter != QUEUE_CAPACITY) {
+		printf("WARNING: counter is %llu, not %llu\n", (unsigned long long)counter, (unsigned long long)QUEUE_CAPACITY);
+	}
+
+	return (double)QUEUE_CAPACITY / seconds / 1000000.0;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+	combiner = mu_combiner_create(0);
+	scall(mu_combiner_create)
+
+	printf("%i threads, %i operations each:\n", THREAD_COUNT, OPS_PER_THREAD);
+	printf("Counter, muMutex:           %.2f Mops/s\n", run(USE_MUTEX, MU_FALSE));
+	printf("Counter, muCombiner:        %.2f Mops/s\n", run(USE_COMBINER, MU_FALSE));
+	printf("Priority queue, muMutex:    %.2f Mops/s\n", run(USE_MUTEX, MU_TRUE));
+	printf("Priority queue, muCombiner: %.2f Mops/s\n", run(USE_COMBINER, MU_TRUE));
+
+	mutex = mu_mutex_destroy(mutex);
+	scall(mu_mutex_destroy)
+	combiner = mu_combiner_destroy(combiner);
+	scall(mu_combiner_destroy)
+
+	// The numbers vary by machine; the combiner should pull ahead with more CPUs fighting over
+	// the structures, since the data then stays in one CPU's cache for a whole batch.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
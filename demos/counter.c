@@ -0,0 +1,192 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          counter.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo has several threads count events and record
+latency-like values, once into a counter and statistics
+guarded by a spinlock, and once into a sharded counter and
+accumulator, and compares how fast each way goes. It checks
+that both ways end up with the same totals.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+// Benchmark parameters
+#define THREAD_COUNT 8
+#define OPS_PER_THREAD 1000000
+
+// Statistics guarded by a spinlock
+muSpinlock spinlock = 0;
+int64_m locked_count = 0;
+uint64_m locked_records = 0;
+int64_m locked_sum = 0, locked_min = 0, locked_max = 0;
+
+// Sharded statistics
+muCounter counter = 0;
+muAccumulator accumulator = 0;
+
+muBool sharded = MU_FALSE;
+
+// A made-up latency for each operation
+int64_m latency_of(size_m thread, size_m i) {
+	return (int64_m)((thread * 7919 + i * 104729) % 1000) + 1;
+}
+
+void bench_func(void* args) {
+	size_m thread = (size_m)args;
+
+	for (size_m i = 0; i < OPS_PER_THREAD; i++) {
+		int64_m latency = latency_of(thread, i);
+
+		if (sharded) {
+			mu_counter_add(counter, 1);
+			mu_accumulator_record(accumulator, latency);
+		} else {
+			mu_spinlock_lock(spinlock);
+			locked_count++;
+			if (locked_records == 0 || latency < locked_min) {
+				locked_min = latency;
+			}
+			if (locked_records == 0 || latency > locked_max) {
+				locked_max = latency;
+			}
+			locked_records++;
+			locked_sum += latency;
+			mu_spinlock_unlock(spinlock);
+		}
+	}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs one benchmark and returns the millions of operations per second
+double run(muBool use_shards) {
+	sharded = use_shards;
+
+	void* args[THREAD_COUNT];
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		args[i] = (void*)i;
+	}
+
+	double start = now_seconds();
+	muThreadGroup group = mu_thread_create_many(THREAD_COUNT, bench_func, args);
+	scall(mu_thread_create_many)
+	group = mu_thread_destroy_many(group, MUM_THREAD_DESTROY_JOIN);
+	scall(mu_thread_destroy_many)
+	double seconds = now_seconds() - start;
+
+	return (double)THREAD_COUNT * OPS_PER_THREAD / seconds / 1000000.0;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	spinlock = mu_spinlock_create();
+	scall(mu_spinlock_create)
+	counter = mu_counter_create();
+	scall(mu_counter_create)
+	accumulator = mu_accumulator_create();
+	scall(mu_accumulator_create)
+
+	printf("%i threads, %i operations each, %u CPUs:\n", THREAD_COUNT, OPS_PER_THREAD, (unsigned)mu_topology_cpu_count());
+	printf("muSpinlock:                %.2f Mops/s\n", run(MU_FALSE));
+	printf("muCounter + muAccumulator: %.2f Mops/s\n", run(MU_TRUE));
+
+	// Both ways should have counted the same
+	uint64_m records;
+	int64_m sum, min, max;
+	mu_accumulator_read(accumulator, &records, &sum, &min, &max);
+	int64_m count = mu_counter_take(counter);
+	printf("Count %lld / %lld, records %llu / %llu, sum %lld / %lld, min %lld / %lld, max %lld / %lld\n",
+		(long long)locked_count, (long long)count, (unsigned long long)locked_records, (unsigned long long)records,
+		(long long)locked_sum, (long long)sum, (long long)locked_min, (long long)min, (long long)locked_max, (long long)max
+	);
+	printf("Count after taking: %lld\n", (long long)mu_counter_read(counter));
+
+	spinlock = mu_spinlock_destroy(spinlock);
+	scall(mu_spinlock_destroy)
+	counter = mu_counter_destroy(counter);
+	scall(mu_counter_destroy)
+	accumulator = mu_accumulator_destroy(accumulator);
+	scall(mu_accumulator_destroy)
+
+	// The numbers vary by machine; the sharded versions should scale with the amount of CPUs,
+	// while the spinlock gets slower the more CPUs fight over it.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
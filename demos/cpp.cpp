@@ -0,0 +1,160 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          cpp.cpp
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo uses the C++ interface: threads started with
+lambdas, some of which capture more than fits in a pointer,
+counting under a mutex and a spinlock through lock guards,
+and a thread that's stopped and joined by going out of
+scope.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 4
+#define OPS_PER_THREAD 100000
+
+// Counts under any kind of lock; which one is decided at compile time
+template <class Lock>
+uint64_m count_with(Lock& lock) {
+	uint64_m count = 0;
+	mum::thread threads[THREAD_COUNT];
+
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mum::thread([&lock, &count] {
+			for (size_m j = 0; j < OPS_PER_THREAD; j++) {
+				mum::lock_guard<Lock> guard(lock);
+				count++;
+			}
+		});
+		scall(mum::thread)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i].join();
+		scall(mum::thread::join)
+	}
+
+	return count;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// The wrappers hold nothing but the C handle
+	printf("sizeof(mum::mutex) = %u, sizeof(mum::thread) = %u, sizeof(void*) = %u\n",
+		(unsigned)sizeof(mum::mutex), (unsigned)sizeof(mum::thread), (unsigned)sizeof(void*)
+	);
+
+	mum::mutex mutex;
+	scall(mum::mutex)
+	mum::spinlock spinlock;
+	scall(mum::spinlock)
+	printf("Counted under a mutex: %llu\n", (unsigned long long)count_with(mutex));
+	printf("Counted under a spinlock: %llu\n", (unsigned long long)count_with(spinlock));
+
+	// A lambda with a large capture; it's moved onto the thread's stack rather than allocated
+	{
+		uint64_m numbers[64];
+		for (size_m i = 0; i < 64; i++) {
+			numbers[i] = i;
+		}
+		uint64_m sum = 0;
+		mum::thread summer([numbers, &sum] {
+			for (size_m i = 0; i < 64; i++) {
+				sum += numbers[i];
+			}
+		});
+		scall(mum::thread)
+		summer.join();
+		scall(mum::thread::join)
+		printf("Sum of a captured array: %llu\n", (unsigned long long)sum);
+	}
+
+	// A thread that runs until it's asked to stop, which happens when it goes out of scope
+	{
+		uint64_m ticks = 0;
+		mum::unique_lock<mum::mutex> lock(mutex, mum::defer_lock);
+		mum::thread ticker([&ticks] {
+			muStopToken token = mu_thread_current_stop_token();
+			while (!mu_stop_requested(token)) {
+				ticks++;
+				mu_thread_sleep(1);
+			}
+		});
+		scall(mum::thread)
+		mu_thread_sleep(20);
+	}
+	printf("Ticker stopped\n");
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
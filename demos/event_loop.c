@@ -0,0 +1,217 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          event_loop.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo bounces a message back and forth between two pipes
+through an event loop, with no dedicated I/O thread (the
+scheduler's idle workers poll the event loop themselves),
+and then signals an eventfd from another thread, printing
+how many round trips and signals went through. It only runs
+on Linux.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+#ifdef __linux__
+
+// Include unistd, fcntl and eventfd for the file descriptors
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define ROUND_TRIPS 20000
+#define SIGNALS 1000
+
+// Two pipes; a byte read from one is written to the other
+int ping[2];
+int pong[2];
+volatile uint32_m round_trips = 0;
+
+// The eventfd signalled by another thread, and the total of its signals received
+int signal_fd;
+volatile uint64_m signals = 0;
+
+void ping_callback(int fd, uint32_m events, void* args) {
+	char byte;
+	while (read(fd, &byte, 1) == 1) {
+		if (write(pong[1], &byte, 1) < 0) {}
+	}
+	return; if (events) {} if (args) {}
+}
+
+void pong_callback(int fd, uint32_m events, void* args) {
+	char byte;
+	while (read(fd, &byte, 1) == 1) {
+		// Send the message back around until enough round trips were made
+		if (++round_trips < ROUND_TRIPS) {
+			if (write(ping[1], &byte, 1) < 0) {}
+		}
+	}
+	return; if (events) {} if (args) {}
+}
+
+void signal_callback(int fd, uint32_m events, void* args) {
+	uint64_m value;
+	if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+		signals += value;
+	}
+	return; if (events) {} if (args) {}
+}
+
+void signal_thread(void* args) {
+	for (uint32_m i = 0; i < SIGNALS; i++) {
+		uint64_m value = 1;
+		if (write(signal_fd, &value, sizeof(value)) < 0) {}
+	}
+	return; if (args) {}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create a scheduler, and an event loop whose callbacks run on it
+	muScheduler scheduler = mu_scheduler_create(0, 0);
+	scall(mu_scheduler_create)
+	muEventLoop loop = mu_event_loop_create(scheduler);
+	scall(mu_event_loop_create)
+
+	// Create the file descriptors, non-blocking so that callbacks can read until they're empty
+	if (pipe(ping) != 0 || pipe(pong) != 0) {
+		printf("Failed to create pipes\n");
+		return 1;
+	}
+	fcntl(ping[0], F_SETFL, O_NONBLOCK);
+	fcntl(pong[0], F_SETFL, O_NONBLOCK);
+	signal_fd = eventfd(0, EFD_NONBLOCK);
+
+	// Add them to the event loop
+	uint64_m ping_source = mu_event_loop_add(loop, ping[0], MUM_EVENT_READ, ping_callback, 0, MUM_TASK_PRIORITY_HIGH);
+	scall(mu_event_loop_add)
+	uint64_m pong_source = mu_event_loop_add(loop, pong[0], MUM_EVENT_READ, pong_callback, 0, MUM_TASK_PRIORITY_HIGH);
+	scall(mu_event_loop_add)
+	uint64_m signal_source = mu_event_loop_add(loop, signal_fd, MUM_EVENT_READ, signal_callback, 0, MUM_TASK_PRIORITY_NORMAL);
+	scall(mu_event_loop_add)
+
+	// Start the message off, and wait for it to finish going around
+	char byte = 'x';
+	if (write(ping[1], &byte, 1) < 0) {}
+	while (round_trips < ROUND_TRIPS) {
+		mu_thread_sleep(1);
+	}
+	printf("Made %u round trips between two pipes\n", (unsigned)round_trips);
+
+	// Signal the eventfd from another thread
+	muThread thread = mu_thread_create(signal_thread, 0);
+	scall(mu_thread_create)
+	mu_thread_wait(thread);
+	scall(mu_thread_wait)
+	mu_thread_destroy(thread);
+	scall(mu_thread_destroy)
+	while (signals < SIGNALS) {
+		mu_thread_sleep(1);
+	}
+	printf("Received %llu signals through an eventfd\n", (unsigned long long)signals);
+
+	// Remove the file descriptors, waiting for any callback still running
+	mu_event_loop_remove(loop, ping_source);
+	scall(mu_event_loop_remove)
+	mu_event_loop_remove(loop, pong_source);
+	scall(mu_event_loop_remove)
+	mu_event_loop_remove(loop, signal_source);
+	scall(mu_event_loop_remove)
+	mu_scheduler_wait(scheduler);
+
+	close(ping[0]);
+	close(ping[1]);
+	close(pong[0]);
+	close(pong[1]);
+	close(signal_fd);
+
+	// Destroy everything
+	mu_event_loop_destroy(loop);
+	scall(mu_event_loop_destroy)
+	mu_scheduler_destroy(scheduler);
+	scall(mu_scheduler_destroy)
+
+	return 0;
+}
+
+#else
+
+int main(void) {
+	printf("This demo requires Linux\n");
+	return 0;
+}
+
+#endif
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
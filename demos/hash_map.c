@@ -0,0 +1,179 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          hash_map.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks the concurrent hash map against a
+hash table guarded by a mutex, with 90/10 and 50/50
+read/write mixes.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+// Benchmark parameters
+#define THREAD_COUNT 4
+#define KEY_COUNT 65536
+#define OPS_PER_THREAD 2000000
+
+/* A simple hash table guarded by a mutex, to compare against */
+
+// Linear probing table big enough to never fill up; key 0 means empty
+uint64_m locked_keys[KEY_COUNT * 2];
+void* locked_values[KEY_COUNT * 2];
+muMutex locked_mutex = 0;
+
+size_m locked_find(uint64_m key) {
+	size_m i = (size_m)(key * 0x9E3779B97F4A7C15ull) & (KEY_COUNT * 2 - 1);
+	while (locked_keys[i] != 0 && locked_keys[i] != key) {
+		i = (i + 1) & (KEY_COUNT * 2 - 1);
+	}
+	return i;
+}
+
+void* locked_get(uint64_m key) {
+	mu_mutex_lock(locked_mutex);
+	void* value = locked_values[locked_find(key)];
+	mu_mutex_unlock(locked_mutex);
+	return value;
+}
+
+void locked_put(uint64_m key, void* value) {
+	mu_mutex_lock(locked_mutex);
+	size_m i = locked_find(key);
+	locked_keys[i] = key;
+	locked_values[i] = value;
+	mu_mutex_unlock(locked_mutex);
+}
+
+/* Benchmark threads */
+
+muHashMap map = 0;
+
+// What a benchmark thread does
+struct bench_args {
+	muBool use_map;
+	uint32_m write_percent;
+	uint64_m seed;
+};
+
+// Small random number generator so that the benchmark doesn't measure rand's lock
+uint64_m next_random(uint64_m* state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+void bench_func(void* args) {
+	struct bench_args* a = (struct bench_args*)args;
+	uint64_m state = a->seed;
+
+	for (size_m i = 0; i < OPS_PER_THREAD; i++) {
+		uint64_m r = next_random(&state);
+		uint64_m key = 1 + (r % KEY_COUNT);
+		muBool write = (r >> 32) % 100 < a->write_percent;
+
+		if (a->use_map) {
+			if (write) {
+				mu_hash_map_put(map, key, (void*)(size_m)r);
+			} else {
+				mu_hash_map_get(map, key, 0);
+			}
+		} else {
+			if (write) {
+				locked_put(key, (void*)(size_m)r);
+			} else {
+				locked_get(key);
+			}
+		}
+	}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs one benchmark and returns the millions of operations per second
+double run(muBool use_map, uint32_m write_percent) {
+	muThread threads[THREAD_COUNT];
+	struct bench_args args[THREAD_COUNT];
+
+	double start = now_seconds();
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		args[i].use_map = use_map;
+		args[i].write_percent = write_percent;
+		args[i].seed = 0x2545F4914F6CDD1Dull * (i + 1);
+		threads[i] = mu_thread_create(bench_func, &args[i]);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_destroy_mode(threads[i], MUM_THREAD_DESTROY_JOIN);
+		scall(mu_thread_destroy_mode)
+	}
+	double seconds = now_seconds() - start;
+
+	return (double)(THREAD_COUNT * OPS_PER_THREAD) / seconds / 1000000.0;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create the two tables, and fill both of them with every key so that lookups hit
+	map = mu_hash_map_create(KEY_COUNT);
+	scall(mu_hash_map_create)
+	locked_mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+
+	for (uint64_m key = 1; key <= KEY_COUNT; key++) {
+		mu_hash_map_put(map, key, (void*)(size_m)key);
+		scall(mu_hash_map_put)
+		locked_put(key, (void*)(size_m)key);
+	}
+
+	// Run the benchmarks
+	printf("%i threads, %i operations each:\n", THREAD_COUNT, OPS_PER_THREAD);
+	printf("90/10 read/write: muHashMap %.2f Mops/s, muMutex table %.2f Mops/s\n", run(MU_TRUE, 10), run(MU_FALSE, 10));
+	printf("50/50 read/write: muHashMap %.2f Mops/s, muMutex table %.2f Mops/s\n", run(MU_TRUE, 50), run(MU_FALSE, 50));
+
+	// Destroy the tables
+	map = mu_hash_map_destroy(map);
+	scall(mu_hash_map_destroy)
+	locked_mutex = mu_mutex_destroy(locked_mutex);
+	scall(mu_mutex_destroy)
+
+	// The numbers vary by machine; with several cores, muHashMap should scale with the amount of
+	// threads, whilst the mutex-guarded table should get slower as threads are added.
+
+	return 0;
+}
+
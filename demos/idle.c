@@ -0,0 +1,173 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          idle.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo times round trips to an echo thread over two
+unbuffered channels with each kind of idle strategy
+attached, printing how much CPU time each used and how
+long the waiting threads spent spinning, yielding and
+parked.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing, and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define ROUND_TRIPS 2000
+// How long the spinning strategies spin for before moving on, in nanoseconds
+#define SPIN_NS 50000
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+muChan ping = 0;
+muChan pong = 0;
+
+void echo(void* args) {
+	uint32_m value;
+	while (mu_chan_recv(ping, &value) == MUM_CHAN_OK) {
+		mu_chan_send(pong, &value);
+	}
+	return; if (args) {}
+}
+
+// Runs the round trips with the given strategy (or none) attached to both channels
+void run(const char* name, muIdleStrategy strategy) {
+	ping = mu_chan_create(sizeof(uint32_m), 0);
+	scall(mu_chan_create)
+	pong = mu_chan_create(sizeof(uint32_m), 0);
+	scall(mu_chan_create)
+	mu_chan_set_idle(ping, strategy);
+	mu_chan_set_idle(pong, strategy);
+	muThread thread = mu_thread_create(echo, 0);
+	scall(mu_thread_create)
+
+	clock_t cpu_start = clock();
+	double start = now_seconds();
+	for (uint32_m i = 0; i < ROUND_TRIPS; i++) {
+		uint32_m value = i;
+		mu_chan_send(ping, &value);
+		mu_chan_recv(pong, &value);
+		if (value != i) {
+			printf("WARNING: sent %u but got %u back\n", (unsigned)i, (unsigned)value);
+		}
+	}
+	double time = now_seconds() - start;
+	double cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+
+	mu_chan_close(ping);
+	mu_thread_wait(thread);
+	scall(mu_thread_wait)
+	mu_thread_destroy(thread);
+	scall(mu_thread_destroy)
+	ping = mu_chan_destroy(ping);
+	scall(mu_chan_destroy)
+	pong = mu_chan_destroy(pong);
+	scall(mu_chan_destroy)
+
+	printf("%-14s %8.2f us per round trip, %6.1f ms of CPU time\n", name, time * 1000000.0 / ROUND_TRIPS, cpu * 1000.0);
+	if (strategy) {
+		uint64_m waits, spin_ns, yield_ns, park_ns, parks;
+		mu_idle_strategy_stats(strategy, &waits, &spin_ns, &yield_ns, &park_ns, &parks);
+		printf("               %llu waits: %.1f ms spinning, %.1f ms yielding, %.1f ms parked (%llu parks)\n",
+			(unsigned long long)waits, (double)spin_ns / 1000000.0, (double)yield_ns / 1000000.0,
+			(double)park_ns / 1000000.0, (unsigned long long)parks
+		);
+	}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	printf("%u round trips to an echo thread:\n", (unsigned)ROUND_TRIPS);
+	run("default", 0);
+
+	const char* names[] = { "spin", "spin, yield", "spin, park", "park" };
+	mumIdleKind kinds[] = { MUM_IDLE_SPIN, MUM_IDLE_SPIN_YIELD, MUM_IDLE_SPIN_PARK, MUM_IDLE_PARK };
+	for (size_m i = 0; i < 4; i++) {
+		muIdleStrategy strategy = mu_idle_strategy_create(kinds[i], SPIN_NS, 0);
+		scall(mu_idle_strategy_create)
+		run(names[i], strategy);
+		strategy = mu_idle_strategy_destroy(strategy);
+		scall(mu_idle_strategy_destroy)
+	}
+
+	// The numbers vary by machine; with a CPU free for each thread, spinning answers fastest
+	// but burns CPU for as long as it waits, whereas parking costs a trip through the kernel
+	// on each side. With fewer CPUs than threads, a thread that only spins keeps the thread
+	// it's waiting on from running until the OS takes its CPU away.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
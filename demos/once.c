@@ -0,0 +1,197 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          once.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo creates a shared mutex lazily from several
+threads at once, first by checking for it under a global
+spinlock, and then with MU_LAZY, timing how long each
+takes to get the mutex once it exists, and checking that
+it was only ever created once.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing, and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 4
+#define GETS_PER_THREAD 2000000
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// How many mutexes each way has created, which should be 1
+uint32_m created_locked = 0;
+uint32_m created_lazy = 0;
+
+// The old way: the check for whether the mutex exists yet is made under a global spinlock
+
+muSpinlock guard = 0;
+muMutex locked_mutex = 0;
+
+muMutex get_locked_mutex(void) {
+	mu_spinlock_lock(guard);
+	if (!locked_mutex) {
+		locked_mutex = mu_mutex_create();
+		scall(mu_mutex_create)
+		created_locked++;
+	}
+	muMutex mutex = locked_mutex;
+	mu_spinlock_unlock(guard);
+	return mutex;
+}
+
+// The new way: MU_LAZY defines lazy_mutex(), which creates it on the first call
+
+muMutex create_lazy_mutex(void) {
+	// Only ever called by one thread, so this needs no lock
+	created_lazy++;
+	muMutex mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+	return mutex;
+}
+
+MU_LAZY(muMutex, lazy_mutex, create_lazy_mutex());
+
+// Each thread gets the mutex over and over, counting how often it didn't get the same one
+uint32_m mismatches[THREAD_COUNT];
+
+void locked_getter(void* args) {
+	muMutex first = get_locked_mutex();
+	for (uint32_m i = 0; i < GETS_PER_THREAD; i++) {
+		if (get_locked_mutex() != first) {
+			mismatches[(size_m)args]++;
+		}
+	}
+}
+
+void lazy_getter(void* args) {
+	muMutex first = lazy_mutex();
+	for (uint32_m i = 0; i < GETS_PER_THREAD; i++) {
+		if (lazy_mutex() != first) {
+			mismatches[(size_m)args]++;
+		}
+	}
+}
+
+double run(void (*getter)(void* args)) {
+	muThread threads[THREAD_COUNT];
+	double start = now_seconds();
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(getter, (void*)i);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	double time = now_seconds() - start;
+
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		if (mismatches[i]) {
+			printf("WARNING: thread %u got a different mutex %u times\n", (unsigned)i, (unsigned)mismatches[i]);
+			mismatches[i] = 0;
+		}
+	}
+	return time;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	guard = mu_spinlock_create();
+	scall(mu_spinlock_create)
+
+	double gets = (double)THREAD_COUNT * GETS_PER_THREAD;
+	printf("%u threads getting a lazily created mutex:\n", (unsigned)THREAD_COUNT);
+	double time = run(locked_getter);
+	printf("  global spinlock:  %.2f ns per get, created %u time(s)\n", time * 1000000000.0 / gets, (unsigned)created_locked);
+	time = run(lazy_getter);
+	printf("  MU_LAZY:          %.2f ns per get, created %u time(s)\n", time * 1000000000.0 / gets, (unsigned)created_lazy);
+
+	locked_mutex = mu_mutex_destroy(locked_mutex);
+	scall(mu_mutex_destroy)
+	// A lazy global is never freed by mum, but it can be by hand once nothing will use it again
+	mu_mutex_destroy(lazy_mutex());
+	scall(mu_mutex_destroy)
+	guard = mu_spinlock_destroy(guard);
+	scall(mu_spinlock_destroy)
+
+	// The numbers vary by machine; the spinlock's cache line bounces between every thread
+	// getting the mutex, whereas once it exists, MU_LAZY only reads a flag that never changes.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
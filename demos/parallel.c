@@ -0,0 +1,236 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          parallel.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks the parallel sort, scan, partition
+and transform-reduce on arrays from a thousand elements
+upwards, against running each of them serially, and checks
+that both give the same results.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing, stdlib for malloc, and time for timing
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define WORKER_COUNT 4
+// Sizes go up by 32 times from 1K; define MAX_COUNT as (1 << 30) to go up to 1G elements,
+// which needs about 16GB of memory
+#ifndef MAX_COUNT
+	#define MAX_COUNT (1 << 25)
+#endif
+
+int compare(const void* a, const void* b, void* args) {
+	if (args) {}
+	uint32_m x = *(const uint32_m*)a;
+	uint32_m y = *(const uint32_m*)b;
+	return (x > y) - (x < y);
+}
+
+void add(void* accumulator, const void* value, void* args) {
+	*(uint32_m*)accumulator += *(const uint32_m*)value;
+	return; if (args) {}
+}
+
+muBool is_even(const void* element, void* args) {
+	if (args) {}
+	return (*(const uint32_m*)element & 1) == 0;
+}
+
+void square(void* value, const void* element, void* args) {
+	uint64_m x = *(const uint32_m*)element;
+	*(uint64_m*)value = x * x;
+	return; if (args) {}
+}
+
+void add64(void* accumulator, const void* value, void* args) {
+	*(uint64_m*)accumulator += *(const uint64_m*)value;
+	return; if (args) {}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// The array being worked on, a copy of it for the serial run, and the random input both
+// start from
+uint32_m* input = 0;
+uint32_m* parallel = 0;
+uint32_m* serial = 0;
+
+void fill(size_m count) {
+	uint32_m x = 2463534242u;
+	for (size_m i = 0; i < count; i++) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		input[i] = x;
+	}
+}
+
+void reset(size_m count) {
+	memcpy(parallel, input, count * sizeof(uint32_m));
+	memcpy(serial, input, count * sizeof(uint32_m));
+}
+
+void report(const char* name, double serial_time, double parallel_time, muBool same) {
+	printf("  %-16s %10.3f ms serial, %10.3f ms parallel, %5.2fx%s\n",
+		name, serial_time * 1000.0, parallel_time * 1000.0, serial_time / parallel_time,
+		same ? "" : "  (RESULTS DIFFER)"
+	);
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	muScheduler scheduler = mu_scheduler_create(WORKER_COUNT, 0);
+	scall(mu_scheduler_create)
+
+	input = (uint32_m*)malloc(MAX_COUNT * sizeof(uint32_m));
+	parallel = (uint32_m*)malloc(MAX_COUNT * sizeof(uint32_m));
+	serial = (uint32_m*)malloc(MAX_COUNT * sizeof(uint32_m));
+	if (!input || !parallel || !serial) {
+		printf("Failed to allocate arrays of %u elements\n", (unsigned)MAX_COUNT);
+		return 1;
+	}
+
+	printf("%u workers, serial below %u elements\n", (unsigned)WORKER_COUNT, (unsigned)MUM_PARALLEL_SERIAL);
+	for (size_m count = 1024; count <= MAX_COUNT; count *= 32) {
+		printf("%lu elements:\n", (unsigned long)count);
+		fill(count);
+		double start, serial_time, parallel_time;
+
+		// Sort
+		reset(count);
+		start = now_seconds();
+		mu_parallel_sort(0, serial, count, sizeof(uint32_m), compare, 0);
+		scall(mu_parallel_sort)
+		serial_time = now_seconds() - start;
+		start = now_seconds();
+		mu_parallel_sort(scheduler, parallel, count, sizeof(uint32_m), compare, 0);
+		scall(mu_parallel_sort)
+		parallel_time = now_seconds() - start;
+		report("sort", serial_time, parallel_time, memcmp(serial, parallel, count * sizeof(uint32_m)) == 0);
+
+		// Inclusive scan, in place
+		reset(count);
+		uint32_m zero = 0;
+		start = now_seconds();
+		mu_parallel_scan(0, serial, serial, count, sizeof(uint32_m), &zero, add, 0, MU_TRUE);
+		scall(mu_parallel_scan)
+		serial_time = now_seconds() - start;
+		start = now_seconds();
+		mu_parallel_scan(scheduler, parallel, parallel, count, sizeof(uint32_m), &zero, add, 0, MU_TRUE);
+		scall(mu_parallel_scan)
+		parallel_time = now_seconds() - start;
+		report("inclusive scan", serial_time, parallel_time, memcmp(serial, parallel, count * sizeof(uint32_m)) == 0);
+
+		// Stable partition
+		reset(count);
+		start = now_seconds();
+		size_m serial_even = mu_parallel_partition(0, serial, count, sizeof(uint32_m), is_even, 0);
+		scall(mu_parallel_partition)
+		serial_time = now_seconds() - start;
+		start = now_seconds();
+		size_m parallel_even = mu_parallel_partition(scheduler, parallel, count, sizeof(uint32_m), is_even, 0);
+		scall(mu_parallel_partition)
+		parallel_time = now_seconds() - start;
+		report("partition", serial_time, parallel_time,
+			serial_even == parallel_even && memcmp(serial, parallel, count * sizeof(uint32_m)) == 0
+		);
+
+		// Sum of squares
+		uint64_m zero64 = 0, serial_sum = 0, parallel_sum = 0;
+		start = now_seconds();
+		mu_parallel_transform_reduce(0, input, count, sizeof(uint32_m), &serial_sum, sizeof(uint64_m), &zero64, square, add64, 0);
+		scall(mu_parallel_transform_reduce)
+		serial_time = now_seconds() - start;
+		start = now_seconds();
+		mu_parallel_transform_reduce(scheduler, input, count, sizeof(uint32_m), &parallel_sum, sizeof(uint64_m), &zero64, square, add64, 0);
+		scall(mu_parallel_transform_reduce)
+		parallel_time = now_seconds() - start;
+		report("transform-reduce", serial_time, parallel_time, serial_sum == parallel_sum);
+	}
+
+	free(input);
+	free(parallel);
+	free(serial);
+	scheduler = mu_scheduler_destroy(scheduler);
+	scall(mu_scheduler_destroy)
+
+	// The numbers vary by machine; below MUM_PARALLEL_SERIAL elements both runs are serial,
+	// and the parallel runs can only pull ahead with more than one CPU.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,228 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          parking_lot.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo gives each of a million accounts its own byte
+mutex, and has several threads transfer money between
+random accounts, checking that none was lost; it then has
+threads fight over a single byte mutex, so that they park,
+and race to call a function through a byte once flag.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define ACCOUNT_COUNT 1000000
+#define THREAD_COUNT 8
+#define TRANSFERS 200000
+#define HOT_ITERATIONS 20000
+
+// Each account has its own lock, costing one byte more per account
+int64_m balances[ACCOUNT_COUNT];
+muByteMutex locks[ACCOUNT_COUNT];
+
+// A single lock that every thread fights over
+muByteMutex hot_lock = 0;
+volatile uint64_m hot_counter = 0;
+
+// A function that must only be called once
+muByteOnce once = 0;
+volatile uint32_m once_calls = 0;
+
+// Small random number generator, one state per thread
+uint32_m next_random(uint32_m* state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+void transfer_func(void* args) {
+	uint32_m state = (uint32_m)(size_m)args * 2654435761u + 1;
+
+	for (size_m i = 0; i < TRANSFERS; i++) {
+		size_m from = next_random(&state) % ACCOUNT_COUNT;
+		size_m to = next_random(&state) % ACCOUNT_COUNT;
+		if (from == to) {
+			continue;
+		}
+
+		// Always lock the lower account first so that two transfers can't deadlock
+		size_m first = from < to ? from : to;
+		size_m second = from < to ? to : from;
+		mu_byte_mutex_lock(&locks[first]);
+		mu_byte_mutex_lock(&locks[second]);
+
+		int64_m amount = (int64_m)(next_random(&state) % 100);
+		balances[from] -= amount;
+		balances[to] += amount;
+
+		mu_byte_mutex_unlock(&locks[second]);
+		mu_byte_mutex_unlock(&locks[first]);
+	}
+}
+
+void hot_func(void* args) {
+	for (size_m i = 0; i < HOT_ITERATIONS; i++) {
+		mu_byte_mutex_lock(&hot_lock);
+		// Hold it for a while, so that the others give up spinning and park
+		for (size_m j = 0; j < 200; j++) {
+			hot_counter++;
+		}
+		mu_byte_mutex_unlock(&hot_lock);
+	}
+	if (args) {}
+}
+
+void init_func(void* args) {
+	// Take a while, so that the other threads have to wait for it
+	mu_thread_sleep(50);
+	once_calls++;
+	if (args) {}
+}
+
+void once_func(void* args) {
+	mu_byte_once_call(&once, init_func, 0);
+	// The function must have returned by now
+	if (once_calls != 1) {
+		printf("  WRONG: once flag returned before its function did\n");
+	}
+	if (args) {}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs the given function on several threads, returning how long it took
+double run(void (*func)(void* args)) {
+	muThread threads[THREAD_COUNT];
+
+	double start = now_seconds();
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(func, (void*)i);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	return now_seconds() - start;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	printf("Lock sizes: muByteMutex %u byte(s), muMutex %u bytes of handle plus its allocation\n",
+		(unsigned)sizeof(muByteMutex), (unsigned)sizeof(muMutex)
+	);
+
+	// Transfers between accounts
+	for (size_m i = 0; i < ACCOUNT_COUNT; i++) {
+		balances[i] = 1000;
+	}
+	double seconds = run(transfer_func);
+	int64_m total = 0;
+	for (size_m i = 0; i < ACCOUNT_COUNT; i++) {
+		total += balances[i];
+	}
+	printf("Transfers: %u threads, %.3f seconds, total %lld of %lld (%s)\n",
+		(unsigned)THREAD_COUNT, seconds, (long long)total, (long long)ACCOUNT_COUNT * 1000,
+		total == (int64_m)ACCOUNT_COUNT * 1000 ? "correct" : "WRONG"
+	);
+
+	// A single contended lock
+	seconds = run(hot_func);
+	uint64_m expected = (uint64_m)THREAD_COUNT * HOT_ITERATIONS * 200;
+	printf("Contended: %u threads, %.3f seconds, counted %llu of %llu (%s)\n",
+		(unsigned)THREAD_COUNT, seconds, (unsigned long long)hot_counter, (unsigned long long)expected,
+		hot_counter == expected ? "correct" : "WRONG"
+	);
+
+	// Racing to call once
+	run(once_func);
+	printf("Once flag: function called %u time(s) (%s)\n", (unsigned)once_calls, once_calls == 1 ? "correct" : "WRONG");
+
+	// Parking with a timeout, on an address that nobody unparks
+	seconds = now_seconds();
+	muBool unparked = mu_park(&seconds, 0, 0, 20);
+	printf("Timed park: %s after %.3f seconds\n", unparked ? "unparked" : "timed out", now_seconds() - seconds);
+
+	// The times vary by machine.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
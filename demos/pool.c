@@ -0,0 +1,286 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          pool.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo benchmarks recycling fixed-size message buffers
+through an object pool against a free list guarded by a
+mutex, and then checks that buffers freed by other threads
+than the ones that allocated them are never handed out
+twice.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing, stdlib for malloc, and time for timing
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 4
+#define ROUNDS 100000
+// Buffers each thread holds at once per round
+#define BATCH 16
+#define BUFFER_SIZE 256
+
+// A message buffer; the first member doubles as the free list link. The pool uses the first
+// 16 bytes of free objects itself, so the owner is kept at the end, where it lasts whilst the
+// buffer is free.
+typedef struct message {
+	struct message* next;
+	uint8_m data[BUFFER_SIZE - sizeof(void*) - sizeof(uint32_m)];
+	uint32_m owner;
+} message;
+
+// The pool being benchmarked
+muPool pool = 0;
+
+// The free list it's compared against
+muMutex list_mutex = 0;
+message* free_list = 0;
+
+message* list_alloc(void) {
+	mu_mutex_lock(list_mutex);
+	message* m = free_list;
+	if (m) {
+		free_list = m->next;
+	}
+	mu_mutex_unlock(list_mutex);
+	return m ? m : (message*)malloc(sizeof(message));
+}
+
+void list_free(message* m) {
+	mu_mutex_lock(list_mutex);
+	m->next = free_list;
+	free_list = m;
+	mu_mutex_unlock(list_mutex);
+}
+
+void pool_func(void* args) {
+	message* held[BATCH];
+	for (size_m r = 0; r < ROUNDS; r++) {
+		for (size_m i = 0; i < BATCH; i++) {
+			held[i] = (message*)mu_pool_alloc(pool);
+			held[i]->owner = (uint32_m)(size_m)args;
+		}
+		for (size_m i = 0; i < BATCH; i++) {
+			mu_pool_free(pool, held[i]);
+		}
+	}
+}
+
+void list_func(void* args) {
+	message* held[BATCH];
+	for (size_m r = 0; r < ROUNDS; r++) {
+		for (size_m i = 0; i < BATCH; i++) {
+			held[i] = list_alloc();
+			held[i]->owner = (uint32_m)(size_m)args;
+		}
+		for (size_m i = 0; i < BATCH; i++) {
+			list_free(held[i]);
+		}
+	}
+}
+
+// Buffers handed from each thread to the next, which frees them
+#define RING_SIZE 256
+typedef struct ring {
+	muMutex mutex;
+	message* slots[RING_SIZE];
+	size_m head;
+	size_m tail;
+} ring;
+ring rings[THREAD_COUNT];
+volatile uint32_m double_allocations = 0;
+
+void cross_func(void* args) {
+	size_m index = (size_m)args;
+	ring* out = &rings[(index + 1) % THREAD_COUNT];
+	ring* in = &rings[index];
+
+	for (size_m r = 0; r < ROUNDS; r++) {
+		// Mark a buffer as ours; if it was still marked, it was handed out twice
+		message* m = (message*)mu_pool_alloc(pool);
+		if (m->owner != 0xFFFFFFFF) {
+			double_allocations++;
+		}
+		m->owner = (uint32_m)index;
+
+		// Pass it on, unless the next thread is lagging behind, in which case free it here
+		mu_mutex_lock(out->mutex);
+		if (out->tail - out->head < RING_SIZE) {
+			out->slots[out->tail++ % RING_SIZE] = m;
+			m = 0;
+		}
+		mu_mutex_unlock(out->mutex);
+		if (m) {
+			m->owner = 0xFFFFFFFF;
+			mu_pool_free(pool, m);
+		}
+
+		// Free whatever the previous thread passed on
+		mu_mutex_lock(in->mutex);
+		while (in->head != in->tail) {
+			m = in->slots[in->head++ % RING_SIZE];
+			m->owner = 0xFFFFFFFF;
+			mu_pool_free(pool, m);
+		}
+		mu_mutex_unlock(in->mutex);
+	}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Runs the given function on several threads, returning how long it took
+double run(void (*func)(void* args)) {
+	muThread threads[THREAD_COUNT];
+
+	double start = now_seconds();
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(func, (void*)i);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	return now_seconds() - start;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	pool = mu_pool_create(sizeof(message));
+	scall(mu_pool_create)
+	list_mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+
+	double pairs = (double)THREAD_COUNT * ROUNDS * BATCH;
+	printf("%u threads, %u-byte buffers:\n", (unsigned)THREAD_COUNT, (unsigned)sizeof(message));
+	printf("  muPool:             %.2f ns per alloc/free pair\n", run(pool_func) * 1000000000.0 / pairs);
+	printf("  mutex + free list:  %.2f ns per alloc/free pair\n", run(list_func) * 1000000000.0 / pairs);
+
+	// Freeing on other threads; start from a fresh pool so that every buffer's mark is known
+	pool = mu_pool_destroy(pool);
+	scall(mu_pool_destroy)
+	pool = mu_pool_create(sizeof(message));
+	scall(mu_pool_create)
+
+	// Mark every buffer that the pool will hand out as free, by taking a few thousand and
+	// giving them back
+	message* held[4096];
+	for (size_m i = 0; i < 4096; i++) {
+		held[i] = (message*)mu_pool_alloc(pool);
+		scall(mu_pool_alloc)
+		held[i]->owner = 0xFFFFFFFF;
+	}
+	for (size_m i = 0; i < 4096; i++) {
+		mu_pool_free(pool, held[i]);
+	}
+
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		rings[i].mutex = mu_mutex_create();
+		scall(mu_mutex_create)
+		rings[i].head = rings[i].tail = 0;
+	}
+	run(cross_func);
+	printf("Cross-thread freeing: %u buffers handed out twice (%s)\n", (unsigned)double_allocations,
+		double_allocations == 0 ? "correct" : "WRONG"
+	);
+
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		for (size_m j = rings[i].head; j != rings[i].tail; j++) {
+			mu_pool_free(pool, rings[i].slots[j % RING_SIZE]);
+		}
+		rings[i].mutex = mu_mutex_destroy(rings[i].mutex);
+		scall(mu_mutex_destroy)
+	}
+
+	// Clean up
+	pool = mu_pool_destroy(pool);
+	scall(mu_pool_destroy)
+	list_mutex = mu_mutex_destroy(list_mutex);
+	scall(mu_mutex_destroy)
+	while (free_list) {
+		message* next = free_list->next;
+		free(free_list);
+		free_list = next;
+	}
+
+	// The numbers vary by machine; the pool should be well ahead of the free list once
+	// several CPUs are fighting over the list's mutex.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
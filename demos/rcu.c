@@ -0,0 +1,202 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          rcu.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo has several threads look up routes in a routing
+table within RCU read sections, while another thread keeps
+replacing the whole table with a new version, freeing old
+versions with mu_rcu_free. Every lookup checks that the
+table it sees was fully written, and the demo prints how
+many lookups were made and how long a read section took.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define READER_COUNT 3
+#define ROUTE_COUNT 256
+#define VERSION_COUNT 20000
+
+// A routing table; every route of a version points to the same gateway, so a reader can tell
+// if it sees a table that isn't fully written
+typedef struct {
+	uint32_m version;
+	uint32_m gateways[ROUTE_COUNT];
+} routing_table;
+
+routing_table* volatile table = 0;
+volatile uint32_m done = 0;
+
+// Lookups made by each reader, and how many saw a broken table
+uint32_m lookups[READER_COUNT];
+uint32_m broken[READER_COUNT];
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+routing_table* make_table(uint32_m version) {
+	routing_table* t = (routing_table*)mu_malloc(sizeof(routing_table));
+	if (!t) {
+		return 0;
+	}
+	t->version = version;
+	for (uint32_m i = 0; i < ROUTE_COUNT; i++) {
+		t->gateways[i] = version;
+	}
+	return t;
+}
+
+void reader(void* args) {
+	size_m index = (size_m)args;
+	uint32_m count = 0, bad = 0, route = (uint32_m)index;
+
+	while (!done) {
+		mu_rcu_read_lock();
+		routing_table* t = mu_rcu_dereference(table);
+		if (t->gateways[route % ROUTE_COUNT] != t->version) {
+			bad++;
+		}
+		mu_rcu_read_unlock();
+
+		route = route * 1103515245 + 12345;
+		count++;
+	}
+
+	lookups[index] = count;
+	broken[index] = bad;
+}
+
+void writer(void* args) {
+	for (uint32_m version = 1; version <= VERSION_COUNT; version++) {
+		routing_table* t = make_table(version);
+		if (!t) {
+			continue;
+		}
+
+		routing_table* old = table;
+		mu_rcu_assign_pointer(table, t);
+		mu_rcu_free(old);
+		scall(mu_rcu_free)
+	}
+	done = 1;
+	return; if (args) {}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Time read sections without anything else going on
+	size_m iterations = 10000000;
+	double start = now_seconds();
+	for (size_m i = 0; i < iterations; i++) {
+		mu_rcu_read_lock();
+		mu_rcu_read_unlock();
+	}
+	printf("Read section: %.2f ns\n", (now_seconds() - start) * 1000000000.0 / (double)iterations);
+
+	table = make_table(0);
+
+	start = now_seconds();
+	muThread threads[READER_COUNT + 1];
+	for (size_m i = 0; i < READER_COUNT; i++) {
+		threads[i] = mu_thread_create(reader, (void*)i);
+		scall(mu_thread_create)
+	}
+	threads[READER_COUNT] = mu_thread_create(writer, 0);
+	scall(mu_thread_create)
+	for (size_m i = 0; i <= READER_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	double elapsed = now_seconds() - start;
+
+	// Wait for the old tables to be freed
+	mu_rcu_barrier();
+	mu_free(table);
+
+	uint32_m count = 0, bad = 0;
+	for (size_m i = 0; i < READER_COUNT; i++) {
+		count += lookups[i];
+		bad += broken[i];
+	}
+	printf("%u versions published, %u lookups in %.3f s, %u lookups saw a broken table\n",
+		(unsigned)VERSION_COUNT, (unsigned)count, elapsed, (unsigned)bad
+	);
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,142 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          scheduler.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo floods a scheduler with low-priority batch work,
+then submits interactive high-priority tasks with deadlines
+on top, and prints how long each priority's tasks waited.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define BATCH_TASKS 2000
+#define INTERACTIVE_TASKS 100
+
+// Burns some time, standing in for real work
+volatile uint64_m sink = 0;
+void busy_work(uint32_m amount) {
+	for (uint32_m i = 0; i < amount; i++) {
+		sink += i;
+	}
+}
+
+void batch_task(void* args) {
+	busy_work(200000);
+	return; if (args) {}
+}
+
+void interactive_task(void* args) {
+	busy_work(20000);
+	return; if (args) {}
+}
+
+void print_stats(muScheduler scheduler, mumTaskPriority priority, const char* name) {
+	size_m queued;
+	uint64_m completed, average, max;
+	mu_scheduler_stats(scheduler, priority, &queued, &completed, &average, &max);
+	printf("%-12s %6llu done, %6llu queued, latency: average %8.3f ms, max %8.3f ms\n",
+		name, (unsigned long long)completed, (unsigned long long)queued, (double)average / 1000000.0, (double)max / 1000000.0
+	);
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create a scheduler with a worker per CPU, aging tasks every 20 ms
+	muScheduler scheduler = mu_scheduler_create(0, 20000000);
+	scall(mu_scheduler_create)
+
+	// Queue up the batch work first, then the interactive tasks, each of which should be done
+	// within 5 ms
+	for (size_m i = 0; i < BATCH_TASKS; i++) {
+		mu_scheduler_submit(scheduler, batch_task, 0, MUM_TASK_PRIORITY_LOW, 0);
+		scall(mu_scheduler_submit)
+	}
+	for (size_m i = 0; i < INTERACTIVE_TASKS; i++) {
+		mu_scheduler_submit(scheduler, interactive_task, 0, MUM_TASK_PRIORITY_HIGH, 5000000);
+		scall(mu_scheduler_submit)
+	}
+
+	// Wait for everything and print the stats; the interactive tasks should have barely waited,
+	// despite being submitted behind all of the batch work
+	mu_scheduler_wait(scheduler);
+	print_stats(scheduler, MUM_TASK_PRIORITY_HIGH, "Interactive:");
+	print_stats(scheduler, MUM_TASK_PRIORITY_LOW, "Batch:");
+
+	// Destroy the scheduler
+	scheduler = mu_scheduler_destroy(scheduler);
+	scall(mu_scheduler_destroy)
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
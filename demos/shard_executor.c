@@ -0,0 +1,182 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          shard_executor.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo runs one shard per CPU (at least four), each of
+which owns a row of counters that only it touches; every
+shard sends every other shard a stream of messages telling
+it to bump one of its counters, and the counts are checked
+once all of them have been run.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define MAX_SHARDS 64
+// Messages each shard sends to each shard, in chunks, so that the rings get published and
+// drained as the stream goes on
+#define MESSAGES 200000
+#define CHUNK 256
+
+muShardExecutor executor = 0;
+uint32_m shard_count = 0;
+
+// Row i is owned by shard i: counts[i][j] is how many messages shard i got from shard j
+uint64_m counts[MAX_SHARDS][MAX_SHARDS];
+// How many messages each shard has sent so far to each other shard; also only touched by the
+// sending shard
+uint32_m progress[MAX_SHARDS];
+
+// Run on the receiving shard, with the sender as the argument
+void count_message(void* args) {
+	uint32_m self = mu_shard_current(executor);
+	// Tasks are only ever run on a shard, but mu_shard_current returns 0xFFFFFFFF elsewhere
+	if (self == 0xFFFFFFFF) {
+		return;
+	}
+	counts[self][(size_m)args]++;
+}
+
+// Sends the next chunk of messages to every shard, and then sends itself to its own shard to
+// send the chunk after that
+void send_chunk(void* args) {
+	uint32_m self = mu_shard_current(executor);
+	if (self == 0xFFFFFFFF) {
+		return;
+	}
+	for (uint32_m i = 0; i < CHUNK && progress[self] < MESSAGES; i++, progress[self]++) {
+		for (uint32_m to = 0; to < shard_count; to++) {
+			mu_shard_submit(executor, to, count_message, (void*)(size_m)self);
+			scall(mu_shard_submit)
+		}
+	}
+	if (progress[self] < MESSAGES) {
+		mu_shard_submit(executor, self, send_chunk, 0);
+		scall(mu_shard_submit)
+	}
+	if (args) {}
+}
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// One shard per CPU, but at least four, several sharing a CPU if there are fewer
+	uint32_m cpu_count = mu_topology_cpu_count();
+	shard_count = cpu_count < 4 ? 4 : cpu_count;
+	shard_count = shard_count > MAX_SHARDS ? MAX_SHARDS : shard_count;
+	uint32_m cpus[MAX_SHARDS];
+	for (uint32_m i = 0; i < shard_count; i++) {
+		cpus[i] = i % cpu_count;
+	}
+
+	executor = mu_shard_executor_create(cpus, shard_count, 0);
+	scall(mu_shard_executor_create)
+	if (!executor) {
+		return 1;
+	}
+
+	// Kick off every shard's stream from outside
+	double start = now_seconds();
+	for (uint32_m i = 0; i < shard_count; i++) {
+		mu_shard_submit(executor, i, send_chunk, 0);
+		scall(mu_shard_submit)
+	}
+	mu_shard_executor_wait(executor);
+	double seconds = now_seconds() - start;
+
+	// Nothing's running now, so the rows can be read from here
+	muBool correct = MU_TRUE;
+	for (uint32_m i = 0; i < shard_count; i++) {
+		for (uint32_m j = 0; j < shard_count; j++) {
+			correct = correct && counts[i][j] == MESSAGES;
+		}
+	}
+	double messages = (double)shard_count * shard_count * MESSAGES;
+	printf("%u shards on %u CPUs: %.0f messages in %.3f seconds, %.2f million per second (%s)\n",
+		(unsigned)shard_count, (unsigned)cpu_count, messages, seconds, messages / seconds / 1000000.0,
+		correct ? "correct" : "WRONG"
+	);
+
+	executor = mu_shard_executor_destroy(executor);
+	scall(mu_shard_executor_destroy)
+
+	// The numbers vary by machine, and shards sharing a CPU take turns with each other.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,138 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          stop.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo shows how to stop threads cooperatively with
+stop tokens instead of cancelling them.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+/* Create the functions that our threads will run on */
+
+// A thread that does busy work until it is requested to stop
+void worker_func(void* args) {
+	// Get the stop token of this thread; polling it is just one load
+	muStopToken token = mu_thread_current_stop_token();
+
+	// Do work until a stop is requested
+	size_m* iterations = (size_m*)args;
+	while (!mu_stop_requested(token)) {
+		*iterations += 1;
+	}
+
+	// Returning from the thread is the same as calling 'mu_thread_exit(0)'
+}
+
+// A thread that sleeps for a long time, but wakes up early when it is requested to stop
+void sleeper_func(void* args) {
+	muBool* finished_sleeping = (muBool*)args;
+	*finished_sleeping = mu_thread_sleep(60000);
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create our threads
+
+	size_m iterations = 0;
+	muThread worker = mu_thread_create(worker_func, &iterations);
+	scall(mu_thread_create)
+
+	muBool finished_sleeping = MU_TRUE;
+	muThread sleeper = mu_thread_create(sleeper_func, &finished_sleeping);
+	scall(mu_thread_create)
+
+	// Let them run for a bit
+	mu_thread_sleep(100);
+
+	// Destroy them by requesting a stop and joining them; neither is ever cancelled, so it
+	// would be safe for them to be holding a lock at this point
+	worker = mu_thread_destroy_mode(worker, MUM_THREAD_DESTROY_JOIN);
+	scall(mu_thread_destroy_mode)
+	sleeper = mu_thread_destroy_mode(sleeper, MUM_THREAD_DESTROY_JOIN);
+	scall(mu_thread_destroy_mode)
+
+	// Print what happened
+	printf("Worker stopped after %s iterations\n", (iterations > 0) ? "some" : "no");
+	printf("Sleeper %s\n", finished_sleeping ? "slept for the full minute" : "was woken up early");
+
+	// Should print:
+	/*
+	Worker stopped after some iterations
+	Sleeper was woken up early
+	*/
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
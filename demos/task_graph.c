@@ -0,0 +1,190 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          task_graph.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo builds a task graph shaped like a small build:
+source files are compiled, grouped into libraries, and
+linked into a program, with one slow code generation step
+at the start. It runs the graph a few times, printing how
+long each run took against its critical path, and then
+shows a cycle being caught.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define LIBRARIES 4
+#define SOURCES_PER_LIBRARY 4
+
+// A build step, which sleeps for as long as it "takes"
+struct step {
+	const char* name;
+	uint32_m milliseconds;
+};
+
+void run_step(void* args) {
+	struct step* step = (struct step*)args;
+	mu_thread_sleep(step->milliseconds);
+}
+
+struct step generate_step = { "generate", 30 };
+struct step compiles[LIBRARIES][SOURCES_PER_LIBRARY];
+struct step archives[LIBRARIES];
+struct step link_step = { "link", 20 };
+const char* names[2 + LIBRARIES * (SOURCES_PER_LIBRARY + 1)];
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create a scheduler and a task graph on it; the steps sleep rather than use a CPU, so the
+	// scheduler can have more workers than there are CPUs
+	muScheduler scheduler = mu_scheduler_create(8, 0);
+	scall(mu_scheduler_create)
+	muTaskGraph graph = mu_task_graph_create(scheduler);
+	scall(mu_task_graph_create)
+
+	// Code generation comes first, and only the first library's sources depend on it
+	uint32_m generate_node = mu_task_graph_add_node(graph, run_step, &generate_step, MUM_TASK_PRIORITY_NORMAL);
+	scall(mu_task_graph_add_node)
+	names[generate_node] = generate_step.name;
+	uint32_m link_node = mu_task_graph_add_node(graph, run_step, &link_step, MUM_TASK_PRIORITY_NORMAL);
+	scall(mu_task_graph_add_node)
+	names[link_node] = link_step.name;
+
+	// Each library is archived from its compiled sources, and every library is linked
+	for (uint32_m l = 0; l < LIBRARIES; l++) {
+		archives[l].name = "archive";
+		archives[l].milliseconds = 10;
+		uint32_m archive_node = mu_task_graph_add_node(graph, run_step, &archives[l], MUM_TASK_PRIORITY_NORMAL);
+		scall(mu_task_graph_add_node)
+		names[archive_node] = archives[l].name;
+
+		for (uint32_m s = 0; s < SOURCES_PER_LIBRARY; s++) {
+			compiles[l][s].name = "compile";
+			compiles[l][s].milliseconds = 10 + s * 5;
+			uint32_m compile_node = mu_task_graph_add_node(graph, run_step, &compiles[l][s], MUM_TASK_PRIORITY_NORMAL);
+			scall(mu_task_graph_add_node)
+			names[compile_node] = compiles[l][s].name;
+
+			if (l == 0) {
+				mu_task_graph_add_edge(graph, generate_node, compile_node);
+				scall(mu_task_graph_add_edge)
+			}
+			mu_task_graph_add_edge(graph, compile_node, archive_node);
+			scall(mu_task_graph_add_edge)
+		}
+
+		mu_task_graph_add_edge(graph, archive_node, link_node);
+		scall(mu_task_graph_add_edge)
+	}
+
+	// Run the graph a few times; steps take as long as they'd take one after another
+	uint64_m sequential = generate_step.milliseconds + link_step.milliseconds;
+	for (uint32_m l = 0; l < LIBRARIES; l++) {
+		sequential += archives[l].milliseconds;
+		for (uint32_m s = 0; s < SOURCES_PER_LIBRARY; s++) {
+			sequential += compiles[l][s].milliseconds;
+		}
+	}
+	printf("Sequentially, the build would take %llu ms\n", (unsigned long long)sequential);
+
+	for (uint32_m run = 0; run < 3; run++) {
+		uint64_m elapsed = mu_task_graph_run(graph);
+		scall(mu_task_graph_run)
+
+		uint32_m path[2 + LIBRARIES * (SOURCES_PER_LIBRARY + 1)];
+		uint32_m path_length;
+		uint64_m critical = mu_task_graph_critical_path(graph, path, &path_length);
+
+		printf("Run %u took %.1f ms; critical path of %.1f ms: ", (unsigned)run, (double)elapsed / 1000000.0, (double)critical / 1000000.0);
+		for (uint32_m i = 0; i < path_length; i++) {
+			printf("%s%s (%.1f ms)", i ? " -> " : "", names[path[i]], (double)mu_task_graph_node_time(graph, path[i]) / 1000000.0);
+		}
+		printf("\n");
+	}
+
+	// Make linking a dependency of code generation, which can never work
+	mu_task_graph_add_edge(graph, link_node, generate_node);
+	scall(mu_task_graph_add_edge)
+	mu_task_graph_run(graph);
+	printf("Running with a cycle: %s\n", mum_result_get_name(result));
+	result = MUM_SUCCESS;
+
+	// Destroy everything
+	mu_task_graph_destroy(graph);
+	scall(mu_task_graph_destroy)
+	mu_scheduler_destroy(scheduler);
+	scall(mu_scheduler_destroy)
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
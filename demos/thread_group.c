@@ -0,0 +1,160 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          thread_group.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo creates a group of threads that each sleep for a
+different amount of time, and waits on them one by one in
+the order they finish, rather than the order they were
+created in. It then times starting and joining a group of
+threads against doing the same with one thread at a time.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 8
+#define ROUNDS 200
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// Sleeps for the given amount of milliseconds
+void sleeper(void* args) {
+	mu_thread_sleep((uint32_m)(size_m)args);
+}
+
+void nothing(void* args) {
+	return; if (args) {}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// The first threads sleep the longest, so they finish last
+	void* sleeps[THREAD_COUNT];
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		sleeps[i] = (void*)(size_m)((THREAD_COUNT - i) * 20);
+	}
+
+	muThreadGroup group = mu_thread_create_many(THREAD_COUNT, sleeper, sleeps);
+	scall(mu_thread_create_many)
+
+	printf("Finishing order:");
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		size_m index = mu_thread_wait_any(group);
+		scall(mu_thread_wait_any)
+		printf(" %u (%u ms)", (unsigned)index, (unsigned)(size_m)sleeps[index]);
+	}
+	printf("\n");
+
+	group = mu_thread_destroy_many(group, MUM_THREAD_DESTROY_JOIN);
+	scall(mu_thread_destroy_many)
+
+	// Start and join threads that do nothing, one at a time...
+	double start = now_seconds();
+	for (size_m round = 0; round < ROUNDS; round++) {
+		muThread threads[THREAD_COUNT];
+		for (size_m i = 0; i < THREAD_COUNT; i++) {
+			threads[i] = mu_thread_create(nothing, 0);
+			scall(mu_thread_create)
+		}
+		for (size_m i = 0; i < THREAD_COUNT; i++) {
+			threads[i] = mu_thread_destroy_mode(threads[i], MUM_THREAD_DESTROY_JOIN);
+			scall(mu_thread_destroy_mode)
+		}
+	}
+	double one_by_one = now_seconds() - start;
+
+	// ...and as a group
+	start = now_seconds();
+	for (size_m round = 0; round < ROUNDS; round++) {
+		group = mu_thread_create_many(THREAD_COUNT, nothing, 0);
+		scall(mu_thread_create_many)
+		group = mu_thread_destroy_many(group, MUM_THREAD_DESTROY_JOIN);
+		scall(mu_thread_destroy_many)
+	}
+	double grouped = now_seconds() - start;
+
+	printf("%i rounds of %i threads: %.2f us per round one by one (%i allocations), %.2f us per round as a group (1 allocation)\n",
+		ROUNDS, THREAD_COUNT, one_by_one * 1000000.0 / ROUNDS, THREAD_COUNT, grouped * 1000000.0 / ROUNDS
+	);
+
+	// Creating the threads themselves costs far more than either way of managing them; what the
+	// group saves is an allocation per thread, and the joining thread going to sleep once per
+	// thread rather than once per group.
+
+	return 0;
+}
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
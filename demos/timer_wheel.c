@@ -0,0 +1,197 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          timer_wheel.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo schedules tens of thousands of timeouts on a timer
+wheel, cancels half of them before they expire (as if the
+requests they guarded had finished in time), runs a periodic
+timer alongside them, and prints how late the timers that
+did fire were.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define TIMEOUTS 20000
+#define MAX_DELAY_MS 400
+#define PERIOD_MS 50
+
+uint64_m now_ns(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (uint64_m)ts.tv_sec * 1000000000 + (uint64_m)ts.tv_nsec;
+}
+
+// A timeout's due time, and what it's set to once it fires
+struct timeout {
+	uint64_m due;
+	uint64_m fired;
+};
+struct timeout timeouts[TIMEOUTS];
+
+volatile uint32_m periodic_runs = 0;
+
+void timeout_callback(void* args) {
+	struct timeout* t = (struct timeout*)args;
+	t->fired = now_ns();
+}
+
+void periodic_callback(void* args) {
+	periodic_runs++;
+	return; if (args) {}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create a scheduler for the callbacks to run on, and a timer wheel with 1 ms ticks
+	muScheduler scheduler = mu_scheduler_create(0, 0);
+	scall(mu_scheduler_create)
+	muTimerWheel wheel = mu_timer_wheel_create(scheduler, 0);
+	scall(mu_timer_wheel_create)
+
+	// Start a periodic timer
+	uint64_m periodic = mu_timer_schedule(wheel, PERIOD_MS * 1000000ull, PERIOD_MS * 1000000ull, periodic_callback, 0, MUM_TASK_PRIORITY_HIGH);
+	scall(mu_timer_schedule)
+
+	// Schedule every timeout with a pseudo-random delay
+	uint64_m* ids = (uint64_m*)mu_malloc(TIMEOUTS * sizeof(uint64_m));
+	uint32_m seed = 12345;
+	uint64_m start = now_ns();
+	for (size_m i = 0; i < TIMEOUTS; i++) {
+		seed = seed * 1664525 + 1013904223;
+		uint64_m delay = (uint64_m)(1 + (seed >> 8) % MAX_DELAY_MS) * 1000000;
+		timeouts[i].due = now_ns() + delay;
+		timeouts[i].fired = 0;
+		ids[i] = mu_timer_schedule(wheel, delay, 0, timeout_callback, &timeouts[i], MUM_TASK_PRIORITY_NORMAL);
+		scall(mu_timer_schedule)
+	}
+	printf("Scheduled %d timeouts in %.3f ms\n", TIMEOUTS, (double)(now_ns() - start) / 1000000.0);
+
+	// Cancel every odd timeout; some may have already fired
+	start = now_ns();
+	size_m cancelled = 0;
+	for (size_m i = 1; i < TIMEOUTS; i += 2) {
+		if (mu_timer_cancel(wheel, ids[i])) {
+			timeouts[i].due = 0;
+			cancelled++;
+		}
+	}
+	printf("Cancelled %llu timeouts in %.3f ms\n", (unsigned long long)cancelled, (double)(now_ns() - start) / 1000000.0);
+
+	// Wait for everything left to fire
+	mu_thread_sleep(MAX_DELAY_MS + 100);
+	mu_timer_cancel(wheel, periodic);
+	mu_scheduler_wait(scheduler);
+
+	// Check that every remaining timeout fired, and never early
+	size_m fired = 0, missing = 0, early = 0;
+	uint64_m late_sum = 0, late_max = 0;
+	for (size_m i = 0; i < TIMEOUTS; i++) {
+		if (timeouts[i].due == 0) {
+			if (timeouts[i].fired) {
+				printf("A cancelled timeout fired\n");
+			}
+			continue;
+		}
+		if (!timeouts[i].fired) {
+			missing++;
+			continue;
+		}
+		fired++;
+		if (timeouts[i].fired < timeouts[i].due) {
+			early++;
+			continue;
+		}
+		uint64_m late = timeouts[i].fired - timeouts[i].due;
+		late_sum += late;
+		if (late > late_max) {
+			late_max = late;
+		}
+	}
+	printf("%llu fired (%llu missing, %llu early), lateness: average %.3f ms, max %.3f ms\n",
+		(unsigned long long)fired, (unsigned long long)missing, (unsigned long long)early,
+		fired ? (double)late_sum / (double)fired / 1000000.0 : 0.0, (double)late_max / 1000000.0
+	);
+	printf("Periodic timer ran %u times\n", (unsigned)periodic_runs);
+
+	// Destroy everything
+	mu_free(ids);
+	mu_timer_wheel_destroy(wheel);
+	scall(mu_timer_wheel_destroy)
+	mu_scheduler_destroy(scheduler);
+	scall(mu_scheduler_destroy)
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
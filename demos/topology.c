@@ -0,0 +1,157 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          topology.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo prints the machine's CPU topology, then creates a
+worker bound to each NUMA node, with its data allocated on
+that same node.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Define _GNU_SOURCE, needed to bind threads to CPUs on Linux
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define WORK_SIZE (1024 * 1024)
+
+// What each worker is given
+struct worker {
+	uint32_m node;
+	uint64_m* data;
+	uint64_m sum;
+	uint32_m ran_on_node;
+};
+
+void worker_func(void* args) {
+	struct worker* w = (struct worker*)args;
+
+	// Touching the data from a thread on the same node keeps every access local
+	for (size_m i = 0; i < WORK_SIZE; i++) {
+		w->data[i] = i;
+	}
+	w->sum = 0;
+	for (size_m i = 0; i < WORK_SIZE; i++) {
+		w->sum += w->data[i];
+	}
+
+	w->ran_on_node = mu_topology_current_node();
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Print the topology
+	uint32_m cpu_count = mu_topology_cpu_count();
+	printf("%u CPUs, %u cores, %u last-level caches, %u NUMA nodes\n",
+		(unsigned)cpu_count, (unsigned)mu_topology_core_count(), (unsigned)mu_topology_llc_count(), (unsigned)mu_topology_node_count()
+	);
+	for (uint32_m cpu = 0; cpu < cpu_count; cpu++) {
+		printf("CPU %u: core %u, LLC %u, node %u\n",
+			(unsigned)cpu, (unsigned)mu_topology_cpu_core(cpu), (unsigned)mu_topology_cpu_llc(cpu), (unsigned)mu_topology_cpu_node(cpu)
+		);
+	}
+
+	// Create a worker on each node, with its data on that node
+	uint32_m node_count = mu_topology_node_count();
+	struct worker workers[64];
+	muThread threads[64];
+	if (node_count > 64) {
+		node_count = 64;
+	}
+
+	for (uint32_m node = 0; node < node_count; node++) {
+		workers[node].node = node;
+		workers[node].data = (uint64_m*)mu_node_alloc(WORK_SIZE * sizeof(uint64_m), node);
+		workers[node].ran_on_node = 0;
+
+		threads[node] = mu_thread_create_on_node(worker_func, &workers[node], node);
+		scall(mu_thread_create_on_node)
+	}
+
+	// Wait for the workers, then print where they ran and free their data
+	for (uint32_m node = 0; node < node_count; node++) {
+		if (threads[node]) {
+			threads[node] = mu_thread_destroy_mode(threads[node], MUM_THREAD_DESTROY_JOIN);
+			scall(mu_thread_destroy_mode)
+			printf("Worker for node %u ran on node %u, sum %llu\n",
+				(unsigned)node, (unsigned)workers[node].ran_on_node, (unsigned long long)workers[node].sum
+			);
+		}
+		mu_node_free(workers[node].data, WORK_SIZE * sizeof(uint64_m));
+	}
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,145 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          trace.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo has a few threads fight over a mutex and a
+spinlock with tracing enabled, and writes the timeline to
+"trace.json", which can be opened in Perfetto
+(https://ui.perfetto.dev) or chrome://tracing.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum, with tracing compiled in
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_TRACE
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing
+#include <stdio.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THREAD_COUNT 4
+#define ITERATIONS 200
+
+muMutex mutex = 0;
+muSpinlock spinlock = 0;
+volatile uint64_m counter = 0;
+
+// Holds each lock for a bit of busy work, so that the other threads have to wait for it
+void do_work(void) {
+	for (uint32_m i = 0; i < 2000; i++) {
+		counter++;
+	}
+}
+
+void thread_func(void* args) {
+	for (uint32_m i = 0; i < ITERATIONS; i++) {
+		mu_mutex_lock(mutex);
+		do_work();
+		mu_mutex_unlock(mutex);
+
+		mu_spinlock_lock(spinlock);
+		do_work();
+		mu_spinlock_unlock(spinlock);
+	}
+
+	return; if (args) {}
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	// Create the locks
+	mutex = mu_mutex_create();
+	scall(mu_mutex_create)
+	spinlock = mu_spinlock_create();
+	scall(mu_spinlock_create)
+
+	// Run the threads and wait for them
+	muThread threads[THREAD_COUNT];
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_create(thread_func, 0);
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = mu_thread_destroy_mode(threads[i], MUM_THREAD_DESTROY_JOIN);
+		scall(mu_thread_destroy_mode)
+	}
+
+	// Write the timeline
+	mu_trace_flush("trace.json");
+	scall(mu_trace_flush)
+	printf("Wrote trace.json\n");
+
+	// Destroy the locks
+	mutex = mu_mutex_destroy(mutex);
+	scall(mu_mutex_destroy)
+	spinlock = mu_spinlock_destroy(spinlock);
+	scall(mu_spinlock_destroy)
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
@@ -0,0 +1,220 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          ws_deque.c
+DEMO WRITTEN BY:    Muukid
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo has one thread push and pop items on a
+work-stealing deque while other threads steal from it, once
+stealing one item at a time and once stealing half at a
+time. It checks that every item was taken exactly once, and
+prints how many steals each way needed.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain, 
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+// Include mum
+#define MUM_NAMES // (for mum_result_get_name)
+#define MUM_IMPLEMENTATION
+#include "muMultithreading.h"
+
+// Include stdio for printing and time for timing
+#include <stdio.h>
+#include <time.h>
+
+// Result + macro for checking result
+mumResult result = MUM_SUCCESS;
+#define scall(fun) if (result != MUM_SUCCESS) { printf("WARNING: '" #fun "' returned: %s\n", mum_result_get_name(result)); result = MUM_SUCCESS; }
+
+#define THIEF_COUNT 3
+#define ITEM_COUNT 1000000
+#define BURST 64
+#define STEAL_BATCH 32
+
+// The items are pointers to these counters, which count how many times each was taken
+volatile uint32_m taken[ITEM_COUNT];
+volatile uint32_m done = 0;
+muBool steal_half = MU_FALSE;
+muWSDeque deque = 0;
+
+// Successful steal calls made by each thief, and items stolen
+uint32_m steal_calls[THIEF_COUNT];
+uint32_m stolen[THIEF_COUNT];
+
+double now_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+void take(void* item) {
+	(*(volatile uint32_m*)item)++;
+}
+
+// Pushes items in bursts, popping about half of each burst back itself
+void owner(void* args) {
+	size_m next = 0;
+	while (next < ITEM_COUNT) {
+		for (size_m i = 0; i < BURST && next < ITEM_COUNT; i++) {
+			mu_ws_deque_push(deque, (void*)&taken[next++]);
+		}
+		for (size_m i = 0; i < BURST / 2; i++) {
+			void* item = mu_ws_deque_pop(deque);
+			if (item) {
+				take(item);
+			}
+		}
+	}
+
+	// Help finish whatever's left
+	void* item;
+	while ((item = mu_ws_deque_pop(deque)) != 0) {
+		take(item);
+	}
+	done = 1;
+	return; if (args) {}
+}
+
+void thief(void* args) {
+	void* items[STEAL_BATCH];
+	uint32_m calls = 0, count = 0;
+
+	while (!done || mu_ws_deque_size(deque) != 0) {
+		size_m got;
+		if (steal_half) {
+			got = mu_ws_deque_steal_half(deque, items, STEAL_BATCH);
+		} else {
+			items[0] = mu_ws_deque_steal(deque);
+			got = items[0] ? 1 : 0;
+		}
+		if (got == 0) {
+			mu_thread_sleep(0);
+			continue;
+		}
+
+		calls++;
+		count += (uint32_m)got;
+		for (size_m i = 0; i < got; i++) {
+			take(items[i]);
+		}
+	}
+
+	size_m index = (size_m)args;
+	steal_calls[index] = calls;
+	stolen[index] = count;
+}
+
+void run(muBool half) {
+	steal_half = half;
+	done = 0;
+	for (size_m i = 0; i < ITEM_COUNT; i++) {
+		taken[i] = 0;
+	}
+
+	// Start small so that the deque has to grow
+	deque = mu_ws_deque_create(16);
+	scall(mu_ws_deque_create)
+
+	double start = now_seconds();
+	muThread threads[THIEF_COUNT + 1];
+	threads[0] = mu_thread_create(owner, 0);
+	scall(mu_thread_create)
+	for (size_m i = 1; i <= THIEF_COUNT; i++) {
+		threads[i] = mu_thread_create(thief, (void*)(i - 1));
+		scall(mu_thread_create)
+	}
+	for (size_m i = 0; i <= THIEF_COUNT; i++) {
+		mu_thread_wait(threads[i]);
+		scall(mu_thread_wait)
+		mu_thread_destroy(threads[i]);
+		scall(mu_thread_destroy)
+	}
+	double elapsed = now_seconds() - start;
+
+	mu_ws_deque_destroy(deque);
+	scall(mu_ws_deque_destroy)
+
+	uint32_m calls = 0, count = 0;
+	for (size_m i = 0; i < THIEF_COUNT; i++) {
+		calls += steal_calls[i];
+		count += stolen[i];
+	}
+
+	// Every item should have been taken exactly once
+	size_m wrong = 0;
+	for (size_m i = 0; i < ITEM_COUNT; i++) {
+		if (taken[i] != 1) {
+			wrong++;
+		}
+	}
+	printf("%-16s %7u items stolen in %7u steals (%.1f per steal), %.3f s, %llu items taken the wrong number of times\n",
+		half ? "Stealing half:" : "Stealing one:", (unsigned)count, (unsigned)calls,
+		calls ? (double)count / (double)calls : 0.0, elapsed, (unsigned long long)wrong
+	);
+}
+
+int main(void) {
+	// Set global result
+	mum_global_result(&result);
+
+	run(MU_FALSE);
+	run(MU_TRUE);
+
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2024 Hum
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
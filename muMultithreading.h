@@ -41,12 +41,26 @@ Note that the libraries listed may also have other dependencies that they also i
 
 muMultithreading is built for POSIX and Win32.
 
-For POSIX, in particular, pthreads is needed. This means that pthread needs to be linked to, usually with `-pthread`.
+For POSIX, in particular, pthreads is needed. This means that pthread needs to be linked to, usually with `-pthread`. On Linux, mum also uses the `futex` system call through `syscall`, along with `clock_gettime` and anonymous memory mappings, which the C library hides when compiling with a strict standard such as `-std=c11`; so that the implementation still compiles then, mum defines `_DEFAULT_SOURCE` and `_POSIX_C_SOURCE` (unless they're already defined) when `MUM_IMPLEMENTATION` is defined, which only works if `muMultithreading.h` is included before any system header in that file.
+
+For Win32, mum parks waiting threads with `WaitOnAddress`, which requires Windows 8 or later and linking to `Synchronization.lib`.
 
 @DOCEND */
 
 #ifndef MUM_H
 	#define MUM_H
+
+	// The implementation uses POSIX and Linux interfaces (clock_gettime, syscall) that glibc
+	// hides under strict standards; feature macros only count if they're defined before the
+	// first system header is included, which is the muUtility header below
+	#if defined(MUM_IMPLEMENTATION) && defined(__linux__)
+		#ifndef _DEFAULT_SOURCE
+			#define _DEFAULT_SOURCE
+		#endif
+		#ifndef _POSIX_C_SOURCE
+			#define _POSIX_C_SOURCE 200809L
+		#endif
+	#endif
 	
 	// @IGNORE
 	/* muUtility v1.1.0 header */
@@ -416,6 +430,16 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 
 		// @DOCLINE mum has several C standard library dependencies not provided by its other library dependencies, all of which are overridable by defining them before MUM_H is defined. The following is a list of those dependencies. Note that defining all of the dependencies of a C standard library file prevents it from being included.
 
+		// @DOCLINE If `MUM_SLAB_MALLOC` is defined before mum is included, `mu_malloc` and `mu_free` are defined as `mu_slab_alloc` and `mu_slab_free` (unless they've already been defined), so that every object allocated by mum goes through mum's slab allocator; see the slab allocator functions.
+		#ifdef MUM_SLAB_MALLOC
+			#ifndef mu_malloc
+				#define mu_malloc mu_slab_alloc
+			#endif
+			#ifndef mu_free
+				#define mu_free mu_slab_free
+			#endif
+		#endif
+
 		#if !defined(mu_malloc) || \
 			!defined(mu_free)
 
@@ -434,7 +458,8 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 
 		#endif
 
-		#if !defined(mu_memcpy)
+		#if !defined(mu_memcpy) || \
+			!defined(mu_memmove)
 
 			// @DOCLINE ## `string.h` dependencies
 			#include <string.h>
@@ -444,6 +469,11 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 				#define mu_memcpy memcpy
 			#endif
 
+			// @DOCLINE `mu_memmove`: equivalent to memmove.
+			#ifndef mu_memmove
+				#define mu_memmove memmove
+			#endif
+
 		#endif
 
 	// @DOCLINE # Enumerators
@@ -501,6 +531,117 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 			MUM_FAILED_PTHREAD_MUTEX_LOCK,
 			// @DOCLINE `@NLFT`: a call to `pthread_mutex_unlock` failed, and the mutex has not been unlocked.
 			MUM_FAILED_PTHREAD_MUTEX_UNLOCK,
+			// @DOCLINE `@NLFT`: a call to `pthread_detach` failed after the thread was cancelled; the thread has been cancelled, but its resources may not be reclaimed.
+			MUM_FAILED_PTHREAD_DETACH,
+			// @DOCLINE `@NLFT`: binding a thread to its CPUs with the `sched_setaffinity` system call failed, or isn't available on this system, and the thread has not been created.
+			MUM_FAILED_PTHREAD_SETAFFINITY,
+			// @DOCLINE `@NLFT`: a call to `epoll_create1` failed, and the event loop has not been created.
+			MUM_FAILED_EPOLL_CREATE,
+			// @DOCLINE `@NLFT`: a call to `eventfd` failed, and the event loop has not been created.
+			MUM_FAILED_EVENTFD,
+			// @DOCLINE `@NLFT`: a call to `epoll_ctl` failed, and the file descriptor has not been added to the event loop.
+			MUM_FAILED_EPOLL_CTL,
+
+			// @DOCLINE ### Tracing result enumerators
+
+			// @DOCLINE `@NLFT`: a file could not be opened for writing.
+			MUM_FAILED_OPEN_FILE,
+			// @DOCLINE `@NLFT`: tracing was requested, but mum was compiled without `MUM_TRACE` defined.
+			MUM_TRACE_DISABLED,
+
+			// @DOCLINE ### Topology result enumerators
+
+			// @DOCLINE `@NLFT`: a CPU, NUMA node, or shard index was out of range.
+			MUM_INVALID_INDEX,
+			// @DOCLINE `@NLFT`: a call to `SetThreadGroupAffinity` failed on Win32, and the thread has not been created.
+			MUM_FAILED_SET_THREAD_GROUP_AFFINITY,
+
+			// @DOCLINE ### Event loop result enumerators
+
+			// @DOCLINE `@NLFT`: event loops aren't available on this system, as they currently require Linux's `epoll`.
+			MUM_EVENT_LOOP_UNSUPPORTED,
+
+			// @DOCLINE ### Task graph result enumerators
+
+			// @DOCLINE `@NLFT`: a task graph's edges form a cycle, and the graph has not been run.
+			MUM_TASK_GRAPH_CYCLE,
+			// @DOCLINE `@NLFT`: a task graph node index was out of range.
+			MUM_TASK_GRAPH_INVALID_NODE,
+
+			// @DOCLINE ### Stop result enumerators
+
+			// @DOCLINE `@NLFT`: a stop was requested for the calling thread whilst it waited (see `mu_thread_request_stop`), and it stopped waiting before what it waited for happened.
+			MUM_STOP_REQUESTED,
+		)
+
+		MU_ENUM(mumThreadDestroyMode,
+			/* @DOCBEGIN
+			## Thread destroy mode enumerator
+
+			mum uses the `mumThreadDestroyMode` enumerator to represent how a thread is destroyed. It has the following possible values.
+
+			@DOCEND */
+
+			// @DOCLINE `@NLFT`: the thread is cancelled if it has not been waited on, and its handle is freed. This is what `mu_thread_destroy` does. On Unix, this calls `pthread_cancel`, which is unsafe if the thread holds a lock at the time. On Win32, the thread is not terminated and keeps running detached.
+			MUM_THREAD_DESTROY_CANCEL,
+			// @DOCLINE `@NLFT`: a stop is requested for the thread (see `mu_thread_request_stop`), the thread is waited on if it has not been already, and its handle is freed. The thread is never forcibly cancelled, so it must poll its stop token or exit on its own.
+			MUM_THREAD_DESTROY_JOIN,
+		)
+
+		MU_ENUM(mumTaskPriority,
+			/* @DOCBEGIN
+			## Task priority enumerator
+
+			mum uses the `mumTaskPriority` enumerator to represent the priority of a task given to a scheduler; see the scheduler functions. It has the following possible values, from most to least urgent.
+
+			@DOCEND */
+
+			// @DOCLINE `@NLFT`: the task runs before anything else, such as work that something is blocked on.
+			MUM_TASK_PRIORITY_CRITICAL,
+			// @DOCLINE `@NLFT`: the task is interactive, and should overtake normal and background work.
+			MUM_TASK_PRIORITY_HIGH,
+			// @DOCLINE `@NLFT`: the task is ordinary work.
+			MUM_TASK_PRIORITY_NORMAL,
+			// @DOCLINE `@NLFT`: the task is background or batch work, run when nothing more urgent is waiting.
+			MUM_TASK_PRIORITY_LOW,
+		)
+
+		MU_ENUM(mumChanStatus,
+			/* @DOCBEGIN
+			## Channel status enumerator
+
+			mum uses the `mumChanStatus` enumerator to represent how an operation on a channel went; see the channel functions. It has the following possible values.
+
+			@DOCEND */
+
+			// @DOCLINE `@NLFT`: the value was sent or received.
+			MUM_CHAN_OK,
+			// @DOCLINE `@NLFT`: the operation couldn't be done without blocking, and nothing was sent or received.
+			MUM_CHAN_WOULD_BLOCK,
+			// @DOCLINE `@NLFT`: the operation couldn't be done in time, and nothing was sent or received.
+			MUM_CHAN_TIMEOUT,
+			// @DOCLINE `@NLFT`: the channel was closed; nothing can be sent on it, or there was nothing left to receive from it.
+			MUM_CHAN_CLOSED,
+			// @DOCLINE `@NLFT`: a stop was requested for the calling thread whilst it waited (see `mu_thread_request_stop`), and nothing was sent or received.
+			MUM_CHAN_STOPPED,
+		)
+
+		MU_ENUM(mumIdleKind,
+			/* @DOCBEGIN
+			## Idle kind enumerator
+
+			mum uses the `mumIdleKind` enumerator to represent how an idle strategy waits; see the idle strategy functions. It has the following possible values, from quickest to wake up to cheapest to wait with.
+
+			@DOCEND */
+
+			// @DOCLINE `@NLFT`: the thread spins, with a pause instruction between checks, for as long as it waits. It never gives up its CPU.
+			MUM_IDLE_SPIN,
+			// @DOCLINE `@NLFT`: the thread spins for a while, and then yields its CPU to other threads between checks for as long as it waits.
+			MUM_IDLE_SPIN_YIELD,
+			// @DOCLINE `@NLFT`: the thread spins for a while, and then sleeps until it's woken up, or until the strategy's park timeout passes, whichever is first.
+			MUM_IDLE_SPIN_PARK,
+			// @DOCLINE `@NLFT`: the thread sleeps straight away, until it's woken up or the park timeout passes.
+			MUM_IDLE_PARK,
 		)
 
 	// @DOCLINE # Macros
@@ -511,10 +652,86 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 
 			// @DOCLINE `muThread`: a [thread](https://en.wikipedia.org/wiki/Thread_(computing)).
 			#define muThread void*
+			// @DOCLINE `muThreadGroup`: a group of threads created together; see `mu_thread_create_many`.
+			#define muThreadGroup void*
 			// @DOCLINE `muMutex`: a [mutex](https://en.wikipedia.org/wiki/Lock_(computer_science)).
 			#define muMutex void*
 			// @DOCLINE `muSpinlock`: a [spinlock](https://en.wikipedia.org/wiki/Spinlock).
 			#define muSpinlock void*
+			// @DOCLINE `muStopToken`: a token that a thread polls to check whether it has been requested to stop; see `mu_stop_requested`.
+			#define muStopToken void*
+			// @DOCLINE `muHashMap`: a concurrent [hash map](https://en.wikipedia.org/wiki/Hash_table).
+			#define muHashMap void*
+			// @DOCLINE `muCohortLock`: a NUMA-aware [cohort lock](https://dl.acm.org/doi/10.1145/2686884).
+			#define muCohortLock void*
+			// @DOCLINE `muAdaptiveLock`: a lock that learns whether to spin or sleep while waiting.
+			#define muAdaptiveLock void*
+			// @DOCLINE `muCombiner`: a [flat-combining](https://doi.org/10.1145/1810479.1810540) lock that runs the operations of waiting threads in batches.
+			#define muCombiner void*
+			// @DOCLINE `muCounter`: a counter split into per-CPU shards.
+			#define muCounter void*
+			// @DOCLINE `muAccumulator`: a count, sum, minimum and maximum of recorded values, split into per-CPU shards.
+			#define muAccumulator void*
+			// @DOCLINE `muPool`: a lock-free pool of fixed-size objects, with per-thread magazines.
+			#define muPool void*
+			// @DOCLINE `muScheduler`: a pool of worker threads running prioritized tasks.
+			#define muScheduler void*
+			// @DOCLINE `muTimerWheel`: a [timer wheel](https://doi.org/10.1109/90.650142) running delayed and periodic tasks on a scheduler.
+			#define muTimerWheel void*
+			// @DOCLINE `muEventLoop`: an [event loop](https://en.wikipedia.org/wiki/Event_loop) dispatching file descriptor readiness onto a scheduler.
+			#define muEventLoop void*
+			// @DOCLINE `muTaskGraph`: a [directed acyclic graph](https://en.wikipedia.org/wiki/Directed_acyclic_graph) of tasks run on a scheduler.
+			#define muTaskGraph void*
+			// @DOCLINE `muWSDeque`: a [Chase-Lev](https://doi.org/10.1145/1073970.1073974) work-stealing deque.
+			#define muWSDeque void*
+			// @DOCLINE `muShardExecutor`: a set of threads bound one per CPU, sending each other tasks over rings.
+			#define muShardExecutor void*
+			// @DOCLINE `muChan`: a [channel](https://go.dev/ref/spec#Channel_types) passing values between threads.
+			#define muChan void*
+			// @DOCLINE `muIdleStrategy`: a way of waiting, spinning, yielding and/or parking, that can be attached to things threads wait on.
+			#define muIdleStrategy void*
+
+		// @DOCLINE ## Event flags
+
+			// @DOCLINE The readiness of a file descriptor added to an event loop is described by a combination of the following flags:
+
+			// @DOCLINE `MUM_EVENT_READ`: the file descriptor can be read from without blocking.
+			#define MUM_EVENT_READ 0x1
+			// @DOCLINE `MUM_EVENT_WRITE`: the file descriptor can be written to without blocking.
+			#define MUM_EVENT_WRITE 0x2
+			// @DOCLINE `MUM_EVENT_HANGUP`: the other end of the file descriptor was closed, or an error occurred on it. This is always reported, whether it was asked for or not.
+			#define MUM_EVENT_HANGUP 0x4
+
+		// @DOCLINE ## Stop token polling
+
+			// @DOCLINE The macro function `mu_stop_requested(token)` evaluates to `MU_TRUE` if a stop has been requested for the thread owning the given `muStopToken`, and `MU_FALSE` if otherwise. It is a single relaxed atomic load with no function call, and is meant to be polled frequently within a thread's loop.
+			#ifndef mu_stop_requested
+				#if defined(__GNUC__) || defined(__clang__)
+					#define mu_stop_requested(token) (__atomic_load_n((const uint32_m*)(token), __ATOMIC_RELAXED) != 0)
+				#else
+					#define mu_stop_requested(token) (*(const volatile uint32_m*)(token) != 0)
+				#endif
+			#endif
+
+		// @DOCLINE ## RCU pointers
+
+			// @DOCLINE The macro function `mu_rcu_assign_pointer(p, v)` publishes the pointer `v` by storing it into the pointer variable `p`, making sure that anything written to what `v` points to beforehand is seen by any reader that loads `v` from `p`. The macro function `mu_rcu_dereference(p)` loads a pointer published this way, to be used within an RCU read section; see the RCU functions. Neither involves a function call with GCC or Clang; with other compilers, `p` should be declared `volatile`.
+			#ifndef mu_rcu_assign_pointer
+				#if defined(__GNUC__) || defined(__clang__)
+					#define mu_rcu_assign_pointer(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+				#else
+					// Stores with a release fence before
+					MUDEF void mum_rcu_assign(void* volatile* p, void* v);
+					#define mu_rcu_assign_pointer(p, v) mum_rcu_assign((void* volatile*)&(p), (void*)(v))
+				#endif
+			#endif
+			#ifndef mu_rcu_dereference
+				#if defined(__GNUC__) || defined(__clang__)
+					#define mu_rcu_dereference(p) __atomic_load_n(&(p), __ATOMIC_CONSUME)
+				#else
+					#define mu_rcu_dereference(p) (p)
+				#endif
+			#endif
 
 		// @DOCLINE ## Version macros
 
@@ -558,11 +775,41 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
 				MUDEF muThread mu_thread_destroy_(mumResult* result, muThread thread);
 
+				// @DOCLINE The function `mu_thread_destroy_mode` destroys a thread using the given destroy mode, defined below: @NLNT
+				MUDEF muThread mu_thread_destroy_mode(muThread thread, mumThreadDestroyMode mode);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muThread mu_thread_destroy_mode_(mumResult* result, muThread thread, mumThreadDestroyMode mode);
+				// @DOCLINE `mu_thread_destroy` is equivalent to calling this function with `MUM_THREAD_DESTROY_CANCEL`. With `MUM_THREAD_DESTROY_JOIN`, this function blocks until the thread has exited.
+
+			// @DOCLINE ### Thread stopping
+
+				// @DOCLINE Threads can be stopped cooperatively instead of being cancelled. Every thread created by mum owns a stop flag, which is set by requesting a stop and read by polling a stop token with `mu_stop_requested`.
+
+				// @DOCLINE The function `mu_thread_request_stop` requests a thread to stop, defined below: @NLNT
+				MUDEF void mu_thread_request_stop(muThread thread);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_thread_request_stop_(mumResult* result, muThread thread);
+				// @DOCLINE If the thread is blocked within a mum blocking primitive, it is woken up, and the primitive gives up and reports the stop to it: the channel functions return `MUM_CHAN_STOPPED`; `mu_thread_sleep`, `mu_idle_wait`, `mu_park`, the byte mutex and inline mutex lock functions, and `mu_call_once` return `MU_FALSE`; and `mu_thread_wait_all`, `mu_thread_wait_any` and `mu_scheduler_wait` set `MUM_STOP_REQUESTED`. From then on, these primitives give up straight away whenever they would block. Requesting a stop does nothing else; the thread decides when and how to exit.
+
+				// @DOCLINE The function `mu_thread_get_stop_token` returns the stop token of a thread, defined below: @NLNT
+				MUDEF muStopToken mu_thread_get_stop_token(muThread thread);
+				// @DOCLINE The token is valid until the thread is destroyed.
+
+				// @DOCLINE The function `mu_thread_current_stop_token` returns the stop token of the calling thread, defined below: @NLNT
+				MUDEF muStopToken mu_thread_current_stop_token(void);
+				// @DOCLINE If the calling thread was not created by mum, a token that never has a stop requested is returned.
+
+			// @DOCLINE ### Thread sleeping
+
+				// @DOCLINE The function `mu_thread_sleep` sleeps the calling thread for the given amount of milliseconds, defined below: @NLNT
+				MUDEF muBool mu_thread_sleep(uint32_m milliseconds);
+				// @DOCLINE The sleep ends early if a stop is requested for the calling thread, in which case `MU_FALSE` is returned; otherwise, `MU_TRUE` is returned.
+
 			// @DOCLINE ### Thread exiting
 
 				// @DOCLINE The function `mu_thread_exit` exits from the current thread with a return value, defined below: @NLNT
 				MUDEF void mu_thread_exit(void* ret);
-				// @DOCLINE This function is meant to be called from within a thread, and is expected to be called at *some* point during the thread's lifetime; if this function is not called during a created thread's lifetime, resulting behaviour is undefined.
+				// @DOCLINE This function is meant to be called from within a thread. Returning from a thread's start function is equivalent to calling this function with a return value of 0.
 
 			// @DOCLINE ### Thread waiting
 
@@ -579,6 +826,39 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 				MUDEF void* mu_thread_get_return_value_(mumResult* result, muThread thread);
 				// @DOCLINE This function may not perform correctly unless `mu_thread_wait` has been called for the given thread beforehand, even if it can be guaranteed that the thread will have already been finished by now.
 
+			// @DOCLINE ### Thread groups
+
+				// @DOCLINE A thread group is several threads created and destroyed together, with one allocation for the whole group no matter how many threads it has. Each thread of a group counts itself as finished as it exits, so that the group can be waited on as a whole, or thread by thread in the order the threads finish.
+
+				// @DOCLINE The function `mu_thread_create_many` creates a group of threads, defined below: @NLNT
+				MUDEF muThreadGroup mu_thread_create_many(size_m count, void (*start)(void* args), void* const* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muThreadGroup mu_thread_create_many_(mumResult* result, size_m count, void (*start)(void* args), void* const* args);
+				// @DOCLINE Thread `i` is passed `args[i]`, or 0 if `args` is 0. No thread starts running `start` until every thread of the group has been created; if creating any of them fails, none of them run it, and the group isn't created.
+
+				// @DOCLINE The function `mu_thread_destroy_many` destroys a group of threads using the given destroy mode, defined below: @NLNT
+				MUDEF muThreadGroup mu_thread_destroy_many(muThreadGroup group, mumThreadDestroyMode mode);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muThreadGroup mu_thread_destroy_many_(mumResult* result, muThreadGroup group, mumThreadDestroyMode mode);
+				// @DOCLINE Each thread of the group is destroyed the same way that `mu_thread_destroy_mode` would.
+
+				// @DOCLINE The function `mu_thread_wait_all` waits on every thread of a group to finish executing, defined below: @NLNT
+				MUDEF void mu_thread_wait_all(muThreadGroup group);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_thread_wait_all_(mumResult* result, muThreadGroup group);
+
+				// @DOCLINE The function `mu_thread_wait_any` waits on any thread of a group to finish executing, and returns its index in the group, defined below: @NLNT
+				MUDEF size_m mu_thread_wait_any(muThreadGroup group);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF size_m mu_thread_wait_any_(mumResult* result, muThreadGroup group);
+				// @DOCLINE Each call returns a different thread, in the order that the threads finished; once every thread of the group has been returned, the amount of threads in the group is returned. Neither this function nor `mu_thread_wait_all` should be called on the same group by several threads at once.
+
+				// @DOCLINE If a stop is requested for the calling thread before the threads it waits on have finished, both functions stop waiting and set `MUM_STOP_REQUESTED`, and `mu_thread_wait_any` returns the amount of threads in the group. The threads can be waited on again later.
+
+				// @DOCLINE The function `mu_thread_group_get` returns a thread of a group, defined below: @NLNT
+				MUDEF muThread mu_thread_group_get(muThreadGroup group, size_m index);
+				// @DOCLINE The thread can be used with any thread function except for the destroy functions, and is valid until the group is destroyed. `index` must be less than the amount of threads in the group.
+
 		// @DOCLINE ## Mutex functions
 
 			// @DOCLINE ### Mutex creation and destruction
@@ -605,6 +885,42 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
 				MUDEF void mu_mutex_unlock_(mumResult* result, muMutex mutex);
 
+		// @DOCLINE ## Idle strategy functions
+
+			// @DOCLINE An idle strategy decides how a thread waits once it has nothing to do, trading CPU time for how quickly it notices that it can go on. Waiting goes through up to three phases: spinning, where the thread checks again and again with a pause instruction in between; yielding, where it lets other threads have its CPU between checks; and parking, where it sleeps in the kernel until another thread wakes it up. The kind of strategy (see `mumIdleKind`) says which phases are used.
+
+			// @DOCLINE A strategy can be attached to spinlocks (`mu_spinlock_set_idle`), channels (`mu_chan_set_idle`), scheduler workers (`mu_scheduler_set_idle`) and shards (`mu_shard_executor_set_idle`), replacing how they'd wait otherwise, and can be shared between any of them. It keeps track of how long the threads using it spent in each phase.
+
+			// @DOCLINE ### Idle strategy creation and destruction
+
+				// @DOCLINE The function `mu_idle_strategy_create` creates an idle strategy, defined below: @NLNT
+				MUDEF muIdleStrategy mu_idle_strategy_create(mumIdleKind kind, uint64_m spin_ns, uint64_m park_ns);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muIdleStrategy mu_idle_strategy_create_(mumResult* result, mumIdleKind kind, uint64_m spin_ns, uint64_m park_ns);
+				// @DOCLINE `spin_ns` is how many nanoseconds to spin for before yielding or parking; if it's 0, a default of 20 microseconds is used. `park_ns` is the longest a thread sleeps for at once before checking again, whether it's been woken up or not; if it's 0, it sleeps until woken up.
+
+				// @DOCLINE The function `mu_idle_strategy_destroy` destroys an idle strategy, defined below: @NLNT
+				MUDEF muIdleStrategy mu_idle_strategy_destroy(muIdleStrategy strategy);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muIdleStrategy mu_idle_strategy_destroy_(mumResult* result, muIdleStrategy strategy);
+				// @DOCLINE It must not be attached to anything still in use.
+
+			// @DOCLINE ### Waiting with an idle strategy
+
+				// @DOCLINE The function `mu_idle_wait` waits until a 32-bit value changes, defined below: @NLNT
+				MUDEF muBool mu_idle_wait(muIdleStrategy strategy, uint32_m* address, uint32_m value, int32_m timeout_ms);
+				// @DOCLINE The thread waits for as long as the value at `address` equals `value`, in the way `strategy` says; if `strategy` is 0, it parks straight away. `MU_TRUE` is returned once the value has changed, and `MU_FALSE` if `timeout_ms` milliseconds passed first, or if a stop was requested for the calling thread (see `mu_thread_request_stop`); -1 waits forever. A thread that changes the value should call `mu_idle_wake` afterwards, as a parked thread otherwise won't notice until its park timeout passes.
+
+				// @DOCLINE The function `mu_idle_wake` wakes threads parked on a 32-bit value within `mu_idle_wait`, defined below: @NLNT
+				MUDEF void mu_idle_wake(uint32_m* address, muBool all);
+				// @DOCLINE One thread is woken up, or every thread if `all` is true. Threads that are spinning or yielding notice the change on their own.
+
+			// @DOCLINE ### Idle strategy statistics
+
+				// @DOCLINE The function `mu_idle_strategy_stats` retrieves how the threads using an idle strategy have waited so far, defined below: @NLNT
+				MUDEF void mu_idle_strategy_stats(muIdleStrategy strategy, uint64_m* waits, uint64_m* spin_ns, uint64_m* yield_ns, uint64_m* park_ns, uint64_m* parks);
+				// @DOCLINE `waits` is how many times a thread had to wait; `spin_ns`, `yield_ns` and `park_ns` are the total nanoseconds spent spinning, yielding and parked (including checking again in between times parked); `parks` is how many times a thread went to sleep. Any of them can be 0 to skip it. The time of a wait is only added once it has finished.
+
 		// @DOCLINE ## Spinlock functions
 
 			// @DOCLINE ### Spinlock creation and destruction
@@ -631,451 +947,10970 @@ For POSIX, in particular, pthreads is needed. This means that pthread needs to b
 				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
 				MUDEF void mu_spinlock_unlock_(mumResult* result, muSpinlock spinlock);
 
-	#ifdef __cplusplus
-	}
-	#endif
+			// @DOCLINE ### Spinlock idle strategy
 
-#endif /* MUM_H */
+				// @DOCLINE The function `mu_spinlock_set_idle` attaches an idle strategy to a spinlock, defined below: @NLNT
+				MUDEF void mu_spinlock_set_idle(muSpinlock spinlock, muIdleStrategy strategy);
+				// @DOCLINE A spinlock spins without ever giving up its CPU by default; with a strategy attached, threads waiting to lock it wait in the way the strategy says instead, and unlocking it wakes one up if any are parked. It can only be set while the spinlock is unlocked and no thread is using it, and 0 goes back to the default.
 
-#ifdef MUM_IMPLEMENTATION
+		// @DOCLINE ## Inline lock functions
 
-	#ifdef __cplusplus
-	extern "C" { // }
-	#endif
+			// @DOCLINE Inline locks are a spinlock and a mutex that are plain structs rather than handles, so that they can be embedded into other structs or declared statically, and that don't need to be created or destroyed; a zeroed lock is unlocked, which the macro `MU_INLINE_LOCK_INIT` can be used to initialize one to. The mutex is not made with the operating system's mutex, but a futex, which waiters spin on for a short while before sleeping.
 
-	/* Global functions */
+			// @DOCLINE The inline lock functions are always functions of mum. If `MUM_INLINE` is defined before the header is included, the uncontended paths of locking, unlocking, and trying to lock either lock are also `static inline` functions defined within the header, which macros of the same names as the inline lock functions call instead, so that a function of mum is only called if the lock is contended (with GCC, Clang, or MSVC; other compilers always call one). Inline locks don't have explicit result checking equivalents, as they can't fail, and aren't traced.
 
-		mumResult* mum_global_res = 0;
-		MUDEF void mum_global_result(mumResult* result) {
-			mum_global_res = result;
-		}
+			// @DOCLINE The struct `muInlineSpinlock` is an inline spinlock, and the struct `muInlineMutex` is an inline mutex; their members shouldn't be accessed directly.
+			typedef struct muInlineSpinlock {
+				uint32_m locked;
+			} muInlineSpinlock;
+			typedef struct muInlineMutex {
+				// 0 if unlocked, 1 if locked, and 2 if locked and threads may be asleep waiting for it
+				uint32_m state;
+			} muInlineMutex;
 
-		/* Names */
+			#define MU_INLINE_LOCK_INIT { 0 }
 
-			#ifdef MUM_NAMES
-				MUDEF const char* mum_result_get_name(mumResult result) {
-					switch (result) {
-						default: return "MUM_UNKNOWN"; break;
-						case MUM_SUCCESS: return "MUM_SUCCESS"; break;
-						case MUM_FAILED_ALLOCATE: return "MUM_FAILED_ALLOCATE"; break;
-						case MUM_FAILED_CREATE_THREAD: return "MUM_FAILED_CREATE_THREAD"; break;
-						case MUM_FAILED_CLOSE_HANDLE: return "MUM_FAILED_CLOSE_HANDLE"; break;
-						case MUM_FAILED_GET_EXIT_CODE_THREAD: return "MUM_FAILED_GET_EXIT_CODE_THREAD"; break;
-						case MUM_THREAD_WAIT_TIMEOUT: return "MUM_THREAD_WAIT_TIMEOUT"; break;
-						case MUM_THREAD_WAIT_FAILED: return "MUM_THREAD_WAIT_FAILED"; break;
-						case MUM_FAILED_CREATE_MUTEX: return "MUM_FAILED_CREATE_MUTEX"; break;
-						case MUM_MUTEX_WAIT_FAILED: return "MUM_MUTEX_WAIT_FAILED"; break;
-						case MUM_MUTEX_WAIT_ABANDONED: return "MUM_MUTEX_WAIT_ABANDONED"; break;
-						case MUM_FAILED_RELEASE_MUTEX: return "MUM_FAILED_RELEASE_MUTEX"; break;
-						case MUM_FAILED_PTHREAD_CREATE: return "MUM_FAILED_PTHREAD_CREATE"; break;
-						case MUM_FAILED_PTHREAD_CANCEL: return "MUM_FAILED_PTHREAD_CANCEL"; break;
-						case MUM_FAILED_PTHREAD_JOIN: return "MUM_FAILED_PTHREAD_JOIN"; break;
-						case MUM_FAILED_PTHREAD_MUTEX_INIT: return "MUM_FAILED_PTHREAD_MUTEX_INIT"; break;
-						case MUM_FAILED_PTHREAD_MUTEX_DESTROY: return "MUM_FAILED_PTHREAD_MUTEX_DESTROY"; break;
-						case MUM_FAILED_PTHREAD_MUTEX_LOCK: return "MUM_FAILED_PTHREAD_MUTEX_LOCK"; break;
-						case MUM_FAILED_PTHREAD_MUTEX_UNLOCK: return "MUM_FAILED_PTHREAD_MUTEX_UNLOCK"; break;
-					}
-				}
-			#endif
+			// @DOCLINE ### Inline spinlock locking and unlocking
 
-		/* Repetitious functions */
+				// @DOCLINE The function `mu_inline_spinlock_lock` locks an inline spinlock, defined below: @NLNT
+				MUDEF void mu_inline_spinlock_lock(muInlineSpinlock* spinlock);
 
-			MUDEF muThread mu_thread_create(void (*start)(void* args), void* args) {
-				return mu_thread_create_(mum_global_res, start, args);
-			}
-			MUDEF muThread mu_thread_destroy(muThread thread) {
-				return mu_thread_destroy_(mum_global_res, thread);
-			}
-			MUDEF void mu_thread_wait(muThread thread) {
-				mu_thread_wait_(mum_global_res, thread);
-			}
-			MUDEF void* mu_thread_get_return_value(muThread thread) {
-				return mu_thread_get_return_value_(mum_global_res, thread);
-			}
-			MUDEF muMutex mu_mutex_create(void) {
-				return mu_mutex_create_(mum_global_res);
-			}
-			MUDEF muMutex mu_mutex_destroy(muMutex mutex) {
-				return mu_mutex_destroy_(mum_global_res, mutex);
-			}
-			MUDEF void mu_mutex_lock(muMutex mutex) {
-				mu_mutex_lock_(mum_global_res, mutex);
-			}
-			MUDEF void mu_mutex_unlock(muMutex mutex) {
-				mu_mutex_unlock_(mum_global_res, mutex);
-			}
-			MUDEF muSpinlock mu_spinlock_create(void) {
-				return mu_spinlock_create_(mum_global_res);
-			}
-			MUDEF muSpinlock mu_spinlock_destroy(muSpinlock spinlock) {
-				return mu_spinlock_destroy_(mum_global_res, spinlock);
-			}
-			MUDEF void mu_spinlock_lock(muSpinlock spinlock) {
-				mu_spinlock_lock_(mum_global_res, spinlock);
-			}
-			MUDEF void mu_spinlock_unlock(muSpinlock spinlock) {
-				mu_spinlock_unlock_(mum_global_res, spinlock);
-			}
+				// @DOCLINE The function `mu_inline_spinlock_try_lock` locks an inline spinlock if it's unlocked, returning whether it did, defined below: @NLNT
+				MUDEF muBool mu_inline_spinlock_try_lock(muInlineSpinlock* spinlock);
 
-	/* Win32 */
+				// @DOCLINE The function `mu_inline_spinlock_unlock` unlocks an inline spinlock, defined below: @NLNT
+				MUDEF void mu_inline_spinlock_unlock(muInlineSpinlock* spinlock);
 
-	#ifdef MU_WIN32
+			// @DOCLINE ### Inline mutex locking and unlocking
 
-		#include <windows.h>
+				// @DOCLINE The function `mu_inline_mutex_lock` locks an inline mutex, returning whether it did, defined below: @NLNT
+				MUDEF muBool mu_inline_mutex_lock(muInlineMutex* mutex);
+				// @DOCLINE It only returns `MU_FALSE` if it had to wait for the mutex asleep and a stop was requested for the calling thread meanwhile (see `mu_thread_request_stop`), in which case the mutex isn't locked.
 
-		/* Thread */
+				// @DOCLINE The function `mu_inline_mutex_try_lock` locks an inline mutex if it's unlocked, returning whether it did, defined below: @NLNT
+				MUDEF muBool mu_inline_mutex_try_lock(muInlineMutex* mutex);
 
-			struct mum_win32_thread {
-				HANDLE handle;
-			};
-			typedef struct mum_win32_thread mum_win32_thread;
+				// @DOCLINE The function `mu_inline_mutex_unlock` unlocks an inline mutex, defined below: @NLNT
+				MUDEF void mu_inline_mutex_unlock(muInlineMutex* mutex);
 
-			MUDEF muThread mu_thread_create_(mumResult* result, void (*start)(void* args), void* args) {
-				mum_win32_thread* p = (mum_win32_thread*)mu_malloc(sizeof(mum_win32_thread));
-				if (!p) {
-					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
-					return 0;
-				}
+			// Wakes a thread waiting on a mutex that was just unlocked from state 2
+			MUDEF void mum_inline_mutex_wake(muInlineMutex* mutex);
 
-				// Memcpy into valid pointer because compiler be dumb sometimes
-				LPTHREAD_START_ROUTINE lp_start;
-				mu_memcpy(&lp_start, &start, sizeof(void*));
+			#ifdef MUM_INLINE
 
-				DWORD id;
-				p->handle = CreateThread(0, 0, lp_start, args, 0, &id);
-				if (p->handle == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_CREATE_THREAD)
-					mu_free(p);
-					return 0;
-				}
+				#if defined(__GNUC__) || defined(__clang__)
 
-				return p;
-			}
+					static inline muBool mum_inline_cas(uint32_m* ptr, uint32_m desired) {
+						uint32_m expected = 0;
+						return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+					}
 
-			MUDEF muThread mu_thread_destroy_(mumResult* result, muThread thread) {
-				mum_win32_thread* p = (mum_win32_thread*)thread;
+					static inline void mum_inline_store(uint32_m* ptr) {
+						__atomic_store_n(ptr, 0, __ATOMIC_RELEASE);
+					}
 
-				if (CloseHandle(p->handle) == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_CLOSE_HANDLE)
-					return thread;
-				}
+					static inline uint32_m mum_inline_release(uint32_m* ptr) {
+						return __atomic_exchange_n(ptr, 0, __ATOMIC_RELEASE);
+					}
 
-				mu_free(thread);
-				return 0;
-			}
+					#define MUM_INLINE_ATOMICS
 
-			MUDEF void mu_thread_exit(void* ret) {
-				DWORD d;
-				mu_memcpy(&d, &ret, sizeof(DWORD));
-				ExitThread(d);
-			}
+				#elif defined(_MSC_VER)
 
-			MUDEF void mu_thread_wait_(mumResult* result, muThread thread) {
-				mum_win32_thread* p = (mum_win32_thread*)thread;
+					#include <intrin.h>
 
-				DWORD wait_result = WaitForSingleObject(p->handle, INFINITE);
+					static inline muBool mum_inline_cas(uint32_m* ptr, uint32_m desired) {
+						return _InterlockedCompareExchange((volatile long*)ptr, (long)desired, 0) == 0;
+					}
 
-				switch (wait_result) {
-					case WAIT_TIMEOUT: {
-						MU_SET_RESULT(result, MUM_THREAD_WAIT_TIMEOUT)
-					} break;
-					case WAIT_FAILED: {
-						MU_SET_RESULT(result, MUM_THREAD_WAIT_FAILED)
-					} break;
-				}
-			}
+					static inline void mum_inline_store(uint32_m* ptr) {
+						_InterlockedExchange((volatile long*)ptr, 0);
+					}
 
-			MUDEF void* mu_thread_get_return_value_(mumResult* result, muThread thread) {
-				mum_win32_thread* p = (mum_win32_thread*)thread;
+					static inline uint32_m mum_inline_release(uint32_m* ptr) {
+						return (uint32_m)_InterlockedExchange((volatile long*)ptr, 0);
+					}
 
-				DWORD exit_code = 0;
-				if (GetExitCodeThread(p->handle, &exit_code) == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_GET_EXIT_CODE_THREAD)
-					return 0;
-				}
+					#define MUM_INLINE_ATOMICS
 
-				void* tp;
-				mu_memcpy(&tp, &exit_code, sizeof(DWORD));
-				return tp;
-			}
+				#endif
 
-		/* Mutex */
+				// The fast paths; without atomics here, they're just the functions of mum. Those are
+				// named in parentheses, so that the macros below aren't expanded for them.
 
-			struct mum_win32_mutex {
-				HANDLE handle;
-			};
-			typedef struct mum_win32_mutex mum_win32_mutex;
+				static inline void mum_inline_spinlock_lock(muInlineSpinlock* spinlock) {
+					#ifdef MUM_INLINE_ATOMICS
+						if (mum_inline_cas(&spinlock->locked, 1)) {
+							return;
+						}
+					#endif
+					(mu_inline_spinlock_lock)(spinlock);
+				}
 
-			MUDEF muMutex mu_mutex_create_(mumResult* result) {
-				mum_win32_mutex* p = (mum_win32_mutex*)mu_malloc(sizeof(mum_win32_mutex));
-				if (!p) {
-					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
-					return 0;
+				static inline muBool mum_inline_spinlock_try_lock(muInlineSpinlock* spinlock) {
+					#ifdef MUM_INLINE_ATOMICS
+						return mum_inline_cas(&spinlock->locked, 1);
+					#else
+						return (mu_inline_spinlock_try_lock)(spinlock);
+					#endif
 				}
 
-				p->handle = CreateMutex(0, MU_FALSE, 0);
-				if (p->handle == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_CREATE_MUTEX)
-					mu_free(p);
-					return 0;
+				static inline void mum_inline_spinlock_unlock(muInlineSpinlock* spinlock) {
+					#ifdef MUM_INLINE_ATOMICS
+						mum_inline_store(&spinlock->locked);
+					#else
+						(mu_inline_spinlock_unlock)(spinlock);
+					#endif
 				}
 
-				return (muMutex)p;
-			}
+				static inline muBool mum_inline_mutex_lock(muInlineMutex* mutex) {
+					#ifdef MUM_INLINE_ATOMICS
+						if (mum_inline_cas(&mutex->state, 1)) {
+							return MU_TRUE;
+						}
+					#endif
+					return (mu_inline_mutex_lock)(mutex);
+				}
+
+				static inline muBool mum_inline_mutex_try_lock(muInlineMutex* mutex) {
+					#ifdef MUM_INLINE_ATOMICS
+						return mum_inline_cas(&mutex->state, 1);
+					#else
+						return (mu_inline_mutex_try_lock)(mutex);
+					#endif
+				}
+
+				static inline void mum_inline_mutex_unlock(muInlineMutex* mutex) {
+					#ifdef MUM_INLINE_ATOMICS
+						if (mum_inline_release(&mutex->state) == 2) {
+							mum_inline_mutex_wake(mutex);
+						}
+					#else
+						(mu_inline_mutex_unlock)(mutex);
+					#endif
+				}
+
+				#define mu_inline_spinlock_lock(spinlock) mum_inline_spinlock_lock(spinlock)
+				#define mu_inline_spinlock_try_lock(spinlock) mum_inline_spinlock_try_lock(spinlock)
+				#define mu_inline_spinlock_unlock(spinlock) mum_inline_spinlock_unlock(spinlock)
+				#define mu_inline_mutex_lock(mutex) mum_inline_mutex_lock(mutex)
+				#define mu_inline_mutex_try_lock(mutex) mum_inline_mutex_try_lock(mutex)
+				#define mu_inline_mutex_unlock(mutex) mum_inline_mutex_unlock(mutex)
+
+			#endif /* MUM_INLINE */
+
+		// @DOCLINE ## Once functions
+
+			// @DOCLINE A once flag calls a function once and only once, however many threads ask for it. Once the function has returned, checking the flag is a single load with acquire ordering and nothing else, so that it can guard something created lazily on a hot path without every caller contending on a lock or an atomic read-modify-write; threads that ask for it whilst the function is still being called sleep until it has returned, rather than spinning. Like inline locks, once flags are plain structs that don't need to be created or destroyed; a zeroed flag is unset, which the macro `MU_ONCE_INIT` can be used to initialize one to. Unlike the byte once flag of the parking lot, a once flag takes up 4 bytes, and threads sleep on it directly.
+
+			// @DOCLINE The struct `muOnce` is a once flag; its members shouldn't be accessed directly.
+			typedef struct muOnce {
+				// 0 if unset, or one of the states below
+				uint32_m state;
+			} muOnce;
+
+			#define MU_ONCE_INIT { 0 }
+
+			// Whilst the function is being called, whilst threads may also be asleep waiting for
+			// it, and once it has returned
+			#define MUM_ONCE_CALLING 1
+			#define MUM_ONCE_SLEEPING 2
+			#define MUM_ONCE_DONE 3
+
+			// Whether a once flag's function has returned, checked within the header where the
+			// compiler has atomics for it, and otherwise left to mu_call_once
+			#if defined(__GNUC__) || defined(__clang__)
+				#define MUM_ONCE_RETURNED(once) (__atomic_load_n(&(once)->state, __ATOMIC_ACQUIRE) == MUM_ONCE_DONE)
+			#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+				#include <intrin.h>
+
+				// Loads on x86 already have acquire ordering, so only the compiler has to be kept
+				// from moving the reads after it above it
+				static inline muBool mum_once_returned(muOnce* once) {
+					muBool returned = *(volatile uint32_m*)&once->state == MUM_ONCE_DONE;
+					_ReadWriteBarrier();
+					return returned;
+				}
+
+				#define MUM_ONCE_RETURNED(once) mum_once_returned(once)
+			#else
+				#define MUM_ONCE_RETURNED(once) 0
+			#endif
+
+			// @DOCLINE ### Calling once
+
+				// @DOCLINE The function `mu_call_once` calls a function with the given arguments if it hasn't been called for a once flag yet, defined below: @NLNT
+				MUDEF muBool mu_call_once(muOnce* once, void (*func)(void* args), void* args);
+				// @DOCLINE If another thread is calling it at the same time, the calling thread sleeps until it returns, so that the function, and whatever it wrote, is known to have finished once this function returns `MU_TRUE`. If a stop is requested for the calling thread whilst it sleeps (see `mu_thread_request_stop`), it stops waiting and returns `MU_FALSE`, and the function may still be running. The function shouldn't call this function with the same flag.
+
+			// Calls once without ever stopping early, for MU_LAZY, which has to return the value
+			MUDEF void mum_call_once_lazy(muOnce* once, void (*func)(void* args), void* args);
+
+			// @DOCLINE ### Lazy globals
+
+				// @DOCLINE The macro `MU_LAZY(type, name, init)` defines a global that's initialized the first time it's used, for use at file scope. It defines a `static` function `name` that takes no arguments and returns a `type`: the first call evaluates the expression `init` under a once flag, and every call returns what it evaluated to. For example, `MU_LAZY(muMutex, cache_mutex, mu_mutex_create());` makes `cache_mutex()` return the same mutex every time, created on the first call. With GCC, Clang, and MSVC on x86, the check for whether `init` has been evaluated is made within the calling function, so that a call costs one load once it has; with other compilers, a function of mum is called every time. A thread waiting for another to evaluate `init` keeps waiting even if a stop is requested for it. The global is never freed.
+				#define MU_LAZY(type, name, init) \
+					static muOnce name##_mum_once = MU_ONCE_INIT; \
+					static type name##_mum_value; \
+					static void name##_mum_init(void* args) { \
+						name##_mum_value = (init); \
+						return; if (args) {} \
+					} \
+					static inline type name(void) { \
+						if (!MUM_ONCE_RETURNED(&name##_mum_once)) { \
+							mum_call_once_lazy(&name##_mum_once, name##_mum_init, 0); \
+						} \
+						return name##_mum_value; \
+					} \
+					struct name##_mum_lazy
+
+		// @DOCLINE ## Parking lot functions
+
+			// @DOCLINE The parking lot lets threads wait on any address, without anything having to be created for it; threads waiting on an address are kept in one global table, in the order that they started waiting, and only for as long as they wait. This is what lets the byte mutex and byte once flag below be a single byte each whilst still having threads wait for them asleep rather than spinning, so that every object of many can have its own lock.
+
+			// @DOCLINE ### Parking and unparking
+
+				// @DOCLINE The function `mu_park` makes the calling thread wait on an address until another thread unparks it, defined below: @NLNT
+				MUDEF muBool mu_park(const void* address, muBool (*validate)(void* args), void* args, int32_m timeout_ms);
+				// @DOCLINE `validate` is called with `args` with the queue of the address locked, and the thread only waits if it returns `MU_TRUE`, so that no thread can unpark the address between the check and the wait; it's usually used to check that what's being waited for still hasn't happened, and can be 0 to always wait. It shouldn't call any parking lot function. `timeout_ms` is how many milliseconds to wait for at most, or -1 to wait until unparked. `MU_TRUE` is returned if the thread was unparked, and `MU_FALSE` if `validate` returned `MU_FALSE`, the wait timed out, or a stop was requested for the calling thread (see `mu_thread_request_stop`).
+
+				// @DOCLINE The function `mu_unpark_one` unparks the thread that has waited the longest on an address, returning whether there was one, defined below: @NLNT
+				MUDEF muBool mu_unpark_one(const void* address, void (*callback)(muBool unparked, muBool more, void* args), void* args);
+				// @DOCLINE If `callback` isn't 0, it's called with `args` with the queue of the address still locked, before the unparked thread is woken up, with whether a thread was unparked and whether more threads are still waiting on the address; it shouldn't call any parking lot function.
+
+				// @DOCLINE The function `mu_unpark_all` unparks every thread waiting on an address, returning how many there were, defined below: @NLNT
+				MUDEF size_m mu_unpark_all(const void* address);
+
+			// @DOCLINE ### Byte mutexes
+
+				// @DOCLINE The type `muByteMutex` is a mutex taking up a single byte, which is unlocked when zeroed and doesn't need to be created or destroyed. Threads that can't lock it spin for a short while, and then wait for it in the parking lot. It isn't recursive.
+				typedef uint8_m muByteMutex;
+
+				// @DOCLINE The function `mu_byte_mutex_lock` locks a byte mutex, returning whether it did, defined below: @NLNT
+				MUDEF muBool mu_byte_mutex_lock(muByteMutex* mutex);
+				// @DOCLINE It only returns `MU_FALSE` if it had to wait for the mutex and a stop was requested for the calling thread meanwhile (see `mu_thread_request_stop`), in which case the mutex isn't locked.
+
+				// @DOCLINE The function `mu_byte_mutex_try_lock` locks a byte mutex if it's unlocked, returning whether it did, defined below: @NLNT
+				MUDEF muBool mu_byte_mutex_try_lock(muByteMutex* mutex);
+
+				// @DOCLINE The function `mu_byte_mutex_unlock` unlocks a byte mutex, defined below: @NLNT
+				MUDEF void mu_byte_mutex_unlock(muByteMutex* mutex);
+
+			// @DOCLINE ### Byte once flags
+
+				// @DOCLINE The type `muByteOnce` is a flag taking up a single byte, which is unset when zeroed, used to call a function once and only once.
+				typedef uint8_m muByteOnce;
+
+				// @DOCLINE The function `mu_byte_once_call` calls a function with the given arguments if it hasn't been called for a byte once flag yet, defined below: @NLNT
+				MUDEF muBool mu_byte_once_call(muByteOnce* once, void (*func)(void* args), void* args);
+				// @DOCLINE If another thread is calling it at the same time, the calling thread waits for it to return first, so that the function is known to have returned once this function returns `MU_TRUE`. If a stop is requested for the calling thread whilst it waits (see `mu_thread_request_stop`), it stops waiting and returns `MU_FALSE`, and the function may still be running. The function shouldn't call this function with the same flag.
+
+		// @DOCLINE ## Cohort lock functions
+
+			// @DOCLINE A cohort lock is a spinning lock made for machines with several NUMA nodes, where handing a lock and the data it protects to a thread on another node is far more expensive than handing it to one on the same node. Threads first take a lock local to their node, and only then the global lock; once a thread unlocks whilst others on the same node are waiting, the lock is passed to one of them without the global lock ever being released, until either no waiters are left on the node or a handoff limit has been reached. The global lock is then released to the other nodes, in the order that they asked for it. Threads that wait for long go to sleep rather than spin.
+
+			// @DOCLINE If the machine only has one NUMA node but several last-level caches, the caches are used in place of nodes; if it only has one of each, the lock works like a plain lock.
+
+			// @DOCLINE ### Cohort lock creation and destruction
+
+				// @DOCLINE The function `mu_cohort_lock_create` creates a cohort lock, defined below: @NLNT
+				MUDEF muCohortLock mu_cohort_lock_create(uint32_m handoff_limit);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCohortLock mu_cohort_lock_create_(mumResult* result, uint32_m handoff_limit);
+				// @DOCLINE `handoff_limit` is the most times in a row that the lock can be handed to a thread on the same node whilst threads on other nodes are waiting; higher is faster, lower is fairer. If it's 0, a default of 64 is used.
+
+				// @DOCLINE The function `mu_cohort_lock_destroy` destroys a cohort lock, defined below: @NLNT
+				MUDEF muCohortLock mu_cohort_lock_destroy(muCohortLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCohortLock mu_cohort_lock_destroy_(mumResult* result, muCohortLock lock);
+
+			// @DOCLINE ### Cohort lock locking and unlocking
+
+				// @DOCLINE The function `mu_cohort_lock_lock` locks a cohort lock, defined below: @NLNT
+				MUDEF void mu_cohort_lock_lock(muCohortLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_cohort_lock_lock_(mumResult* result, muCohortLock lock);
+
+				// @DOCLINE The function `mu_cohort_lock_unlock` unlocks a cohort lock, defined below: @NLNT
+				MUDEF void mu_cohort_lock_unlock(muCohortLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_cohort_lock_unlock_(mumResult* result, muCohortLock lock);
+
+		// @DOCLINE ## Adaptive lock functions
+
+			// @DOCLINE An adaptive lock spins while waiting if the lock is likely to be released soon, and sleeps otherwise. Each lock keeps an average of how long it's held for, and a limit on how long a waiter spins, which grows towards twice the average hold time whilst spinning pays off, and shrinks whenever a waiter spins for the whole limit and has to sleep anyway. A waiter also stops spinning once the holder has held the lock for far longer than usual, since the holder has then most likely been taken off its CPU. On a machine with one logical CPU, waiters never spin.
+
+			// @DOCLINE Hold times are only measured for one in every few uncontended acquisitions, as well as for every contended one, since reading the time is slow enough to matter for short critical sections; even so, an uncontended adaptive lock is a little slower than a mutex or spinlock.
+
+			// @DOCLINE ### Adaptive lock creation and destruction
+
+				// @DOCLINE The function `mu_adaptive_lock_create` creates an adaptive lock, defined below: @NLNT
+				MUDEF muAdaptiveLock mu_adaptive_lock_create(void);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muAdaptiveLock mu_adaptive_lock_create_(mumResult* result);
+
+				// @DOCLINE The function `mu_adaptive_lock_destroy` destroys an adaptive lock, defined below: @NLNT
+				MUDEF muAdaptiveLock mu_adaptive_lock_destroy(muAdaptiveLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muAdaptiveLock mu_adaptive_lock_destroy_(mumResult* result, muAdaptiveLock lock);
+
+			// @DOCLINE ### Adaptive lock locking and unlocking
+
+				// @DOCLINE The function `mu_adaptive_lock_lock` locks an adaptive lock, defined below: @NLNT
+				MUDEF void mu_adaptive_lock_lock(muAdaptiveLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_adaptive_lock_lock_(mumResult* result, muAdaptiveLock lock);
+
+				// @DOCLINE The function `mu_adaptive_lock_unlock` unlocks an adaptive lock, defined below: @NLNT
+				MUDEF void mu_adaptive_lock_unlock(muAdaptiveLock lock);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_adaptive_lock_unlock_(mumResult* result, muAdaptiveLock lock);
+
+			// @DOCLINE ### Adaptive lock statistics
+
+				// @DOCLINE The function `mu_adaptive_lock_stats` retrieves the statistics that an adaptive lock tunes itself with, defined below: @NLNT
+				MUDEF void mu_adaptive_lock_stats(muAdaptiveLock lock, uint64_m* acquisitions, uint64_m* contended, uint64_m* spun, uint64_m* parked, uint64_m* average_hold_ns, uint64_m* spin_limit_ns);
+				// @DOCLINE `acquisitions` is how many times the lock has been locked; `contended` is how many of those had to wait; `spun` and `parked` are how many of those got the lock by spinning and by sleeping; `average_hold_ns` is the average time the lock is held for, weighted towards recent holds; and `spin_limit_ns` is the current limit on how long a waiter spins. Any of the pointers can be 0. The statistics may be out of date by the time they're returned if other threads are using the lock.
+
+		// @DOCLINE ## Combiner functions
+
+			// @DOCLINE A combiner runs operations one at a time like a lock would, but instead of each thread taking the lock and running its own operation, whichever thread gets to run first also runs the operations that other threads have queued up in the meantime, up to a batch limit, before handing the rest over to the next waiting thread. The data that the operations work on then stays in one CPU's cache for a whole batch, rather than moving between CPUs for every operation, which is what mostly limits a heavily contended lock. Waiting threads don't touch the data at all; they wait on a flag of their own until their operation has been run. Operations are queued in the order they're submitted ([CC-Synch](https://doi.org/10.1145/2145816.2145849)), and each thread needs only one queue entry, however many combiners it uses.
+
+			// @DOCLINE ### Combiner creation and destruction
+
+				// @DOCLINE The function `mu_combiner_create` creates a combiner, defined below: @NLNT
+				MUDEF muCombiner mu_combiner_create(uint32_m batch_limit);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCombiner mu_combiner_create_(mumResult* result, uint32_m batch_limit);
+				// @DOCLINE `batch_limit` is the most operations that one thread runs before handing the rest over; higher is faster, lower is fairer to the thread doing the running. If it's 0, a default of 64 is used.
+
+				// @DOCLINE The function `mu_combiner_destroy` destroys a combiner, defined below: @NLNT
+				MUDEF muCombiner mu_combiner_destroy(muCombiner combiner);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCombiner mu_combiner_destroy_(mumResult* result, muCombiner combiner);
+
+			// @DOCLINE ### Running operations
+
+				// @DOCLINE The function `mu_combiner_execute` runs an operation under a combiner, possibly on another thread, and returns once it has been run, defined below: @NLNT
+				MUDEF void mu_combiner_execute(muCombiner combiner, void (*operation)(void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_combiner_execute_(mumResult* result, muCombiner combiner, void (*operation)(void* args), void* args);
+				// @DOCLINE No two operations of the same combiner run at the same time, and everything an operation wrote is visible to the thread that submitted it once this function returns. Since an operation may run on any thread, it shouldn't rely on thread-local state, and it must not call `mu_combiner_execute` itself. Results can be passed back through `args`. If the calling thread's queue entry can't be allocated on its first call, `MUM_FAILED_ALLOCATE` is set and the operation isn't run.
+
+		// @DOCLINE ## Counter and accumulator functions
+
+			// @DOCLINE Counters and accumulators are meant for values that many threads update often and that are read far less often, such as statistics. Each is split into one shard per logical CPU (rounded up to a power of 2), each on its own cache line, and an update only touches the shard of the CPU that the calling thread last looked itself up on, which it does every few updates; an update is still atomic, since a thread may have moved to another CPU in the meantime, but it doesn't have to fight with other CPUs for the cache line. Reading adds up every shard, so it's slower than with a single shared value, and isn't a snapshot of one instant if updates are made meanwhile.
+
+			// @DOCLINE ### Counter creation and destruction
+
+				// @DOCLINE The function `mu_counter_create` creates a counter starting at 0, defined below: @NLNT
+				MUDEF muCounter mu_counter_create(void);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCounter mu_counter_create_(mumResult* result);
+
+				// @DOCLINE The function `mu_counter_destroy` destroys a counter, defined below: @NLNT
+				MUDEF muCounter mu_counter_destroy(muCounter counter);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muCounter mu_counter_destroy_(mumResult* result, muCounter counter);
+
+			// @DOCLINE ### Counter use
+
+				// @DOCLINE The function `mu_counter_add` adds to a counter, defined below: @NLNT
+				MUDEF void mu_counter_add(muCounter counter, int64_m amount);
+
+				// @DOCLINE The function `mu_counter_read` returns the value of a counter, defined below: @NLNT
+				MUDEF int64_m mu_counter_read(muCounter counter);
+
+				// @DOCLINE The function `mu_counter_take` returns the value of a counter and resets it to 0, defined below: @NLNT
+				MUDEF int64_m mu_counter_take(muCounter counter);
+				// @DOCLINE Every amount added is returned by exactly one call, so this can be used to read how much has been added since the last call, even whilst other threads keep adding.
+
+			// @DOCLINE ### Accumulator creation and destruction
+
+				// @DOCLINE The function `mu_accumulator_create` creates an accumulator with no values recorded, defined below: @NLNT
+				MUDEF muAccumulator mu_accumulator_create(void);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muAccumulator mu_accumulator_create_(mumResult* result);
+
+				// @DOCLINE The function `mu_accumulator_destroy` destroys an accumulator, defined below: @NLNT
+				MUDEF muAccumulator mu_accumulator_destroy(muAccumulator accumulator);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muAccumulator mu_accumulator_destroy_(mumResult* result, muAccumulator accumulator);
+
+			// @DOCLINE ### Accumulator use
+
+				// @DOCLINE The function `mu_accumulator_record` records a value in an accumulator, defined below: @NLNT
+				MUDEF void mu_accumulator_record(muAccumulator accumulator, int64_m value);
+				// @DOCLINE Recording a value that isn't a new minimum or maximum for its shard only costs two atomic additions.
+
+				// @DOCLINE The function `mu_accumulator_read` retrieves the amount of values recorded in an accumulator, and their sum, minimum and maximum, defined below: @NLNT
+				MUDEF void mu_accumulator_read(muAccumulator accumulator, uint64_m* count, int64_m* sum, int64_m* min, int64_m* max);
+				// @DOCLINE Any of the pointers can be 0. If no values have been recorded, the minimum and maximum are 0.
+
+				// @DOCLINE The function `mu_accumulator_reset` clears every value recorded in an accumulator, defined below: @NLNT
+				MUDEF void mu_accumulator_reset(muAccumulator accumulator);
+				// @DOCLINE Values recorded whilst the accumulator is being reset may be partly kept.
+
+		// @DOCLINE ## Hash map functions
+
+			// @DOCLINE A hash map maps `uint64_m` keys to `void*` values, and can be read and written by any amount of threads at once without an external lock. Lookups take no locks and never write to memory shared with other threads besides a per-stripe counter, on its own cache line, that's shared by at most a few threads; writes only ever lock the single slot that they change. When a hash map fills up, it's resized incrementally by the threads writing to it, and the memory freed by resizing is reclaimed internally once no thread can still be reading it.
+
+			// @DOCLINE ### Hash map creation and destruction
+
+				// @DOCLINE The function `mu_hash_map_create` creates a hash map, defined below: @NLNT
+				MUDEF muHashMap mu_hash_map_create(size_m capacity);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muHashMap mu_hash_map_create_(mumResult* result, size_m capacity);
+				// @DOCLINE `capacity` is the amount of keys that the hash map is expected to hold. The hash map grows past it as needed, but never shrinks below it.
+
+				// @DOCLINE The function `mu_hash_map_destroy` destroys a hash map, defined below: @NLNT
+				MUDEF muHashMap mu_hash_map_destroy(muHashMap map);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muHashMap mu_hash_map_destroy_(mumResult* result, muHashMap map);
+				// @DOCLINE The hash map must not be in use by any other thread when it is destroyed. Values stored within it are not freed.
+
+			// @DOCLINE ### Hash map lookup
+
+				// @DOCLINE The function `mu_hash_map_get` looks up the value of a key, defined below: @NLNT
+				MUDEF muBool mu_hash_map_get(muHashMap map, uint64_m key, void** value);
+				// @DOCLINE If the key is present, `MU_TRUE` is returned and its value is written to `value` (if `value` is not 0); otherwise, `MU_FALSE` is returned.
+
+			// @DOCLINE ### Hash map writing
+
+				// @DOCLINE The function `mu_hash_map_put` sets the value of a key, inserting it if it isn't present, defined below: @NLNT
+				MUDEF void mu_hash_map_put(muHashMap map, uint64_m key, void* value);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_hash_map_put_(mumResult* result, muHashMap map, uint64_m key, void* value);
+
+				// @DOCLINE The function `mu_hash_map_insert` inserts a key only if it isn't already present, defined below: @NLNT
+				MUDEF muBool mu_hash_map_insert(muHashMap map, uint64_m key, void* value, void** existing);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muBool mu_hash_map_insert_(mumResult* result, muHashMap map, uint64_m key, void* value, void** existing);
+				// @DOCLINE `MU_TRUE` is returned if the key was inserted. If the key was already present, `MU_FALSE` is returned and its current value is written to `existing` (if `existing` is not 0). This is the function to use for populating a cache, as only one of several threads racing to insert the same key wins.
+
+				// @DOCLINE The function `mu_hash_map_remove` removes a key, defined below: @NLNT
+				MUDEF muBool mu_hash_map_remove(muHashMap map, uint64_m key, void** value);
+				// @DOCLINE If the key was present, `MU_TRUE` is returned and its value is written to `value` (if `value` is not 0); otherwise, `MU_FALSE` is returned.
+
+		// @DOCLINE ## Slab allocator functions
+
+			// @DOCLINE mum provides an allocator meant for many threads allocating and freeing small objects at once. Each thread allocates from its own cache of slabs, one per size class, without any atomic operations; freeing memory allocated by another thread pushes it onto a lock-free queue within its slab, which the owning thread collects once it runs out of memory. Allocations of up to 8 KB are served from slabs, and anything bigger is mapped directly from the operating system. Slabs of threads that have exited are adopted by other threads.
+
+			// @DOCLINE The allocator can be used by the user directly, and can be used for all of mum's own allocations by defining `MUM_SLAB_MALLOC` before mum is included.
+
+			// @DOCLINE ### Slab allocation
+
+				// @DOCLINE The function `mu_slab_alloc` allocates memory, defined below: @NLNT
+				MUDEF void* mu_slab_alloc(size_m size);
+				// @DOCLINE It works like `malloc`: the memory is aligned to 16 bytes, and 0 is returned if the memory could not be allocated.
+
+			// @DOCLINE ### Slab freeing
+
+				// @DOCLINE The function `mu_slab_free` frees memory allocated by `mu_slab_alloc`, defined below: @NLNT
+				MUDEF void mu_slab_free(void* ptr);
+				// @DOCLINE It works like `free`, and can be called by any thread, not just the one that allocated the memory. Passing 0 does nothing.
+
+		// @DOCLINE ## Object pool functions
+
+			// @DOCLINE An object pool hands out objects of one fixed size, such as message buffers recycled between threads. Each thread keeps up to two magazines of free objects per pool, each holding up to 32, and allocates from and frees into them without touching anything shared; only once both are full or empty does it trade a whole magazine with the pool's depot, a lock-free stack whose top is tagged with a counter, so that no two threads can be fooled by a magazine that was taken and put back in between ([ABA](https://en.wikipedia.org/wiki/ABA_problem)). A pool grows in chunks, each twice as big as the last, as needed, and only gives its memory back once destroyed. When a thread exits, its magazines are given back to the depots of the pools that still exist.
+
+			// @DOCLINE ### Object pool creation and destruction
+
+				// @DOCLINE The function `mu_pool_create` creates an object pool, defined below: @NLNT
+				MUDEF muPool mu_pool_create(size_m object_size);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muPool mu_pool_create_(mumResult* result, size_m object_size);
+				// @DOCLINE `object_size` is rounded up to a multiple of 16, and to at least 16; objects are aligned to 16 bytes.
+
+				// @DOCLINE The function `mu_pool_destroy` destroys an object pool, along with every object allocated from it, defined below: @NLNT
+				MUDEF muPool mu_pool_destroy(muPool pool);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muPool mu_pool_destroy_(mumResult* result, muPool pool);
+				// @DOCLINE No other thread may be using the pool at the time.
+
+			// @DOCLINE ### Object pool allocation and freeing
+
+				// @DOCLINE The function `mu_pool_alloc` allocates an object from an object pool, defined below: @NLNT
+				MUDEF void* mu_pool_alloc(muPool pool);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void* mu_pool_alloc_(mumResult* result, muPool pool);
+				// @DOCLINE The object's contents are undefined. If the pool needs to grow and can't, or the calling thread's magazines can't be allocated on its first call for the pool, `MUM_FAILED_ALLOCATE` is set and 0 is returned. Objects free in the magazines of other threads aren't used, so a pool can grow whilst others hold free objects.
+
+				// @DOCLINE The function `mu_pool_free` gives an object back to the object pool it was allocated from, defined below: @NLNT
+				MUDEF void mu_pool_free(muPool pool, void* object);
+				// @DOCLINE It can be called by any thread, not just the one that allocated the object. Passing 0 does nothing.
+
+		// @DOCLINE ## Tracing functions
+
+			// @DOCLINE If `MUM_TRACE` is defined when the implementation is compiled, mum records a timeline of what its threads, mutexes and spinlocks do: threads being created, starting, exiting and being waited on, and locks being acquired, contended and released. Each thread records into its own ring buffer without any locks, timestamped with the CPU's timestamp counter where available. If `MUM_TRACE` is not defined, none of this is compiled in, and locking works exactly as it does normally.
+
+			// @DOCLINE Each ring buffer holds `MUM_TRACE_CAPACITY` events (16384 by default, overridable by defining it as a power of 2 before the implementation); once it fills up, the oldest events are overwritten.
+
+			// @DOCLINE ### Trace flushing
+
+				// @DOCLINE The function `mu_trace_flush` writes every event recorded since the last flush to a file in the Chrome trace event JSON format, which can be opened in Perfetto or `chrome://tracing`, defined below: @NLNT
+				MUDEF void mu_trace_flush(const char* path);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_trace_flush_(mumResult* result, const char* path);
+				// @DOCLINE Lock holds are shown as async spans per lock, and waiting for a lock or a thread as spans on the waiting thread. The file is overwritten. If mum was compiled without `MUM_TRACE`, `MUM_TRACE_DISABLED` is set and nothing is written. Events recorded while the flush is in progress are kept for the next flush.
+
+		// @DOCLINE ## Topology functions
+
+			// @DOCLINE mum can describe the layout of the machine's logical CPUs: which of them are SMT siblings sharing a physical core, which share a last-level cache, and which NUMA node they belong to. On Linux, this is read from `/sys/devices/system/cpu` and `/sys/devices/system/node`; on Win32, from `GetLogicalProcessorInformationEx`. Elsewhere, or if that information isn't available, every CPU is treated as its own core and cache on a single node. The topology is discovered once, the first time it's needed.
+
+			// @DOCLINE CPUs, cores, last-level caches and nodes are all identified by indexes counting up from 0, which don't necessarily match the operating system's own numbering.
+
+			// @DOCLINE ### Topology counts
+
+				// @DOCLINE The function `mu_topology_cpu_count` returns the amount of logical CPUs, defined below: @NLNT
+				MUDEF uint32_m mu_topology_cpu_count(void);
+
+				// @DOCLINE The function `mu_topology_core_count` returns the amount of physical cores, defined below: @NLNT
+				MUDEF uint32_m mu_topology_core_count(void);
+
+				// @DOCLINE The function `mu_topology_llc_count` returns the amount of last-level caches, defined below: @NLNT
+				MUDEF uint32_m mu_topology_llc_count(void);
+
+				// @DOCLINE The function `mu_topology_node_count` returns the amount of NUMA nodes, defined below: @NLNT
+				MUDEF uint32_m mu_topology_node_count(void);
+
+			// @DOCLINE ### CPU placement
+
+				// @DOCLINE The function `mu_topology_cpu_core` returns the physical core that a CPU belongs to, defined below: @NLNT
+				MUDEF uint32_m mu_topology_cpu_core(uint32_m cpu);
+				// @DOCLINE CPUs with the same core are SMT siblings.
+
+				// @DOCLINE The function `mu_topology_cpu_llc` returns the last-level cache that a CPU uses, defined below: @NLNT
+				MUDEF uint32_m mu_topology_cpu_llc(uint32_m cpu);
+
+				// @DOCLINE The function `mu_topology_cpu_node` returns the NUMA node that a CPU belongs to, defined below: @NLNT
+				MUDEF uint32_m mu_topology_cpu_node(uint32_m cpu);
+
+				// @DOCLINE All three return 0 if `cpu` is out of range.
+
+			// @DOCLINE ### Current CPU
+
+				// @DOCLINE The function `mu_topology_current_cpu` returns the CPU that the calling thread is running on, defined below: @NLNT
+				MUDEF uint32_m mu_topology_current_cpu(void);
+				// @DOCLINE The thread can be moved to another CPU at any time unless it's bound to one, so the result is only a hint. 0 is returned if the current CPU can't be retrieved.
+
+				// @DOCLINE The function `mu_topology_current_node` returns the NUMA node that the calling thread is running on, defined below: @NLNT
+				MUDEF uint32_m mu_topology_current_node(void);
+
+			// @DOCLINE ### Bound thread creation
+
+				// @DOCLINE The function `mu_thread_create_on_cpu` creates a thread that only runs on the given CPU, defined below: @NLNT
+				MUDEF muThread mu_thread_create_on_cpu(void (*start)(void* args), void* args, uint32_m cpu);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muThread mu_thread_create_on_cpu_(mumResult* result, void (*start)(void* args), void* args, uint32_m cpu);
+
+				// @DOCLINE The function `mu_thread_create_on_node` creates a thread that only runs on the CPUs of the given NUMA node, defined below: @NLNT
+				MUDEF muThread mu_thread_create_on_node(void (*start)(void* args), void* args, uint32_m node);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muThread mu_thread_create_on_node_(mumResult* result, void (*start)(void* args), void* args, uint32_m node);
+
+				// @DOCLINE Both work like `mu_thread_create`, and the thread is bound before it starts running. If the index is out of range, `MUM_INVALID_INDEX` is set. On Unix, binding is only supported on Linux, where the new thread binds itself through the `sched_setaffinity` system call before running `start`.
+
+			// @DOCLINE ### Node-local allocation
+
+				// @DOCLINE The function `mu_node_alloc` maps memory that is placed on the given NUMA node, defined below: @NLNT
+				MUDEF void* mu_node_alloc(size_m size, uint32_m node);
+				// @DOCLINE The memory is page-aligned and zeroed, and 0 is returned if it could not be allocated. The node is preferred rather than required, so the memory falls back to other nodes once the node runs out. On Unix systems other than Linux, the memory is not placed on any specific node.
+
+				// @DOCLINE The function `mu_node_free` frees memory allocated by `mu_node_alloc`, defined below: @NLNT
+				MUDEF void mu_node_free(void* ptr, size_m size);
+				// @DOCLINE `size` must be the size that the memory was allocated with.
+
+		// @DOCLINE ## Scheduler functions
+
+			// @DOCLINE A scheduler runs tasks on a pool of worker threads. Each task has a priority (see `mumTaskPriority`), and optionally a deadline; a worker always runs the most urgent task it can find, and tasks of the same priority run earliest deadline first, with tasks without a deadline running after those with one, in the order they were submitted. So that lower priorities are never starved, a task that has waited for long is treated as one priority higher for every aging period it has waited.
+
+			// @DOCLINE Each worker has its own queues. Submitting a task pushes it onto a worker's queue without any locks (onto the calling worker's own queue if called from within a task), and idle workers take work from the queues of others, including tasks that a busy worker has taken in but not started. Workers with nothing to do sleep.
+
+			// @DOCLINE ### Scheduler creation and destruction
+
+				// @DOCLINE The function `mu_scheduler_create` creates a scheduler, defined below: @NLNT
+				MUDEF muScheduler mu_scheduler_create(uint32_m worker_count, uint64_m aging_ns);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muScheduler mu_scheduler_create_(mumResult* result, uint32_m worker_count, uint64_m aging_ns);
+				// @DOCLINE If `worker_count` is 0, one worker is created per logical CPU. `aging_ns` is the aging period in nanoseconds; if it's 0, a default of 50 milliseconds is used.
+
+				// @DOCLINE The function `mu_scheduler_destroy` destroys a scheduler, defined below: @NLNT
+				MUDEF muScheduler mu_scheduler_destroy(muScheduler scheduler);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muScheduler mu_scheduler_destroy_(mumResult* result, muScheduler scheduler);
+				// @DOCLINE Every task already submitted is run before the workers are stopped.
+
+			// @DOCLINE ### Task submission
+
+				// @DOCLINE The function `mu_scheduler_submit` submits a task to a scheduler, defined below: @NLNT
+				MUDEF void mu_scheduler_submit(muScheduler scheduler, void (*task)(void* args), void* args, mumTaskPriority priority, uint64_m deadline_ns);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_scheduler_submit_(mumResult* result, muScheduler scheduler, void (*task)(void* args), void* args, mumTaskPriority priority, uint64_m deadline_ns);
+				// @DOCLINE `deadline_ns` is how many nanoseconds from now the task should be done by, or 0 for no deadline. A deadline only decides the order that tasks run in; tasks are never cancelled for missing one.
+
+				// @DOCLINE The function `mu_scheduler_wait` waits until every task submitted to a scheduler has finished running, defined below: @NLNT
+				MUDEF void mu_scheduler_wait(muScheduler scheduler);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_scheduler_wait_(mumResult* result, muScheduler scheduler);
+				// @DOCLINE It must not be called from within a task of the same scheduler. If a stop is requested for the calling thread whilst it waits, it stops waiting and `MUM_STOP_REQUESTED` is set.
+
+			// @DOCLINE ### Scheduler statistics
+
+				// @DOCLINE The function `mu_scheduler_stats` retrieves statistics about the tasks of a priority, defined below: @NLNT
+				MUDEF void mu_scheduler_stats(muScheduler scheduler, mumTaskPriority priority, size_m* queued, uint64_m* completed, uint64_m* average_latency_ns, uint64_m* max_latency_ns);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_scheduler_stats_(mumResult* result, muScheduler scheduler, mumTaskPriority priority, size_m* queued, uint64_m* completed, uint64_m* average_latency_ns, uint64_m* max_latency_ns);
+				// @DOCLINE `queued` is the amount of tasks submitted with the priority that haven't started running yet; `completed` is the amount that have finished running; and the latencies are the average and longest times between a task being submitted and starting to run. Any of the pointers can be 0. Aging doesn't change which priority a task counts towards.
+
+			// @DOCLINE ### Scheduler idle strategy
+
+				// @DOCLINE The function `mu_scheduler_set_idle` attaches an idle strategy to the workers of a scheduler, defined below: @NLNT
+				MUDEF void mu_scheduler_set_idle(muScheduler scheduler, muIdleStrategy strategy);
+				// @DOCLINE A worker with nothing to do goes to sleep straight away by default; with a strategy attached, it keeps looking for work whilst spinning or yielding, and only goes to sleep once the strategy parks. Idle workers only poll an event loop of the scheduler once they'd go to sleep, so with a strategy that never parks, `mu_event_loop_poll` has to be called for I/O to be noticed. It can be changed at any time, and 0 goes back to the default; the strategy must outlive its use by the scheduler.
+
+		// @DOCLINE ## Timer wheel functions
+
+			// @DOCLINE A timer wheel calls a callback once a delay has passed, and optionally again every period after that. Time is counted in ticks of a fixed length, and timers are kept in a hierarchy of wheels, so scheduling and cancelling a timer take constant time no matter how many timers there are, and expiring timers only touches the timers that are due. A timer fires at or up to about one tick after its due time.
+
+			// @DOCLINE Each timer wheel has its own timer thread, which sleeps until the next tick that has something to do, and submits every timer that expires as a task to a scheduler; callbacks therefore run on the scheduler's workers, never on the timer thread.
+
+			// @DOCLINE ### Timer wheel creation and destruction
+
+				// @DOCLINE The function `mu_timer_wheel_create` creates a timer wheel, defined below: @NLNT
+				MUDEF muTimerWheel mu_timer_wheel_create(muScheduler scheduler, uint64_m tick_ns);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muTimerWheel mu_timer_wheel_create_(mumResult* result, muScheduler scheduler, uint64_m tick_ns);
+				// @DOCLINE `tick_ns` is the length of a tick in nanoseconds; if it's 0, a default of 1 millisecond is used. The scheduler must outlive the timer wheel.
+
+				// @DOCLINE The function `mu_timer_wheel_destroy` destroys a timer wheel, defined below: @NLNT
+				MUDEF muTimerWheel mu_timer_wheel_destroy(muTimerWheel wheel);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muTimerWheel mu_timer_wheel_destroy_(mumResult* result, muTimerWheel wheel);
+				// @DOCLINE Timers that haven't expired yet are dropped without being called. Callbacks of timers that already expired may still be queued on or running on the scheduler.
+
+			// @DOCLINE ### Timer scheduling
+
+				// @DOCLINE The function `mu_timer_schedule` schedules a timer, defined below: @NLNT
+				MUDEF uint64_m mu_timer_schedule(muTimerWheel wheel, uint64_m delay_ns, uint64_m period_ns, void (*callback)(void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF uint64_m mu_timer_schedule_(mumResult* result, muTimerWheel wheel, uint64_m delay_ns, uint64_m period_ns, void (*callback)(void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE `callback` is submitted to the scheduler with the given priority once `delay_ns` nanoseconds have passed. If `period_ns` is not 0, it is then submitted again every `period_ns` nanoseconds until the timer is cancelled; if the timer thread falls behind, missed periods are skipped rather than run back to back. The function returns an identifier for the timer, which is never 0, or 0 if the timer could not be scheduled. Timers can be scheduled from within callbacks.
+
+				// @DOCLINE The function `mu_timer_cancel` cancels a timer, defined below: @NLNT
+				MUDEF muBool mu_timer_cancel(muTimerWheel wheel, uint64_m timer);
+				// @DOCLINE `MU_TRUE` is returned if the timer was cancelled, and `MU_FALSE` if the timer already expired (and wasn't periodic) or was already cancelled. A callback submitted just before the timer was cancelled may still run after this function returns.
+
+		// @DOCLINE ## Event loop functions
+
+			// @DOCLINE An event loop watches file descriptors for readiness, and submits a file descriptor's callback as a task to a scheduler once it's ready, so callbacks run directly on the scheduler's workers rather than being handed over by an I/O thread. Event loops are currently only implemented on Linux, using `epoll` and `eventfd`; elsewhere, creating one fails with `MUM_EVENT_LOOP_UNSUPPORTED`.
+
+			// @DOCLINE Events are picked up whenever the event loop is polled. The first event loop created for a scheduler is polled by the scheduler's workers whenever they would otherwise sleep, so no dedicated I/O thread is needed; if the workers may all be busy for long, a thread can also call `mu_event_loop_poll` in a loop.
+
+			// @DOCLINE ### Event loop creation and destruction
+
+				// @DOCLINE The function `mu_event_loop_create` creates an event loop, defined below: @NLNT
+				MUDEF muEventLoop mu_event_loop_create(muScheduler scheduler);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muEventLoop mu_event_loop_create_(mumResult* result, muScheduler scheduler);
+				// @DOCLINE The scheduler must outlive the event loop.
+
+				// @DOCLINE The function `mu_event_loop_destroy` destroys an event loop, defined below: @NLNT
+				MUDEF muEventLoop mu_event_loop_destroy(muEventLoop loop);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muEventLoop mu_event_loop_destroy_(mumResult* result, muEventLoop loop);
+				// @DOCLINE Any file descriptors still in the event loop are removed from it, but not closed. No thread may be polling the event loop with `mu_event_loop_poll` when it's destroyed.
+
+			// @DOCLINE ### File descriptors
+
+				// @DOCLINE The function `mu_event_loop_add` adds a file descriptor to an event loop, defined below: @NLNT
+				MUDEF uint64_m mu_event_loop_add(muEventLoop loop, int fd, uint32_m events, void (*callback)(int fd, uint32_m events, void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF uint64_m mu_event_loop_add_(mumResult* result, muEventLoop loop, int fd, uint32_m events, void (*callback)(int fd, uint32_m events, void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE `events` is the event flags to wait for. Once the file descriptor is ready, `callback` is submitted to the scheduler with the given priority, and is given the flags that are ready. The file descriptor isn't watched again until the callback returns, so one file descriptor's callback never runs on two workers at once, and the callback should read or write until it would block, as it won't be called again for readiness that it left unused. The function returns an identifier for the file descriptor within the event loop, which is never 0, or 0 if it could not be added.
+
+				// @DOCLINE The function `mu_event_loop_remove` removes a file descriptor from an event loop, defined below: @NLNT
+				MUDEF void mu_event_loop_remove(muEventLoop loop, uint64_m source);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_event_loop_remove_(mumResult* result, muEventLoop loop, uint64_m source);
+				// @DOCLINE `source` is the identifier returned by `mu_event_loop_add`. A callback that was already submitted may still run after this function returns, so the file descriptor should only be closed once it's known not to run, such as from within the callback itself.
+
+			// @DOCLINE ### Polling
+
+				// @DOCLINE The function `mu_event_loop_poll` waits for file descriptors in an event loop to become ready, and submits their callbacks, defined below: @NLNT
+				MUDEF size_m mu_event_loop_poll(muEventLoop loop, int32_m timeout_ms);
+				// @DOCLINE The amount of callbacks submitted is returned. `timeout_ms` is how many milliseconds to wait for at most, or -1 to wait until something is ready or the event loop is woken up. Calling this function from within a task of the event loop's scheduler submits the callbacks to the calling worker.
+
+				// @DOCLINE The function `mu_event_loop_wake` makes any thread waiting in `mu_event_loop_poll` on an event loop return early, defined below: @NLNT
+				MUDEF void mu_event_loop_wake(muEventLoop loop);
+
+		// @DOCLINE ## Task graph functions
+
+			// @DOCLINE A task graph is a set of tasks (nodes), and edges between them saying which tasks must finish before others can start. Running a graph submits every task without inputs to a scheduler; each node counts down its unfinished inputs atomically, and is submitted by whichever of its inputs finishes last, so independent branches run in parallel with no joins in between.
+
+			// @DOCLINE A graph can be run any amount of times. Its structure is only rebuilt on the first run after nodes or edges are added, so running it again doesn't allocate anything besides the scheduler's own tasks. How long each node took in the last run is recorded, for finding the graph's critical path.
+
+			// @DOCLINE ### Task graph creation and destruction
+
+				// @DOCLINE The function `mu_task_graph_create` creates an empty task graph, defined below: @NLNT
+				MUDEF muTaskGraph mu_task_graph_create(muScheduler scheduler);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muTaskGraph mu_task_graph_create_(mumResult* result, muScheduler scheduler);
+				// @DOCLINE The scheduler must outlive the task graph.
+
+				// @DOCLINE The function `mu_task_graph_destroy` destroys a task graph, defined below: @NLNT
+				MUDEF muTaskGraph mu_task_graph_destroy(muTaskGraph graph);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muTaskGraph mu_task_graph_destroy_(mumResult* result, muTaskGraph graph);
+
+			// @DOCLINE ### Building a task graph
+
+				// @DOCLINE The function `mu_task_graph_add_node` adds a node to a task graph, defined below: @NLNT
+				MUDEF uint32_m mu_task_graph_add_node(muTaskGraph graph, void (*task)(void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF uint32_m mu_task_graph_add_node_(mumResult* result, muTaskGraph graph, void (*task)(void* args), void* args, mumTaskPriority priority);
+				// @DOCLINE The index of the node is returned; nodes are numbered from 0 in the order they're added.
+
+				// @DOCLINE The function `mu_task_graph_add_edge` adds an edge to a task graph, so that one node only starts once another has finished, defined below: @NLNT
+				MUDEF void mu_task_graph_add_edge(muTaskGraph graph, uint32_m from, uint32_m to);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_task_graph_add_edge_(mumResult* result, muTaskGraph graph, uint32_m from, uint32_m to);
+				// @DOCLINE `to` starts once `from` has finished. If either node doesn't exist, `MUM_TASK_GRAPH_INVALID_NODE` is set. Cycles aren't checked for until the graph is run.
+
+				// @DOCLINE Nodes and edges must not be added while the graph is running.
+
+			// @DOCLINE ### Running a task graph
+
+				// @DOCLINE The function `mu_task_graph_run` runs every node of a task graph, and waits for them all to finish, defined below: @NLNT
+				MUDEF uint64_m mu_task_graph_run(muTaskGraph graph);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF uint64_m mu_task_graph_run_(mumResult* result, muTaskGraph graph);
+				// @DOCLINE The amount of nanoseconds the run took is returned. If the graph has a cycle, `MUM_TASK_GRAPH_CYCLE` is set and nothing is run. A graph must not be run from within a task of its own scheduler, or by two threads at once.
+
+			// @DOCLINE ### Profiling a task graph
+
+				// @DOCLINE The function `mu_task_graph_node_time` returns how many nanoseconds a node took to run in the last run of a task graph, defined below: @NLNT
+				MUDEF uint64_m mu_task_graph_node_time(muTaskGraph graph, uint32_m node);
+
+				// @DOCLINE The function `mu_task_graph_critical_path` finds the critical path of the last run of a task graph, defined below: @NLNT
+				MUDEF uint64_m mu_task_graph_critical_path(muTaskGraph graph, uint32_m* nodes, uint32_m* node_count);
+				// @DOCLINE The critical path is the chain of nodes, each depending on the last, that took the longest to run in total; no schedule could run the graph faster than it. Its total time in nanoseconds is returned. If `nodes` isn't 0, the path's nodes are written to it in order, so it must have room for as many nodes as are in the graph; if `node_count` isn't 0, the amount of nodes in the path is written to it.
+
+		// @DOCLINE ## Parallel algorithm functions
+
+			// @DOCLINE The parallel algorithms split an array of elements into blocks and run them on the workers of a scheduler, so that no threads are created per call. The calling thread works on blocks too, and only waits for blocks that it didn't take itself, so calling one from within a task of the same scheduler is fine. If `scheduler` is 0, or the array has fewer than `MUM_PARALLEL_SERIAL` elements (16384 by default, overridable by defining it before the implementation), everything is done serially on the calling thread, as splitting up a small array costs more than it saves.
+
+			// @DOCLINE Elements are `size` bytes each, and are moved around with `mu_memcpy`, like with `qsort`. Every callback gets the `args` pointer passed to the function it was given to.
+
+			// @DOCLINE ### Parallel sorting
+
+				// @DOCLINE The function `mu_parallel_sort` sorts an array, defined below: @NLNT
+				MUDEF void mu_parallel_sort(muScheduler scheduler, void* base, size_m count, size_m size, int (*compare)(const void* a, const void* b, void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_parallel_sort_(mumResult* result, muScheduler scheduler, void* base, size_m count, size_m size, int (*compare)(const void* a, const void* b, void* args), void* args);
+				// @DOCLINE `compare` returns less than 0 if `a` comes before `b`, 0 if they're equal, and more than 0 if `a` comes after `b`. The sort is a stable merge sort: each block is sorted on its own, and then pairs of blocks are merged, each merge being split evenly between as many workers as there are blocks. It needs a second array as big as `base`; if that can't be allocated, `MUM_FAILED_ALLOCATE` is set and the array is left untouched.
+
+			// @DOCLINE ### Parallel scanning
+
+				// @DOCLINE The function `mu_parallel_scan` computes the prefix sums of an array, defined below: @NLNT
+				MUDEF void mu_parallel_scan(muScheduler scheduler, const void* input, void* output, size_m count, size_m size, const void* identity, void (*reduce)(void* accumulator, const void* value, void* args), void* args, muBool inclusive);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_parallel_scan_(mumResult* result, muScheduler scheduler, const void* input, void* output, size_m count, size_m size, const void* identity, void (*reduce)(void* accumulator, const void* value, void* args), void* args, muBool inclusive);
+				// @DOCLINE `reduce` combines `value` into `accumulator`, and must be associative, but needn't be commutative; `identity` is an element that `reduce` leaves other elements unchanged with, such as 0 for addition. If `inclusive` is true, each element of `output` is the sum of the elements of `input` up to and including its own; otherwise, it's the sum of the elements before its own, so the first is `identity`. `input` and `output` may be the same array.
+
+				// @DOCLINE The scan takes two passes: the first sums each block, the sums of the blocks before each block are then added up serially, and the second pass scans each block starting from that. If the little space needed for the sums of each block can't be allocated, `MUM_FAILED_ALLOCATE` is set and nothing is written.
+
+			// @DOCLINE ### Parallel partitioning
+
+				// @DOCLINE The function `mu_parallel_partition` moves the elements of an array that match a predicate before those that don't, defined below: @NLNT
+				MUDEF size_m mu_parallel_partition(muScheduler scheduler, void* base, size_m count, size_m size, muBool (*predicate)(const void* element, void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF size_m mu_parallel_partition_(mumResult* result, muScheduler scheduler, void* base, size_m count, size_m size, muBool (*predicate)(const void* element, void* args), void* args);
+				// @DOCLINE The amount of elements that matched is returned. The partition is stable: both the elements that matched and those that didn't keep their order. `predicate` is called once per element. It needs a second array as big as `base`; if that can't be allocated, `MUM_FAILED_ALLOCATE` is set, 0 is returned and the array is left untouched.
+
+			// @DOCLINE ### Parallel transform-reduce
+
+				// @DOCLINE The function `mu_parallel_transform_reduce` transforms each element of an array, and sums up the results, defined below: @NLNT
+				MUDEF void mu_parallel_transform_reduce(muScheduler scheduler, const void* input, size_m count, size_m size, void* output, size_m output_size, const void* identity, void (*transform)(void* value, const void* element, void* args), void (*reduce)(void* accumulator, const void* value, void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_parallel_transform_reduce_(mumResult* result, muScheduler scheduler, const void* input, size_m count, size_m size, void* output, size_m output_size, const void* identity, void (*transform)(void* value, const void* element, void* args), void (*reduce)(void* accumulator, const void* value, void* args), void* args);
+				// @DOCLINE `transform` writes the transformed value of `element`, which is `output_size` bytes, to `value`. The values are summed with `reduce` starting from `identity`, like with `mu_parallel_scan`, and the sum is written to `output`. Blocks are summed in order, so `reduce` needs to be associative, but not commutative. If the space for the sums of each block can't be allocated, `MUM_FAILED_ALLOCATE` is set and nothing is written.
+
+		// @DOCLINE ## Work-stealing deque functions
+
+			// @DOCLINE A work-stealing deque holds pointers for one owner thread, which pushes and pops them at the bottom like a stack, while any other thread can steal them from the top. Neither end uses locks: the owner's operations are plain loads and stores except when taking the very last item, and stealing is a single compare-and-swap. The deque grows as needed; only the owner ever resizes it.
+
+			// @DOCLINE Items can be any non-zero pointer, as 0 is returned to mean that nothing was taken.
+
+			// @DOCLINE ### Work-stealing deque creation and destruction
+
+				// @DOCLINE The function `mu_ws_deque_create` creates an empty work-stealing deque, defined below: @NLNT
+				MUDEF muWSDeque mu_ws_deque_create(size_m capacity);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muWSDeque mu_ws_deque_create_(mumResult* result, size_m capacity);
+				// @DOCLINE `capacity` is how many items the deque can initially hold, rounded up to a power of 2; if it's 0, a default of 64 is used.
+
+				// @DOCLINE The function `mu_ws_deque_destroy` destroys a work-stealing deque, defined below: @NLNT
+				MUDEF muWSDeque mu_ws_deque_destroy(muWSDeque deque);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muWSDeque mu_ws_deque_destroy_(mumResult* result, muWSDeque deque);
+				// @DOCLINE No other thread may be using the deque when it's destroyed. Items still in it are dropped.
+
+			// @DOCLINE ### Owner operations
+
+				// @DOCLINE The function `mu_ws_deque_push` pushes an item onto the bottom of a work-stealing deque, defined below: @NLNT
+				MUDEF void mu_ws_deque_push(muWSDeque deque, void* item);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_ws_deque_push_(mumResult* result, muWSDeque deque, void* item);
+				// @DOCLINE If the deque is full, it's grown to twice its size; if that fails, `MUM_FAILED_ALLOCATE` is set and the item isn't pushed.
+
+				// @DOCLINE The function `mu_ws_deque_pop` pops the item at the bottom of a work-stealing deque, defined below: @NLNT
+				MUDEF void* mu_ws_deque_pop(muWSDeque deque);
+				// @DOCLINE 0 is returned if the deque is empty. Only the deque's owner may push and pop, and the owner is whichever single thread does so.
+
+			// @DOCLINE ### Stealing
+
+				// @DOCLINE The function `mu_ws_deque_steal` steals the item at the top of a work-stealing deque, defined below: @NLNT
+				MUDEF void* mu_ws_deque_steal(muWSDeque deque);
+				// @DOCLINE 0 is returned if the deque is empty, or if another thread took the item first; either way, a thief would usually move on to another deque.
+
+				// @DOCLINE The function `mu_ws_deque_steal_half` steals about half of the items of a work-stealing deque at once, defined below: @NLNT
+				MUDEF size_m mu_ws_deque_steal_half(muWSDeque deque, void** items, size_m max_count);
+				// @DOCLINE Up to `max_count` items are written to `items`, oldest first, and the amount stolen is returned. Taking half at once means that a thief, and the deque it steals from, need stealing from again far less often. Each item is still claimed with its own compare-and-swap, since claiming several at once could take the same items that the owner is popping without synchronizing; fewer items may be stolen than asked for if another thread gets in the way.
+
+				// @DOCLINE The function `mu_ws_deque_size` returns roughly how many items a work-stealing deque holds, defined below: @NLNT
+				MUDEF size_m mu_ws_deque_size(muWSDeque deque);
+				// @DOCLINE The size may be out of date by the time it's returned if other threads are using the deque.
+
+		// @DOCLINE ## Channel functions
+
+			// @DOCLINE A channel passes values of a fixed size from any amount of sending threads to any amount of receiving threads, in the style of Go's channels. A buffered channel holds up to its capacity of values; sends only block whilst it's full, and receives whilst it's empty. An unbuffered channel holds none, so a send blocks until a receiver takes the value, and vice versa. An unbounded channel holds any amount of values, so sends never block.
+
+			// @DOCLINE The buffer is a lock-free ring (or, for an unbounded channel, a lock-free list of segments of 31 values, allocated as it grows and freed as it's drained), so sending into a channel that has room, or receiving from one that has values, takes no locks. Threads that do block are queued on the channel and sleep until another thread completes their operation for them: a sender that finds a receiver waiting copies its value straight to where the receiver asked for it, and a receiver that finds a sender waiting copies the sender's value straight from it, so neither goes through the buffer.
+
+			// @DOCLINE Once a channel is closed, no more values can be sent on it, but values still in its buffer can be received.
+
+			// @DOCLINE ### Channel creation and destruction
+
+				// @DOCLINE The function `mu_chan_create` creates a channel, defined below: @NLNT
+				MUDEF muChan mu_chan_create(size_m element_size, size_m capacity);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muChan mu_chan_create_(mumResult* result, size_m element_size, size_m capacity);
+				// @DOCLINE `element_size` is the size of each value in bytes, and can be 0 for channels that are only used to signal. `capacity` is how many values the channel can hold; if it's 0, the channel is unbuffered, and if it's `MUM_CHAN_UNBOUNDED`, defined below, the channel is unbounded. @NLNT
+				#define MUM_CHAN_UNBOUNDED MU_SIZE_MAX
+				// @DOCLINE If a segment for an unbounded channel can't be allocated, the send that needed it is treated as though the channel were full.
+
+				// @DOCLINE The function `mu_chan_destroy` destroys a channel, defined below: @NLNT
+				MUDEF muChan mu_chan_destroy(muChan chan);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muChan mu_chan_destroy_(mumResult* result, muChan chan);
+				// @DOCLINE No thread may be using the channel when it's destroyed. Values still in it are dropped.
+
+			// @DOCLINE ### Sending
+
+				// @DOCLINE The function `mu_chan_send` sends a value on a channel, blocking until it's been taken into the buffer or by a receiver, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_send(muChan chan, const void* value);
+				// @DOCLINE `MUM_CHAN_OK` is returned once the value is sent, and `MUM_CHAN_CLOSED` if the channel is or gets closed first, in which case the value isn't sent. The value is copied from `value`, which must stay untouched until the function returns.
+
+				// @DOCLINE The function `mu_chan_try_send` sends a value on a channel if it can do so without blocking, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_try_send(muChan chan, const void* value);
+				// @DOCLINE `MUM_CHAN_WOULD_BLOCK` is returned if the buffer is full, or if the channel is unbuffered and no receiver is waiting.
+
+				// @DOCLINE The function `mu_chan_send_timed` sends a value on a channel, blocking for at most a given amount of time, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_send_timed(muChan chan, const void* value, int32_m timeout_ms);
+				// @DOCLINE `MUM_CHAN_TIMEOUT` is returned if the value couldn't be sent within `timeout_ms` milliseconds. A timeout of -1 waits forever, like `mu_chan_send`, and 0 doesn't wait, like `mu_chan_try_send`.
+
+			// @DOCLINE ### Receiving
+
+				// @DOCLINE The function `mu_chan_recv` receives a value from a channel, blocking until there is one, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_recv(muChan chan, void* value);
+				// @DOCLINE The value is written to `value`, unless `value` is 0, in which case it's thrown away. `MUM_CHAN_OK` is returned once a value is received, and `MUM_CHAN_CLOSED` if the channel is closed and has no values left in it.
+
+				// @DOCLINE The function `mu_chan_try_recv` receives a value from a channel if it can do so without blocking, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_try_recv(muChan chan, void* value);
+				// @DOCLINE `MUM_CHAN_WOULD_BLOCK` is returned if the buffer is empty, and, if the channel is unbuffered, no sender is waiting.
+
+				// @DOCLINE The function `mu_chan_recv_timed` receives a value from a channel, blocking for at most a given amount of time, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_recv_timed(muChan chan, void* value, int32_m timeout_ms);
+				// @DOCLINE `MUM_CHAN_TIMEOUT` is returned if no value could be received within `timeout_ms` milliseconds, which works like it does for `mu_chan_send_timed`.
+
+			// @DOCLINE ### Closing
+
+				// @DOCLINE The function `mu_chan_close` closes a channel, defined below: @NLNT
+				MUDEF void mu_chan_close(muChan chan);
+				// @DOCLINE Every blocked sender returns `MUM_CHAN_CLOSED`, and so does every blocked receiver once the buffer is empty. Closing a channel that's already closed does nothing.
+
+			// @DOCLINE ### Stopping
+
+				// @DOCLINE If a stop is requested for a thread blocked in a send, receive or select (see `mu_thread_request_stop`), it stops waiting and `MUM_CHAN_STOPPED` is returned, and nothing is sent or received. A thread whose stop has been requested gets `MUM_CHAN_STOPPED` whenever one of these functions would block, but can still send and receive without blocking.
+
+			// @DOCLINE ### Selecting
+
+				// @DOCLINE The struct `muChanCase` describes one of the operations that `mu_chan_select` picks between, defined below: @NLNT
+				typedef struct muChanCase {
+					// @DOCLINE `chan`: the channel to send on or receive from.
+					muChan chan;
+					// @DOCLINE `value`: the value to send, or where to write the value received (which may be 0).
+					void* value;
+					// @DOCLINE `send`: `MU_TRUE` to send, `MU_FALSE` to receive.
+					muBool send;
+				} muChanCase;
+
+				// @DOCLINE The function `mu_chan_select` waits until one of several sends and receives can be done, and does only that one, defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_select(muChanCase* cases, size_m case_count, int32_m timeout_ms, size_m* index);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF mumChanStatus mu_chan_select_(mumResult* result, muChanCase* cases, size_m case_count, int32_m timeout_ms, size_m* index);
+				// @DOCLINE The index of the case that was done is written to `index`, and its status is returned: `MUM_CHAN_OK`, or `MUM_CHAN_CLOSED` if its channel was closed, which counts as being able to be done. If none can be done within `timeout_ms` milliseconds, `MUM_CHAN_TIMEOUT` is returned, or `MUM_CHAN_WOULD_BLOCK` if `timeout_ms` was 0; -1 waits forever. If several cases can be done at once, one is picked at random, so that none of them is starved. The same channel can appear in several cases. If `case_count` is 0, `MUM_CHAN_WOULD_BLOCK` is returned.
+
+				// @DOCLINE Up to 8 cases are kept track of on the stack; if there are more, and space for them can't be allocated, `MUM_FAILED_ALLOCATE` is set and `MUM_CHAN_WOULD_BLOCK` is returned.
+
+			// @DOCLINE ### Channel idle strategy
+
+				// @DOCLINE The function `mu_chan_set_idle` attaches an idle strategy to a channel, defined below: @NLNT
+				MUDEF void mu_chan_set_idle(muChan chan, muIdleStrategy strategy);
+				// @DOCLINE A thread blocked on a channel goes to sleep straight away by default; with a strategy attached, it waits for its operation to be completed in the way the strategy says instead. A select combines the strategies of its cases' channels: it goes to sleep straight away if any of them has no strategy or one that parks straight away, and otherwise waits in the way of the strategy with the shortest spin phase. It can be changed at any time, and 0 goes back to the default; the strategy must outlive its use by the channel.
+
+		// @DOCLINE ## Shard executor functions
+
+			// @DOCLINE A shard executor is made for thread-per-core designs in which no data is shared: it runs one thread per chosen CPU, bound to it, and each of these threads (a shard) runs a loop of its own, running tasks sent to it. A shard owns whatever data the user assigns it, and other shards work on that data by sending tasks to the shard rather than by taking locks.
+
+			// @DOCLINE Every pair of shards has its own single-producer single-consumer ring, so that sending a task from one shard to another involves no atomic read-modify-write operations and no other shard. Tasks sent by a task aren't made visible to their shards one by one, but all at once, after the sending shard has finished its current batch of tasks, at which point each receiving shard is woken up at most once ("rung") if it's asleep. Tasks sent from threads other than the executor's shards, or sent whilst the ring to a shard is full, go through a lock-free list per shard instead, which allocates. A shard with nothing to do sleeps.
+
+			// @DOCLINE ### Shard executor creation and destruction
+
+				// @DOCLINE The function `mu_shard_executor_create` creates a shard executor, defined below: @NLNT
+				MUDEF muShardExecutor mu_shard_executor_create(const uint32_m* cpus, uint32_m shard_count, uint32_m ring_size);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muShardExecutor mu_shard_executor_create_(mumResult* result, const uint32_m* cpus, uint32_m shard_count, uint32_m ring_size);
+				// @DOCLINE Shard `i` is bound to CPU `cpus[i]` (see the topology functions); if `cpus` is 0, shard `i` is bound to CPU `i`, and if `shard_count` is also 0, one shard is created per CPU. `ring_size` is how many tasks each ring between two shards can hold, rounded up to a power of 2; if it's 0, a default of 1024 is used. If binding threads isn't supported, the shards run unbound. If a CPU is out of range, `MUM_INVALID_INDEX` is set, and if a shard's thread can't be created, its error is set; either way, the executor isn't created.
+
+				// @DOCLINE The function `mu_shard_executor_destroy` destroys a shard executor, defined below: @NLNT
+				MUDEF muShardExecutor mu_shard_executor_destroy(muShardExecutor executor);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF muShardExecutor mu_shard_executor_destroy_(mumResult* result, muShardExecutor executor);
+				// @DOCLINE Every task already sent, along with any task they send in turn, is run before the shards are stopped. It must not be called from within a shard.
+
+			// @DOCLINE ### Sending tasks
+
+				// @DOCLINE The function `mu_shard_submit` sends a task to a shard, to be run on its thread, defined below: @NLNT
+				MUDEF void mu_shard_submit(muShardExecutor executor, uint32_m shard, void (*task)(void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_shard_submit_(mumResult* result, muShardExecutor executor, uint32_m shard, void (*task)(void* args), void* args);
+				// @DOCLINE Tasks sent by one shard to another are run in the order they were sent, unless the ring between them was full for some of them. If `shard` is out of range, `MUM_INVALID_INDEX` is set; if the task has to go through a shard's list and can't be allocated, `MUM_FAILED_ALLOCATE` is set. Either way, the task isn't sent.
+
+				// @DOCLINE The function `mu_shard_executor_wait` waits until every task sent to the shards of a shard executor has been run, defined below: @NLNT
+				MUDEF void mu_shard_executor_wait(muShardExecutor executor);
+				// @DOCLINE This includes any task that they send in turn. It must not be called from within a shard.
+
+				// @DOCLINE The function `mu_shard_current` returns the index of the shard that the calling thread is, defined below: @NLNT
+				MUDEF uint32_m mu_shard_current(muShardExecutor executor);
+				// @DOCLINE If the calling thread isn't one of the executor's shards, `0xFFFFFFFF` is returned.
+
+			// @DOCLINE ### Shard idle strategy
+
+				// @DOCLINE The function `mu_shard_executor_set_idle` attaches an idle strategy to the shards of a shard executor, defined below: @NLNT
+				MUDEF void mu_shard_executor_set_idle(muShardExecutor executor, muIdleStrategy strategy);
+				// @DOCLINE A shard with nothing to do goes to sleep straight away by default; with a strategy attached, it keeps polling its rings and list whilst spinning or yielding, and only goes to sleep once the strategy parks. It can be changed at any time, and 0 goes back to the default; the strategy must outlive its use by the executor.
+
+		// @DOCLINE ## RCU functions
+
+			// @DOCLINE RCU ([read-copy-update](https://en.wikipedia.org/wiki/Read-copy-update)) lets data that's read far more often than it's changed be read without locks. Readers mark the sections in which they use published data; a writer publishes a new version of the data (with `mu_rcu_assign_pointer`), and then waits for a grace period, after which no reader can still be using the old version, so it can be freed. Grace periods are global, not tied to any object.
+
+			// @DOCLINE Entering and leaving a read section only touches a counter of the calling thread's own, and on Windows and on Linux with `membarrier` (Linux 4.14 and later), no memory fence is needed either, as the writer makes every thread execute a fence when waiting for a grace period instead. Elsewhere, readers execute a fence when entering and leaving.
+
+			// @DOCLINE ### Read sections
+
+				// @DOCLINE The function `mu_rcu_read_lock` enters a read section, defined below: @NLNT
+				MUDEF void mu_rcu_read_lock(void);
+
+				// @DOCLINE The function `mu_rcu_read_unlock` leaves a read section, defined below: @NLNT
+				MUDEF void mu_rcu_read_unlock(void);
+				// @DOCLINE Read sections can be nested. A reader must not block on anything that waits for a grace period while inside a read section.
+
+			// @DOCLINE ### Grace periods
+
+				// @DOCLINE The function `mu_rcu_synchronize` waits for a grace period, defined below: @NLNT
+				MUDEF void mu_rcu_synchronize(void);
+				// @DOCLINE Once it returns, every read section that was active when it was called has been left. It must not be called from within a read section.
+
+				// @DOCLINE The function `mu_rcu_call` calls a function once a grace period has passed, without waiting for it, defined below: @NLNT
+				MUDEF void mu_rcu_call(void (*callback)(void* args), void* args);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_rcu_call_(mumResult* result, void (*callback)(void* args), void* args);
+				// @DOCLINE Callbacks are run in batches on a background thread, which is started on the first call, and which waits for one grace period for each batch. It can be called from within a read section.
+
+				// @DOCLINE The function `mu_rcu_free` frees memory allocated with `mu_malloc` once a grace period has passed, defined below: @NLNT
+				MUDEF void mu_rcu_free(void* ptr);
+				// @DOCLINE Its explicit result checking equivalent is defined below: @NLNT
+				MUDEF void mu_rcu_free_(mumResult* result, void* ptr);
+				// @DOCLINE This is the same as calling `mu_rcu_call` with a callback that calls `mu_free`.
+
+				// @DOCLINE The function `mu_rcu_barrier` waits until every callback given to `mu_rcu_call` before it was called has run, defined below: @NLNT
+				MUDEF void mu_rcu_barrier(void);
+				// @DOCLINE It must not be called from within a read section or a callback.
+
+	#ifdef __cplusplus
+	}
+	#endif
+
+	// @DOCLINE # C++ interface
+
+		// @DOCLINE When compiled as C++11 or later, mum also defines a thin C++ layer over its C functions in the namespace `mum`, unless `MUM_NO_CPP` is defined. Everything in it is inline and non-virtual, and each object holds nothing but the C handle it wraps, so it costs nothing over calling the C functions by hand. Errors are reported through the global result, the same as the C functions without an underscore.
+
+		// @DOCLINE ## Locks
+
+			// @DOCLINE `mum::basic_lock<Policy>` owns a lock, creating it when constructed and destroying it when destroyed; it can be moved, but not copied, and has the member functions `lock`, `unlock`, and `native_handle`, which returns the C handle. The policy decides at compile time which kind of lock it is, and is a struct with a `handle_type` and the static functions `create`, `destroy`, `lock` and `unlock`; the following policies and lock types are defined:
+
+			// @DOCLINE * `mum::mutex_policy`, used by `mum::mutex`, a `muMutex`.
+			// @DOCLINE * `mum::spinlock_policy`, used by `mum::spinlock`, a `muSpinlock`.
+			// @DOCLINE * `mum::adaptive_lock_policy`, used by `mum::adaptive_lock`, a `muAdaptiveLock`.
+			// @DOCLINE * `mum::cohort_lock_policy`, used by `mum::cohort_lock`, a `muCohortLock`, which can be constructed with a handoff limit.
+
+			// @DOCLINE `mum::lock_guard<Lock>` locks a lock when constructed and unlocks it when destroyed, unless constructed with `mum::adopt_lock`, in which case the lock must already be locked. `mum::unique_lock<Lock>` does the same, but can also be constructed with `mum::defer_lock` to not lock it yet, be moved, and be locked and unlocked again with `lock` and `unlock`; `owns_lock` returns whether it's currently locked by it, and `release` lets go of the lock without unlocking it. Both work with any type that has `lock` and `unlock` member functions.
+
+		// @DOCLINE ## Threads
+
+			// @DOCLINE `mum::thread` owns a thread, and can be moved, but not copied. It's constructed with anything callable with no arguments, such as a lambda; the callable is moved onto the new thread's own stack before the constructor returns, so it's never heap-allocated, however large it is. Its member functions are `joinable`, `join`, `request_stop`, `get_stop_token`, and `native_handle`. Destroying or assigning over a joinable thread requests it to stop and waits on it, like `mu_thread_destroy_mode` with `MUM_THREAD_DESTROY_JOIN`.
+
+	#if defined(__cplusplus) && (__cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)) && !defined(MUM_NO_CPP)
+
+		#include <type_traits>
+		#include <utility>
+
+		extern "C" {
+			// Hands a thread's start arguments over to it; the creator waits until the new thread
+			// signals that it has taken them
+			MUDEF void mum_handoff_wait(uint32_m* flag);
+			MUDEF void mum_handoff_signal(uint32_m* flag);
+		}
+
+		namespace mum {
+
+			/* Locks */
+
+				struct mutex_policy {
+					typedef muMutex handle_type;
+					static handle_type create() { return mu_mutex_create(); }
+					static handle_type destroy(handle_type lock) { return mu_mutex_destroy(lock); }
+					static void lock(handle_type lock) { mu_mutex_lock(lock); }
+					static void unlock(handle_type lock) { mu_mutex_unlock(lock); }
+				};
+
+				struct spinlock_policy {
+					typedef muSpinlock handle_type;
+					static handle_type create() { return mu_spinlock_create(); }
+					static handle_type destroy(handle_type lock) { return mu_spinlock_destroy(lock); }
+					static void lock(handle_type lock) { mu_spinlock_lock(lock); }
+					static void unlock(handle_type lock) { mu_spinlock_unlock(lock); }
+				};
+
+				struct adaptive_lock_policy {
+					typedef muAdaptiveLock handle_type;
+					static handle_type create() { return mu_adaptive_lock_create(); }
+					static handle_type destroy(handle_type lock) { return mu_adaptive_lock_destroy(lock); }
+					static void lock(handle_type lock) { mu_adaptive_lock_lock(lock); }
+					static void unlock(handle_type lock) { mu_adaptive_lock_unlock(lock); }
+				};
+
+				struct cohort_lock_policy {
+					typedef muCohortLock handle_type;
+					static handle_type create(uint32_m handoff_limit = 0) { return mu_cohort_lock_create(handoff_limit); }
+					static handle_type destroy(handle_type lock) { return mu_cohort_lock_destroy(lock); }
+					static void lock(handle_type lock) { mu_cohort_lock_lock(lock); }
+					static void unlock(handle_type lock) { mu_cohort_lock_unlock(lock); }
+				};
+
+				template <class Policy>
+				class basic_lock {
+					public:
+						typedef typename Policy::handle_type handle_type;
+
+						basic_lock() : handle_(Policy::create()) {}
+						// Only usable with policies whose create takes a parameter
+						explicit basic_lock(uint32_m parameter) : handle_(Policy::create(parameter)) {}
+						~basic_lock() {
+							if (handle_) {
+								Policy::destroy(handle_);
+							}
+						}
+
+						basic_lock(const basic_lock&) = delete;
+						basic_lock& operator=(const basic_lock&) = delete;
+						basic_lock(basic_lock&& other) noexcept : handle_(other.handle_) {
+							other.handle_ = 0;
+						}
+						basic_lock& operator=(basic_lock&& other) noexcept {
+							if (this != &other) {
+								if (handle_) {
+									Policy::destroy(handle_);
+								}
+								handle_ = other.handle_;
+								other.handle_ = 0;
+							}
+							return *this;
+						}
+
+						void lock() { Policy::lock(handle_); }
+						void unlock() { Policy::unlock(handle_); }
+						handle_type native_handle() const { return handle_; }
+						explicit operator bool() const { return handle_ != 0; }
+
+					private:
+						handle_type handle_;
+				};
+
+				typedef basic_lock<mutex_policy> mutex;
+				typedef basic_lock<spinlock_policy> spinlock;
+				typedef basic_lock<adaptive_lock_policy> adaptive_lock;
+				typedef basic_lock<cohort_lock_policy> cohort_lock;
+
+			/* Lock guards */
+
+				struct defer_lock_t { explicit defer_lock_t() = default; };
+				struct adopt_lock_t { explicit adopt_lock_t() = default; };
+				static const defer_lock_t defer_lock = defer_lock_t();
+				static const adopt_lock_t adopt_lock = adopt_lock_t();
+
+				template <class Lock>
+				class lock_guard {
+					public:
+						explicit lock_guard(Lock& lock) : lock_(lock) {
+							lock_.lock();
+						}
+						lock_guard(Lock& lock, adopt_lock_t) : lock_(lock) {}
+						~lock_guard() {
+							lock_.unlock();
+						}
+
+						lock_guard(const lock_guard&) = delete;
+						lock_guard& operator=(const lock_guard&) = delete;
+
+					private:
+						Lock& lock_;
+				};
+
+				template <class Lock>
+				class unique_lock {
+					public:
+						unique_lock() noexcept : lock_(0), owns_(false) {}
+						explicit unique_lock(Lock& lock) : lock_(&lock), owns_(false) {
+							this->lock();
+						}
+						unique_lock(Lock& lock, defer_lock_t) noexcept : lock_(&lock), owns_(false) {}
+						unique_lock(Lock& lock, adopt_lock_t) noexcept : lock_(&lock), owns_(true) {}
+						~unique_lock() {
+							if (owns_) {
+								lock_->unlock();
+							}
+						}
+
+						unique_lock(const unique_lock&) = delete;
+						unique_lock& operator=(const unique_lock&) = delete;
+						unique_lock(unique_lock&& other) noexcept : lock_(other.lock_), owns_(other.owns_) {
+							other.lock_ = 0;
+							other.owns_ = false;
+						}
+						unique_lock& operator=(unique_lock&& other) noexcept {
+							if (this != &other) {
+								if (owns_) {
+									lock_->unlock();
+								}
+								lock_ = other.lock_;
+								owns_ = other.owns_;
+								other.lock_ = 0;
+								other.owns_ = false;
+							}
+							return *this;
+						}
+
+						void lock() {
+							lock_->lock();
+							owns_ = true;
+						}
+						void unlock() {
+							lock_->unlock();
+							owns_ = false;
+						}
+						Lock* release() noexcept {
+							Lock* lock = lock_;
+							lock_ = 0;
+							owns_ = false;
+							return lock;
+						}
+
+						bool owns_lock() const noexcept { return owns_; }
+						explicit operator bool() const noexcept { return owns_; }
+						Lock* mutex() const noexcept { return lock_; }
+
+					private:
+						Lock* lock_;
+						bool owns_;
+				};
+
+			/* Threads */
+
+				class thread {
+					public:
+						thread() noexcept : handle_(0) {}
+
+						template <class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, thread>::value>::type>
+						explicit thread(F&& f) : handle_(0) {
+							typedef typename std::decay<F>::type closure_type;
+							closure_type closure(std::forward<F>(f));
+							handoff<closure_type> h = { &closure, 0 };
+							handle_ = mu_thread_create(&thread::start<closure_type>, &h);
+							if (handle_) {
+								mum_handoff_wait(&h.taken);
+							}
+						}
+
+						~thread() {
+							reset();
+						}
+
+						thread(const thread&) = delete;
+						thread& operator=(const thread&) = delete;
+						thread(thread&& other) noexcept : handle_(other.handle_) {
+							other.handle_ = 0;
+						}
+						thread& operator=(thread&& other) noexcept {
+							if (this != &other) {
+								reset();
+								handle_ = other.handle_;
+								other.handle_ = 0;
+							}
+							return *this;
+						}
+
+						bool joinable() const noexcept { return handle_ != 0; }
+						void join() {
+							mu_thread_wait(handle_);
+							handle_ = mu_thread_destroy(handle_);
+						}
+						void request_stop() { mu_thread_request_stop(handle_); }
+						muStopToken get_stop_token() const { return mu_thread_get_stop_token(handle_); }
+						muThread native_handle() const noexcept { return handle_; }
+
+					private:
+						template <class Closure>
+						struct handoff {
+							Closure* closure;
+							uint32_m taken;
+						};
+
+						// Runs on the new thread; the creator's closure is only valid until taken
+						template <class Closure>
+						static void start(void* args) {
+							handoff<Closure>* h = static_cast<handoff<Closure>*>(args);
+							Closure closure(std::move(*h->closure));
+							mum_handoff_signal(&h->taken);
+							closure();
+						}
+
+						void reset() {
+							if (handle_) {
+								handle_ = mu_thread_destroy_mode(handle_, MUM_THREAD_DESTROY_JOIN);
+							}
+						}
+
+						muThread handle_;
+				};
+
+		}
+
+	#endif
+
+#endif /* MUM_H */
+
+#ifdef MUM_IMPLEMENTATION
+
+	#ifdef __cplusplus
+	extern "C" { // }
+	#endif
+
+	/* Thread-local storage */
+
+		#ifndef MUM_THREAD_LOCAL
+			#if defined(__cplusplus) && __cplusplus >= 201103L
+				#define MUM_THREAD_LOCAL thread_local
+			#elif defined(_MSC_VER)
+				#define MUM_THREAD_LOCAL __declspec(thread)
+			#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+				#define MUM_THREAD_LOCAL _Thread_local
+			#else
+				#define MUM_THREAD_LOCAL __thread
+			#endif
+		#endif
+
+	/* Global functions */
+
+		mumResult* mum_global_res = 0;
+		MUDEF void mum_global_result(mumResult* result) {
+			mum_global_res = result;
+		}
+
+		// Stop flag handed out as the stop token of threads not created by mum; never set
+		static uint32_m mum_null_stop = 0;
+
+		#define MUM_NO_TIMEOUT (~(uint64_m)0)
+
+		/* Names */
+
+			#ifdef MUM_NAMES
+				MUDEF const char* mum_result_get_name(mumResult result) {
+					switch (result) {
+						default: return "MUM_UNKNOWN"; break;
+						case MUM_SUCCESS: return "MUM_SUCCESS"; break;
+						case MUM_FAILED_ALLOCATE: return "MUM_FAILED_ALLOCATE"; break;
+						case MUM_FAILED_CREATE_THREAD: return "MUM_FAILED_CREATE_THREAD"; break;
+						case MUM_FAILED_CLOSE_HANDLE: return "MUM_FAILED_CLOSE_HANDLE"; break;
+						case MUM_FAILED_GET_EXIT_CODE_THREAD: return "MUM_FAILED_GET_EXIT_CODE_THREAD"; break;
+						case MUM_THREAD_WAIT_TIMEOUT: return "MUM_THREAD_WAIT_TIMEOUT"; break;
+						case MUM_THREAD_WAIT_FAILED: return "MUM_THREAD_WAIT_FAILED"; break;
+						case MUM_FAILED_CREATE_MUTEX: return "MUM_FAILED_CREATE_MUTEX"; break;
+						case MUM_MUTEX_WAIT_FAILED: return "MUM_MUTEX_WAIT_FAILED"; break;
+						case MUM_MUTEX_WAIT_ABANDONED: return "MUM_MUTEX_WAIT_ABANDONED"; break;
+						case MUM_FAILED_RELEASE_MUTEX: return "MUM_FAILED_RELEASE_MUTEX"; break;
+						case MUM_FAILED_PTHREAD_CREATE: return "MUM_FAILED_PTHREAD_CREATE"; break;
+						case MUM_FAILED_PTHREAD_CANCEL: return "MUM_FAILED_PTHREAD_CANCEL"; break;
+						case MUM_FAILED_PTHREAD_JOIN: return "MUM_FAILED_PTHREAD_JOIN"; break;
+						case MUM_FAILED_PTHREAD_MUTEX_INIT: return "MUM_FAILED_PTHREAD_MUTEX_INIT"; break;
+						case MUM_FAILED_PTHREAD_MUTEX_DESTROY: return "MUM_FAILED_PTHREAD_MUTEX_DESTROY"; break;
+						case MUM_FAILED_PTHREAD_MUTEX_LOCK: return "MUM_FAILED_PTHREAD_MUTEX_LOCK"; break;
+						case MUM_FAILED_PTHREAD_MUTEX_UNLOCK: return "MUM_FAILED_PTHREAD_MUTEX_UNLOCK"; break;
+						case MUM_FAILED_PTHREAD_DETACH: return "MUM_FAILED_PTHREAD_DETACH"; break;
+						case MUM_FAILED_PTHREAD_SETAFFINITY: return "MUM_FAILED_PTHREAD_SETAFFINITY"; break;
+						case MUM_FAILED_EPOLL_CREATE: return "MUM_FAILED_EPOLL_CREATE"; break;
+						case MUM_FAILED_EVENTFD: return "MUM_FAILED_EVENTFD"; break;
+						case MUM_FAILED_EPOLL_CTL: return "MUM_FAILED_EPOLL_CTL"; break;
+						case MUM_FAILED_OPEN_FILE: return "MUM_FAILED_OPEN_FILE"; break;
+						case MUM_TRACE_DISABLED: return "MUM_TRACE_DISABLED"; break;
+						case MUM_INVALID_INDEX: return "MUM_INVALID_INDEX"; break;
+						case MUM_FAILED_SET_THREAD_GROUP_AFFINITY: return "MUM_FAILED_SET_THREAD_GROUP_AFFINITY"; break;
+						case MUM_EVENT_LOOP_UNSUPPORTED: return "MUM_EVENT_LOOP_UNSUPPORTED"; break;
+						case MUM_TASK_GRAPH_CYCLE: return "MUM_TASK_GRAPH_CYCLE"; break;
+						case MUM_TASK_GRAPH_INVALID_NODE: return "MUM_TASK_GRAPH_INVALID_NODE"; break;
+						case MUM_STOP_REQUESTED: return "MUM_STOP_REQUESTED"; break;
+					}
+				}
+			#endif
+
+		/* Repetitious functions */
+
+			MUDEF muThread mu_thread_create(void (*start)(void* args), void* args) {
+				return mu_thread_create_(mum_global_res, start, args);
+			}
+			MUDEF muThread mu_thread_destroy(muThread thread) {
+				return mu_thread_destroy_(mum_global_res, thread);
+			}
+			MUDEF muThread mu_thread_destroy_mode(muThread thread, mumThreadDestroyMode mode) {
+				return mu_thread_destroy_mode_(mum_global_res, thread, mode);
+			}
+			MUDEF void mu_thread_request_stop(muThread thread) {
+				mu_thread_request_stop_(mum_global_res, thread);
+			}
+			MUDEF void mu_thread_wait(muThread thread) {
+				mu_thread_wait_(mum_global_res, thread);
+			}
+			MUDEF void* mu_thread_get_return_value(muThread thread) {
+				return mu_thread_get_return_value_(mum_global_res, thread);
+			}
+			MUDEF muThreadGroup mu_thread_create_many(size_m count, void (*start)(void* args), void* const* args) {
+				return mu_thread_create_many_(mum_global_res, count, start, args);
+			}
+			MUDEF muThreadGroup mu_thread_destroy_many(muThreadGroup group, mumThreadDestroyMode mode) {
+				return mu_thread_destroy_many_(mum_global_res, group, mode);
+			}
+			MUDEF void mu_thread_wait_all(muThreadGroup group) {
+				mu_thread_wait_all_(mum_global_res, group);
+			}
+			MUDEF size_m mu_thread_wait_any(muThreadGroup group) {
+				return mu_thread_wait_any_(mum_global_res, group);
+			}
+			MUDEF muMutex mu_mutex_create(void) {
+				return mu_mutex_create_(mum_global_res);
+			}
+			MUDEF muMutex mu_mutex_destroy(muMutex mutex) {
+				return mu_mutex_destroy_(mum_global_res, mutex);
+			}
+			MUDEF void mu_mutex_lock(muMutex mutex) {
+				mu_mutex_lock_(mum_global_res, mutex);
+			}
+			MUDEF void mu_mutex_unlock(muMutex mutex) {
+				mu_mutex_unlock_(mum_global_res, mutex);
+			}
+			MUDEF muSpinlock mu_spinlock_create(void) {
+				return mu_spinlock_create_(mum_global_res);
+			}
+			MUDEF muSpinlock mu_spinlock_destroy(muSpinlock spinlock) {
+				return mu_spinlock_destroy_(mum_global_res, spinlock);
+			}
+			MUDEF void mu_spinlock_lock(muSpinlock spinlock) {
+				mu_spinlock_lock_(mum_global_res, spinlock);
+			}
+			MUDEF void mu_spinlock_unlock(muSpinlock spinlock) {
+				mu_spinlock_unlock_(mum_global_res, spinlock);
+			}
+			MUDEF muCohortLock mu_cohort_lock_create(uint32_m handoff_limit) {
+				return mu_cohort_lock_create_(mum_global_res, handoff_limit);
+			}
+			MUDEF muCohortLock mu_cohort_lock_destroy(muCohortLock lock) {
+				return mu_cohort_lock_destroy_(mum_global_res, lock);
+			}
+			MUDEF void mu_cohort_lock_lock(muCohortLock lock) {
+				mu_cohort_lock_lock_(mum_global_res, lock);
+			}
+			MUDEF void mu_cohort_lock_unlock(muCohortLock lock) {
+				mu_cohort_lock_unlock_(mum_global_res, lock);
+			}
+			MUDEF muAdaptiveLock mu_adaptive_lock_create(void) {
+				return mu_adaptive_lock_create_(mum_global_res);
+			}
+			MUDEF muAdaptiveLock mu_adaptive_lock_destroy(muAdaptiveLock lock) {
+				return mu_adaptive_lock_destroy_(mum_global_res, lock);
+			}
+			MUDEF void mu_adaptive_lock_lock(muAdaptiveLock lock) {
+				mu_adaptive_lock_lock_(mum_global_res, lock);
+			}
+			MUDEF void mu_adaptive_lock_unlock(muAdaptiveLock lock) {
+				mu_adaptive_lock_unlock_(mum_global_res, lock);
+			}
+			MUDEF muCombiner mu_combiner_create(uint32_m batch_limit) {
+				return mu_combiner_create_(mum_global_res, batch_limit);
+			}
+			MUDEF muCombiner mu_combiner_destroy(muCombiner combiner) {
+				return mu_combiner_destroy_(mum_global_res, combiner);
+			}
+			MUDEF void mu_combiner_execute(muCombiner combiner, void (*operation)(void* args), void* args) {
+				mu_combiner_execute_(mum_global_res, combiner, operation, args);
+			}
+			MUDEF muCounter mu_counter_create(void) {
+				return mu_counter_create_(mum_global_res);
+			}
+			MUDEF muCounter mu_counter_destroy(muCounter counter) {
+				return mu_counter_destroy_(mum_global_res, counter);
+			}
+			MUDEF muAccumulator mu_accumulator_create(void) {
+				return mu_accumulator_create_(mum_global_res);
+			}
+			MUDEF muAccumulator mu_accumulator_destroy(muAccumulator accumulator) {
+				return mu_accumulator_destroy_(mum_global_res, accumulator);
+			}
+			MUDEF muHashMap mu_hash_map_create(size_m capacity) {
+				return mu_hash_map_create_(mum_global_res, capacity);
+			}
+			MUDEF muHashMap mu_hash_map_destroy(muHashMap map) {
+				return mu_hash_map_destroy_(mum_global_res, map);
+			}
+			MUDEF void mu_hash_map_put(muHashMap map, uint64_m key, void* value) {
+				mu_hash_map_put_(mum_global_res, map, key, value);
+			}
+			MUDEF muBool mu_hash_map_insert(muHashMap map, uint64_m key, void* value, void** existing) {
+				return mu_hash_map_insert_(mum_global_res, map, key, value, existing);
+			}
+			MUDEF void mu_trace_flush(const char* path) {
+				mu_trace_flush_(mum_global_res, path);
+			}
+			MUDEF muThread mu_thread_create_on_cpu(void (*start)(void* args), void* args, uint32_m cpu) {
+				return mu_thread_create_on_cpu_(mum_global_res, start, args, cpu);
+			}
+			MUDEF muThread mu_thread_create_on_node(void (*start)(void* args), void* args, uint32_m node) {
+				return mu_thread_create_on_node_(mum_global_res, start, args, node);
+			}
+			MUDEF muScheduler mu_scheduler_create(uint32_m worker_count, uint64_m aging_ns) {
+				return mu_scheduler_create_(mum_global_res, worker_count, aging_ns);
+			}
+			MUDEF muScheduler mu_scheduler_destroy(muScheduler scheduler) {
+				return mu_scheduler_destroy_(mum_global_res, scheduler);
+			}
+			MUDEF void mu_scheduler_submit(muScheduler scheduler, void (*task)(void* args), void* args, mumTaskPriority priority, uint64_m deadline_ns) {
+				mu_scheduler_submit_(mum_global_res, scheduler, task, args, priority, deadline_ns);
+			}
+			MUDEF void mu_scheduler_wait(muScheduler scheduler) {
+				mu_scheduler_wait_(mum_global_res, scheduler);
+			}
+			MUDEF void mu_scheduler_stats(muScheduler scheduler, mumTaskPriority priority, size_m* queued, uint64_m* completed, uint64_m* average_latency_ns, uint64_m* max_latency_ns) {
+				mu_scheduler_stats_(mum_global_res, scheduler, priority, queued, completed, average_latency_ns, max_latency_ns);
+			}
+			MUDEF muTimerWheel mu_timer_wheel_create(muScheduler scheduler, uint64_m tick_ns) {
+				return mu_timer_wheel_create_(mum_global_res, scheduler, tick_ns);
+			}
+			MUDEF muTimerWheel mu_timer_wheel_destroy(muTimerWheel wheel) {
+				return mu_timer_wheel_destroy_(mum_global_res, wheel);
+			}
+			MUDEF uint64_m mu_timer_schedule(muTimerWheel wheel, uint64_m delay_ns, uint64_m period_ns, void (*callback)(void* args), void* args, mumTaskPriority priority) {
+				return mu_timer_schedule_(mum_global_res, wheel, delay_ns, period_ns, callback, args, priority);
+			}
+			MUDEF muEventLoop mu_event_loop_create(muScheduler scheduler) {
+				return mu_event_loop_create_(mum_global_res, scheduler);
+			}
+			MUDEF muEventLoop mu_event_loop_destroy(muEventLoop loop) {
+				return mu_event_loop_destroy_(mum_global_res, loop);
+			}
+			MUDEF uint64_m mu_event_loop_add(muEventLoop loop, int fd, uint32_m events, void (*callback)(int fd, uint32_m events, void* args), void* args, mumTaskPriority priority) {
+				return mu_event_loop_add_(mum_global_res, loop, fd, events, callback, args, priority);
+			}
+			MUDEF void mu_event_loop_remove(muEventLoop loop, uint64_m source) {
+				mu_event_loop_remove_(mum_global_res, loop, source);
+			}
+			MUDEF muTaskGraph mu_task_graph_create(muScheduler scheduler) {
+				return mu_task_graph_create_(mum_global_res, scheduler);
+			}
+			MUDEF muTaskGraph mu_task_graph_destroy(muTaskGraph graph) {
+				return mu_task_graph_destroy_(mum_global_res, graph);
+			}
+			MUDEF uint32_m mu_task_graph_add_node(muTaskGraph graph, void (*task)(void* args), void* args, mumTaskPriority priority) {
+				return mu_task_graph_add_node_(mum_global_res, graph, task, args, priority);
+			}
+			MUDEF void mu_task_graph_add_edge(muTaskGraph graph, uint32_m from, uint32_m to) {
+				mu_task_graph_add_edge_(mum_global_res, graph, from, to);
+			}
+			MUDEF uint64_m mu_task_graph_run(muTaskGraph graph) {
+				return mu_task_graph_run_(mum_global_res, graph);
+			}
+			MUDEF muWSDeque mu_ws_deque_create(size_m capacity) {
+				return mu_ws_deque_create_(mum_global_res, capacity);
+			}
+			MUDEF muWSDeque mu_ws_deque_destroy(muWSDeque deque) {
+				return mu_ws_deque_destroy_(mum_global_res, deque);
+			}
+			MUDEF void mu_ws_deque_push(muWSDeque deque, void* item) {
+				mu_ws_deque_push_(mum_global_res, deque, item);
+			}
+			MUDEF void mu_rcu_call(void (*callback)(void* args), void* args) {
+				mu_rcu_call_(mum_global_res, callback, args);
+			}
+			MUDEF void mu_rcu_free(void* ptr) {
+				mu_rcu_free_(mum_global_res, ptr);
+			}
+			MUDEF muPool mu_pool_create(size_m object_size) {
+				return mu_pool_create_(mum_global_res, object_size);
+			}
+			MUDEF muPool mu_pool_destroy(muPool pool) {
+				return mu_pool_destroy_(mum_global_res, pool);
+			}
+			MUDEF void* mu_pool_alloc(muPool pool) {
+				return mu_pool_alloc_(mum_global_res, pool);
+			}
+			MUDEF muShardExecutor mu_shard_executor_create(const uint32_m* cpus, uint32_m shard_count, uint32_m ring_size) {
+				return mu_shard_executor_create_(mum_global_res, cpus, shard_count, ring_size);
+			}
+			MUDEF muShardExecutor mu_shard_executor_destroy(muShardExecutor executor) {
+				return mu_shard_executor_destroy_(mum_global_res, executor);
+			}
+			MUDEF void mu_shard_submit(muShardExecutor executor, uint32_m shard, void (*task)(void* args), void* args) {
+				mu_shard_submit_(mum_global_res, executor, shard, task, args);
+			}
+			MUDEF void mu_parallel_sort(muScheduler scheduler, void* base, size_m count, size_m size, int (*compare)(const void* a, const void* b, void* args), void* args) {
+				mu_parallel_sort_(mum_global_res, scheduler, base, count, size, compare, args);
+			}
+			MUDEF void mu_parallel_scan(muScheduler scheduler, const void* input, void* output, size_m count, size_m size, const void* identity, void (*reduce)(void* accumulator, const void* value, void* args), void* args, muBool inclusive) {
+				mu_parallel_scan_(mum_global_res, scheduler, input, output, count, size, identity, reduce, args, inclusive);
+			}
+			MUDEF size_m mu_parallel_partition(muScheduler scheduler, void* base, size_m count, size_m size, muBool (*predicate)(const void* element, void* args), void* args) {
+				return mu_parallel_partition_(mum_global_res, scheduler, base, count, size, predicate, args);
+			}
+			MUDEF void mu_parallel_transform_reduce(muScheduler scheduler, const void* input, size_m count, size_m size, void* output, size_m output_size, const void* identity, void (*transform)(void* value, const void* element, void* args), void (*reduce)(void* accumulator, const void* value, void* args), void* args) {
+				mu_parallel_transform_reduce_(mum_global_res, scheduler, input, count, size, output, output_size, identity, transform, reduce, args);
+			}
+			MUDEF muChan mu_chan_create(size_m element_size, size_m capacity) {
+				return mu_chan_create_(mum_global_res, element_size, capacity);
+			}
+			MUDEF muChan mu_chan_destroy(muChan chan) {
+				return mu_chan_destroy_(mum_global_res, chan);
+			}
+			MUDEF mumChanStatus mu_chan_select(muChanCase* cases, size_m case_count, int32_m timeout_ms, size_m* index) {
+				return mu_chan_select_(mum_global_res, cases, case_count, timeout_ms, index);
+			}
+			MUDEF muIdleStrategy mu_idle_strategy_create(mumIdleKind kind, uint64_m spin_ns, uint64_m park_ns) {
+				return mu_idle_strategy_create_(mum_global_res, kind, spin_ns, park_ns);
+			}
+			MUDEF muIdleStrategy mu_idle_strategy_destroy(muIdleStrategy strategy) {
+				return mu_idle_strategy_destroy_(mum_global_res, strategy);
+			}
+
+	/* Win32 primitives */
+
+	#ifdef MU_WIN32
+
+		#include <windows.h>
+
+		#ifdef _MSC_VER
+			#pragma comment(lib, "Synchronization.lib")
+		#endif
+
+		/* Atomics */
+
+			#define MUM_RELAXED 0
+			#define MUM_ACQUIRE 2
+			#define MUM_RELEASE 3
+			#define MUM_SEQ_CST 5
+
+			// x86 loads and stores are already acquire and release, so only the compiler needs to
+			// be kept from reordering around them
+			#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+				#include <intrin.h>
+				#define MUM_WIN32_FENCE() _ReadWriteBarrier()
+			#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+				#define MUM_WIN32_FENCE() __asm__ __volatile__("" ::: "memory")
+			#else
+				#define MUM_WIN32_FENCE() MemoryBarrier()
+			#endif
+
+			static inline uint32_m mum_atomic_load32(volatile uint32_m* ptr, int order) {
+				uint32_m value = *ptr;
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				return value;
+			}
+
+			static inline void mum_atomic_store32(volatile uint32_m* ptr, uint32_m value, int order) {
+				if (order == MUM_SEQ_CST) {
+					InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+					return;
+				}
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				*ptr = value;
+			}
+
+			static inline uint32_m mum_atomic_fetch_add32(volatile uint32_m* ptr, uint32_m value) {
+				return (uint32_m)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+			}
+
+			static inline uint32_m mum_atomic_fetch_sub32(volatile uint32_m* ptr, uint32_m value) {
+				return (uint32_m)InterlockedExchangeAdd((volatile LONG*)ptr, -(LONG)value);
+			}
+
+			static inline muBool mum_atomic_cas32(volatile uint32_m* ptr, uint32_m* expected, uint32_m desired) {
+				uint32_m previous = (uint32_m)InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)*expected);
+				if (previous == *expected) {
+					return MU_TRUE;
+				}
+				*expected = previous;
+				return MU_FALSE;
+			}
+
+			static inline uint32_m mum_atomic_exchange32(volatile uint32_m* ptr, uint32_m value) {
+				return (uint32_m)InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+			}
+
+			static inline uint64_m mum_atomic_load64(volatile uint64_m* ptr, int order) {
+				// A plain 64-bit read can tear on 32-bit targets
+				#ifdef _WIN64
+					uint64_m value = *ptr;
+					if (order != MUM_RELAXED) {
+						MUM_WIN32_FENCE();
+					}
+					return value;
+				#else
+					return (uint64_m)InterlockedCompareExchange64((volatile LONG64*)ptr, 0, 0);
+					if (order) {}
+				#endif
+			}
+
+			static inline void mum_atomic_store64(volatile uint64_m* ptr, uint64_m value, int order) {
+				// Likewise, a plain 64-bit write can tear on 32-bit targets
+				#ifdef _WIN64
+					if (order == MUM_SEQ_CST) {
+						InterlockedExchange64((volatile LONG64*)ptr, (LONG64)value);
+						return;
+					}
+					if (order != MUM_RELAXED) {
+						MUM_WIN32_FENCE();
+					}
+					*ptr = value;
+				#else
+					InterlockedExchange64((volatile LONG64*)ptr, (LONG64)value);
+					if (order) {}
+				#endif
+			}
+
+			static inline uint64_m mum_atomic_fetch_add64(volatile uint64_m* ptr, uint64_m value) {
+				return (uint64_m)InterlockedExchangeAdd64((volatile LONG64*)ptr, (LONG64)value);
+			}
+
+			static inline muBool mum_atomic_cas64(volatile uint64_m* ptr, uint64_m* expected, uint64_m desired) {
+				uint64_m previous = (uint64_m)InterlockedCompareExchange64((volatile LONG64*)ptr, (LONG64)desired, (LONG64)*expected);
+				if (previous == *expected) {
+					return MU_TRUE;
+				}
+				*expected = previous;
+				return MU_FALSE;
+			}
+
+			static inline uint8_m mum_atomic_load8(volatile uint8_m* ptr, int order) {
+				uint8_m value = *ptr;
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				return value;
+			}
+
+			static inline void mum_atomic_store8(volatile uint8_m* ptr, uint8_m value, int order) {
+				if (order == MUM_SEQ_CST) {
+					InterlockedExchange8((volatile CHAR*)ptr, (CHAR)value);
+					return;
+				}
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				*ptr = value;
+			}
+
+			static inline muBool mum_atomic_cas8(volatile uint8_m* ptr, uint8_m* expected, uint8_m desired) {
+				uint8_m previous = (uint8_m)_InterlockedCompareExchange8((volatile char*)ptr, (char)desired, (char)*expected);
+				if (previous == *expected) {
+					return MU_TRUE;
+				}
+				*expected = previous;
+				return MU_FALSE;
+			}
+
+			static inline void* mum_atomic_load_ptr(void* volatile* ptr, int order) {
+				void* value = *ptr;
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				return value;
+			}
+
+			static inline void mum_atomic_store_ptr(void* volatile* ptr, void* value, int order) {
+				if (order == MUM_SEQ_CST) {
+					InterlockedExchangePointer(ptr, value);
+					return;
+				}
+				if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+				*ptr = value;
+			}
+
+			static inline muBool mum_atomic_cas_ptr(void* volatile* ptr, void** expected, void* desired) {
+				void* previous = InterlockedCompareExchangePointer(ptr, desired, *expected);
+				if (previous == *expected) {
+					return MU_TRUE;
+				}
+				*expected = previous;
+				return MU_FALSE;
+			}
+
+			static inline void* mum_atomic_exchange_ptr(void* volatile* ptr, void* value) {
+				return InterlockedExchangePointer(ptr, value);
+			}
+
+			static inline void mum_atomic_fence(int order) {
+				// Only a full fence needs anything more than what x86 does already
+				if (order == MUM_SEQ_CST) {
+					MemoryBarrier();
+				} else if (order != MUM_RELAXED) {
+					MUM_WIN32_FENCE();
+				}
+			}
+
+			// Only keeps the compiler from reordering, on any architecture
+			#if defined(_MSC_VER)
+				#include <intrin.h>
+				#define mum_compiler_barrier() _ReadWriteBarrier()
+			#else
+				#define mum_compiler_barrier() __asm__ __volatile__("" ::: "memory")
+			#endif
+
+		/* Time */
+
+			static inline uint64_m mum_time_ns(void) {
+				LARGE_INTEGER frequency, counter;
+				QueryPerformanceFrequency(&frequency);
+				QueryPerformanceCounter(&counter);
+				return (uint64_m)((double)counter.QuadPart * (1000000000.0 / (double)frequency.QuadPart));
+			}
+
+		/* Scheduling */
+
+			static inline void mum_thread_yield(void) {
+				SwitchToThread();
+			}
+
+			static inline void mum_cpu_relax(void) {
+				YieldProcessor();
+			}
+
+		/* Futex */
+
+			static inline void mum_futex_wait(volatile uint32_m* addr, uint32_m expected, uint64_m timeout_ns) {
+				DWORD ms = INFINITE;
+				if (timeout_ns != MUM_NO_TIMEOUT) {
+					uint64_m rounded = (timeout_ns + 999999) / 1000000;
+					ms = (rounded >= INFINITE) ? INFINITE - 1 : (DWORD)rounded;
+				}
+				WaitOnAddress((volatile VOID*)addr, &expected, sizeof(uint32_m), ms);
+			}
+
+			static inline void mum_futex_wake(volatile uint32_m* addr, muBool all) {
+				if (all) {
+					WakeByAddressAll((PVOID)addr);
+				} else {
+					WakeByAddressSingle((PVOID)addr);
+				}
+			}
+
+			// Waits while *addr == expected and *stop == 0, returning whether it could wait on both
+			// at once; WaitOnAddress only takes one address
+			static inline muBool mum_futex_wait_either(volatile uint32_m* addr, uint32_m expected, volatile uint32_m* stop, uint64_m timeout_ns) {
+				return MU_FALSE; if (addr || expected || stop || timeout_ns) {}
+			}
+
+		/* Memory mapping */
+
+			// Windows hands out address space in 64 KB granules, so every mapping is aligned to
+			// 64 KB already
+			static inline void* mum_os_map_aligned(size_m size, size_m alignment) {
+				if (alignment > 65536) {
+					return 0;
+				}
+				return VirtualAlloc(0, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			}
+
+			static inline void mum_os_unmap(void* ptr, size_m size) {
+				VirtualFree(ptr, 0, MEM_RELEASE);
+				return; if (size) {}
+			}
+
+			// Maps memory preferably placed on the given node, using the OS's own node number
+			static inline void* mum_os_map_node(size_m size, uint32_m os_node) {
+				return VirtualAllocExNuma(GetCurrentProcess(), 0, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, (DWORD)os_node);
+			}
+
+			// Whether a mapping can be unmapped in pieces
+			#define MUM_OS_PARTIAL_UNMAP 0
+
+		/* Process barrier */
+
+			// Makes every running thread of the process execute a full memory barrier, so that
+			// threads which only need ordering against a rare writer can get by with compiler
+			// barriers. The init function returns whether it's available; if not, mum_process_barrier
+			// is just a fence, and those threads need real fences too.
+
+			static inline muBool mum_process_barrier_init(void) {
+				return MU_TRUE;
+			}
+
+			static inline void mum_process_barrier(void) {
+				FlushProcessWriteBuffers();
+			}
+
+		/* Thread exit hook */
+
+			// Calls a hook with the value last given to mum_thread_exit_hook_set for it once the
+			// calling thread exits, for any thread, not just ones created by mum
+
+			#define MUM_EXIT_HOOK_SLAB 0
+			#define MUM_EXIT_HOOK_RCU 1
+			#define MUM_EXIT_HOOK_COMBINER 2
+			#define MUM_EXIT_HOOK_POOL 3
+			#define MUM_EXIT_HOOK_TRACE 4
+			#define MUM_EXIT_HOOKS 5
+
+			static void mum_slab_thread_exit(void* value);
+			static void mum_rcu_thread_exit(void* value);
+			static void mum_combiner_thread_exit(void* value);
+			static void mum_pool_thread_exit(void* value);
+			static void mum_trace_thread_exit(void* value);
+
+			static DWORD mum_win32_exit_fls[MUM_EXIT_HOOKS];
+			static INIT_ONCE mum_win32_exit_once = INIT_ONCE_STATIC_INIT;
+
+			static void WINAPI mum_win32_exit_slab(PVOID value) {
+				if (value) {
+					mum_slab_thread_exit(value);
+				}
+			}
+
+			static void WINAPI mum_win32_exit_rcu(PVOID value) {
+				if (value) {
+					mum_rcu_thread_exit(value);
+				}
+			}
+
+			static void WINAPI mum_win32_exit_combiner(PVOID value) {
+				if (value) {
+					mum_combiner_thread_exit(value);
+				}
+			}
+
+			static void WINAPI mum_win32_exit_pool(PVOID value) {
+				if (value) {
+					mum_pool_thread_exit(value);
+				}
+			}
+
+			static void WINAPI mum_win32_exit_trace(PVOID value) {
+				if (value) {
+					mum_trace_thread_exit(value);
+				}
+			}
+
+			static BOOL CALLBACK mum_win32_exit_init(PINIT_ONCE once, PVOID parameter, PVOID* context) {
+				mum_win32_exit_fls[MUM_EXIT_HOOK_SLAB] = FlsAlloc(mum_win32_exit_slab);
+				mum_win32_exit_fls[MUM_EXIT_HOOK_RCU] = FlsAlloc(mum_win32_exit_rcu);
+				mum_win32_exit_fls[MUM_EXIT_HOOK_COMBINER] = FlsAlloc(mum_win32_exit_combiner);
+				mum_win32_exit_fls[MUM_EXIT_HOOK_POOL] = FlsAlloc(mum_win32_exit_pool);
+				mum_win32_exit_fls[MUM_EXIT_HOOK_TRACE] = FlsAlloc(mum_win32_exit_trace);
+				return TRUE; if (once || parameter || context) {}
+			}
+
+			static inline void mum_thread_exit_hook_set(uint32_m hook, void* value) {
+				InitOnceExecuteOnce(&mum_win32_exit_once, mum_win32_exit_init, 0, 0);
+				FlsSetValue(mum_win32_exit_fls[hook], value);
+			}
+
+	#endif
+
+	/* Unix primitives */
+
+	#ifdef MU_UNIX
+
+		#include <pthread.h>
+		#include <sched.h>
+		#include <time.h>
+
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <unistd.h>
+
+		#ifdef __linux__
+			#include <sys/syscall.h>
+			#include <linux/futex.h>
+			#include <errno.h>
+			#include <sys/epoll.h>
+			#include <sys/eventfd.h>
+			#define MUM_EPOLL
+		#endif
+
+		/* Atomics */
+
+			#define MUM_RELAXED __ATOMIC_RELAXED
+			#define MUM_ACQUIRE __ATOMIC_ACQUIRE
+			#define MUM_RELEASE __ATOMIC_RELEASE
+			#define MUM_SEQ_CST __ATOMIC_SEQ_CST
+
+			static inline uint32_m mum_atomic_load32(volatile uint32_m* ptr, int order) {
+				return __atomic_load_n(ptr, order);
+			}
+
+			static inline void mum_atomic_store32(volatile uint32_m* ptr, uint32_m value, int order) {
+				__atomic_store_n(ptr, value, order);
+			}
+
+			static inline uint32_m mum_atomic_fetch_add32(volatile uint32_m* ptr, uint32_m value) {
+				return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+			}
+
+			static inline uint32_m mum_atomic_fetch_sub32(volatile uint32_m* ptr, uint32_m value) {
+				return __atomic_fetch_sub(ptr, value, __ATOMIC_SEQ_CST);
+			}
+
+			static inline muBool mum_atomic_cas32(volatile uint32_m* ptr, uint32_m* expected, uint32_m desired) {
+				return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			static inline uint32_m mum_atomic_exchange32(volatile uint32_m* ptr, uint32_m value) {
+				return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+			}
+
+			static inline uint64_m mum_atomic_load64(volatile uint64_m* ptr, int order) {
+				return __atomic_load_n(ptr, order);
+			}
+
+			static inline void mum_atomic_store64(volatile uint64_m* ptr, uint64_m value, int order) {
+				__atomic_store_n(ptr, value, order);
+			}
+
+			static inline uint64_m mum_atomic_fetch_add64(volatile uint64_m* ptr, uint64_m value) {
+				return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+			}
+
+			static inline muBool mum_atomic_cas64(volatile uint64_m* ptr, uint64_m* expected, uint64_m desired) {
+				return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			static inline uint8_m mum_atomic_load8(volatile uint8_m* ptr, int order) {
+				return __atomic_load_n(ptr, order);
+			}
+
+			static inline void mum_atomic_store8(volatile uint8_m* ptr, uint8_m value, int order) {
+				__atomic_store_n(ptr, value, order);
+			}
+
+			static inline muBool mum_atomic_cas8(volatile uint8_m* ptr, uint8_m* expected, uint8_m desired) {
+				return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			static inline void* mum_atomic_load_ptr(void* volatile* ptr, int order) {
+				return __atomic_load_n(ptr, order);
+			}
+
+			static inline void mum_atomic_store_ptr(void* volatile* ptr, void* value, int order) {
+				__atomic_store_n(ptr, value, order);
+			}
+
+			static inline muBool mum_atomic_cas_ptr(void* volatile* ptr, void** expected, void* desired) {
+				return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			static inline void* mum_atomic_exchange_ptr(void* volatile* ptr, void* value) {
+				return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+			}
+
+			static inline void mum_atomic_fence(int order) {
+				__atomic_thread_fence(order);
+			}
+
+			// Only keeps the compiler from reordering
+			#define mum_compiler_barrier() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+		/* Time */
+
+			static inline uint64_m mum_time_ns(void) {
+				struct timespec ts;
+				clock_gettime(CLOCK_MONOTONIC, &ts);
+				return (uint64_m)ts.tv_sec * 1000000000 + (uint64_m)ts.tv_nsec;
+			}
+
+		/* Scheduling */
+
+			static inline void mum_thread_yield(void) {
+				sched_yield();
+			}
+
+			static inline void mum_cpu_relax(void) {
+				#if defined(__i386__) || defined(__x86_64__)
+					__builtin_ia32_pause();
+				#elif defined(__aarch64__) || defined(__arm__)
+					__asm__ __volatile__("yield");
+				#endif
+			}
+
+		/* Futex */
+
+		#ifdef __linux__
+
+			static inline void mum_futex_wait(volatile uint32_m* addr, uint32_m expected, uint64_m timeout_ns) {
+				struct timespec ts;
+				struct timespec* tp = 0;
+				if (timeout_ns != MUM_NO_TIMEOUT) {
+					ts.tv_sec = (time_t)(timeout_ns / 1000000000);
+					ts.tv_nsec = (long)(timeout_ns % 1000000000);
+					tp = &ts;
+				}
+				syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, tp, 0, 0);
+			}
+
+			static inline void mum_futex_wake(volatile uint32_m* addr, muBool all) {
+				syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1, 0, 0, 0);
+			}
+
+			// Waits while *addr == expected and *stop == 0, returning whether it could wait on both
+			// at once, which takes futex_waitv (Linux 5.16); its timeout is absolute
+
+			#ifdef SYS_futex_waitv
+
+				struct mum_futex_waitv {
+					uint64_m val;
+					uint64_m uaddr;
+					uint32_m flags;
+					uint32_m reserved;
+				};
+
+				// FUTEX2_SIZE_U32 | FUTEX2_PRIVATE
+				#define MUM_FUTEX2_FLAGS (0x02 | 128)
+
+				static uint32_m mum_futex_waitv_missing = 0;
+
+				static inline muBool mum_futex_wait_either(volatile uint32_m* addr, uint32_m expected, volatile uint32_m* stop, uint64_m timeout_ns) {
+					if (mum_atomic_load32(&mum_futex_waitv_missing, MUM_RELAXED)) {
+						return MU_FALSE;
+					}
+
+					struct mum_futex_waitv waiters[2];
+					waiters[0].val = expected;
+					waiters[0].uaddr = (uint64_m)(size_m)addr;
+					waiters[0].flags = MUM_FUTEX2_FLAGS;
+					waiters[0].reserved = 0;
+					waiters[1].val = 0;
+					waiters[1].uaddr = (uint64_m)(size_m)stop;
+					waiters[1].flags = MUM_FUTEX2_FLAGS;
+					waiters[1].reserved = 0;
+
+					struct timespec ts;
+					struct timespec* tp = 0;
+					if (timeout_ns != MUM_NO_TIMEOUT) {
+						uint64_m deadline = mum_time_ns() + timeout_ns;
+						ts.tv_sec = (time_t)(deadline / 1000000000);
+						ts.tv_nsec = (long)(deadline % 1000000000);
+						tp = &ts;
+					}
+					if (syscall(SYS_futex_waitv, waiters, 2, 0, tp, CLOCK_MONOTONIC) == -1 && errno == ENOSYS) {
+						mum_atomic_store32(&mum_futex_waitv_missing, 1, MUM_RELAXED);
+						return MU_FALSE;
+					}
+					return MU_TRUE;
+				}
+
+			#else
+
+				static inline muBool mum_futex_wait_either(volatile uint32_m* addr, uint32_m expected, volatile uint32_m* stop, uint64_m timeout_ns) {
+					return MU_FALSE; if (addr || expected || stop || timeout_ns) {}
+				}
+
+			#endif
+
+		#else
+
+			// There's no portable futex outside of Linux, so waiters sleep on a condition variable
+			// picked from a small table by the address they wait on. Wakers always broadcast, since
+			// unrelated addresses can share a bucket.
+
+			#define MUM_UNIX_WAIT_BUCKETS 64
+
+			struct mum_unix_wait_bucket {
+				pthread_mutex_t mutex;
+				pthread_cond_t cond;
+			};
+
+			static struct mum_unix_wait_bucket mum_unix_wait_table[MUM_UNIX_WAIT_BUCKETS];
+			static pthread_once_t mum_unix_wait_once = PTHREAD_ONCE_INIT;
+
+			static void mum_unix_wait_init(void) {
+				for (size_m i = 0; i < MUM_UNIX_WAIT_BUCKETS; i++) {
+					pthread_mutex_init(&mum_unix_wait_table[i].mutex, 0);
+					pthread_cond_init(&mum_unix_wait_table[i].cond, 0);
+				}
+			}
+
+			static inline struct mum_unix_wait_bucket* mum_unix_wait_get_bucket(volatile uint32_m* addr) {
+				pthread_once(&mum_unix_wait_once, mum_unix_wait_init);
+				return &mum_unix_wait_table[((size_m)addr >> 2) % MUM_UNIX_WAIT_BUCKETS];
+			}
+
+			static inline void mum_futex_wait(volatile uint32_m* addr, uint32_m expected, uint64_m timeout_ns) {
+				struct mum_unix_wait_bucket* b = mum_unix_wait_get_bucket(addr);
+
+				pthread_mutex_lock(&b->mutex);
+				if (__atomic_load_n(addr, __ATOMIC_SEQ_CST) == expected) {
+					if (timeout_ns == MUM_NO_TIMEOUT) {
+						pthread_cond_wait(&b->cond, &b->mutex);
+					} else {
+						struct timespec ts;
+						clock_gettime(CLOCK_REALTIME, &ts);
+						uint64_m ns = (uint64_m)ts.tv_nsec + timeout_ns;
+						ts.tv_sec += (time_t)(ns / 1000000000);
+						ts.tv_nsec = (long)(ns % 1000000000);
+						pthread_cond_timedwait(&b->cond, &b->mutex, &ts);
+					}
+				}
+				pthread_mutex_unlock(&b->mutex);
+			}
+
+			static inline void mum_futex_wake(volatile uint32_m* addr, muBool all) {
+				struct mum_unix_wait_bucket* b = mum_unix_wait_get_bucket(addr);
+
+				pthread_mutex_lock(&b->mutex);
+				pthread_cond_broadcast(&b->cond);
+				pthread_mutex_unlock(&b->mutex);
+				return; if (all) {}
+			}
+
+			// Waits while *addr == expected and *stop == 0, returning whether it could wait on both
+			// at once; a bucket only covers one address
+			static inline muBool mum_futex_wait_either(volatile uint32_m* addr, uint32_m expected, volatile uint32_m* stop, uint64_m timeout_ns) {
+				return MU_FALSE; if (addr || expected || stop || timeout_ns) {}
+			}
+
+		#endif
+
+		/* Memory mapping */
+
+			#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+				#define MAP_ANONYMOUS MAP_ANON
+			#endif
+
+			// Maps private zeroed memory; if neither anonymous flag is visible (such as when a
+			// system header came before mum under a strict standard), a private mapping of
+			// /dev/zero is the POSIX equivalent
+			static inline void* mum_os_mmap(size_m size) {
+				#ifdef MAP_ANONYMOUS
+					void* p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				#else
+					int fd = open("/dev/zero", O_RDWR);
+					if (fd == -1) {
+						return 0;
+					}
+					void* p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+					close(fd);
+				#endif
+				if (p == MAP_FAILED) {
+					return 0;
+				}
+				return p;
+			}
+
+			static inline void* mum_os_map_aligned(size_m size, size_m alignment) {
+				// Over-map, then trim the unaligned head and the tail
+				uint8_m* p = (uint8_m*)mum_os_mmap(size + alignment);
+				if (!p) {
+					return 0;
+				}
+
+				size_m head = (alignment - ((size_m)p & (alignment - 1))) & (alignment - 1);
+				if (head) {
+					munmap(p, head);
+				}
+				if (alignment - head) {
+					munmap(p + head + size, alignment - head);
+				}
+				return p + head;
+			}
+
+			static inline void mum_os_unmap(void* ptr, size_m size) {
+				munmap(ptr, size);
+			}
+
+			// Maps memory preferably placed on the given node, using the OS's own node number
+			static inline void* mum_os_map_node(size_m size, uint32_m os_node) {
+				void* p = mum_os_mmap(size);
+				if (!p) {
+					return 0;
+				}
+
+				#if defined(__linux__) && defined(SYS_mbind)
+					// MPOL_PREFERRED; if this fails, the memory still works, just without the placement
+					unsigned long mask[16] = { 0 };
+					size_m bits = sizeof(unsigned long) * 8;
+					if (os_node < sizeof(mask) * 8) {
+						mask[os_node / bits] = 1ul << (os_node % bits);
+						syscall(SYS_mbind, p, size, 1, mask, sizeof(mask) * 8, 0);
+					}
+				#else
+					if (os_node) {}
+				#endif
+
+				return p;
+			}
+
+			// Whether a mapping can be unmapped in pieces
+			#define MUM_OS_PARTIAL_UNMAP 1
+
+		/* Process barrier */
+
+			// Makes every running thread of the process execute a full memory barrier, so that
+			// threads which only need ordering against a rare writer can get by with compiler
+			// barriers. The init function returns whether it's available; if not, mum_process_barrier
+			// is just a fence, and those threads need real fences too.
+
+			#if defined(__linux__) && defined(SYS_membarrier)
+
+				#define MUM_MEMBARRIER_PRIVATE_EXPEDITED 8
+				#define MUM_MEMBARRIER_REGISTER_PRIVATE_EXPEDITED 16
+
+				static muBool mum_process_barrier_ok = MU_FALSE;
+
+				static inline muBool mum_process_barrier_init(void) {
+					mum_process_barrier_ok = syscall(SYS_membarrier, MUM_MEMBARRIER_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+					return mum_process_barrier_ok;
+				}
+
+				static inline void mum_process_barrier(void) {
+					if (mum_process_barrier_ok) {
+						syscall(SYS_membarrier, MUM_MEMBARRIER_PRIVATE_EXPEDITED, 0);
+					} else {
+						__atomic_thread_fence(__ATOMIC_SEQ_CST);
+					}
+				}
+
+			#else
+
+				static inline muBool mum_process_barrier_init(void) {
+					return MU_FALSE;
+				}
+
+				static inline void mum_process_barrier(void) {
+					__atomic_thread_fence(__ATOMIC_SEQ_CST);
+				}
+
+			#endif
+
+		/* Thread exit hook */
+
+			// Calls a hook with the value last given to mum_thread_exit_hook_set for it once the
+			// calling thread exits, for any thread, not just ones created by mum
+
+			#define MUM_EXIT_HOOK_SLAB 0
+			#define MUM_EXIT_HOOK_RCU 1
+			#define MUM_EXIT_HOOK_COMBINER 2
+			#define MUM_EXIT_HOOK_POOL 3
+			#define MUM_EXIT_HOOK_TRACE 4
+			#define MUM_EXIT_HOOKS 5
+
+			static void mum_slab_thread_exit(void* value);
+			static void mum_rcu_thread_exit(void* value);
+			static void mum_combiner_thread_exit(void* value);
+			static void mum_pool_thread_exit(void* value);
+			static void mum_trace_thread_exit(void* value);
+
+			static pthread_key_t mum_unix_exit_keys[MUM_EXIT_HOOKS];
+			static pthread_once_t mum_unix_exit_once = PTHREAD_ONCE_INIT;
+
+			static void mum_unix_exit_init(void) {
+				pthread_key_create(&mum_unix_exit_keys[MUM_EXIT_HOOK_SLAB], mum_slab_thread_exit);
+				pthread_key_create(&mum_unix_exit_keys[MUM_EXIT_HOOK_RCU], mum_rcu_thread_exit);
+				pthread_key_create(&mum_unix_exit_keys[MUM_EXIT_HOOK_COMBINER], mum_combiner_thread_exit);
+				pthread_key_create(&mum_unix_exit_keys[MUM_EXIT_HOOK_POOL], mum_pool_thread_exit);
+				pthread_key_create(&mum_unix_exit_keys[MUM_EXIT_HOOK_TRACE], mum_trace_thread_exit);
+			}
+
+			static inline void mum_thread_exit_hook_set(uint32_m hook, void* value) {
+				pthread_once(&mum_unix_exit_once, mum_unix_exit_init);
+				pthread_setspecific(mum_unix_exit_keys[hook], value);
+			}
+
+	#endif
+
+	/* Thread state */
+
+		// State shared by the thread handles of every platform; always the first member of a
+		// platform's thread struct, so a muThread can be cast to it directly.
+		struct mum_thread_group;
+
+		struct mum_thread_state {
+			void (*start)(void* args);
+			void* args;
+			// Set once a stop has been requested; what stop tokens point to
+			uint32_m stop;
+			// Address the thread is waiting on within a stoppable wait, or 0
+			void* volatile parked;
+			// One reference held by the handle, one by the running thread; unused within a group,
+			// where the group's references are used instead
+			uint32_m refs;
+			muBool waited;
+			// The group the thread belongs to and its index within it, or 0 if it has none
+			struct mum_thread_group* group;
+			uint32_m index;
+		};
+
+		static MUM_THREAD_LOCAL struct mum_thread_state* mum_current_thread = 0;
+
+		static void mum_thread_state_init(struct mum_thread_state* s, void (*start)(void* args), void* args, struct mum_thread_group* group, uint32_m index) {
+			s->start = start;
+			s->args = args;
+			s->stop = 0;
+			s->parked = 0;
+			s->refs = 2;
+			s->waited = MU_FALSE;
+			s->group = group;
+			s->index = index;
+		}
+
+		static void mum_thread_state_release(struct mum_thread_state* s) {
+			if (mum_atomic_fetch_sub32(&s->refs, 1) == 1) {
+				mu_free(s);
+			}
+		}
+
+		// A group is one allocation: this header, then the platform's thread structs, then the
+		// order that the threads finished in
+		struct mum_thread_group {
+			size_m count;
+			size_m thread_size;
+			uint8_m* threads;
+			// Index + 1 of each finished thread, in the order they finished; 0 until written
+			uint32_m* finished_order;
+			// Threads that have finished
+			uint32_m finished;
+			// 0 until every thread has been created, then 1, or 2 if creating one failed
+			uint32_m gate;
+			// One reference held by the handle, one by each running thread
+			uint32_m refs;
+			// Threads returned by mu_thread_wait_any so far
+			size_m returned;
+		};
+
+		static struct mum_thread_group* mum_thread_group_alloc(mumResult* result, size_m count, size_m thread_size) {
+			size_m header = (sizeof(struct mum_thread_group) + 15) & ~(size_m)15;
+			thread_size = (thread_size + 15) & ~(size_m)15;
+
+			struct mum_thread_group* g = (struct mum_thread_group*)mu_malloc(header + thread_size * count + sizeof(uint32_m) * count);
+			if (!g) {
+				MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+				return 0;
+			}
+
+			g->count = count;
+			g->thread_size = thread_size;
+			g->threads = (uint8_m*)g + header;
+			g->finished_order = (uint32_m*)(g->threads + thread_size * count);
+			for (size_m i = 0; i < count; i++) {
+				g->finished_order[i] = 0;
+			}
+			g->finished = 0;
+			g->gate = 0;
+			g->refs = (uint32_m)count + 1;
+			g->returned = 0;
+			return g;
+		}
+
+		static inline struct mum_thread_state* mum_thread_group_thread(struct mum_thread_group* g, size_m index) {
+			return (struct mum_thread_state*)(g->threads + g->thread_size * index);
+		}
+
+		static void mum_thread_group_release(struct mum_thread_group* g) {
+			if (mum_atomic_fetch_sub32(&g->refs, 1) == 1) {
+				mu_free(g);
+			}
+		}
+
+		// Lets the threads of a group run once they've all been created, or makes them exit
+		static void mum_thread_group_open(struct mum_thread_group* g, muBool run) {
+			mum_atomic_store32(&g->gate, run ? 1 : 2, MUM_RELEASE);
+			mum_futex_wake(&g->gate, MU_TRUE);
+		}
+
+		// Called by a new thread before it runs its start function; returns whether it should
+		static muBool mum_thread_state_enter(struct mum_thread_state* s) {
+			struct mum_thread_group* g = s->group;
+			if (!g) {
+				return MU_TRUE;
+			}
+
+			uint32_m gate;
+			while ((gate = mum_atomic_load32(&g->gate, MUM_ACQUIRE)) == 0) {
+				mum_futex_wait(&g->gate, 0, MUM_NO_TIMEOUT);
+			}
+			return gate == 1;
+		}
+
+		// Called by a thread as it exits, however it exits
+		static void mum_thread_state_exit(struct mum_thread_state* s) {
+			struct mum_thread_group* g = s->group;
+			if (!g) {
+				mum_thread_state_release(s);
+				return;
+			}
+
+			uint32_m slot = mum_atomic_fetch_add32(&g->finished, 1);
+			mum_atomic_store32(&g->finished_order[slot], s->index + 1, MUM_RELEASE);
+			mum_futex_wake(&g->finished, MU_TRUE);
+			mum_thread_group_release(g);
+		}
+
+		// Where a thread can't wait on its stop flag alongside what it's waiting for, a stop
+		// request wakes the address it's parked on instead, which is lost if the thread hasn't
+		// gone to sleep yet; it sleeps for this long at most at once, so that it notices then.
+		#define MUM_STOP_SLICE_NS 10000000ull
+
+		// Whether a stop has been requested for the calling thread
+		static inline muBool mum_stop_requested_self(void) {
+			struct mum_thread_state* self = mum_current_thread;
+			return self && mum_atomic_load32(&self->stop, MUM_RELAXED) != 0;
+		}
+
+		// Waits while *addr == expected, unless a stop has been requested for the calling thread,
+		// in which case MU_FALSE is returned. Can return spuriously.
+		static muBool mum_park_stoppable(volatile uint32_m* addr, uint32_m expected, uint64_m timeout_ns) {
+			struct mum_thread_state* self = mum_current_thread;
+			if (!self) {
+				mum_futex_wait(addr, expected, timeout_ns);
+				return MU_TRUE;
+			}
+			if (addr == &self->stop) {
+				mum_futex_wait(addr, expected, timeout_ns);
+				return mum_atomic_load32(&self->stop, MUM_ACQUIRE) == 0;
+			}
+
+			mum_atomic_store_ptr(&self->parked, (void*)addr, MUM_SEQ_CST);
+			if (mum_atomic_load32(&self->stop, MUM_SEQ_CST) == 0 && !mum_futex_wait_either(addr, expected, &self->stop, timeout_ns)) {
+				mum_futex_wait(addr, expected, timeout_ns < MUM_STOP_SLICE_NS ? timeout_ns : MUM_STOP_SLICE_NS);
+			}
+			mum_atomic_store_ptr(&self->parked, 0, MUM_SEQ_CST);
+
+			return mum_atomic_load32(&self->stop, MUM_ACQUIRE) == 0;
+		}
+
+		// Waits until at least count threads of a group have finished, returning MU_FALSE if a
+		// stop was requested for the calling thread first and the wait is stoppable
+		static muBool mum_thread_group_wait_finished(struct mum_thread_group* g, size_m count, muBool stoppable) {
+			uint32_m finished;
+			while ((finished = mum_atomic_load32(&g->finished, MUM_ACQUIRE)) < count) {
+				if (!stoppable) {
+					mum_futex_wait(&g->finished, finished, MUM_NO_TIMEOUT);
+				} else if (!mum_park_stoppable(&g->finished, finished, MUM_NO_TIMEOUT)) {
+					return MU_FALSE;
+				}
+			}
+			return MU_TRUE;
+		}
+
+		static void mum_thread_state_request_stop(struct mum_thread_state* s) {
+			mum_atomic_store32(&s->stop, 1, MUM_SEQ_CST);
+			mum_futex_wake(&s->stop, MU_TRUE);
+
+			// Only needed where the thread can't wait on its stop flag directly, and only once,
+			// as a wake that comes too early is caught by the thread's next slice
+			void* parked = mum_atomic_load_ptr(&s->parked, MUM_SEQ_CST);
+			if (parked) {
+				mum_futex_wake((volatile uint32_m*)parked, MU_TRUE);
+			}
+		}
+
+	/* Topology */
+
+		// Filled in once by the platform's mum_topology_discover; every array is indexed by mum's
+		// own CPU index except for os_node, which is indexed by node, and cpu_of_os, which maps
+		// the OS's CPU numbers back to mum's (~0 for CPUs mum doesn't know about)
+		struct mum_topology {
+			uint32_m cpu_count;
+			uint32_m core_count;
+			uint32_m llc_count;
+			uint32_m node_count;
+			uint32_m* os_cpu;
+			uint32_m* core;
+			uint32_m* llc;
+			uint32_m* node;
+			uint32_m* os_node;
+			uint32_m* cpu_of_os;
+			uint32_m os_cpu_limit;
+		};
+
+		static struct mum_topology mum_topology;
+		static uint32_m mum_topology_state = 0;
+
+		// A single CPU on a single node, used if the topology can't be allocated
+		static uint32_m mum_topology_zero[1] = { 0 };
+
+		static void mum_topology_discover(struct mum_topology* t);
+
+		static void mum_topology_fallback(struct mum_topology* t) {
+			t->cpu_count = t->core_count = t->llc_count = t->node_count = 1;
+			t->os_cpu = t->core = t->llc = t->node = t->os_node = t->cpu_of_os = mum_topology_zero;
+			t->os_cpu_limit = 1;
+		}
+
+		// Renumbers keys (each less than limit) to 0, 1, 2... in order of first appearance, and
+		// returns how many distinct keys there were; scratch must hold limit values
+		static uint32_m mum_topology_densify(uint32_m* keys, uint32_m count, uint32_m* scratch, uint32_m limit) {
+			for (uint32_m i = 0; i < limit; i++) {
+				scratch[i] = 0xFFFFFFFF;
+			}
+
+			uint32_m next = 0;
+			for (uint32_m i = 0; i < count; i++) {
+				if (scratch[keys[i]] == 0xFFFFFFFF) {
+					scratch[keys[i]] = next++;
+				}
+				keys[i] = scratch[keys[i]];
+			}
+			return next;
+		}
+
+		static struct mum_topology* mum_topology_get(void) {
+			if (mum_atomic_load32(&mum_topology_state, MUM_ACQUIRE) == 2) {
+				return &mum_topology;
+			}
+
+			uint32_m expected = 0;
+			if (mum_atomic_cas32(&mum_topology_state, &expected, 1)) {
+				mum_topology_discover(&mum_topology);
+				mum_atomic_store32(&mum_topology_state, 2, MUM_RELEASE);
+				mum_futex_wake(&mum_topology_state, MU_TRUE);
+			} else {
+				while (mum_atomic_load32(&mum_topology_state, MUM_ACQUIRE) != 2) {
+					mum_futex_wait(&mum_topology_state, 1, MUM_NO_TIMEOUT);
+				}
+			}
+			return &mum_topology;
+		}
+
+	/* Tracing */
+
+		// Event kinds; the object is the lock or thread handle the event is about
+		#define MUM_TRACE_LOCK_ACQUIRE 0
+		#define MUM_TRACE_LOCK_CONTEND 1
+		#define MUM_TRACE_LOCK_ACQUIRE_CONTENDED 2
+		#define MUM_TRACE_LOCK_RELEASE 3
+		#define MUM_TRACE_THREAD_CREATE 4
+		#define MUM_TRACE_THREAD_START 5
+		#define MUM_TRACE_THREAD_EXIT 6
+		#define MUM_TRACE_THREAD_WAIT 7
+		#define MUM_TRACE_THREAD_WAITED 8
+
+		// Object types
+		#define MUM_TRACE_MUTEX 0
+		#define MUM_TRACE_SPINLOCK 1
+		#define MUM_TRACE_THREAD 2
+		#define MUM_TRACE_COHORT_LOCK 3
+		#define MUM_TRACE_ADAPTIVE_LOCK 4
+
+	#ifdef MUM_TRACE
+
+		#include <stdio.h>
+
+		#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+			#include <intrin.h>
+			#define MUM_TRACE_TICKS() __rdtsc()
+		#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+			#include <x86intrin.h>
+			#define MUM_TRACE_TICKS() __rdtsc()
+		#else
+			#define MUM_TRACE_TICKS() mum_time_ns()
+		#endif
+
+		#ifndef MUM_TRACE_CAPACITY
+			#define MUM_TRACE_CAPACITY 16384
+		#endif
+
+		struct mum_trace_event {
+			uint64_m ticks;
+			void* object;
+			uint32_m tid;
+			uint16_m kind;
+			uint16_m type;
+		};
+
+		// Written only by the thread using it; head is published with release so that the flusher
+		// can read every event before it. Rings are never freed, as the flusher may be reading
+		// them, but the ring of any thread that has exited is handed to the next thread that
+		// starts tracing, so there are only ever as many as threads have traced at once.
+		struct mum_trace_ring {
+			struct mum_trace_ring* next;
+			uint32_m in_use;
+			uint32_m head;
+			uint32_m tail;
+			struct mum_trace_event events[MUM_TRACE_CAPACITY];
+		};
+
+		static void* volatile mum_trace_rings = 0;
+		static uint32_m mum_trace_next_tid = 1;
+		static uint32_m mum_trace_flush_lock = 0;
+		static uint64_m mum_trace_base_ticks = 0;
+		static uint64_m mum_trace_base_ns = 0;
+		static uint32_m mum_trace_calibrated = 0;
+
+		static MUM_THREAD_LOCAL struct mum_trace_ring* mum_trace_local = 0;
+		static MUM_THREAD_LOCAL uint32_m mum_trace_tid = 0;
+
+		static struct mum_trace_ring* mum_trace_ring_get(void) {
+			// The first thread to trace anything records the point that ticks are measured from
+			uint32_m expected = 0;
+			if (mum_atomic_cas32(&mum_trace_calibrated, &expected, 1)) {
+				mum_trace_base_ns = mum_time_ns();
+				mum_trace_base_ticks = MUM_TRACE_TICKS();
+				mum_atomic_store32(&mum_trace_calibrated, 2, MUM_RELEASE);
+			}
+
+			if (mum_trace_tid == 0) {
+				mum_trace_tid = mum_atomic_fetch_add32(&mum_trace_next_tid, 1);
+			}
+
+			struct mum_trace_ring* ring = (struct mum_trace_ring*)mum_atomic_load_ptr(&mum_trace_rings, MUM_ACQUIRE);
+			for (; ring; ring = ring->next) {
+				expected = 0;
+				if (mum_atomic_load32(&ring->in_use, MUM_RELAXED) == 0 && mum_atomic_cas32(&ring->in_use, &expected, 1)) {
+					mum_trace_local = ring;
+					mum_thread_exit_hook_set(MUM_EXIT_HOOK_TRACE, ring);
+					return ring;
+				}
+			}
+
+			ring = (struct mum_trace_ring*)mu_malloc(sizeof(struct mum_trace_ring));
+			if (!ring) {
+				return 0;
+			}
+			ring->in_use = 1;
+			ring->head = 0;
+			ring->tail = 0;
+
+			void* head = mum_atomic_load_ptr(&mum_trace_rings, MUM_RELAXED);
+			do {
+				ring->next = (struct mum_trace_ring*)head;
+			} while (!mum_atomic_cas_ptr(&mum_trace_rings, &head, ring));
+
+			mum_trace_local = ring;
+			mum_thread_exit_hook_set(MUM_EXIT_HOOK_TRACE, ring);
+			return ring;
+		}
+
+		static void mum_trace_record(uint16_m kind, uint16_m type, void* object) {
+			struct mum_trace_ring* ring = mum_trace_local;
+			if (!ring) {
+				ring = mum_trace_ring_get();
+				if (!ring) {
+					return;
+				}
+			}
+
+			uint32_m head = ring->head;
+			struct mum_trace_event* e = &ring->events[head & (MUM_TRACE_CAPACITY - 1)];
+			e->ticks = MUM_TRACE_TICKS();
+			e->object = object;
+			e->tid = mum_trace_tid;
+			e->kind = kind;
+			e->type = type;
+			mum_atomic_store32(&ring->head, head + 1, MUM_RELEASE);
+		}
+
+		// Called by a mum thread right before it exits; the exit hook isn't needed after that, as
+		// the ring may be someone else's by the time it would run
+		static void mum_trace_release_ring(void) {
+			struct mum_trace_ring* ring = mum_trace_local;
+			if (ring) {
+				mum_trace_local = 0;
+				mum_thread_exit_hook_set(MUM_EXIT_HOOK_TRACE, 0);
+				mum_atomic_store32(&ring->in_use, 0, MUM_RELEASE);
+			}
+		}
+
+		// Releases the ring of a thread not created by mum once it exits
+		static void mum_trace_thread_exit(void* value) {
+			mum_atomic_store32(&((struct mum_trace_ring*)value)->in_use, 0, MUM_RELEASE);
+		}
+
+		#define MUM_TRACE_EVENT(kind, type, object) mum_trace_record(kind, type, (void*)(object))
+		#define MUM_TRACE_RELEASE_RING() mum_trace_release_ring()
+
+	#else
+
+		#define MUM_TRACE_EVENT(kind, type, object) ((void)0)
+		#define MUM_TRACE_RELEASE_RING() ((void)0)
+
+		static void mum_trace_thread_exit(void* value) {
+			return; if (value) {}
+		}
+
+	#endif
+
+	/* Idle strategies */
+
+		// A thread that finds nothing to do calls mum_idle_step each time, which spins or yields
+		// once and returns false, until the strategy says to park, at which point it returns true
+		// and the caller sleeps in whatever way it usually does; once the thread has something to
+		// do again, mum_idle_end adds the time of the phase it was in. The clock is only read
+		// every so many spins, so that spinning stays tight. A null strategy parks straight away,
+		// which is how everything waits if no strategy is attached.
+
+		#define MUM_IDLE_DEFAULT_SPIN 20000
+		#define MUM_IDLE_CLOCK_SPINS 16
+
+		#define MUM_IDLE_PHASE_NONE 0
+		#define MUM_IDLE_PHASE_SPIN 1
+		#define MUM_IDLE_PHASE_YIELD 2
+		#define MUM_IDLE_PHASE_PARK 3
+
+		struct mum_idle {
+			mumIdleKind kind;
+			uint64_m spin_ns;
+			uint64_m park_ns;
+			// Added to by every thread using the strategy
+			uint64_m waits;
+			uint64_m spin_time;
+			uint64_m yield_time;
+			uint64_m park_time;
+			uint64_m parks;
+		};
+		typedef struct mum_idle mum_idle;
+
+		// Kept by the waiting thread; phase must start as MUM_IDLE_PHASE_NONE
+		struct mum_idle_state {
+			uint64_m phase_start;
+			uint32_m phase;
+			uint32_m spins;
+		};
+
+		static void mum_idle_add(mum_idle* idle, uint32_m phase, uint64_m ns) {
+			switch (phase) {
+				case MUM_IDLE_PHASE_SPIN: mum_atomic_fetch_add64(&idle->spin_time, ns); break;
+				case MUM_IDLE_PHASE_YIELD: mum_atomic_fetch_add64(&idle->yield_time, ns); break;
+				case MUM_IDLE_PHASE_PARK: mum_atomic_fetch_add64(&idle->park_time, ns); break;
+				default: break;
+			}
+		}
+
+		// Returns whether the caller should park now
+		static muBool mum_idle_step(mum_idle* idle, struct mum_idle_state* st) {
+			if (!idle) {
+				return MU_TRUE;
+			}
+
+			if (st->phase == MUM_IDLE_PHASE_NONE) {
+				mum_atomic_fetch_add64(&idle->waits, 1);
+				st->phase_start = mum_time_ns();
+				st->spins = 0;
+				st->phase = (idle->kind == MUM_IDLE_PARK) ? MUM_IDLE_PHASE_PARK : MUM_IDLE_PHASE_SPIN;
+			}
+
+			if (st->phase == MUM_IDLE_PHASE_SPIN) {
+				mum_cpu_relax();
+				if (idle->kind == MUM_IDLE_SPIN || ++st->spins % MUM_IDLE_CLOCK_SPINS != 0) {
+					return MU_FALSE;
+				}
+				uint64_m time = mum_time_ns();
+				if (time - st->phase_start < idle->spin_ns) {
+					return MU_FALSE;
+				}
+				mum_idle_add(idle, MUM_IDLE_PHASE_SPIN, time - st->phase_start);
+				st->phase_start = time;
+				st->phase = (idle->kind == MUM_IDLE_SPIN_YIELD) ? MUM_IDLE_PHASE_YIELD : MUM_IDLE_PHASE_PARK;
+			}
+
+			if (st->phase == MUM_IDLE_PHASE_YIELD) {
+				mum_thread_yield();
+				return MU_FALSE;
+			}
+
+			mum_atomic_fetch_add64(&idle->parks, 1);
+			return MU_TRUE;
+		}
+
+		static void mum_idle_end(mum_idle* idle, struct mum_idle_state* st) {
+			if (!idle || st->phase == MUM_IDLE_PHASE_NONE) {
+				return;
+			}
+			mum_idle_add(idle, st->phase, mum_time_ns() - st->phase_start);
+			st->phase = MUM_IDLE_PHASE_NONE;
+		}
+
+		// How long to sleep for at once when parking
+		static inline uint64_m mum_idle_park_ns(mum_idle* idle) {
+			return (idle && idle->park_ns) ? idle->park_ns : MUM_NO_TIMEOUT;
+		}
+
+		// Spinlocks with a strategy attached are futex locks (0 unlocked, 1 locked, 2 locked with
+		// threads that may be parked), which only start marking themselves as having parked
+		// threads once the strategy says to park
+		static void mum_idle_lock(mum_idle* idle, volatile uint32_m* word) {
+			struct mum_idle_state st;
+			st.phase = MUM_IDLE_PHASE_NONE;
+
+			for (;;) {
+				uint32_m expected = 0;
+				if (mum_atomic_load32(word, MUM_RELAXED) == 0 && mum_atomic_cas32(word, &expected, 1)) {
+					mum_idle_end(idle, &st);
+					return;
+				}
+				if (mum_idle_step(idle, &st)) {
+					break;
+				}
+			}
+
+			while (mum_atomic_exchange32(word, 2) != 0) {
+				mum_futex_wait(word, 2, mum_idle_park_ns(idle));
+			}
+			mum_idle_end(idle, &st);
+		}
+
+		static inline void mum_idle_unlock(volatile uint32_m* word) {
+			if (mum_atomic_exchange32(word, 0) == 2) {
+				mum_futex_wake(word, MU_FALSE);
+			}
+		}
+
+		MUDEF muIdleStrategy mu_idle_strategy_create_(mumResult* result, mumIdleKind kind, uint64_m spin_ns, uint64_m park_ns) {
+			mum_idle* idle = (mum_idle*)mu_malloc(sizeof(mum_idle));
+			if (!idle) {
+				MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+				return 0;
+			}
+
+			idle->kind = kind;
+			idle->spin_ns = spin_ns ? spin_ns : MUM_IDLE_DEFAULT_SPIN;
+			idle->park_ns = park_ns;
+			idle->waits = 0;
+			idle->spin_time = 0;
+			idle->yield_time = 0;
+			idle->park_time = 0;
+			idle->parks = 0;
+			return idle;
+		}
+
+		MUDEF muIdleStrategy mu_idle_strategy_destroy_(mumResult* result, muIdleStrategy strategy) {
+			mu_free(strategy);
+			return 0; if (result) {}
+		}
+
+		MUDEF muBool mu_idle_wait(muIdleStrategy strategy, uint32_m* address, uint32_m value, int32_m timeout_ms) {
+			mum_idle* idle = (mum_idle*)strategy;
+			uint64_m deadline = (timeout_ms < 0) ? MUM_NO_TIMEOUT : mum_time_ns() + (uint64_m)timeout_ms * 1000000;
+			struct mum_idle_state st;
+			st.phase = MUM_IDLE_PHASE_NONE;
+
+			for (;;) {
+				if (mum_atomic_load32(address, MUM_ACQUIRE) != value) {
+					mum_idle_end(idle, &st);
+					return MU_TRUE;
+				}
+				if (mum_stop_requested_self()) {
+					mum_idle_end(idle, &st);
+					return MU_FALSE;
+				}
+
+				uint64_m wait = mum_idle_park_ns(idle);
+				if (deadline != MUM_NO_TIMEOUT) {
+					uint64_m time = mum_time_ns();
+					if (time >= deadline) {
+						mum_idle_end(idle, &st);
+						return MU_FALSE;
+					}
+					if (deadline - time < wait) {
+						wait = deadline - time;
+					}
+				}
+				if (mum_idle_step(idle, &st)) {
+					mum_park_stoppable(address, value, wait);
+				}
+			}
+		}
+
+		MUDEF void mu_idle_wake(uint32_m* address, muBool all) {
+			mum_futex_wake(address, all);
+		}
+
+		MUDEF void mu_idle_strategy_stats(muIdleStrategy strategy, uint64_m* waits, uint64_m* spin_ns, uint64_m* yield_ns, uint64_m* park_ns, uint64_m* parks) {
+			mum_idle* idle = (mum_idle*)strategy;
+			if (waits) {
+				*waits = mum_atomic_load64(&idle->waits, MUM_RELAXED);
+			}
+			if (spin_ns) {
+				*spin_ns = mum_atomic_load64(&idle->spin_time, MUM_RELAXED);
+			}
+			if (yield_ns) {
+				*yield_ns = mum_atomic_load64(&idle->yield_time, MUM_RELAXED);
+			}
+			if (park_ns) {
+				*park_ns = mum_atomic_load64(&idle->park_time, MUM_RELAXED);
+			}
+			if (parks) {
+				*parks = mum_atomic_load64(&idle->parks, MUM_RELAXED);
+			}
+		}
+
+	/* Win32 */
+
+	#ifdef MU_WIN32
+
+		/* Thread */
+
+			struct mum_win32_thread {
+				struct mum_thread_state state;
+				HANDLE handle;
+			};
+			typedef struct mum_win32_thread mum_win32_thread;
+
+			static DWORD WINAPI mum_win32_thread_start(LPVOID thread) {
+				mum_win32_thread* p = (mum_win32_thread*)thread;
+				mum_current_thread = &p->state;
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_START, MUM_TRACE_THREAD, p);
+
+				if (mum_thread_state_enter(&p->state)) {
+					p->state.start(p->state.args);
+				}
+
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_EXIT, MUM_TRACE_THREAD, p);
+				MUM_TRACE_RELEASE_RING();
+				mum_current_thread = 0;
+				mum_thread_state_exit(&p->state);
+				return 0;
+			}
+
+			// Starts a thread whose state has been initialized, bound to the given affinity if it
+			// isn't 0; returns whether it was started
+			static muBool mum_win32_thread_launch(mumResult* result, mum_win32_thread* p, GROUP_AFFINITY* affinity) {
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_CREATE, MUM_TRACE_THREAD, p);
+				DWORD id;
+				p->handle = CreateThread(0, 0, mum_win32_thread_start, p, affinity ? CREATE_SUSPENDED : 0, &id);
+				if (p->handle == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_CREATE_THREAD)
+					return MU_FALSE;
+				}
+
+				// The thread is bound whilst it's suspended, so it never runs anywhere else
+				if (affinity) {
+					if (SetThreadGroupAffinity(p->handle, affinity, 0) == 0) {
+						MU_SET_RESULT(result, MUM_FAILED_SET_THREAD_GROUP_AFFINITY)
+						TerminateThread(p->handle, 0);
+						CloseHandle(p->handle);
+						return MU_FALSE;
+					}
+					ResumeThread(p->handle);
+				}
+
+				return MU_TRUE;
+			}
+
+			// Creates a thread, bound to the given affinity if it isn't 0
+			static muThread mum_win32_thread_create(mumResult* result, void (*start)(void* args), void* args, GROUP_AFFINITY* affinity) {
+				mum_win32_thread* p = (mum_win32_thread*)mu_malloc(sizeof(mum_win32_thread));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				mum_thread_state_init(&p->state, start, args, 0, 0);
+				if (!mum_win32_thread_launch(result, p, affinity)) {
+					mu_free(p);
+					return 0;
+				}
+
+				return p;
+			}
+
+			MUDEF muThread mu_thread_create_(mumResult* result, void (*start)(void* args), void* args) {
+				return mum_win32_thread_create(result, start, args, 0);
+			}
+
+			MUDEF muThreadGroup mu_thread_create_many_(mumResult* result, size_m count, void (*start)(void* args), void* const* args) {
+				struct mum_thread_group* g = mum_thread_group_alloc(result, count, sizeof(mum_win32_thread));
+				if (!g) {
+					return 0;
+				}
+
+				for (size_m i = 0; i < count; i++) {
+					mum_win32_thread* p = (mum_win32_thread*)mum_thread_group_thread(g, i);
+					mum_thread_state_init(&p->state, start, args ? args[i] : 0, g, (uint32_m)i);
+					if (!mum_win32_thread_launch(result, p, 0)) {
+						// The threads created so far exit without running anything
+						mum_thread_group_open(g, MU_FALSE);
+						for (size_m j = 0; j < i; j++) {
+							p = (mum_win32_thread*)mum_thread_group_thread(g, j);
+							WaitForSingleObject(p->handle, INFINITE);
+							CloseHandle(p->handle);
+						}
+						mu_free(g);
+						return 0;
+					}
+				}
+
+				mum_thread_group_open(g, MU_TRUE);
+				return g;
+			}
+
+			MUDEF muThreadGroup mu_thread_destroy_many_(mumResult* result, muThreadGroup group, mumThreadDestroyMode mode) {
+				struct mum_thread_group* g = (struct mum_thread_group*)group;
+
+				if (mode == MUM_THREAD_DESTROY_JOIN) {
+					for (size_m i = 0; i < g->count; i++) {
+						mum_thread_state_request_stop(mum_thread_group_thread(g, i));
+					}
+
+					// Not stoppable, as the group is freed once its threads have been joined
+					mum_thread_group_wait_finished(g, g->count, MU_FALSE);
+					mumResult wait_result = MUM_SUCCESS;
+					mu_thread_wait_all_(&wait_result, group);
+					if (wait_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, wait_result)
+						return group;
+					}
+				}
+
+				for (size_m i = 0; i < g->count; i++) {
+					if (CloseHandle(((mum_win32_thread*)mum_thread_group_thread(g, i))->handle) == 0) {
+						MU_SET_RESULT(result, MUM_FAILED_CLOSE_HANDLE)
+					}
+				}
+
+				mum_thread_group_release(g);
+				return 0;
+			}
+
+			MUDEF muThread mu_thread_destroy_(mumResult* result, muThread thread) {
+				return mu_thread_destroy_mode_(result, thread, MUM_THREAD_DESTROY_CANCEL);
+			}
+
+			MUDEF muThread mu_thread_destroy_mode_(mumResult* result, muThread thread, mumThreadDestroyMode mode) {
+				mum_win32_thread* p = (mum_win32_thread*)thread;
+
+				if (mode == MUM_THREAD_DESTROY_JOIN && !p->state.waited) {
+					mum_thread_state_request_stop(&p->state);
+
+					mumResult wait_result = MUM_SUCCESS;
+					mu_thread_wait_(&wait_result, thread);
+					if (wait_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, wait_result)
+						return thread;
+					}
+				}
+
+				if (CloseHandle(p->handle) == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_CLOSE_HANDLE)
+					return thread;
+				}
+
+				mum_thread_state_release(&p->state);
+				return 0;
+			}
+
+			MUDEF void mu_thread_exit(void* ret) {
+				// ExitThread never returns to the start routine, so its reference is dropped here
+				struct mum_thread_state* self = mum_current_thread;
+				if (self) {
+					MUM_TRACE_EVENT(MUM_TRACE_THREAD_EXIT, MUM_TRACE_THREAD, self);
+					MUM_TRACE_RELEASE_RING();
+					mum_current_thread = 0;
+					mum_thread_state_exit(self);
+				}
+
+				DWORD d;
+				mu_memcpy(&d, &ret, sizeof(DWORD));
+				ExitThread(d);
+			}
+
+			MUDEF void mu_thread_wait_(mumResult* result, muThread thread) {
+				mum_win32_thread* p = (mum_win32_thread*)thread;
+
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAIT, MUM_TRACE_THREAD, p);
+				DWORD wait_result = WaitForSingleObject(p->handle, INFINITE);
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAITED, MUM_TRACE_THREAD, p);
+
+				switch (wait_result) {
+					default: {
+						p->state.waited = MU_TRUE;
+					} break;
+					case WAIT_TIMEOUT: {
+						MU_SET_RESULT(result, MUM_THREAD_WAIT_TIMEOUT)
+					} break;
+					case WAIT_FAILED: {
+						MU_SET_RESULT(result, MUM_THREAD_WAIT_FAILED)
+					} break;
+				}
+			}
+
+			MUDEF void* mu_thread_get_return_value_(mumResult* result, muThread thread) {
+				mum_win32_thread* p = (mum_win32_thread*)thread;
+
+				DWORD exit_code = 0;
+				if (GetExitCodeThread(p->handle, &exit_code) == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_GET_EXIT_CODE_THREAD)
+					return 0;
+				}
+
+				void* tp;
+				mu_memcpy(&tp, &exit_code, sizeof(DWORD));
+				return tp;
+			}
+
+		/* Mutex */
+
+			struct mum_win32_mutex {
+				HANDLE handle;
+			};
+			typedef struct mum_win32_mutex mum_win32_mutex;
+
+			MUDEF muMutex mu_mutex_create_(mumResult* result) {
+				mum_win32_mutex* p = (mum_win32_mutex*)mu_malloc(sizeof(mum_win32_mutex));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->handle = CreateMutex(0, MU_FALSE, 0);
+				if (p->handle == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_CREATE_MUTEX)
+					mu_free(p);
+					return 0;
+				}
+
+				return (muMutex)p;
+			}
+
+			MUDEF muMutex mu_mutex_destroy_(mumResult* result, muMutex mutex) {
+				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+
+				if (CloseHandle(p->handle) == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_CLOSE_HANDLE)
+					return p;
+				}
+
+				mu_free(p);
+				return 0;
+			}
+
+			MUDEF void mu_mutex_lock_(mumResult* result, muMutex mutex) {
+				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+
+				#ifdef MUM_TRACE
+					// Try without waiting first to tell whether the mutex was contended
+					DWORD wait_result = WaitForSingleObject(p->handle, 0);
+					if (wait_result == WAIT_TIMEOUT) {
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_MUTEX, p);
+						wait_result = WaitForSingleObject(p->handle, INFINITE);
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_MUTEX, p);
+					} else {
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_MUTEX, p);
+					}
+				#else
+					DWORD wait_result = WaitForSingleObject(p->handle, INFINITE);
+				#endif
+
+				switch (wait_result) {
+					// The mutex has most likely been closed. This should pretty much never happen with
+					// the way mum is set up, but if it has, that's really bad. Most likely, rather mum
+					// is not working as intended at all, or the user has modified things that they
+					// shouldn't.
+					case WAIT_FAILED: {
+						MU_SET_RESULT(result, MUM_MUTEX_WAIT_FAILED)
+					} break;
+
+					// The thread holding the mutex has died. This can be due to a few things:
+					// * The thread crashed or otherwise imploded in on itself.
+					// * The user has fiddled around with values they shouldn't.
+					// Either way, this is REALLY, REALLY bad, and will lead to sporadic random bugs &
+					// crashes.
+					// Note: we still have ownership due to this, but ehhhhh.
+					// https://devblogs.microsoft.com/oldnewthing/20050912-14/?p=34253
+					// (Raymond Chen is awesome btw)
+					case WAIT_ABANDONED: {
+						MU_SET_RESULT(result, MUM_MUTEX_WAIT_ABANDONED)
+					} break;
+				}
+			}
+
+			MUDEF void mu_mutex_unlock_(mumResult* result, muMutex mutex) {
+				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_MUTEX, p);
+				if (ReleaseMutex(p->handle) == 0) {
+					MU_SET_RESULT(result, MUM_FAILED_RELEASE_MUTEX)
+				}
+			}
+
+		/* Spinlock */
+
+			struct mum_win32_spinlock {
+				LONG volatile locked;
+				mum_idle* idle;
+			};
+			typedef struct mum_win32_spinlock mum_win32_spinlock;
+
+			MUDEF muSpinlock mu_spinlock_create_(mumResult* result) {
+				mum_win32_spinlock* p = (mum_win32_spinlock*)mu_malloc(sizeof(mum_win32_spinlock));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->locked = 0;
+				p->idle = 0;
+				return p;
+			}
+
+			MUDEF muSpinlock mu_spinlock_destroy_(mumResult* result, muSpinlock spinlock) {
+				mu_free(spinlock);
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_spinlock_lock_(mumResult* result, muSpinlock spinlock) {
+				mum_win32_spinlock* p = (mum_win32_spinlock*)spinlock;
+
+				#ifdef MUM_TRACE
+					if (InterlockedCompareExchange(&p->locked, 1, 0) == 0) {
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_SPINLOCK, p);
+						return;
+					}
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_SPINLOCK, p);
+				#endif
+
+				if (p->idle) {
+					mum_idle_lock(p->idle, (volatile uint32_m*)&p->locked);
+				} else {
+					while (InterlockedCompareExchange(&p->locked, 1, 0) == 1) {}
+				}
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_SPINLOCK, p);
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_spinlock_unlock_(mumResult* result, muSpinlock spinlock) {
+				mum_win32_spinlock* p = (mum_win32_spinlock*)spinlock;
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_SPINLOCK, p);
+				if (p->idle) {
+					mum_idle_unlock((volatile uint32_m*)&p->locked);
+				} else {
+					_interlockedbittestandreset(&p->locked, 0);
+				}
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_spinlock_set_idle(muSpinlock spinlock, muIdleStrategy strategy) {
+				((mum_win32_spinlock*)spinlock)->idle = (mum_idle*)strategy;
+			}
+
+		/* Topology */
+
+			static void mum_topology_discover(struct mum_topology* t) {
+				DWORD length = 0;
+				GetLogicalProcessorInformationEx(RelationAll, 0, &length);
+				uint8_m* info_buf = (uint8_m*)mu_malloc(length ? length : 1);
+				if (!info_buf || !GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)info_buf, &length)) {
+					if (info_buf) {
+						mu_free(info_buf);
+					}
+					mum_topology_fallback(t);
+					return;
+				}
+
+				// OS CPU numbers are group * 64 + the CPU's number within its group
+				uint32_m cpu_count = 0;
+				uint32_m node_count = 0;
+				uint32_m limit = 0;
+				for (DWORD offset = 0; offset < length;) {
+					PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(info_buf + offset);
+					if (info->Relationship == RelationProcessorCore) {
+						for (WORD g = 0; g < info->Processor.GroupCount; g++) {
+							KAFFINITY mask = info->Processor.GroupMask[g].Mask;
+							for (uint32_m bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+								if (mask & ((KAFFINITY)1 << bit)) {
+									uint32_m os = (uint32_m)info->Processor.GroupMask[g].Group * 64 + bit;
+									cpu_count++;
+									if (os + 1 > limit) {
+										limit = os + 1;
+									}
+								}
+							}
+						}
+					} else if (info->Relationship == RelationNumaNode) {
+						node_count++;
+					}
+					offset += info->Size;
+				}
+
+				uint32_m* block = (cpu_count == 0) ? 0 : (uint32_m*)mu_malloc(sizeof(uint32_m) * (cpu_count * 5 + (node_count ? node_count : 1) + limit));
+				if (!block) {
+					mu_free(info_buf);
+					mum_topology_fallback(t);
+					return;
+				}
+				t->cpu_count = cpu_count;
+				t->os_cpu = block;
+				t->core = t->os_cpu + cpu_count;
+				t->llc = t->core + cpu_count;
+				t->node = t->llc + cpu_count;
+				t->os_node = t->node + cpu_count;
+				t->cpu_of_os = t->os_node + (node_count ? node_count : 1);
+				t->os_cpu_limit = limit;
+				uint32_m* best_level = t->cpu_of_os + limit;
+
+				for (uint32_m i = 0; i < limit; i++) {
+					t->cpu_of_os[i] = 0xFFFFFFFF;
+				}
+
+				// Cores come first so that every CPU has an index before caches and nodes refer to it
+				uint32_m cpu = 0;
+				uint32_m core = 0;
+				for (DWORD offset = 0; offset < length; offset += ((PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(info_buf + offset))->Size) {
+					PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(info_buf + offset);
+					if (info->Relationship != RelationProcessorCore) {
+						continue;
+					}
+					for (WORD g = 0; g < info->Processor.GroupCount; g++) {
+						KAFFINITY mask = info->Processor.GroupMask[g].Mask;
+						for (uint32_m bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+							if (mask & ((KAFFINITY)1 << bit)) {
+								uint32_m os = (uint32_m)info->Processor.GroupMask[g].Group * 64 + bit;
+								t->os_cpu[cpu] = os;
+								t->cpu_of_os[os] = cpu;
+								t->core[cpu] = core;
+								t->llc[cpu] = core;
+								t->node[cpu] = 0;
+								best_level[cpu] = 0;
+								cpu++;
+							}
+						}
+					}
+					core++;
+				}
+				t->core_count = core;
+
+				uint32_m cache = 0;
+				uint32_m node = 0;
+				for (DWORD offset = 0; offset < length; offset += ((PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(info_buf + offset))->Size) {
+					PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(info_buf + offset);
+					GROUP_AFFINITY affinity;
+					if (info->Relationship == RelationCache) {
+						affinity = info->Cache.GroupMask;
+					} else if (info->Relationship == RelationNumaNode) {
+						affinity = info->NumaNode.GroupMask;
+						t->os_node[node] = (uint32_m)info->NumaNode.NodeNumber;
+					} else {
+						continue;
+					}
+
+					for (uint32_m bit = 0; bit < sizeof(KAFFINITY) * 8; bit++) {
+						uint32_m os = (uint32_m)affinity.Group * 64 + bit;
+						if (!(affinity.Mask & ((KAFFINITY)1 << bit)) || os >= limit || t->cpu_of_os[os] == 0xFFFFFFFF) {
+							continue;
+						}
+						uint32_m i = t->cpu_of_os[os];
+
+						if (info->Relationship == RelationNumaNode) {
+							t->node[i] = node;
+						} else if (info->Cache.Level > best_level[i]) {
+							// Caches are keyed by the number of the cache (plus the core count, so
+							// that CPUs without any cache keep a key of their own)
+							best_level[i] = info->Cache.Level;
+							t->llc[i] = core + cache;
+						}
+					}
+
+					if (info->Relationship == RelationCache) {
+						cache++;
+					} else {
+						node++;
+					}
+				}
+				mu_free(info_buf);
+
+				t->node_count = node ? node : 1;
+				if (!node) {
+					t->os_node[0] = 0;
+				}
+
+				// Renumber the caches, which needs scratch space for every key
+				uint32_m* keys = (uint32_m*)mu_malloc(sizeof(uint32_m) * (core + cache));
+				if (keys) {
+					t->llc_count = mum_topology_densify(t->llc, cpu_count, keys, core + cache);
+					mu_free(keys);
+				} else {
+					for (uint32_m i = 0; i < cpu_count; i++) {
+						t->llc[i] = t->core[i];
+					}
+					t->llc_count = core;
+				}
+			}
+
+			static uint32_m mum_topology_current_os_cpu(void) {
+				PROCESSOR_NUMBER number;
+				GetCurrentProcessorNumberEx(&number);
+				return (uint32_m)number.Group * 64 + (uint32_m)number.Number;
+			}
+
+			// Creates a thread bound to the CPUs for which (cpu == ~0 || i == cpu) and (node == ~0 ||
+			// their node == node); a thread can only be bound within one processor group, so the
+			// group of the first matching CPU is used
+			static muThread mum_thread_create_bound(mumResult* result, void (*start)(void* args), void* args, uint32_m cpu, uint32_m node) {
+				struct mum_topology* t = mum_topology_get();
+
+				GROUP_AFFINITY affinity;
+				affinity.Mask = 0;
+				affinity.Group = 0;
+				affinity.Reserved[0] = affinity.Reserved[1] = affinity.Reserved[2] = 0;
+				muBool found = MU_FALSE;
+				for (uint32_m i = 0; i < t->cpu_count; i++) {
+					if ((cpu != 0xFFFFFFFF && i != cpu) || (node != 0xFFFFFFFF && t->node[i] != node)) {
+						continue;
+					}
+					WORD group = (WORD)(t->os_cpu[i] / 64);
+					if (!found) {
+						affinity.Group = group;
+						found = MU_TRUE;
+					}
+					if (group == affinity.Group) {
+						affinity.Mask |= (KAFFINITY)1 << (t->os_cpu[i] % 64);
+					}
+				}
+
+				return mum_win32_thread_create(result, start, args, &affinity);
+			}
+
+	#endif
+
+	/* Unix */
+
+	#ifdef MU_UNIX
+
+		/* Thread */
+
+			// The CPUs a thread binds itself to before running anything, and where it then reports
+			// whether that worked; lives on the creating thread's stack
+			struct mum_unix_bind {
+				unsigned long mask[16];
+				// 0 until the thread has tried, then 1 if it's bound, or 2 if it isn't
+				uint32_m state;
+			};
+
+			struct mum_unix_thread {
+				struct mum_thread_state state;
+				pthread_t thread;
+				void* ret;
+				// 0 if the thread isn't bound
+				struct mum_unix_bind* bind;
+			};
+			typedef struct mum_unix_thread mum_unix_thread;
+
+			static void mum_unix_thread_cleanup(void* thread) {
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_EXIT, MUM_TRACE_THREAD, thread);
+				MUM_TRACE_RELEASE_RING();
+				mum_current_thread = 0;
+				mum_thread_state_exit((struct mum_thread_state*)thread);
+			}
+
+			// Binds the calling thread if it's meant to be, and reports back; returns whether it
+			// should go on to run
+			static muBool mum_unix_thread_bind(mum_unix_thread* p) {
+				struct mum_unix_bind* b = p->bind;
+				if (!b) {
+					return MU_TRUE;
+				}
+
+				muBool bound = MU_FALSE;
+				#if defined(__linux__) && defined(SYS_sched_setaffinity)
+					bound = syscall(SYS_sched_setaffinity, 0, sizeof(b->mask), b->mask) == 0;
+				#endif
+				// The creating thread may return as soon as it sees this, so b isn't touched after
+				mum_atomic_store32(&b->state, bound ? 1 : 2, MUM_RELEASE);
+				mum_futex_wake(&b->state, MU_FALSE);
+				return bound;
+			}
+
+			static void* mum_unix_thread_start(void* thread) {
+				mum_unix_thread* p = (mum_unix_thread*)thread;
+				mum_current_thread = &p->state;
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_START, MUM_TRACE_THREAD, p);
+
+				// Also runs if the thread calls mu_thread_exit or is cancelled
+				pthread_cleanup_push(mum_unix_thread_cleanup, p);
+				if (mum_unix_thread_bind(p) && mum_thread_state_enter(&p->state)) {
+					p->state.start(p->state.args);
+				}
+				pthread_cleanup_pop(1);
+
+				return 0;
+			}
+
+			// Starts a thread whose state has been initialized, bound as described by bind if it
+			// isn't 0; returns whether it was started
+			static muBool mum_unix_thread_launch(mumResult* result, mum_unix_thread* p, struct mum_unix_bind* bind) {
+				p->ret = 0;
+				p->bind = bind;
+
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_CREATE, MUM_TRACE_THREAD, p);
+				if (pthread_create(&p->thread, 0, mum_unix_thread_start, p) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_CREATE)
+					return MU_FALSE;
+				}
+
+				return MU_TRUE;
+			}
+
+			// Creates a thread, bound as described by bind if it isn't 0
+			static muThread mum_unix_thread_create(mumResult* result, void (*start)(void* args), void* args, struct mum_unix_bind* bind) {
+				mum_unix_thread* p = (mum_unix_thread*)mu_malloc(sizeof(mum_unix_thread));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				mum_thread_state_init(&p->state, start, args, 0, 0);
+				if (!mum_unix_thread_launch(result, p, bind)) {
+					mu_free(p);
+					return 0;
+				}
+
+				if (bind) {
+					uint32_m state;
+					while ((state = mum_atomic_load32(&bind->state, MUM_ACQUIRE)) == 0) {
+						mum_futex_wait(&bind->state, 0, MUM_NO_TIMEOUT);
+					}
+					if (state != 1) {
+						// The thread has exited without running anything
+						MU_SET_RESULT(result, MUM_FAILED_PTHREAD_SETAFFINITY)
+						pthread_join(p->thread, 0);
+						mum_thread_state_release(&p->state);
+						return 0;
+					}
+				}
+
+				return (muThread)p;
+			}
+
+			MUDEF muThread mu_thread_create_(mumResult* result, void (*start)(void* args), void* args) {
+				return mum_unix_thread_create(result, start, args, 0);
+			}
+
+			MUDEF muThreadGroup mu_thread_create_many_(mumResult* result, size_m count, void (*start)(void* args), void* const* args) {
+				struct mum_thread_group* g = mum_thread_group_alloc(result, count, sizeof(mum_unix_thread));
+				if (!g) {
+					return 0;
+				}
+
+				for (size_m i = 0; i < count; i++) {
+					mum_unix_thread* p = (mum_unix_thread*)mum_thread_group_thread(g, i);
+					mum_thread_state_init(&p->state, start, args ? args[i] : 0, g, (uint32_m)i);
+					if (!mum_unix_thread_launch(result, p, 0)) {
+						// The threads created so far exit without running anything
+						mum_thread_group_open(g, MU_FALSE);
+						for (size_m j = 0; j < i; j++) {
+							pthread_join(((mum_unix_thread*)mum_thread_group_thread(g, j))->thread, 0);
+						}
+						mu_free(g);
+						return 0;
+					}
+				}
+
+				mum_thread_group_open(g, MU_TRUE);
+				return g;
+			}
+
+			MUDEF muThreadGroup mu_thread_destroy_many_(mumResult* result, muThreadGroup group, mumThreadDestroyMode mode) {
+				struct mum_thread_group* g = (struct mum_thread_group*)group;
+
+				if (mode == MUM_THREAD_DESTROY_JOIN) {
+					for (size_m i = 0; i < g->count; i++) {
+						mum_thread_state_request_stop(mum_thread_group_thread(g, i));
+					}
+
+					// Not stoppable, as the group is freed once its threads have been joined
+					mum_thread_group_wait_finished(g, g->count, MU_FALSE);
+					mumResult wait_result = MUM_SUCCESS;
+					mu_thread_wait_all_(&wait_result, group);
+					if (wait_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, wait_result)
+						return group;
+					}
+				} else {
+					// Same as destroying each thread on its own, except that the memory is only
+					// freed once every thread has exited
+					for (size_m i = 0; i < g->count; i++) {
+						mum_unix_thread* p = (mum_unix_thread*)mum_thread_group_thread(g, i);
+						if (p->state.waited) {
+							continue;
+						}
+						if (pthread_cancel(p->thread) != 0) {
+							MU_SET_RESULT(result, MUM_FAILED_PTHREAD_CANCEL)
+						}
+						if (pthread_detach(p->thread) != 0) {
+							MU_SET_RESULT(result, MUM_FAILED_PTHREAD_DETACH)
+						}
+					}
+				}
+
+				mum_thread_group_release(g);
+				return 0;
+			}
+
+			MUDEF muThread mu_thread_destroy_(mumResult* result, muThread thread) {
+				return mu_thread_destroy_mode_(result, thread, MUM_THREAD_DESTROY_CANCEL);
+			}
+
+			MUDEF muThread mu_thread_destroy_mode_(mumResult* result, muThread thread, mumThreadDestroyMode mode) {
+				mum_unix_thread* p = (mum_unix_thread*)thread;
+
+				// A thread that has been joined no longer exists, so there's nothing left to stop
+				if (!p->state.waited) {
+					if (mode == MUM_THREAD_DESTROY_JOIN) {
+						mum_thread_state_request_stop(&p->state);
+
+						MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAIT, MUM_TRACE_THREAD, p);
+						int join_result = pthread_join(p->thread, &p->ret);
+						MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAITED, MUM_TRACE_THREAD, p);
+						if (join_result != 0) {
+							MU_SET_RESULT(result, MUM_FAILED_PTHREAD_JOIN)
+							return thread;
+						}
+						p->state.waited = MU_TRUE;
+					} else {
+						if (pthread_cancel(p->thread) != 0) {
+							MU_SET_RESULT(result, MUM_FAILED_PTHREAD_CANCEL)
+							return thread;
+						}
+
+						// Nobody is going to join the cancelled thread, so let its resources be
+						// reclaimed once it actually exits
+						if (pthread_detach(p->thread) != 0) {
+							MU_SET_RESULT(result, MUM_FAILED_PTHREAD_DETACH)
+						}
+					}
+				}
+
+				mum_thread_state_release(&p->state);
+				return 0;
+			}
+
+			MUDEF void mu_thread_exit(void* ret) {
+				pthread_exit(ret);
+			}
+
+			MUDEF void mu_thread_wait_(mumResult* result, muThread thread) {
+				mum_unix_thread* p = (mum_unix_thread*)thread;
+
+				if (p->state.waited) {
+					return;
+				}
+
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAIT, MUM_TRACE_THREAD, p);
+				int join_result = pthread_join(p->thread, &p->ret);
+				MUM_TRACE_EVENT(MUM_TRACE_THREAD_WAITED, MUM_TRACE_THREAD, p);
+				if (join_result != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_JOIN)
+					return;
+				}
+				p->state.waited = MU_TRUE;
+			}
+
+			MUDEF void* mu_thread_get_return_value_(mumResult* result, muThread thread) {
+				return ((mum_unix_thread*)thread)->ret;
+				if (result) {}
+			}
+
+		/* Mutex */
+
+			struct mum_unix_mutex {
+				pthread_mutex_t mutex;
+			};
+			typedef struct mum_unix_mutex mum_unix_mutex;
+
+			MUDEF muMutex mu_mutex_create_(mumResult* result) {
+				mum_unix_mutex* p = (mum_unix_mutex*)mu_malloc(sizeof(mum_unix_mutex));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				if (pthread_mutex_init(&p->mutex, 0) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_INIT)
+					mu_free(p);
+					return 0;
+				}
+
+				return (muMutex)p;
+			}
+
+			MUDEF muMutex mu_mutex_destroy_(mumResult* result, muMutex mutex) {
+				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+
+				if (pthread_mutex_destroy(&p->mutex) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_DESTROY)
+					return mutex;
+				}
+
+				mu_free(p);
+				return 0;
+			}
+
+			MUDEF void mu_mutex_lock_(mumResult* result, muMutex mutex) {
+				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+
+				#ifdef MUM_TRACE
+					// Try without waiting first to tell whether the mutex was contended
+					if (pthread_mutex_trylock(&p->mutex) == 0) {
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_MUTEX, p);
+						return;
+					}
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_MUTEX, p);
+				#endif
+
+				if (pthread_mutex_lock(&p->mutex) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_LOCK)
+					return;
+				}
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_MUTEX, p);
+			}
+
+			MUDEF void mu_mutex_unlock_(mumResult* result, muMutex mutex) {
+				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_MUTEX, p);
+				if (pthread_mutex_unlock(&p->mutex) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_UNLOCK)
+				}
+			}
+
+		/* Spinlock */
+
+			struct mum_unix_spinlock {
+				int locked;
+				mum_idle* idle;
+			};
+			typedef struct mum_unix_spinlock mum_unix_spinlock;
+
+			MUDEF muSpinlock mu_spinlock_create_(mumResult* result) {
+				mum_unix_spinlock* p = (mum_unix_spinlock*)mu_malloc(sizeof(mum_unix_spinlock));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->locked = 0;
+				p->idle = 0;
+				return (muSpinlock)p;
+			}
+
+			MUDEF muSpinlock mu_spinlock_destroy_(mumResult* result, muSpinlock spinlock) {
+				mu_free(spinlock);
+				return 0; if (result) {}
+			}
+
+			static inline muBool mum_atomic_compare_exchange(int* ptr, int compare, int exchange) {
+				return __atomic_compare_exchange_n(ptr, &compare, exchange, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			MUDEF void mu_spinlock_lock_(mumResult* result, muSpinlock spinlock) {
+				mum_unix_spinlock* p = (mum_unix_spinlock*)spinlock;
+
+				#ifdef MUM_TRACE
+					if (mum_atomic_compare_exchange(&p->locked, 0, 1)) {
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_SPINLOCK, p);
+						return;
+					}
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_SPINLOCK, p);
+				#endif
+
+				if (p->idle) {
+					mum_idle_lock(p->idle, (volatile uint32_m*)&p->locked);
+				} else {
+					while (!mum_atomic_compare_exchange(&p->locked, 0, 1)) {}
+				}
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_SPINLOCK, p);
+
+				return; if (result) {}
+			}
+
+			static inline void mum_atomic_store(int* ptr, int value) {
+				if (value) {}
+				__atomic_store_n(ptr, 0, __ATOMIC_SEQ_CST);
+			}
+
+			MUDEF void mu_spinlock_unlock_(mumResult* result, muSpinlock spinlock) {
+				mum_unix_spinlock* p = (mum_unix_spinlock*)spinlock;
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_SPINLOCK, p);
+				if (p->idle) {
+					mum_idle_unlock((volatile uint32_m*)&p->locked);
+				} else {
+					mum_atomic_store(&p->locked, 0);
+				}
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_spinlock_set_idle(muSpinlock spinlock, muIdleStrategy strategy) {
+				((mum_unix_spinlock*)spinlock)->idle = (mum_idle*)strategy;
+			}
+
+		/* Topology */
+
+		#ifdef __linux__
+
+			// Reads a small sysfs file as a null-terminated string
+			static muBool mum_unix_read_file(const char* path, char* buf, size_m size) {
+				int fd = open(path, O_RDONLY);
+				if (fd < 0) {
+					return MU_FALSE;
+				}
+				ssize_t length = read(fd, buf, size - 1);
+				close(fd);
+
+				if (length <= 0) {
+					return MU_FALSE;
+				}
+				buf[length] = 0;
+				return MU_TRUE;
+			}
+
+			// Builds prefix + number + suffix into buf
+			static const char* mum_unix_path(char* buf, const char* prefix, uint32_m number, const char* suffix) {
+				char digits[10];
+				size_m digit_count = 0;
+				do {
+					digits[digit_count++] = (char)('0' + number % 10);
+					number /= 10;
+				} while (number);
+
+				char* p = buf;
+				while (*prefix) {
+					*p++ = *prefix++;
+				}
+				while (digit_count) {
+					*p++ = digits[--digit_count];
+				}
+				while (*suffix) {
+					*p++ = *suffix++;
+				}
+				*p = 0;
+				return buf;
+			}
+
+			// Parses the next range of a sysfs list such as "0-3,8,10-11", returning 0 once there
+			// are none left
+			static const char* mum_unix_next_range(const char* s, uint32_m* first, uint32_m* last) {
+				while (*s == ',' || *s == ' ' || *s == '\n') {
+					s++;
+				}
+				if (*s < '0' || *s > '9') {
+					return 0;
+				}
+
+				*first = 0;
+				while (*s >= '0' && *s <= '9') {
+					*first = *first * 10 + (uint32_m)(*s++ - '0');
+				}
+				*last = *first;
+				if (*s == '-') {
+					s++;
+					*last = 0;
+					while (*s >= '0' && *s <= '9') {
+						*last = *last * 10 + (uint32_m)(*s++ - '0');
+					}
+				}
+				return s;
+			}
+
+			static void mum_topology_discover(struct mum_topology* t) {
+				static const char cpu_dir[] = "/sys/devices/system/cpu/cpu";
+				char buf[4096];
+				char path[128];
+				const char* s;
+				uint32_m first, last;
+
+				// Count the online CPUs and the highest OS CPU number
+				uint32_m cpu_count = 0;
+				uint32_m limit = 0;
+				if (mum_unix_read_file("/sys/devices/system/cpu/online", buf, sizeof(buf))) {
+					for (s = buf; (s = mum_unix_next_range(s, &first, &last)) != 0;) {
+						if (last >= first && last < 65536) {
+							cpu_count += last - first + 1;
+							limit = last + 1;
+						}
+					}
+				}
+				if (cpu_count == 0) {
+					long online = sysconf(_SC_NPROCESSORS_ONLN);
+					cpu_count = limit = online > 0 ? (uint32_m)online : 1;
+					buf[0] = 0;
+				}
+
+				// Count the online nodes
+				uint32_m node_count = 0;
+				uint32_m node_limit = 0;
+				char nodes[1024];
+				if (!mum_unix_read_file("/sys/devices/system/node/online", nodes, sizeof(nodes))) {
+					nodes[0] = 0;
+				}
+				for (s = nodes; (s = mum_unix_next_range(s, &first, &last)) != 0;) {
+					if (last >= first && last < 65536) {
+						node_count += last - first + 1;
+						node_limit = last + 1;
+					}
+				}
+
+				uint32_m scratch_size = limit > node_limit ? limit : node_limit;
+				uint32_m* block = (uint32_m*)mu_malloc(sizeof(uint32_m) * (cpu_count * 4 + (node_count ? node_count : 1) + limit + scratch_size));
+				if (!block) {
+					mum_topology_fallback(t);
+					return;
+				}
+				t->cpu_count = cpu_count;
+				t->os_cpu = block;
+				t->core = t->os_cpu + cpu_count;
+				t->llc = t->core + cpu_count;
+				t->node = t->llc + cpu_count;
+				t->os_node = t->node + cpu_count;
+				t->cpu_of_os = t->os_node + (node_count ? node_count : 1);
+				t->os_cpu_limit = limit;
+				uint32_m* scratch = t->cpu_of_os + limit;
+
+				for (uint32_m i = 0; i < limit; i++) {
+					t->cpu_of_os[i] = 0xFFFFFFFF;
+				}
+				if (buf[0]) {
+					uint32_m i = 0;
+					for (s = buf; (s = mum_unix_next_range(s, &first, &last)) != 0;) {
+						for (uint32_m cpu = first; last >= first && last < 65536 && cpu <= last; cpu++) {
+							t->os_cpu[i] = cpu;
+							t->cpu_of_os[cpu] = i++;
+						}
+					}
+				} else {
+					for (uint32_m i = 0; i < cpu_count; i++) {
+						t->os_cpu[i] = i;
+						t->cpu_of_os[i] = i;
+					}
+				}
+
+				for (uint32_m i = 0; i < cpu_count; i++) {
+					uint32_m os = t->os_cpu[i];
+
+					// A core is identified by the lowest CPU among its SMT siblings
+					t->core[i] = os;
+					if (mum_unix_read_file(mum_unix_path(path, cpu_dir, os, "/topology/thread_siblings_list"), buf, sizeof(buf))) {
+						if (mum_unix_next_range(buf, &first, &last) && first < limit) {
+							t->core[i] = first;
+						}
+					}
+
+					// Likewise, a last-level cache by the lowest CPU sharing the highest-level cache
+					t->llc[i] = t->core[i];
+					uint32_m best_level = 0;
+					for (uint32_m index = 0; index < 16; index++) {
+						char name[32];
+						mum_unix_path(name, "/cache/index", index, "/level");
+						if (!mum_unix_read_file(mum_unix_path(path, cpu_dir, os, name), buf, sizeof(buf))) {
+							break;
+						}
+						uint32_m level = (uint32_m)(buf[0] - '0');
+						if (level <= best_level) {
+							continue;
+						}
+
+						mum_unix_path(name, "/cache/index", index, "/shared_cpu_list");
+						if (mum_unix_read_file(mum_unix_path(path, cpu_dir, os, name), buf, sizeof(buf))) {
+							if (mum_unix_next_range(buf, &first, &last) && first < limit) {
+								t->llc[i] = first;
+								best_level = level;
+							}
+						}
+					}
+
+					t->node[i] = 0;
+				}
+
+				t->core_count = mum_topology_densify(t->core, cpu_count, scratch, limit);
+				t->llc_count = mum_topology_densify(t->llc, cpu_count, scratch, limit);
+
+				// Assign every CPU listed by a node to it
+				t->node_count = 0;
+				for (s = nodes; (s = mum_unix_next_range(s, &first, &last)) != 0;) {
+					for (uint32_m node = first; last >= first && last < 65536 && node <= last; node++) {
+						uint32_m index = t->node_count++;
+						t->os_node[index] = node;
+
+						if (!mum_unix_read_file(mum_unix_path(path, "/sys/devices/system/node/node", node, "/cpulist"), buf, sizeof(buf))) {
+							continue;
+						}
+						const char* c = buf;
+						uint32_m cpu_first, cpu_last;
+						while ((c = mum_unix_next_range(c, &cpu_first, &cpu_last)) != 0) {
+							for (uint32_m cpu = cpu_first; cpu <= cpu_last && cpu < limit; cpu++) {
+								if (t->cpu_of_os[cpu] != 0xFFFFFFFF) {
+									t->node[t->cpu_of_os[cpu]] = index;
+								}
+							}
+						}
+					}
+				}
+				if (t->node_count == 0) {
+					t->node_count = 1;
+					t->os_node[0] = 0;
+				}
+			}
+
+			static uint32_m mum_topology_current_os_cpu(void) {
+				// sched_getcpu avoids a system call where the C library can, but needs _GNU_SOURCE
+				#ifdef CPU_SET
+					int cpu = sched_getcpu();
+					return cpu < 0 ? 0xFFFFFFFF : (uint32_m)cpu;
+				#else
+					unsigned cpu = 0;
+					if (syscall(SYS_getcpu, &cpu, 0, 0) != 0) {
+						return 0xFFFFFFFF;
+					}
+					return (uint32_m)cpu;
+				#endif
+			}
+
+		#else
+
+			static void mum_topology_discover(struct mum_topology* t) {
+				long online = sysconf(_SC_NPROCESSORS_ONLN);
+				uint32_m cpu_count = online > 0 ? (uint32_m)online : 1;
+
+				uint32_m* block = (uint32_m*)mu_malloc(sizeof(uint32_m) * (cpu_count * 5 + 1));
+				if (!block) {
+					mum_topology_fallback(t);
+					return;
+				}
+
+				t->cpu_count = t->core_count = t->llc_count = cpu_count;
+				t->node_count = 1;
+				t->os_cpu = block;
+				t->core = t->os_cpu + cpu_count;
+				t->llc = t->core + cpu_count;
+				t->node = t->llc + cpu_count;
+				t->cpu_of_os = t->node + cpu_count;
+				t->os_node = t->cpu_of_os + cpu_count;
+				t->os_cpu_limit = cpu_count;
+
+				for (uint32_m i = 0; i < cpu_count; i++) {
+					t->os_cpu[i] = t->core[i] = t->llc[i] = t->cpu_of_os[i] = i;
+					t->node[i] = 0;
+				}
+				t->os_node[0] = 0;
+			}
+
+			static uint32_m mum_topology_current_os_cpu(void) {
+				return 0xFFFFFFFF;
+			}
+
+		#endif
+
+			// Creates a thread bound to the CPUs for which (cpu == ~0 || i == cpu) and (node == ~0 ||
+			// their node == node)
+			static muThread mum_thread_create_bound(mumResult* result, void (*start)(void* args), void* args, uint32_m cpu, uint32_m node) {
+				#if defined(__linux__) && defined(SYS_sched_setaffinity)
+					// A raw CPU mask, like the one given to SYS_mbind, so that cpu_set_t and
+					// pthread_attr_setaffinity_np (and with them _GNU_SOURCE) aren't needed
+					struct mum_topology* t = mum_topology_get();
+
+					struct mum_unix_bind bind;
+					size_m bits = sizeof(unsigned long) * 8;
+					for (size_m i = 0; i < sizeof(bind.mask) / sizeof(unsigned long); i++) {
+						bind.mask[i] = 0;
+					}
+					bind.state = 0;
+					for (uint32_m i = 0; i < t->cpu_count; i++) {
+						if ((cpu == 0xFFFFFFFF || i == cpu) && (node == 0xFFFFFFFF || t->node[i] == node) && t->os_cpu[i] < sizeof(bind.mask) * 8) {
+							bind.mask[t->os_cpu[i] / bits] |= 1ul << (t->os_cpu[i] % bits);
+						}
+					}
+
+					return mum_unix_thread_create(result, start, args, &bind);
+				#else
+					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_SETAFFINITY)
+					return 0; if (start || args || cpu || node) {}
+				#endif
+			}
+
+	#endif
+
+	/* Shared */
+
+		/* Thread stopping */
+
+			MUDEF void mu_thread_request_stop_(mumResult* result, muThread thread) {
+				mum_thread_state_request_stop((struct mum_thread_state*)thread);
+				return; if (result) {}
+			}
+
+			MUDEF muStopToken mu_thread_get_stop_token(muThread thread) {
+				return (muStopToken)&((struct mum_thread_state*)thread)->stop;
+			}
+
+			MUDEF muStopToken mu_thread_current_stop_token(void) {
+				struct mum_thread_state* self = mum_current_thread;
+				if (!self) {
+					return (muStopToken)&mum_null_stop;
+				}
+				return (muStopToken)&self->stop;
+			}
+
+		/* Thread groups */
+
+			MUDEF void mu_thread_wait_all_(mumResult* result, muThreadGroup group) {
+				struct mum_thread_group* g = (struct mum_thread_group*)group;
+
+				// Sleep once for the whole group rather than once per thread; joining the threads
+				// afterwards is then just cleanup
+				if (!mum_thread_group_wait_finished(g, g->count, MU_TRUE)) {
+					MU_SET_RESULT(result, MUM_STOP_REQUESTED)
+					return;
+				}
+
+				for (size_m i = 0; i < g->count; i++) {
+					mumResult wait_result = MUM_SUCCESS;
+					mu_thread_wait_(&wait_result, mum_thread_group_thread(g, i));
+					if (wait_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, wait_result)
+						return;
+					}
+				}
+			}
+
+			MUDEF size_m mu_thread_wait_any_(mumResult* result, muThreadGroup group) {
+				struct mum_thread_group* g = (struct mum_thread_group*)group;
+				if (g->returned == g->count) {
+					return g->count;
+				}
+
+				if (!mum_thread_group_wait_finished(g, g->returned + 1, MU_TRUE)) {
+					MU_SET_RESULT(result, MUM_STOP_REQUESTED)
+					return g->count;
+				}
+
+				// The finished thread writes its index right after counting itself
+				uint32_m index;
+				while ((index = mum_atomic_load32(&g->finished_order[g->returned], MUM_ACQUIRE)) == 0) {
+					mum_cpu_relax();
+				}
+				index--;
+				g->returned++;
+
+				mu_thread_wait_(result, mum_thread_group_thread(g, index));
+				return index;
+			}
+
+			MUDEF muThread mu_thread_group_get(muThreadGroup group, size_m index) {
+				return mum_thread_group_thread((struct mum_thread_group*)group, index);
+			}
+
+		/* Thread start handoff */
+
+			MUDEF void mum_handoff_wait(uint32_m* flag) {
+				while (mum_atomic_load32(flag, MUM_ACQUIRE) == 0) {
+					mum_futex_wait(flag, 0, MUM_NO_TIMEOUT);
+				}
+			}
+
+			MUDEF void mum_handoff_signal(uint32_m* flag) {
+				mum_atomic_store32(flag, 1, MUM_RELEASE);
+				mum_futex_wake(flag, MU_FALSE);
+			}
+
+		/* Thread sleeping */
+
+			MUDEF muBool mu_thread_sleep(uint32_m milliseconds) {
+				// A mum thread sleeps on its own stop flag, so a stop request wakes it up directly
+				struct mum_thread_state* self = mum_current_thread;
+				uint32_m local = 0;
+				volatile uint32_m* word = self ? &self->stop : &local;
+
+				uint64_m deadline = mum_time_ns() + (uint64_m)milliseconds * 1000000;
+				for (;;) {
+					uint64_m now = mum_time_ns();
+					if (now >= deadline) {
+						return MU_TRUE;
+					}
+					if (!mum_park_stoppable(word, 0, deadline - now)) {
+						return MU_FALSE;
+					}
+				}
+			}
+
+		/* Thread index */
+
+			// Small per-thread index handed out round-robin, used to spread threads over striped
+			// data without every thread hashing its own address
+			static uint32_m mum_thread_index_next = 0;
+			static MUM_THREAD_LOCAL uint32_m mum_thread_index_plus_one = 0;
+
+			static inline uint32_m mum_thread_index(void) {
+				if (mum_thread_index_plus_one == 0) {
+					mum_thread_index_plus_one = mum_atomic_fetch_add32(&mum_thread_index_next, 1) + 1;
+				}
+				return mum_thread_index_plus_one - 1;
+			}
+
+		/* Reader guard */
+
+			// Deferred reclamation for structures whose readers take no locks. Readers bump a
+			// counter in their stripe (on its own cache line, and picked by thread index, so only
+			// shared once there are more threads than stripes) for the current epoch parity;
+			// a reclaimer flips the parity and waits for the old parity's counters to drain. Two
+			// flips are needed, since a reader can increment a stale parity's counter after it has
+			// already been checked.
+
+			#define MUM_CACHE_LINE 64
+			#define MUM_READER_STRIPES 32
+
+			struct mum_reader_stripe {
+				uint32_m count[2];
+				uint8_m pad[MUM_CACHE_LINE - 2 * sizeof(uint32_m)];
+			};
+
+			struct mum_reader_guard {
+				uint32_m epoch;
+				uint32_m lock;
+				uint8_m pad[MUM_CACHE_LINE - 2 * sizeof(uint32_m)];
+				struct mum_reader_stripe stripes[MUM_READER_STRIPES];
+			};
+
+			static void mum_reader_guard_init(struct mum_reader_guard* g) {
+				g->epoch = 0;
+				g->lock = 0;
+				for (size_m i = 0; i < MUM_READER_STRIPES; i++) {
+					g->stripes[i].count[0] = 0;
+					g->stripes[i].count[1] = 0;
+				}
+			}
+
+			// Returns the counter that has to be passed to mum_reader_exit
+			static inline uint32_m* mum_reader_enter(struct mum_reader_guard* g) {
+				uint32_m parity = mum_atomic_load32(&g->epoch, MUM_RELAXED) & 1;
+				uint32_m* count = &g->stripes[mum_thread_index() % MUM_READER_STRIPES].count[parity];
+				mum_atomic_fetch_add32(count, 1);
+				return count;
+			}
+
+			static inline void mum_reader_exit(uint32_m* count) {
+				mum_atomic_fetch_sub32(count, 1);
+			}
+
+			static inline void mum_spin_backoff(uint32_m* spins) {
+				if (++*spins < 64) {
+					mum_cpu_relax();
+				} else {
+					mum_thread_yield();
+				}
+			}
+
+			// Waits until every reader that could have seen memory unpublished before this call has
+			// exited; the caller must not be inside a read section of the same guard.
+			static void mum_reader_synchronize(struct mum_reader_guard* g) {
+				uint32_m spins = 0;
+				uint32_m expected = 0;
+				while (!mum_atomic_cas32(&g->lock, &expected, 1)) {
+					expected = 0;
+					mum_spin_backoff(&spins);
+				}
+
+				for (uint32_m flip = 0; flip < 2; flip++) {
+					uint32_m old_parity = mum_atomic_fetch_add32(&g->epoch, 1) & 1;
+					for (size_m i = 0; i < MUM_READER_STRIPES; i++) {
+						spins = 0;
+						while (mum_atomic_load32(&g->stripes[i].count[old_parity], MUM_SEQ_CST) != 0) {
+							mum_spin_backoff(&spins);
+						}
+					}
+				}
+
+				mum_atomic_store32(&g->lock, 0, MUM_RELEASE);
+			}
+
+		/* Byte groups */
+
+			// Returns a bitmask of which of the 16 bytes at 'bytes' equal 'value'. Used as a filter
+			// only; any matching byte is re-read atomically before being trusted, as other threads
+			// may be changing bytes while they're loaded here.
+
+			#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+				#include <emmintrin.h>
+
+				static inline uint32_m mum_group_match(const uint8_m* bytes, uint8_m value) {
+					__m128i group = _mm_loadu_si128((const __m128i*)bytes);
+					return (uint32_m)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+				}
+
+				// Same as mum_group_match, but for every byte with its high bit set
+				static inline uint32_m mum_group_match_high(const uint8_m* bytes) {
+					return (uint32_m)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)bytes));
+				}
+
+			#elif defined(__aarch64__) || defined(_M_ARM64)
+
+				#include <arm_neon.h>
+
+				static inline uint32_m mum_group_match(const uint8_m* bytes, uint8_m value) {
+					static const uint8_m weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+					uint8x16_t eq = vceqq_u8(vld1q_u8(bytes), vdupq_n_u8(value));
+					uint8x16_t bits = vandq_u8(eq, vld1q_u8(weights));
+					return (uint32_m)vaddv_u8(vget_low_u8(bits)) | ((uint32_m)vaddv_u8(vget_high_u8(bits)) << 8);
+				}
+
+				// Same as mum_group_match, but for every byte with its high bit set
+				static inline uint32_m mum_group_match_high(const uint8_m* bytes) {
+					static const uint8_m weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+					uint8x16_t high = vtstq_u8(vld1q_u8(bytes), vdupq_n_u8(0x80));
+					uint8x16_t bits = vandq_u8(high, vld1q_u8(weights));
+					return (uint32_m)vaddv_u8(vget_low_u8(bits)) | ((uint32_m)vaddv_u8(vget_high_u8(bits)) << 8);
+				}
+
+			#else
+
+				static inline uint32_m mum_group_match(const uint8_m* bytes, uint8_m value) {
+					uint32_m mask = 0;
+					for (uint32_m i = 0; i < 16; i++) {
+						if (bytes[i] == value) {
+							mask |= (uint32_m)1 << i;
+						}
+					}
+					return mask;
+				}
+
+				// Same as mum_group_match, but for every byte with its high bit set
+				static inline uint32_m mum_group_match_high(const uint8_m* bytes) {
+					uint32_m mask = 0;
+					for (uint32_m i = 0; i < 16; i++) {
+						if (bytes[i] & 0x80) {
+							mask |= (uint32_m)1 << i;
+						}
+					}
+					return mask;
+				}
+
+			#endif
+
+
+			static inline uint32_m mum_lowest_bit(uint32_m mask) {
+				uint32_m i = 0;
+				while (!(mask & 1)) {
+					mask >>= 1;
+					i++;
+				}
+				return i;
+			}
+
+		/* Hash map */
+
+			// Open addressing over groups of 16 slots, each slot having a control byte; control
+			// bytes are matched 16 at a time. A full slot's control byte is the low 7 bits of its
+			// key's hash, and every other state has the high bit set.
+			//
+			// Writers claim an empty slot, or lock a full one, by setting it to BUSY, so readers
+			// never take a lock and at most wait on a single slot that's mid-write. Empty slots are
+			// never reused until a resize, which means a key always lives before the first empty
+			// slot of its probe sequence, and inserters racing on the same key meet at one slot.
+			//
+			// Resizing is cooperative and incremental: once a table has a next table, every writer
+			// migrates a chunk of it, plus the probe sequence of the key it's writing, before
+			// writing into the next table. Migrated slots keep their key and are marked as moved,
+			// so readers can follow a key into the next table. Replaced tables are freed once every
+			// reader that could still be looking at them has left.
+
+			#define MUM_HM_EMPTY 0xFF
+			#define MUM_HM_BUSY 0x80
+			#define MUM_HM_TOMBSTONE 0x81
+			#define MUM_HM_MOVED_EMPTY 0x82
+			#define MUM_HM_MOVED_FULL 0x83
+			#define MUM_HM_MOVED_OTHER 0x84
+
+			#define MUM_HM_GROUP 16
+			#define MUM_HM_MIN_CAPACITY 64
+			#define MUM_HM_CHUNK 128
+
+			// Outcomes of writing into a single table
+			#define MUM_HM_DONE 0
+			#define MUM_HM_RESTART 1
+			#define MUM_HM_GROW 2
+
+			// Write operations
+			#define MUM_HM_PUT 0
+			#define MUM_HM_INSERT 1
+			#define MUM_HM_REMOVE 2
+
+			struct mum_hm_slot {
+				uint64_m key;
+				void* volatile value;
+			};
+
+			struct mum_hm_table {
+				size_m capacity;
+				size_m group_mask;
+				uint32_m used;
+				uint32_m chunk_count;
+				uint32_m migrate_next;
+				uint32_m migrate_done;
+				void* volatile next;
+				uint8_m* ctrl;
+				struct mum_hm_slot* slots;
+			};
+			typedef struct mum_hm_table mum_hm_table;
+
+			struct mum_hash_map {
+				struct mum_reader_guard guard;
+				void* volatile table;
+				size_m min_capacity;
+			};
+			typedef struct mum_hash_map mum_hash_map;
+
+			static inline uint64_m mum_hm_hash(uint64_m key) {
+				key ^= key >> 30;
+				key *= 0xBF58476D1CE4E5B9ull;
+				key ^= key >> 27;
+				key *= 0x94D049BB133111EBull;
+				key ^= key >> 31;
+				return key;
+			}
+
+			static inline size_m mum_hm_round_capacity(size_m capacity) {
+				size_m rounded = MUM_HM_MIN_CAPACITY;
+				while (rounded < capacity) {
+					rounded <<= 1;
+				}
+				return rounded;
+			}
+
+			static mum_hm_table* mum_hm_table_create(size_m capacity) {
+				// Control bytes and slots share the table's allocation
+				size_m header = (sizeof(mum_hm_table) + 15) & ~(size_m)15;
+				mum_hm_table* t = (mum_hm_table*)mu_malloc(header + capacity + capacity * sizeof(struct mum_hm_slot));
+				if (!t) {
+					return 0;
+				}
+
+				t->capacity = capacity;
+				t->group_mask = capacity / MUM_HM_GROUP - 1;
+				t->used = 0;
+				t->chunk_count = (uint32_m)((capacity + MUM_HM_CHUNK - 1) / MUM_HM_CHUNK);
+				t->migrate_next = 0;
+				t->migrate_done = 0;
+				t->next = 0;
+				t->ctrl = (uint8_m*)t + header;
+				t->slots = (struct mum_hm_slot*)(t->ctrl + capacity);
+				for (size_m i = 0; i < capacity; i++) {
+					t->ctrl[i] = MUM_HM_EMPTY;
+				}
+				return t;
+			}
+
+			// First slot of the i-th group in a key's probe sequence; triangular steps visit every
+			// group of a power-of-two table
+			static inline size_m mum_hm_group(mum_hm_table* t, uint64_m hash, size_m i) {
+				return ((((size_m)(hash >> 7)) + i * (i + 1) / 2) & t->group_mask) * MUM_HM_GROUP;
+			}
+
+			// Waits for a slot to stop being BUSY and returns its settled state
+			static inline uint8_m mum_hm_settle(mum_hm_table* t, size_m slot) {
+				uint32_m spins = 0;
+				uint8_m c;
+				while ((c = mum_atomic_load8(&t->ctrl[slot], MUM_ACQUIRE)) == MUM_HM_BUSY) {
+					mum_spin_backoff(&spins);
+				}
+				return c;
+			}
+
+			static muBool mum_hm_lookup(mum_hm_table* t, uint64_m key, uint64_m hash, void** value) {
+				uint8_m h2 = (uint8_m)(hash & 0x7F);
+
+				for (size_m i = 0; i <= t->group_mask; i++) {
+					size_m base = mum_hm_group(t, hash, i);
+
+					// Slots whose hash byte doesn't match can be skipped, as can tombstones and
+					// other keys' moved slots, which are filtered out after re-reading
+					uint32_m candidates = mum_group_match(t->ctrl + base, h2) | mum_group_match_high(t->ctrl + base);
+					while (candidates) {
+						size_m slot = base + mum_lowest_bit(candidates);
+						candidates &= candidates - 1;
+
+						uint8_m c = mum_hm_settle(t, slot);
+						if (c == h2 && t->slots[slot].key == key) {
+							*value = mum_atomic_load_ptr(&t->slots[slot].value, MUM_ACQUIRE);
+							return MU_TRUE;
+						}
+						if (c == MUM_HM_EMPTY) {
+							return MU_FALSE;
+						}
+						if (c == MUM_HM_MOVED_EMPTY || (c == MUM_HM_MOVED_FULL && t->slots[slot].key == key)) {
+							return mum_hm_lookup((mum_hm_table*)mum_atomic_load_ptr(&t->next, MUM_ACQUIRE), key, hash, value);
+						}
+					}
+				}
+				return MU_FALSE;
+			}
+
+			// Performs a write within a single table that isn't being migrated
+			static int mum_hm_write(mum_hm_table* t, int op, uint64_m key, uint64_m hash, void* value, void** previous, muBool* found, size_m limit) {
+				uint8_m h2 = (uint8_m)(hash & 0x7F);
+
+				for (size_m i = 0; i <= t->group_mask; i++) {
+					size_m base = mum_hm_group(t, hash, i);
+
+					uint32_m candidates = mum_group_match(t->ctrl + base, h2) | mum_group_match_high(t->ctrl + base);
+					while (candidates) {
+						size_m slot = base + mum_lowest_bit(candidates);
+						candidates &= candidates - 1;
+
+						for (;;) {
+							uint8_m c = mum_hm_settle(t, slot);
+
+							if (c >= MUM_HM_MOVED_EMPTY && c <= MUM_HM_MOVED_OTHER) {
+								return MUM_HM_RESTART;
+							}
+
+							if (c == MUM_HM_EMPTY) {
+								if (op == MUM_HM_REMOVE) {
+									*found = MU_FALSE;
+									return MUM_HM_DONE;
+								}
+								if (mum_atomic_load32(&t->used, MUM_RELAXED) >= limit) {
+									return MUM_HM_GROW;
+								}
+								if (!mum_atomic_cas8(&t->ctrl[slot], &c, MUM_HM_BUSY)) {
+									continue;
+								}
+
+								mum_atomic_fetch_add32(&t->used, 1);
+								t->slots[slot].key = key;
+								mum_atomic_store_ptr(&t->slots[slot].value, value, MUM_RELAXED);
+								mum_atomic_store8(&t->ctrl[slot], h2, MUM_RELEASE);
+								*found = MU_FALSE;
+								return MUM_HM_DONE;
+							}
+
+							if (c == h2 && t->slots[slot].key == key) {
+								if (op == MUM_HM_INSERT) {
+									*previous = mum_atomic_load_ptr(&t->slots[slot].value, MUM_ACQUIRE);
+									*found = MU_TRUE;
+									return MUM_HM_DONE;
+								}
+								if (!mum_atomic_cas8(&t->ctrl[slot], &c, MUM_HM_BUSY)) {
+									continue;
+								}
+
+								*previous = t->slots[slot].value;
+								*found = MU_TRUE;
+								if (op == MUM_HM_PUT) {
+									mum_atomic_store_ptr(&t->slots[slot].value, value, MUM_RELAXED);
+									mum_atomic_store8(&t->ctrl[slot], h2, MUM_RELEASE);
+								} else {
+									mum_atomic_store8(&t->ctrl[slot], MUM_HM_TOMBSTONE, MUM_RELEASE);
+								}
+								return MUM_HM_DONE;
+							}
+
+							// Another key or a tombstone; keep probing
+							break;
+						}
+					}
+				}
+
+				// No empty slot left anywhere
+				if (op == MUM_HM_REMOVE) {
+					*found = MU_FALSE;
+					return MUM_HM_DONE;
+				}
+				return MUM_HM_GROW;
+			}
+
+			// Freezes a slot of a table being migrated, copying it into the next table if it's full;
+			// returns the slot's moved state
+			static uint8_m mum_hm_migrate_slot(mum_hm_table* t, size_m slot) {
+				mum_hm_table* next = (mum_hm_table*)mum_atomic_load_ptr(&t->next, MUM_ACQUIRE);
+
+				for (;;) {
+					uint8_m c = mum_hm_settle(t, slot);
+					switch (c) {
+						case MUM_HM_MOVED_EMPTY: case MUM_HM_MOVED_FULL: case MUM_HM_MOVED_OTHER: {
+							return c;
+						} break;
+						case MUM_HM_EMPTY: {
+							if (mum_atomic_cas8(&t->ctrl[slot], &c, MUM_HM_MOVED_EMPTY)) {
+								return MUM_HM_MOVED_EMPTY;
+							}
+						} break;
+						case MUM_HM_TOMBSTONE: {
+							if (mum_atomic_cas8(&t->ctrl[slot], &c, MUM_HM_MOVED_OTHER)) {
+								return MUM_HM_MOVED_OTHER;
+							}
+						} break;
+						default: {
+							if (mum_atomic_cas8(&t->ctrl[slot], &c, MUM_HM_BUSY)) {
+								// Nothing can write this key into the next table before this slot is
+								// marked as moved, so a plain insert never finds it there already
+								uint64_m key = t->slots[slot].key;
+								void* previous;
+								muBool found;
+								mum_hm_write(next, MUM_HM_INSERT, key, mum_hm_hash(key), t->slots[slot].value, &previous, &found, next->capacity);
+								mum_atomic_store8(&t->ctrl[slot], MUM_HM_MOVED_FULL, MUM_RELEASE);
+								return MUM_HM_MOVED_FULL;
+							}
+						} break;
+					}
+				}
+			}
+
+			// Migrates a key's probe sequence up to the key itself or the first empty slot, so that
+			// the key can be written into the next table
+			static void mum_hm_migrate_probe(mum_hm_table* t, uint64_m key, uint64_m hash) {
+				for (size_m i = 0; i <= t->group_mask; i++) {
+					size_m base = mum_hm_group(t, hash, i);
+					for (size_m slot = base; slot < base + MUM_HM_GROUP; slot++) {
+						uint8_m c = mum_hm_migrate_slot(t, slot);
+						if (c == MUM_HM_MOVED_EMPTY || (c == MUM_HM_MOVED_FULL && t->slots[slot].key == key)) {
+							return;
+						}
+					}
+				}
+			}
+
+			// Migrates one chunk of a table; returns the table if it has just been fully migrated
+			// and replaced by this call, meaning the caller is the one that has to retire it
+			static mum_hm_table* mum_hm_help(mum_hash_map* map, mum_hm_table* t) {
+				uint32_m chunk = mum_atomic_fetch_add32(&t->migrate_next, 1);
+				if (chunk >= t->chunk_count) {
+					return 0;
+				}
+
+				size_m begin = (size_m)chunk * MUM_HM_CHUNK;
+				size_m end = begin + MUM_HM_CHUNK;
+				if (end > t->capacity) {
+					end = t->capacity;
+				}
+				for (size_m slot = begin; slot < end; slot++) {
+					mum_hm_migrate_slot(t, slot);
+				}
+
+				if (mum_atomic_fetch_add32(&t->migrate_done, 1) + 1 == t->chunk_count) {
+					void* expected = t;
+					mum_atomic_cas_ptr(&map->table, &expected, mum_atomic_load_ptr(&t->next, MUM_ACQUIRE));
+					return t;
+				}
+				return 0;
+			}
+
+			// Helps until a table has been fully migrated
+			static mum_hm_table* mum_hm_finish(mum_hash_map* map, mum_hm_table* t) {
+				mum_hm_table* retired = 0;
+				while (mum_atomic_load32(&t->migrate_next, MUM_RELAXED) < t->chunk_count) {
+					mum_hm_table* r = mum_hm_help(map, t);
+					if (r) {
+						retired = r;
+					}
+				}
+
+				uint32_m spins = 0;
+				while (mum_atomic_load32(&t->migrate_done, MUM_ACQUIRE) < t->chunk_count) {
+					mum_spin_backoff(&spins);
+				}
+				return retired;
+			}
+
+			// Begins migrating a table into a new one sized for its live keys
+			static muBool mum_hm_grow(mum_hash_map* map, mum_hm_table* t) {
+				if (mum_atomic_load_ptr(&t->next, MUM_ACQUIRE)) {
+					return MU_TRUE;
+				}
+
+				size_m live = 0;
+				for (size_m i = 0; i < t->capacity; i++) {
+					if (mum_atomic_load8(&t->ctrl[i], MUM_RELAXED) < 0x80) {
+						live++;
+					}
+				}
+
+				size_m capacity = mum_hm_round_capacity(live * 2 + 1);
+				if (capacity < map->min_capacity) {
+					capacity = map->min_capacity;
+				}
+
+				mum_hm_table* next = mum_hm_table_create(capacity);
+				if (!next) {
+					return MU_FALSE;
+				}
+
+				void* expected = 0;
+				if (!mum_atomic_cas_ptr(&t->next, &expected, next)) {
+					mu_free(next);
+				}
+				return MU_TRUE;
+			}
+
+			static muBool mum_hm_operate(mumResult* result, mum_hash_map* map, int op, uint64_m key, void* value, void** previous) {
+				uint64_m hash = mum_hm_hash(key);
+				muBool found = MU_FALSE;
+				void* previous_value = 0;
+				mum_hm_table* retired = 0;
+
+				uint32_m* reader = mum_reader_enter(&map->guard);
+				for (;;) {
+					mum_hm_table* t = (mum_hm_table*)mum_atomic_load_ptr(&map->table, MUM_ACQUIRE);
+					mum_hm_table* next = (mum_hm_table*)mum_atomic_load_ptr(&t->next, MUM_ACQUIRE);
+
+					if (!next) {
+						int r = mum_hm_write(t, op, key, hash, value, &previous_value, &found, t->capacity / 8 * 7);
+						if (r == MUM_HM_DONE) {
+							break;
+						}
+						if (r == MUM_HM_GROW && !mum_hm_grow(map, t)) {
+							MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+							break;
+						}
+						continue;
+					}
+
+					// Migration in progress: do a share of it, then write into the next table, where
+					// new keys are held to half of the capacity so that what's still left to migrate
+					// always fits
+					mum_hm_table* r = mum_hm_help(map, t);
+					if (r) {
+						retired = r;
+					}
+					mum_hm_migrate_probe(t, key, hash);
+
+					int w = mum_hm_write(next, op, key, hash, value, &previous_value, &found, next->capacity / 2);
+					if (w == MUM_HM_DONE) {
+						break;
+					}
+					if (w == MUM_HM_GROW) {
+						r = mum_hm_finish(map, t);
+						if (r) {
+							retired = r;
+						}
+					}
+				}
+				mum_reader_exit(reader);
+
+				if (retired) {
+					mum_reader_synchronize(&map->guard);
+					mu_free(retired);
+				}
+
+				if (previous && found) {
+					*previous = previous_value;
+				}
+				return found;
+			}
+
+			MUDEF muHashMap mu_hash_map_create_(mumResult* result, size_m capacity) {
+				mum_hash_map* map = (mum_hash_map*)mu_malloc(sizeof(mum_hash_map));
+				if (!map) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				// Room for the requested amount of keys below the load factor
+				map->min_capacity = mum_hm_round_capacity(capacity + capacity / 7);
+				map->table = mum_hm_table_create(map->min_capacity);
+				if (!map->table) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					mu_free(map);
+					return 0;
+				}
+
+				mum_reader_guard_init(&map->guard);
+				return (muHashMap)map;
+			}
+
+			MUDEF muHashMap mu_hash_map_destroy_(mumResult* result, muHashMap map) {
+				mum_hash_map* p = (mum_hash_map*)map;
+				mum_hm_table* t = (mum_hm_table*)p->table;
+
+				if (t->next) {
+					mu_free(t->next);
+				}
+				mu_free(t);
+				mu_free(p);
+				return 0; if (result) {}
+			}
+
+			MUDEF muBool mu_hash_map_get(muHashMap map, uint64_m key, void** value) {
+				mum_hash_map* p = (mum_hash_map*)map;
+				uint64_m hash = mum_hm_hash(key);
+
+				uint32_m* reader = mum_reader_enter(&p->guard);
+				void* found_value = 0;
+				muBool found = mum_hm_lookup((mum_hm_table*)mum_atomic_load_ptr(&p->table, MUM_ACQUIRE), key, hash, &found_value);
+				mum_reader_exit(reader);
+
+				if (found && value) {
+					*value = found_value;
+				}
+				return found;
+			}
+
+			MUDEF void mu_hash_map_put_(mumResult* result, muHashMap map, uint64_m key, void* value) {
+				mum_hm_operate(result, (mum_hash_map*)map, MUM_HM_PUT, key, value, 0);
+			}
+
+			MUDEF muBool mu_hash_map_insert_(mumResult* result, muHashMap map, uint64_m key, void* value, void** existing) {
+				mumResult res = MUM_SUCCESS;
+				muBool found = mum_hm_operate(&res, (mum_hash_map*)map, MUM_HM_INSERT, key, value, existing);
+				if (res != MUM_SUCCESS) {
+					MU_SET_RESULT(result, res)
+					return MU_FALSE;
+				}
+				return !found;
+			}
+
+			MUDEF muBool mu_hash_map_remove(muHashMap map, uint64_m key, void** value) {
+				return mum_hm_operate(0, (mum_hash_map*)map, MUM_HM_REMOVE, key, 0, value);
+			}
+
+		/* Tracing */
+
+		#ifdef MUM_TRACE
+
+			static void mum_trace_write_event(FILE* f, struct mum_trace_event* e, double us_per_tick, muBool* first) {
+				static const char* type_names[5] = { "mutex", "spinlock", "thread", "cohort_lock", "adaptive_lock" };
+				unsigned long long object = (unsigned long long)(size_m)e->object;
+				const char* type = type_names[e->type];
+				double ts = (double)(e->ticks - mum_trace_base_ticks) * us_per_tick;
+
+				// Most events become a begin or end of a span on their thread, named after the object
+				const char* phase = 0;
+				const char* name = 0;
+				switch (e->kind) {
+					case MUM_TRACE_LOCK_CONTEND: phase = "B"; name = "wait"; break;
+					case MUM_TRACE_THREAD_START: phase = "B"; name = "run"; break;
+					case MUM_TRACE_THREAD_EXIT: phase = "E"; name = "run"; break;
+					case MUM_TRACE_THREAD_WAIT: phase = "B"; name = "wait"; break;
+					case MUM_TRACE_THREAD_WAITED: phase = "E"; name = "wait"; break;
+					case MUM_TRACE_LOCK_ACQUIRE_CONTENDED: phase = "E"; name = "wait"; break;
+					default: break;
+				}
+
+				if (phase) {
+					fprintf(f, "%s\n{\"name\":\"%s %s 0x%llx\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+						*first ? "" : ",", name, type, object, type, phase, ts, (unsigned)e->tid
+					);
+					*first = MU_FALSE;
+				}
+
+				// Lock holds can overlap in any order, so they're async spans keyed by the lock
+				switch (e->kind) {
+					case MUM_TRACE_LOCK_ACQUIRE: case MUM_TRACE_LOCK_ACQUIRE_CONTENDED: phase = "b"; break;
+					case MUM_TRACE_LOCK_RELEASE: phase = "e"; break;
+					case MUM_TRACE_THREAD_CREATE: phase = "i"; break;
+					default: return;
+				}
+
+				if (e->kind == MUM_TRACE_THREAD_CREATE) {
+					fprintf(f, "%s\n{\"name\":\"create %s 0x%llx\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+						*first ? "" : ",", type, object, type, ts, (unsigned)e->tid
+					);
+				} else {
+					fprintf(f, "%s\n{\"name\":\"hold %s 0x%llx\",\"cat\":\"%s\",\"ph\":\"%s\",\"id\":\"0x%llx\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+						*first ? "" : ",", type, object, type, phase, object, ts, (unsigned)e->tid
+					);
+				}
+				*first = MU_FALSE;
+			}
+
+			MUDEF void mu_trace_flush_(mumResult* result, const char* path) {
+				FILE* f = fopen(path, "wb");
+				if (!f) {
+					MU_SET_RESULT(result, MUM_FAILED_OPEN_FILE)
+					return;
+				}
+
+				uint32_m spins = 0;
+				uint32_m expected = 0;
+				while (!mum_atomic_cas32(&mum_trace_flush_lock, &expected, 1)) {
+					expected = 0;
+					mum_spin_backoff(&spins);
+				}
+
+				// Convert ticks to microseconds by comparing them against the clock over the time
+				// since tracing began
+				double us_per_tick = 0.001;
+				if (mum_atomic_load32(&mum_trace_calibrated, MUM_ACQUIRE) == 2) {
+					uint64_m ticks = MUM_TRACE_TICKS() - mum_trace_base_ticks;
+					uint64_m ns = mum_time_ns() - mum_trace_base_ns;
+					if (ticks != 0) {
+						us_per_tick = (double)ns / (double)ticks / 1000.0;
+					}
+				}
+
+				fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", f);
+				muBool first = MU_TRUE;
+
+				struct mum_trace_ring* ring = (struct mum_trace_ring*)mum_atomic_load_ptr(&mum_trace_rings, MUM_ACQUIRE);
+				for (; ring; ring = ring->next) {
+					uint32_m head = mum_atomic_load32(&ring->head, MUM_ACQUIRE);
+					uint32_m tail = ring->tail;
+					if (head - tail > MUM_TRACE_CAPACITY) {
+						tail = head - MUM_TRACE_CAPACITY;
+					}
+
+					for (uint32_m i = tail; i != head; i++) {
+						struct mum_trace_event e = ring->events[i & (MUM_TRACE_CAPACITY - 1)];
+
+						// The owning thread may have lapped the ring and overwritten this event
+						// whilst it was being copied
+						uint32_m now = mum_atomic_load32(&ring->head, MUM_ACQUIRE);
+						if (now - i >= MUM_TRACE_CAPACITY) {
+							continue;
+						}
+
+						mum_trace_write_event(f, &e, us_per_tick, &first);
+					}
+					ring->tail = head;
+				}
+
+				fputs("\n]}\n", f);
+				mum_atomic_store32(&mum_trace_flush_lock, 0, MUM_RELEASE);
+
+				fclose(f);
+			}
+
+		#else
+
+			MUDEF void mu_trace_flush_(mumResult* result, const char* path) {
+				MU_SET_RESULT(result, MUM_TRACE_DISABLED)
+				return; if (path) {}
+			}
+
+		#endif
+
+		/* Slab allocator */
+
+			// Memory is carved out of 64 KB slabs aligned to 64 KB, so the slab of any pointer is
+			// found by masking it. Every slab holds objects of one size class and is owned by one
+			// thread's heap, which allocates from and frees into the slab's local free list without
+			// any atomics. Other threads push what they free onto the slab's remote list, which the
+			// owner takes over in one exchange when its slabs run dry.
+			//
+			// So that running dry never means looking through every slab, a heap keeps a list per
+			// size class of the slabs that it knows have room (partial). The lowest bit of a slab's
+			// remote list is set once its owner has been told about it: the first remote free after
+			// the owner last collected the slab sets the bit, and instead of going onto the slab's
+			// list, goes onto its heap's delayed list, guarded by the heap's own lock. The owner
+			// frees whatever is on the delayed list when it runs dry, collecting each slab on the
+			// way. As the object is live until then, its slab can't be freed in the meantime.
+			//
+			// Slabs that become empty go to a global pool; slabs of exited threads that still have
+			// live objects are abandoned and adopted by the next thread to need their size class.
+			// Allocations too big for a slab get their own mapping, with a slab header in front.
+			// Heaps are carved out of a shared slab and reused once their thread exits, but never
+			// unmapped, as a thread freeing remotely may still be looking at an exited thread's.
+
+			#define MUM_SLAB_SIZE ((size_m)65536)
+			#define MUM_SLAB_HEADER ((size_m)192)
+			#define MUM_SLAB_MAX ((size_m)8192)
+			#define MUM_SLAB_CLASSES 32
+			#define MUM_SLAB_LARGE 0xFFFFFFFF
+			#define MUM_SLAB_BATCH 16
+			#define MUM_SLAB_POOL_MAX 64
+
+			struct mum_slab {
+				// Written by other threads
+				void* volatile remote;
+				uint8_m pad[MUM_CACHE_LINE - sizeof(void*)];
+
+				// Written by the owning thread, the heap only with its lock held
+				void* volatile heap;
+				uint32_m owner;
+				uint32_m size_class;
+				size_m object_size;
+				void* free;
+				uint8_m* bump;
+				uint8_m* end;
+				uint32_m used;
+				struct mum_slab* prev;
+				struct mum_slab* next;
+				muBool partial;
+				struct mum_slab* partial_prev;
+				struct mum_slab* partial_next;
+				size_m map_size;
+			};
+			typedef struct mum_slab mum_slab;
+
+			struct mum_slab_heap {
+				// Written by other threads, with lock held
+				uint32_m lock;
+				void* volatile delayed;
+				uint8_m pad[MUM_CACHE_LINE - sizeof(void*) * 2];
+
+				// Written by the owning thread
+				uint32_m id;
+				mum_slab* active[MUM_SLAB_CLASSES];
+				mum_slab* slabs[MUM_SLAB_CLASSES];
+				mum_slab* partial[MUM_SLAB_CLASSES];
+				// The next reusable heap, whilst it has no thread
+				struct mum_slab_heap* next_free;
+			};
+			typedef struct mum_slab_heap mum_slab_heap;
+
+			static MUM_THREAD_LOCAL mum_slab_heap* mum_slab_local = 0;
+			static uint32_m mum_slab_next_id = 1;
+
+			// Global pool of empty slabs, lists of abandoned ones, and heaps to reuse or carve new
+			// ones from, guarded by a spinlock
+			static uint32_m mum_slab_lock = 0;
+			static mum_slab* mum_slab_pool = 0;
+			static size_m mum_slab_pool_count = 0;
+			static mum_slab* mum_slab_abandoned[MUM_SLAB_CLASSES];
+			static mum_slab_heap* mum_slab_free_heaps = 0;
+			static uint8_m* mum_slab_heap_bump = 0;
+			static uint8_m* mum_slab_heap_end = 0;
+
+			static inline void mum_slab_spin_lock(uint32_m* lock) {
+				uint32_m spins = 0;
+				uint32_m expected = 0;
+				while (!mum_atomic_cas32(lock, &expected, 1)) {
+					expected = 0;
+					mum_spin_backoff(&spins);
+				}
+			}
+
+			static inline void mum_slab_spin_unlock(uint32_m* lock) {
+				mum_atomic_store32(lock, 0, MUM_RELEASE);
+			}
+
+			static inline void mum_slab_global_lock(void) {
+				mum_slab_spin_lock(&mum_slab_lock);
+			}
+
+			static inline void mum_slab_global_unlock(void) {
+				mum_slab_spin_unlock(&mum_slab_lock);
+			}
+
+			// Classes are 16 to 128 bytes in steps of 16, then four classes per power of two up to
+			// MUM_SLAB_MAX
+			static inline uint32_m mum_slab_class(size_m size) {
+				if (size <= 128) {
+					return (uint32_m)((size + 15) >> 4) - 1;
+				}
+
+				uint32_m bit = 7;
+				while (((size - 1) >> (bit + 1)) != 0) {
+					bit++;
+				}
+				return 8 + (bit - 7) * 4 + (uint32_m)(((size - 1) - ((size_m)1 << bit)) >> (bit - 2));
+			}
+
+			static inline size_m mum_slab_class_size(uint32_m size_class) {
+				if (size_class < 8) {
+					return (size_m)(size_class + 1) * 16;
+				}
+				uint32_m bit = 7 + (size_class - 8) / 4;
+				return ((size_m)1 << bit) + (size_m)((size_class - 8) % 4 + 1) * ((size_m)1 << (bit - 2));
+			}
+
+			static mum_slab* mum_slab_take(void) {
+				mum_slab_global_lock();
+				mum_slab* s = mum_slab_pool;
+				if (s) {
+					mum_slab_pool = s->next;
+					mum_slab_pool_count--;
+				}
+				mum_slab_global_unlock();
+				if (s) {
+					return s;
+				}
+
+				// Map a batch of slabs at once where they can be unmapped one by one later
+				size_m batch = MUM_OS_PARTIAL_UNMAP ? MUM_SLAB_BATCH : 1;
+				uint8_m* p = (uint8_m*)mum_os_map_aligned(batch * MUM_SLAB_SIZE, MUM_SLAB_SIZE);
+				if (!p) {
+					return 0;
+				}
+
+				if (batch > 1) {
+					mum_slab_global_lock();
+					for (size_m i = 1; i < batch; i++) {
+						mum_slab* extra = (mum_slab*)(p + i * MUM_SLAB_SIZE);
+						extra->next = mum_slab_pool;
+						mum_slab_pool = extra;
+						mum_slab_pool_count++;
+					}
+					mum_slab_global_unlock();
+				}
+				return (mum_slab*)p;
+			}
+
+			static void mum_slab_give(mum_slab* s) {
+				mum_slab_global_lock();
+				if (mum_slab_pool_count < MUM_SLAB_POOL_MAX) {
+					s->next = mum_slab_pool;
+					mum_slab_pool = s;
+					mum_slab_pool_count++;
+					s = 0;
+				}
+				mum_slab_global_unlock();
+
+				if (s) {
+					mum_os_unmap(s, MUM_SLAB_SIZE);
+				}
+			}
+
+			static inline void mum_slab_link(mum_slab_heap* heap, mum_slab* s) {
+				s->prev = 0;
+				s->next = heap->slabs[s->size_class];
+				if (s->next) {
+					s->next->prev = s;
+				}
+				heap->slabs[s->size_class] = s;
+			}
+
+			// Puts a slab that has room on its heap's partial list, unless it's already there or is
+			// the active slab, which is found without the list
+			static inline void mum_slab_partial_push(mum_slab_heap* heap, mum_slab* s) {
+				if (s->partial || heap->active[s->size_class] == s) {
+					return;
+				}
+				s->partial = MU_TRUE;
+				s->partial_prev = 0;
+				s->partial_next = heap->partial[s->size_class];
+				if (s->partial_next) {
+					s->partial_next->partial_prev = s;
+				}
+				heap->partial[s->size_class] = s;
+			}
+
+			static inline void mum_slab_partial_remove(mum_slab_heap* heap, mum_slab* s) {
+				if (!s->partial) {
+					return;
+				}
+				if (s->partial_prev) {
+					s->partial_prev->partial_next = s->partial_next;
+				} else {
+					heap->partial[s->size_class] = s->partial_next;
+				}
+				if (s->partial_next) {
+					s->partial_next->partial_prev = s->partial_prev;
+				}
+				s->partial = MU_FALSE;
+			}
+
+			static inline void mum_slab_unlink(mum_slab_heap* heap, mum_slab* s) {
+				mum_slab_partial_remove(heap, s);
+				if (s->prev) {
+					s->prev->next = s->next;
+				} else {
+					heap->slabs[s->size_class] = s->next;
+				}
+				if (s->next) {
+					s->next->prev = s->prev;
+				}
+				if (heap->active[s->size_class] == s) {
+					heap->active[s->size_class] = 0;
+				}
+			}
+
+			// Takes over everything other threads have freed into a slab, and clears the notified
+			// bit, so that the next remote free tells the owner again
+			static inline void mum_slab_collect(mum_slab* s) {
+				if (!mum_atomic_load_ptr(&s->remote, MUM_RELAXED)) {
+					return;
+				}
+
+				void* list = 0;
+				void* head = mum_atomic_load_ptr(&s->remote, MUM_RELAXED);
+				while (!mum_atomic_cas_ptr(&s->remote, &head, 0)) {}
+				list = (void*)((size_m)head & ~(size_m)1);
+
+				while (list) {
+					void* next = *(void**)list;
+					*(void**)list = s->free;
+					s->free = list;
+					s->used--;
+					list = next;
+				}
+			}
+
+			static inline muBool mum_slab_has_room(mum_slab* s) {
+				return s->free || s->bump < s->end;
+			}
+
+			// Frees an object into a slab that the calling thread owns
+			static void mum_slab_free_local(mum_slab_heap* heap, mum_slab* s, void* ptr) {
+				*(void**)ptr = s->free;
+				s->free = ptr;
+				s->used--;
+
+				// Keep the active slab around even if it's empty so that an alloc/free pair
+				// doesn't keep taking slabs from the pool and giving them back
+				if (s->used == 0 && heap->active[s->size_class] != s) {
+					mum_slab_unlink(heap, s);
+					mum_slab_give(s);
+				} else {
+					mum_slab_partial_push(heap, s);
+				}
+			}
+
+			// Takes the delayed list of a heap, whose thread is the calling one
+			static void* mum_slab_take_delayed(mum_slab_heap* heap) {
+				if (!mum_atomic_load_ptr(&heap->delayed, MUM_RELAXED)) {
+					return 0;
+				}
+				mum_slab_spin_lock(&heap->lock);
+				void* list = heap->delayed;
+				mum_atomic_store_ptr(&heap->delayed, 0, MUM_RELAXED);
+				mum_slab_spin_unlock(&heap->lock);
+				return list;
+			}
+
+			// Frees the objects of a delayed list, collecting their slabs, which puts every slab
+			// that other threads have freed into since it was last collected on a partial list
+			static void mum_slab_free_delayed(mum_slab_heap* heap, void* list) {
+				while (list) {
+					void* next = *(void**)list;
+					mum_slab* s = (mum_slab*)((size_m)list & ~(MUM_SLAB_SIZE - 1));
+					mum_slab_collect(s);
+					mum_slab_free_local(heap, s, list);
+					list = next;
+				}
+			}
+
+			// Frees an object into a slab that the calling thread doesn't own
+			static void mum_slab_free_remote(mum_slab* s, void* ptr) {
+				void* head = mum_atomic_load_ptr(&s->remote, MUM_RELAXED);
+				for (;;) {
+					if ((size_m)head & 1) {
+						*(void**)ptr = (void*)((size_m)head & ~(size_m)1);
+						if (mum_atomic_cas_ptr(&s->remote, &head, (void*)((size_m)ptr | 1))) {
+							return;
+						}
+					} else if (mum_atomic_cas_ptr(&s->remote, &head, (void*)((size_m)head | 1))) {
+						break;
+					}
+				}
+
+				// Tell the owner, through its delayed list; the slab can't go anywhere whilst ptr is
+				// still live, but it can change hands
+				for (;;) {
+					mum_slab_heap* heap = (mum_slab_heap*)mum_atomic_load_ptr(&s->heap, MUM_ACQUIRE);
+					if (!heap) {
+						// Abandoned, so whoever adopts it collects it
+						head = mum_atomic_load_ptr(&s->remote, MUM_RELAXED);
+						do {
+							*(void**)ptr = (void*)((size_m)head & ~(size_m)1);
+						} while (!mum_atomic_cas_ptr(&s->remote, &head, (void*)((size_m)ptr | ((size_m)head & 1))));
+						return;
+					}
+
+					mum_slab_spin_lock(&heap->lock);
+					if (mum_atomic_load_ptr(&s->heap, MUM_RELAXED) == heap) {
+						// Stored atomically for the owner's check without the lock
+						*(void**)ptr = heap->delayed;
+						mum_atomic_store_ptr(&heap->delayed, ptr, MUM_RELAXED);
+						mum_slab_spin_unlock(&heap->lock);
+						return;
+					}
+					mum_slab_spin_unlock(&heap->lock);
+				}
+			}
+
+			static void mum_slab_thread_exit(void* value) {
+				mum_slab_heap* heap = (mum_slab_heap*)value;
+				if (mum_slab_local == heap) {
+					mum_slab_local = 0;
+				}
+
+				// From here on, remote frees leave the heap alone
+				mum_slab_spin_lock(&heap->lock);
+				for (uint32_m c = 0; c < MUM_SLAB_CLASSES; c++) {
+					for (mum_slab* s = heap->slabs[c]; s; s = s->next) {
+						mum_atomic_store_ptr(&s->heap, 0, MUM_RELAXED);
+					}
+				}
+				void* delayed = heap->delayed;
+				heap->delayed = 0;
+				mum_slab_spin_unlock(&heap->lock);
+				mum_slab_free_delayed(heap, delayed);
+
+				for (uint32_m c = 0; c < MUM_SLAB_CLASSES; c++) {
+					mum_slab* s = heap->slabs[c];
+					while (s) {
+						mum_slab* next = s->next;
+						mum_slab_collect(s);
+
+						if (s->used == 0) {
+							mum_slab_give(s);
+						} else {
+							// Other threads still hold objects of this slab; whatever they free
+							// piles up on its remote list until another thread adopts it
+							mum_atomic_store32(&s->owner, 0, MUM_SEQ_CST);
+							mum_slab_global_lock();
+							s->next = mum_slab_abandoned[c];
+							mum_slab_abandoned[c] = s;
+							mum_slab_global_unlock();
+						}
+						s = next;
+					}
+				}
+
+				mum_slab_global_lock();
+				heap->next_free = mum_slab_free_heaps;
+				mum_slab_free_heaps = heap;
+				mum_slab_global_unlock();
+			}
+
+			// Reuses the heap of an exited thread, or carves a new one out of the current slab of
+			// heaps
+			static mum_slab_heap* mum_slab_heap_alloc(void) {
+				size_m size = (sizeof(mum_slab_heap) + MUM_CACHE_LINE - 1) & ~(size_m)(MUM_CACHE_LINE - 1);
+
+				mum_slab_global_lock();
+				mum_slab_heap* heap = mum_slab_free_heaps;
+				if (heap) {
+					mum_slab_free_heaps = heap->next_free;
+				} else if (mum_slab_heap_bump && (size_m)(mum_slab_heap_end - mum_slab_heap_bump) >= size) {
+					heap = (mum_slab_heap*)mum_slab_heap_bump;
+					mum_slab_heap_bump += size;
+					heap->lock = 0;
+					heap->delayed = 0;
+				}
+				mum_slab_global_unlock();
+				if (heap) {
+					return heap;
+				}
+
+				uint8_m* region = (uint8_m*)mum_slab_take();
+				if (!region) {
+					return 0;
+				}
+				mum_slab_global_lock();
+				// Another thread may have started a new slab of heaps in the meantime
+				if ((size_m)(mum_slab_heap_end - mum_slab_heap_bump) < size) {
+					mum_slab_heap_bump = region;
+					mum_slab_heap_end = region + MUM_SLAB_SIZE;
+					region = 0;
+				}
+				heap = (mum_slab_heap*)mum_slab_heap_bump;
+				mum_slab_heap_bump += size;
+				mum_slab_global_unlock();
+				if (region) {
+					mum_slab_give((mum_slab*)region);
+				}
+
+				heap->lock = 0;
+				heap->delayed = 0;
+				return heap;
+			}
+
+			static mum_slab_heap* mum_slab_heap_get(void) {
+				mum_slab_heap* heap = mum_slab_local;
+				if (heap) {
+					return heap;
+				}
+
+				// The lock of a reused heap is left as it is, as a remote free may still be looking
+				// at it
+				heap = mum_slab_heap_alloc();
+				if (!heap) {
+					return 0;
+				}
+				heap->id = mum_atomic_fetch_add32(&mum_slab_next_id, 1);
+				for (uint32_m c = 0; c < MUM_SLAB_CLASSES; c++) {
+					heap->active[c] = 0;
+					heap->slabs[c] = 0;
+					heap->partial[c] = 0;
+				}
+
+				mum_slab_local = heap;
+				mum_thread_exit_hook_set(MUM_EXIT_HOOK_SLAB, heap);
+				return heap;
+			}
+
+			static void* mum_slab_alloc_large(size_m size) {
+				size_m map_size = (MUM_SLAB_HEADER + size + 4095) & ~(size_m)4095;
+				mum_slab* s = (mum_slab*)mum_os_map_aligned(map_size, MUM_SLAB_SIZE);
+				if (!s) {
+					return 0;
+				}
+
+				s->size_class = MUM_SLAB_LARGE;
+				s->map_size = map_size;
+				return (uint8_m*)s + MUM_SLAB_HEADER;
+			}
+
+			static void* mum_slab_alloc_slow(mum_slab_heap* heap, uint32_m size_class) {
+				// Take in what other threads have freed, which may refill the active slab itself
+				mum_slab_free_delayed(heap, mum_slab_take_delayed(heap));
+				mum_slab* s = heap->active[size_class];
+				if (!s || !mum_slab_has_room(s)) {
+					// Then take the first slab known to have room
+					s = heap->partial[size_class];
+					if (s) {
+						mum_slab_partial_remove(heap, s);
+						mum_slab_collect(s);
+					}
+				}
+
+				// Then adopt slabs left behind by exited threads
+				while (!s) {
+					mum_slab_global_lock();
+					s = mum_slab_abandoned[size_class];
+					if (s) {
+						mum_slab_abandoned[size_class] = s->next;
+					}
+					mum_slab_global_unlock();
+					if (!s) {
+						break;
+					}
+
+					mum_atomic_store32(&s->owner, heap->id, MUM_SEQ_CST);
+					mum_atomic_store_ptr(&s->heap, heap, MUM_RELEASE);
+					s->partial = MU_FALSE;
+					mum_slab_link(heap, s);
+					mum_slab_collect(s);
+					if (!mum_slab_has_room(s)) {
+						s = 0;
+					}
+				}
+
+				// Then start a fresh slab
+				if (!s) {
+					s = mum_slab_take();
+					if (!s) {
+						return 0;
+					}
+
+					s->owner = heap->id;
+					s->size_class = size_class;
+					s->object_size = mum_slab_class_size(size_class);
+					s->free = 0;
+					s->bump = (uint8_m*)s + MUM_SLAB_HEADER;
+					s->end = (uint8_m*)s + MUM_SLAB_SIZE - s->object_size + 1;
+					s->used = 0;
+					s->map_size = MUM_SLAB_SIZE;
+					s->remote = 0;
+					s->heap = heap;
+					s->partial = MU_FALSE;
+					mum_slab_link(heap, s);
+				}
+
+				heap->active[size_class] = s;
+				return mu_slab_alloc(s->object_size);
+			}
+
+			MUDEF void* mu_slab_alloc(size_m size) {
+				if (size > MUM_SLAB_MAX) {
+					return mum_slab_alloc_large(size);
+				}
+
+				mum_slab_heap* heap = mum_slab_heap_get();
+				if (!heap) {
+					return 0;
+				}
+
+				uint32_m size_class = mum_slab_class(size ? size : 1);
+				mum_slab* s = heap->active[size_class];
+				if (s) {
+					void* p = s->free;
+					if (p) {
+						s->free = *(void**)p;
+						s->used++;
+						return p;
+					}
+					if (s->bump < s->end) {
+						p = s->bump;
+						s->bump += s->object_size;
+						s->used++;
+						return p;
+					}
+				}
+
+				return mum_slab_alloc_slow(heap, size_class);
+			}
+
+			MUDEF void mu_slab_free(void* ptr) {
+				if (!ptr) {
+					return;
+				}
+
+				mum_slab* s = (mum_slab*)((size_m)ptr & ~(MUM_SLAB_SIZE - 1));
+				if (s->size_class == MUM_SLAB_LARGE) {
+					mum_os_unmap(s, s->map_size);
+					return;
+				}
+
+				mum_slab_heap* heap = mum_slab_local;
+				if (heap && mum_atomic_load32(&s->owner, MUM_RELAXED) == heap->id) {
+					mum_slab_free_local(heap, s, ptr);
+					return;
+				}
+				mum_slab_free_remote(s, ptr);
+			}
+
+		/* Topology */
+
+			MUDEF uint32_m mu_topology_cpu_count(void) {
+				return mum_topology_get()->cpu_count;
+			}
+
+			MUDEF uint32_m mu_topology_core_count(void) {
+				return mum_topology_get()->core_count;
+			}
+
+			MUDEF uint32_m mu_topology_llc_count(void) {
+				return mum_topology_get()->llc_count;
+			}
+
+			MUDEF uint32_m mu_topology_node_count(void) {
+				return mum_topology_get()->node_count;
+			}
+
+			MUDEF uint32_m mu_topology_cpu_core(uint32_m cpu) {
+				struct mum_topology* t = mum_topology_get();
+				return cpu < t->cpu_count ? t->core[cpu] : 0;
+			}
+
+			MUDEF uint32_m mu_topology_cpu_llc(uint32_m cpu) {
+				struct mum_topology* t = mum_topology_get();
+				return cpu < t->cpu_count ? t->llc[cpu] : 0;
+			}
+
+			MUDEF uint32_m mu_topology_cpu_node(uint32_m cpu) {
+				struct mum_topology* t = mum_topology_get();
+				return cpu < t->cpu_count ? t->node[cpu] : 0;
+			}
+
+			MUDEF uint32_m mu_topology_current_cpu(void) {
+				struct mum_topology* t = mum_topology_get();
+				uint32_m os = mum_topology_current_os_cpu();
+				if (os >= t->os_cpu_limit || t->cpu_of_os[os] == 0xFFFFFFFF) {
+					return 0;
+				}
+				return t->cpu_of_os[os];
+			}
+
+			MUDEF uint32_m mu_topology_current_node(void) {
+				return mu_topology_cpu_node(mu_topology_current_cpu());
+			}
+
+			// Looking up the current CPU can be a system call, so each thread only refreshes it
+			// every so often; a thread that has moved in between just uses another CPU's data
+			static MUM_THREAD_LOCAL uint32_m mum_cached_cpu = 0;
+			static MUM_THREAD_LOCAL uint32_m mum_cached_cpu_age = 0;
+
+			static inline uint32_m mum_current_cpu_cached(void) {
+				if ((mum_cached_cpu_age++ & 63) == 0) {
+					mum_cached_cpu = mu_topology_current_cpu();
+				}
+				return mum_cached_cpu;
+			}
+
+			MUDEF muThread mu_thread_create_on_cpu_(mumResult* result, void (*start)(void* args), void* args, uint32_m cpu) {
+				if (cpu >= mum_topology_get()->cpu_count) {
+					MU_SET_RESULT(result, MUM_INVALID_INDEX)
+					return 0;
+				}
+				return mum_thread_create_bound(result, start, args, cpu, 0xFFFFFFFF);
+			}
+
+			MUDEF muThread mu_thread_create_on_node_(mumResult* result, void (*start)(void* args), void* args, uint32_m node) {
+				if (node >= mum_topology_get()->node_count) {
+					MU_SET_RESULT(result, MUM_INVALID_INDEX)
+					return 0;
+				}
+				return mum_thread_create_bound(result, start, args, 0xFFFFFFFF, node);
+			}
+
+			MUDEF void* mu_node_alloc(size_m size, uint32_m node) {
+				struct mum_topology* t = mum_topology_get();
+				if (node >= t->node_count || size == 0) {
+					return 0;
+				}
+				return mum_os_map_node(size, t->os_node[node]);
+			}
+
+			MUDEF void mu_node_free(void* ptr, size_m size) {
+				if (ptr) {
+					mum_os_unmap(ptr, size);
+				}
+			}
+
+		/* Futex lock */
+
+			// A plain internal lock; the state is 0 if unlocked, 1 if locked, and 2 if locked and
+			// threads may be asleep waiting for it. Waiters spin for a short while before sleeping.
+
+			#define MUM_LOCK_SPINS 128
+
+			// Returns whether the lock had to be waited for
+			static inline muBool mum_lock_acquire(uint32_m* state) {
+				uint32_m expected = 0;
+				if (mum_atomic_cas32(state, &expected, 1)) {
+					return MU_FALSE;
+				}
+
+				uint32_m spins = 0;
+				while (spins < MUM_LOCK_SPINS) {
+					expected = 0;
+					if (mum_atomic_load32(state, MUM_RELAXED) == 0 && mum_atomic_cas32(state, &expected, 1)) {
+						return MU_TRUE;
+					}
+					mum_spin_backoff(&spins);
+				}
+
+				while (mum_atomic_exchange32(state, 2) != 0) {
+					mum_futex_wait(state, 2, MUM_NO_TIMEOUT);
+				}
+				return MU_TRUE;
+			}
+
+			static inline void mum_lock_release(uint32_m* state) {
+				if (mum_atomic_exchange32(state, 0) == 2) {
+					mum_futex_wake(state, MU_FALSE);
+				}
+			}
+
+		/* Inline locks */
+
+			// Called directly without MUM_INLINE, and from the header's fast paths when they fail, or
+			// with no atomics there; named in parentheses, as MUM_INLINE makes macros of the names
+			MUDEF void (mu_inline_spinlock_lock)(muInlineSpinlock* spinlock) {
+				uint32_m expected = 0;
+				while (!mum_atomic_cas32(&spinlock->locked, &expected, 1)) {
+					// Wait for it to look unlocked before trying again, so as not to keep taking the
+					// cache line from whoever holds it
+					while (mum_atomic_load32(&spinlock->locked, MUM_RELAXED) != 0) {
+						mum_cpu_relax();
+					}
+					expected = 0;
+				}
+			}
+
+			MUDEF muBool (mu_inline_spinlock_try_lock)(muInlineSpinlock* spinlock) {
+				uint32_m expected = 0;
+				return mum_atomic_cas32(&spinlock->locked, &expected, 1);
+			}
+
+			MUDEF void (mu_inline_spinlock_unlock)(muInlineSpinlock* spinlock) {
+				mum_atomic_store32(&spinlock->locked, 0, MUM_RELEASE);
+			}
+
+			// The same as mum_lock_acquire, except that sleeping is stoppable; giving up leaves the
+			// state at 2, which only costs the holder a wake that finds nobody
+			MUDEF muBool (mu_inline_mutex_lock)(muInlineMutex* mutex) {
+				uint32_m expected = 0;
+				if (mum_atomic_cas32(&mutex->state, &expected, 1)) {
+					return MU_TRUE;
+				}
+
+				uint32_m spins = 0;
+				while (spins < MUM_LOCK_SPINS) {
+					expected = 0;
+					if (mum_atomic_load32(&mutex->state, MUM_RELAXED) == 0 && mum_atomic_cas32(&mutex->state, &expected, 1)) {
+						return MU_TRUE;
+					}
+					mum_spin_backoff(&spins);
+				}
+
+				while (mum_atomic_exchange32(&mutex->state, 2) != 0) {
+					if (!mum_park_stoppable(&mutex->state, 2, MUM_NO_TIMEOUT)) {
+						return MU_FALSE;
+					}
+				}
+				return MU_TRUE;
+			}
+
+			MUDEF muBool (mu_inline_mutex_try_lock)(muInlineMutex* mutex) {
+				uint32_m expected = 0;
+				return mum_atomic_cas32(&mutex->state, &expected, 1);
+			}
+
+			MUDEF void (mu_inline_mutex_unlock)(muInlineMutex* mutex) {
+				mum_lock_release(&mutex->state);
+			}
+
+			MUDEF void mum_inline_mutex_wake(muInlineMutex* mutex) {
+				mum_futex_wake(&mutex->state, MU_FALSE);
+			}
+
+		/* Once flags */
+
+			// The function is called by whoever moves the state from 0 to 1; anybody else who
+			// finds it at 1 sets it to 2 before sleeping, so that the caller only makes the system
+			// call to wake them if somebody is asleep
+
+			static muBool mum_call_once(muOnce* once, void (*func)(void* args), void* args, muBool stoppable) {
+				uint32_m state = mum_atomic_load32(&once->state, MUM_ACQUIRE);
+				while (state != MUM_ONCE_DONE) {
+					if (state == 0) {
+						// A failed compare-and-swap updates the state to go around with
+						if (!mum_atomic_cas32(&once->state, &state, MUM_ONCE_CALLING)) {
+							continue;
+						}
+						func(args);
+						if (mum_atomic_exchange32(&once->state, MUM_ONCE_DONE) == MUM_ONCE_SLEEPING) {
+							mum_futex_wake(&once->state, MU_TRUE);
+						}
+						return MU_TRUE;
+					}
+
+					if (state == MUM_ONCE_CALLING && !mum_atomic_cas32(&once->state, &state, MUM_ONCE_SLEEPING)) {
+						continue;
+					}
+					if (!stoppable) {
+						mum_futex_wait(&once->state, MUM_ONCE_SLEEPING, MUM_NO_TIMEOUT);
+					} else if (!mum_park_stoppable(&once->state, MUM_ONCE_SLEEPING, MUM_NO_TIMEOUT)) {
+						return MU_FALSE;
+					}
+					state = mum_atomic_load32(&once->state, MUM_ACQUIRE);
+				}
+				return MU_TRUE;
+			}
+
+			MUDEF muBool mu_call_once(muOnce* once, void (*func)(void* args), void* args) {
+				return mum_call_once(once, func, args, MU_TRUE);
+			}
+
+			MUDEF void mum_call_once_lazy(muOnce* once, void (*func)(void* args), void* args) {
+				mum_call_once(once, func, args, MU_FALSE);
+			}
+
+		/* Parking lot */
+
+			// Parked threads are kept in a fixed table of FIFO queues, each on its own cache line
+			// and picked by a hash of the address; queues are shared by any addresses that hash
+			// the same, so each thread in one also keeps which address it's waiting on. A thread's
+			// place in a queue is on its own stack, and is only in the queue whilst it's parked.
+
+			#define MUM_PARKING_BITS 8
+			#define MUM_PARKING_BUCKETS (1 << MUM_PARKING_BITS)
+
+			struct mum_parked {
+				const void* address;
+				struct mum_parked* next;
+				// 1 whilst parked; cleared by whoever takes it off the queue to unpark it
+				uint32_m parked;
+			};
+			typedef struct mum_parked mum_parked;
+
+			struct mum_parking_bucket {
+				mum_parked* head;
+				mum_parked* tail;
+				uint32_m lock;
+				uint8_m pad[MUM_CACHE_LINE - 2 * sizeof(void*) - sizeof(uint32_m)];
+			};
+			typedef struct mum_parking_bucket mum_parking_bucket;
+
+			static mum_parking_bucket mum_parking_lot[MUM_PARKING_BUCKETS];
+
+			static inline mum_parking_bucket* mum_parking_bucket_get(const void* address) {
+				// Fibonacci hashing, so that the high bits depend on every bit of the address
+				uint64_m hash = (uint64_m)(size_m)address * 0x9E3779B97F4A7C15ull;
+				return &mum_parking_lot[hash >> (64 - MUM_PARKING_BITS)];
+			}
+
+			// Takes a thread off a queue that's locked; prev is the one before it, or 0
+			static inline void mum_parking_unlink(mum_parking_bucket* b, mum_parked* prev, mum_parked* p) {
+				if (prev) {
+					prev->next = p->next;
+				} else {
+					b->head = p->next;
+				}
+				if (b->tail == p) {
+					b->tail = prev;
+				}
+			}
+
+			// The parked thread can return as soon as the flag is cleared, after which its place in
+			// the queue is gone; waking its address afterwards is harmless even if it's been reused,
+			// as every futex waiter checks what it's waiting for again once woken up.
+			static inline void mum_parking_wake(mum_parked* p) {
+				mum_atomic_store32(&p->parked, 0, MUM_RELEASE);
+				mum_futex_wake(&p->parked, MU_FALSE);
+			}
+
+			// Takes a thread that timed out off its queue, returning whether it was still in it
+			static muBool mum_parking_remove(mum_parking_bucket* b, mum_parked* self) {
+				mum_lock_acquire(&b->lock);
+				mum_parked* prev = 0;
+				mum_parked* p = b->head;
+				while (p && p != self) {
+					prev = p;
+					p = p->next;
+				}
+				if (p) {
+					mum_parking_unlink(b, prev, p);
+				}
+				mum_lock_release(&b->lock);
+				return p != 0;
+			}
+
+			MUDEF muBool mu_park(const void* address, muBool (*validate)(void* args), void* args, int32_m timeout_ms) {
+				mum_parking_bucket* b = mum_parking_bucket_get(address);
+				mum_parked self;
+				self.address = address;
+				self.next = 0;
+				self.parked = 1;
+
+				mum_lock_acquire(&b->lock);
+				if (validate && !validate(args)) {
+					mum_lock_release(&b->lock);
+					return MU_FALSE;
+				}
+				if (b->tail) {
+					b->tail->next = &self;
+				} else {
+					b->head = &self;
+				}
+				b->tail = &self;
+				mum_lock_release(&b->lock);
+
+				uint64_m deadline = MUM_NO_TIMEOUT;
+				if (timeout_ms >= 0) {
+					deadline = mum_time_ns() + (uint64_m)timeout_ms * 1000000;
+				}
+				muBool stoppable = MU_TRUE;
+				while (mum_atomic_load32(&self.parked, MUM_ACQUIRE)) {
+					uint64_m wait = MUM_NO_TIMEOUT;
+					muBool give_up = MU_FALSE;
+					if (deadline != MUM_NO_TIMEOUT) {
+						uint64_m time = mum_time_ns();
+						give_up = time >= deadline;
+						wait = give_up ? 0 : deadline - time;
+					}
+					if (!give_up) {
+						if (!stoppable) {
+							mum_futex_wait(&self.parked, 1, wait);
+							continue;
+						}
+						give_up = !mum_park_stoppable(&self.parked, 1, wait);
+					}
+
+					if (give_up) {
+						if (mum_parking_remove(b, &self)) {
+							return MU_FALSE;
+						}
+						// Already taken off by a thread that's about to clear the flag
+						deadline = MUM_NO_TIMEOUT;
+						stoppable = MU_FALSE;
+					}
+				}
+				return MU_TRUE;
+			}
+
+			MUDEF muBool mu_unpark_one(const void* address, void (*callback)(muBool unparked, muBool more, void* args), void* args) {
+				mum_parking_bucket* b = mum_parking_bucket_get(address);
+
+				mum_lock_acquire(&b->lock);
+				mum_parked* prev = 0;
+				mum_parked* p = b->head;
+				while (p && p->address != address) {
+					prev = p;
+					p = p->next;
+				}
+
+				muBool more = MU_FALSE;
+				if (p) {
+					mum_parking_unlink(b, prev, p);
+					for (mum_parked* q = p->next; q; q = q->next) {
+						if (q->address == address) {
+							more = MU_TRUE;
+							break;
+						}
+					}
+				}
+				if (callback) {
+					callback(p != 0, more, args);
+				}
+				mum_lock_release(&b->lock);
+
+				if (!p) {
+					return MU_FALSE;
+				}
+				mum_parking_wake(p);
+				return MU_TRUE;
+			}
+
+			MUDEF size_m mu_unpark_all(const void* address) {
+				mum_parking_bucket* b = mum_parking_bucket_get(address);
+				mum_parked* woken = 0;
+				mum_parked* woken_tail = 0;
+
+				mum_lock_acquire(&b->lock);
+				mum_parked* prev = 0;
+				mum_parked* p = b->head;
+				while (p) {
+					mum_parked* next = p->next;
+					if (p->address == address) {
+						mum_parking_unlink(b, prev, p);
+						p->next = 0;
+						if (woken_tail) {
+							woken_tail->next = p;
+						} else {
+							woken = p;
+						}
+						woken_tail = p;
+					} else {
+						prev = p;
+					}
+					p = next;
+				}
+				mum_lock_release(&b->lock);
+
+				size_m count = 0;
+				while (woken) {
+					// Read before waking it, after which it may be gone
+					mum_parked* next = woken->next;
+					mum_parking_wake(woken);
+					woken = next;
+					count++;
+				}
+				return count;
+			}
+
+		/* Byte locks */
+
+			// A byte mutex is 1 if locked, and has 2 added whilst threads may be parked on it. Once
+			// the holder unlocks it with threads parked, it unparks one, and leaves 2 set if there
+			// are more; the unparked thread then competes for it like any other.
+			// A byte once flag is 1 whilst its function is being called, again with 2 added whilst
+			// threads may be parked on it, and 4 once it has returned.
+
+			#define MUM_BYTE_LOCKED 1
+			#define MUM_BYTE_PARKED 2
+			#define MUM_BYTE_DONE 4
+
+			// Parks only if the byte is still locked with parked threads
+			static muBool mum_byte_validate(void* args) {
+				return mum_atomic_load8((uint8_m*)args, MUM_RELAXED) == (MUM_BYTE_LOCKED | MUM_BYTE_PARKED);
+			}
+
+			MUDEF muBool mu_byte_mutex_lock(muByteMutex* mutex) {
+				uint8_m state = 0;
+				if (mum_atomic_cas8(mutex, &state, MUM_BYTE_LOCKED)) {
+					return MU_TRUE;
+				}
+
+				uint32_m spins = 0;
+				for (;;) {
+					state = mum_atomic_load8(mutex, MUM_RELAXED);
+					if (!(state & MUM_BYTE_LOCKED)) {
+						if (mum_atomic_cas8(mutex, &state, state | MUM_BYTE_LOCKED)) {
+							return MU_TRUE;
+						}
+						continue;
+					}
+
+					// Spin for a while first, unless threads are already parked
+					if (!(state & MUM_BYTE_PARKED)) {
+						if (spins < MUM_LOCK_SPINS) {
+							mum_spin_backoff(&spins);
+							continue;
+						}
+						if (!mum_atomic_cas8(mutex, &state, state | MUM_BYTE_PARKED)) {
+							continue;
+						}
+					}
+					if (!mu_park(mutex, mum_byte_validate, mutex, -1) && mum_stop_requested_self()) {
+						return MU_FALSE;
+					}
+				}
+			}
+
+			MUDEF muBool mu_byte_mutex_try_lock(muByteMutex* mutex) {
+				uint8_m state = mum_atomic_load8(mutex, MUM_RELAXED);
+				while (!(state & MUM_BYTE_LOCKED)) {
+					if (mum_atomic_cas8(mutex, &state, state | MUM_BYTE_LOCKED)) {
+						return MU_TRUE;
+					}
+				}
+				return MU_FALSE;
+			}
+
+			// Called with the queue locked, so no thread can park on the mutex in between
+			static void mum_byte_mutex_unparked(muBool unparked, muBool more, void* args) {
+				mum_atomic_store8((uint8_m*)args, more ? MUM_BYTE_PARKED : 0, MUM_RELEASE);
+				return; if (unparked) {}
+			}
+
+			MUDEF void mu_byte_mutex_unlock(muByteMutex* mutex) {
+				uint8_m state = MUM_BYTE_LOCKED;
+				if (mum_atomic_cas8(mutex, &state, 0)) {
+					return;
+				}
+				mu_unpark_one(mutex, mum_byte_mutex_unparked, mutex);
+			}
+
+			MUDEF muBool mu_byte_once_call(muByteOnce* once, void (*func)(void* args), void* args) {
+				if (mum_atomic_load8(once, MUM_ACQUIRE) == MUM_BYTE_DONE) {
+					return MU_TRUE;
+				}
+
+				for (;;) {
+					uint8_m state = mum_atomic_load8(once, MUM_ACQUIRE);
+					if (state == MUM_BYTE_DONE) {
+						return MU_TRUE;
+					}
+
+					if (state == 0) {
+						if (!mum_atomic_cas8(once, &state, MUM_BYTE_LOCKED)) {
+							continue;
+						}
+						func(args);
+
+						state = MUM_BYTE_LOCKED;
+						while (!mum_atomic_cas8(once, &state, MUM_BYTE_DONE)) {}
+						if (state & MUM_BYTE_PARKED) {
+							mu_unpark_all(once);
+						}
+						return MU_TRUE;
+					}
+
+					if (!(state & MUM_BYTE_PARKED) && !mum_atomic_cas8(once, &state, state | MUM_BYTE_PARKED)) {
+						continue;
+					}
+					if (!mu_park(once, mum_byte_validate, once, -1) && mum_stop_requested_self()) {
+						return MU_FALSE;
+					}
+				}
+			}
+
+		/* Cohort lock */
+
+			// Each cohort (a node, or a last-level cache if there's only one node) has its own local
+			// lock on its own cache line. Whoever holds a cohort's lock also holds the global ticket
+			// lock, either because it took it itself or because it was passed along with the local
+			// lock by the previous holder from the same cohort. The local lock lets threads barge in,
+			// since handing it over within a cohort is cheap; the global one is first-come,
+			// first-served, so that no cohort is starved.
+
+			#define MUM_COHORT_DEFAULT_LIMIT 64
+
+			// A ticket lock hands the lock to one specific waiter, which is hopeless if that waiter
+			// isn't running, so waiters that have spun for a while go to sleep instead
+			struct mum_ticket {
+				uint32_m next;
+				uint32_m serving;
+				uint32_m sleepers;
+			};
+
+			static inline void mum_ticket_wait(struct mum_ticket* t, uint32_m ticket) {
+				uint32_m spins = 0;
+				for (;;) {
+					uint32_m serving = mum_atomic_load32(&t->serving, MUM_ACQUIRE);
+					if (serving == ticket) {
+						return;
+					}
+
+					if (spins < MUM_LOCK_SPINS) {
+						mum_spin_backoff(&spins);
+						continue;
+					}
+
+					mum_atomic_fetch_add32(&t->sleepers, 1);
+					mum_futex_wait(&t->serving, serving, MUM_NO_TIMEOUT);
+					mum_atomic_fetch_sub32(&t->sleepers, 1);
+				}
+			}
+
+			static inline void mum_ticket_advance(struct mum_ticket* t) {
+				mum_atomic_store32(&t->serving, mum_atomic_load32(&t->serving, MUM_RELAXED) + 1, MUM_SEQ_CST);
+				if (mum_atomic_load32(&t->sleepers, MUM_SEQ_CST) != 0) {
+					mum_futex_wake(&t->serving, MU_TRUE);
+				}
+			}
+
+			struct mum_cohort {
+				// 0 if unlocked, 1 if locked, 2 if locked and threads may be asleep waiting for it
+				uint32_m state;
+				// Threads trying to take the local lock
+				uint32_m waiting;
+				// Set by a holder handing the lock to the next local waiter along with the global lock
+				uint32_m global_owned;
+				// Handoffs in a row within this cohort; only touched by the holder
+				uint32_m batch;
+				uint8_m pad[MUM_CACHE_LINE - 4 * sizeof(uint32_m)];
+			};
+
+
+			struct mum_cohort_lock {
+				struct mum_ticket global;
+				uint8_m pad[MUM_CACHE_LINE - sizeof(struct mum_ticket)];
+				uint32_m cohort_count;
+				uint32_m handoff_limit;
+				// Cohort of the current holder; only touched by the holder
+				uint32_m owner;
+				struct mum_cohort* cohorts;
+			};
+			typedef struct mum_cohort_lock mum_cohort_lock;
+
+			static inline muBool mum_cohort_by_node(struct mum_topology* t) {
+				return t->node_count > 1;
+			}
+
+			// A thread that has moved to another CPU since it last looked just queues in the wrong
+			// cohort for a while
+			static inline uint32_m mum_cohort_current(mum_cohort_lock* p) {
+				uint32_m cpu = mum_current_cpu_cached();
+				struct mum_topology* t = mum_topology_get();
+				uint32_m cohort = mum_cohort_by_node(t) ? t->node[cpu] : t->llc[cpu];
+				return cohort < p->cohort_count ? cohort : 0;
+			}
+
+			MUDEF muCohortLock mu_cohort_lock_create_(mumResult* result, uint32_m handoff_limit) {
+				struct mum_topology* t = mum_topology_get();
+				uint32_m cohort_count = mum_cohort_by_node(t) ? t->node_count : t->llc_count;
+
+				// One extra cohort's worth of room to align the cohorts to a cache line
+				mum_cohort_lock* p = (mum_cohort_lock*)mu_malloc(sizeof(mum_cohort_lock) + sizeof(struct mum_cohort) * (cohort_count + 1));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->global.next = 0;
+				p->global.serving = 0;
+				p->global.sleepers = 0;
+				p->cohort_count = cohort_count;
+				p->handoff_limit = handoff_limit ? handoff_limit : MUM_COHORT_DEFAULT_LIMIT;
+				p->owner = 0;
+
+				size_m cohorts = ((size_m)(p + 1) + MUM_CACHE_LINE - 1) & ~(size_m)(MUM_CACHE_LINE - 1);
+				p->cohorts = (struct mum_cohort*)cohorts;
+				for (uint32_m i = 0; i < cohort_count; i++) {
+					p->cohorts[i].state = 0;
+					p->cohorts[i].waiting = 0;
+					p->cohorts[i].global_owned = 0;
+					p->cohorts[i].batch = 0;
+				}
+
+				return p;
+			}
+
+			MUDEF muCohortLock mu_cohort_lock_destroy_(mumResult* result, muCohortLock lock) {
+				mu_free(lock);
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_cohort_lock_lock_(mumResult* result, muCohortLock lock) {
+				mum_cohort_lock* p = (mum_cohort_lock*)lock;
+				uint32_m index = mum_cohort_current(p);
+				struct mum_cohort* c = &p->cohorts[index];
+
+				mum_atomic_fetch_add32(&c->waiting, 1);
+				muBool contended = mum_lock_acquire(&c->state);
+				mum_atomic_fetch_sub32(&c->waiting, 1);
+				if (contended) {
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_COHORT_LOCK, p);
+				}
+
+				// The previous local holder may have passed the global lock along
+				if (!c->global_owned) {
+					uint32_m global_ticket = mum_atomic_fetch_add32(&p->global.next, 1);
+					if (!contended && mum_atomic_load32(&p->global.serving, MUM_ACQUIRE) != global_ticket) {
+						contended = MU_TRUE;
+						MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_COHORT_LOCK, p);
+					}
+					mum_ticket_wait(&p->global, global_ticket);
+					c->batch = 0;
+				}
+
+				p->owner = index;
+				if (contended) {
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_COHORT_LOCK, p);
+				} else {
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_COHORT_LOCK, p);
+				}
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_cohort_lock_unlock_(mumResult* result, muCohortLock lock) {
+				mum_cohort_lock* p = (mum_cohort_lock*)lock;
+				struct mum_cohort* c = &p->cohorts[p->owner];
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_COHORT_LOCK, p);
+
+				// Keep the global lock within the cohort if someone local is waiting and the cohort
+				// hasn't hogged it for too long
+				if (mum_atomic_load32(&c->waiting, MUM_RELAXED) != 0 && c->batch < p->handoff_limit) {
+					c->batch++;
+					c->global_owned = 1;
+				} else {
+					c->global_owned = 0;
+					mum_ticket_advance(&p->global);
+				}
+
+				mum_lock_release(&c->state);
+
+				return; if (result) {}
+			}
+
+		/* Adaptive lock */
+
+			// The state is the same as the futex lock's. Everything but the state is only written by
+			// the holder, so the tuning needs no atomic read-modify-writes; waiters only read the
+			// time the lock was taken and the spin limit. Averages are exponentially weighted, each
+			// new sample counting for an eighth. The time the lock was taken is 0 if the hold isn't
+			// being measured.
+
+			#define MUM_ADAPTIVE_MIN_SPIN 250ull
+			#define MUM_ADAPTIVE_MAX_SPIN 50000ull
+			#define MUM_ADAPTIVE_INITIAL_SPIN 2000ull
+			// A holder that has held the lock for this many times its average hold time (plus the
+			// spin limit) is assumed to have been descheduled
+			#define MUM_ADAPTIVE_STALL_FACTOR 4
+			// Uncontended holds measured; one in this many, a power of 2
+			#define MUM_ADAPTIVE_SAMPLE 8
+
+			struct mum_adaptive_lock {
+				uint32_m state;
+				uint32_m multi_cpu;
+				uint8_m pad[MUM_CACHE_LINE - 2 * sizeof(uint32_m)];
+				uint64_m acquired_ns;
+				uint64_m hold_ns;
+				uint64_m spin_ns;
+				uint64_m acquisitions;
+				uint64_m contended;
+				uint64_m spun;
+				uint64_m parked;
+			};
+			typedef struct mum_adaptive_lock mum_adaptive_lock;
+
+			static inline uint64_m mum_adaptive_average(uint64_m average, uint64_m sample) {
+				return (uint64_m)((int64_m)average + ((int64_m)sample - (int64_m)average) / 8);
+			}
+
+			MUDEF muAdaptiveLock mu_adaptive_lock_create_(mumResult* result) {
+				mum_adaptive_lock* p = (mum_adaptive_lock*)mu_malloc(sizeof(mum_adaptive_lock));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->state = 0;
+				p->multi_cpu = mu_topology_cpu_count() > 1;
+				p->acquired_ns = 0;
+				p->hold_ns = 0;
+				p->spin_ns = MUM_ADAPTIVE_INITIAL_SPIN;
+				p->acquisitions = 0;
+				p->contended = 0;
+				p->spun = 0;
+				p->parked = 0;
+				return p;
+			}
+
+			MUDEF muAdaptiveLock mu_adaptive_lock_destroy_(mumResult* result, muAdaptiveLock lock) {
+				mu_free(lock);
+				return 0; if (result) {}
+			}
+
+			// Spins until the lock is taken or spinning stops looking worthwhile; returns whether
+			// the lock was taken
+			static muBool mum_adaptive_spin(mum_adaptive_lock* p) {
+				uint64_m limit = mum_atomic_load64(&p->spin_ns, MUM_RELAXED);
+				uint64_m stall = mum_atomic_load64(&p->hold_ns, MUM_RELAXED) * MUM_ADAPTIVE_STALL_FACTOR + limit;
+				uint64_m start = mum_time_ns();
+
+				for (uint32_m spins = 1;; spins++) {
+					uint32_m expected = 0;
+					if (mum_atomic_load32(&p->state, MUM_RELAXED) == 0 && mum_atomic_cas32(&p->state, &expected, 1)) {
+						return MU_TRUE;
+					}
+					mum_cpu_relax();
+
+					// Reading the time isn't free, so only check every so often
+					if ((spins & 15) == 0) {
+						uint64_m now = mum_time_ns();
+						if (now - start >= limit) {
+							return MU_FALSE;
+						}
+						uint64_m acquired = mum_atomic_load64(&p->acquired_ns, MUM_RELAXED);
+						if (acquired != 0 && now > acquired && now - acquired > stall) {
+							return MU_FALSE;
+						}
+					}
+				}
+			}
+
+			MUDEF void mu_adaptive_lock_lock_(mumResult* result, muAdaptiveLock lock) {
+				mum_adaptive_lock* p = (mum_adaptive_lock*)lock;
+
+				uint32_m expected = 0;
+				if (mum_atomic_cas32(&p->state, &expected, 1)) {
+					MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE, MUM_TRACE_ADAPTIVE_LOCK, p);
+					uint64_m acquisitions = p->acquisitions + 1;
+					mum_atomic_store64(&p->acquisitions, acquisitions, MUM_RELAXED);
+					mum_atomic_store64(&p->acquired_ns, (acquisitions & (MUM_ADAPTIVE_SAMPLE - 1)) == 0 ? mum_time_ns() : 0, MUM_RELAXED);
+					return;
+				}
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_CONTEND, MUM_TRACE_ADAPTIVE_LOCK, p);
+				muBool spun = p->multi_cpu && mum_adaptive_spin(p);
+				if (!spun) {
+					while (mum_atomic_exchange32(&p->state, 2) != 0) {
+						mum_futex_wait(&p->state, 2, MUM_NO_TIMEOUT);
+					}
+				}
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_ACQUIRE_CONTENDED, MUM_TRACE_ADAPTIVE_LOCK, p);
+
+				// Spinning that paid off moves the limit towards twice the average hold time, which
+				// covers most waits; spinning that didn't backs off quickly
+				uint64_m limit = p->spin_ns;
+				if (spun) {
+					uint64_m target = p->hold_ns * 2;
+					target = target < MUM_ADAPTIVE_MIN_SPIN ? MUM_ADAPTIVE_MIN_SPIN : target;
+					target = target > MUM_ADAPTIVE_MAX_SPIN ? MUM_ADAPTIVE_MAX_SPIN : target;
+					limit = mum_adaptive_average(limit, target);
+					mum_atomic_store64(&p->spun, p->spun + 1, MUM_RELAXED);
+				} else {
+					if (p->multi_cpu) {
+						limit -= limit / 4;
+						limit = limit < MUM_ADAPTIVE_MIN_SPIN ? MUM_ADAPTIVE_MIN_SPIN : limit;
+					}
+					mum_atomic_store64(&p->parked, p->parked + 1, MUM_RELAXED);
+				}
+				mum_atomic_store64(&p->spin_ns, limit, MUM_RELAXED);
+
+				mum_atomic_store64(&p->acquisitions, p->acquisitions + 1, MUM_RELAXED);
+				mum_atomic_store64(&p->contended, p->contended + 1, MUM_RELAXED);
+				mum_atomic_store64(&p->acquired_ns, mum_time_ns(), MUM_RELAXED);
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_adaptive_lock_unlock_(mumResult* result, muAdaptiveLock lock) {
+				mum_adaptive_lock* p = (mum_adaptive_lock*)lock;
+
+				if (p->acquired_ns != 0) {
+					uint64_m hold = mum_time_ns() - p->acquired_ns;
+					mum_atomic_store64(&p->hold_ns, mum_adaptive_average(p->hold_ns, hold), MUM_RELAXED);
+				}
+
+				MUM_TRACE_EVENT(MUM_TRACE_LOCK_RELEASE, MUM_TRACE_ADAPTIVE_LOCK, p);
+				if (mum_atomic_exchange32(&p->state, 0) == 2) {
+					mum_futex_wake(&p->state, MU_FALSE);
+				}
+
+				return; if (result) {}
+			}
+
+			MUDEF void mu_adaptive_lock_stats(muAdaptiveLock lock, uint64_m* acquisitions, uint64_m* contended, uint64_m* spun, uint64_m* parked, uint64_m* average_hold_ns, uint64_m* spin_limit_ns) {
+				mum_adaptive_lock* p = (mum_adaptive_lock*)lock;
+				if (acquisitions) {
+					*acquisitions = mum_atomic_load64(&p->acquisitions, MUM_RELAXED);
+				}
+				if (contended) {
+					*contended = mum_atomic_load64(&p->contended, MUM_RELAXED);
+				}
+				if (spun) {
+					*spun = mum_atomic_load64(&p->spun, MUM_RELAXED);
+				}
+				if (parked) {
+					*parked = mum_atomic_load64(&p->parked, MUM_RELAXED);
+				}
+				if (average_hold_ns) {
+					*average_hold_ns = mum_atomic_load64(&p->hold_ns, MUM_RELAXED);
+				}
+				if (spin_limit_ns) {
+					*spin_limit_ns = mum_atomic_load64(&p->spin_ns, MUM_RELAXED);
+				}
+			}
+
+		/* Combiner */
+
+			// Each submission swaps the thread's spare node in as the new tail, and fills in the
+			// node that was the tail before with its operation, so that the tail is always an empty
+			// node and the thread takes the old tail as its spare. A node's owner waits on it until
+			// either its operation has been run (done) or it has been handed the job of running
+			// the queue from its own node onwards (not done). The runner only touches a node until
+			// it clears that node's wait flag, after which the node belongs to its owner again.
+
+			#define MUM_COMBINER_DEFAULT_LIMIT 64
+
+			// Wait flag values; 2 means the owner may be asleep on it
+			#define MUM_COMBINER_READY 0
+			#define MUM_COMBINER_WAIT 1
+			#define MUM_COMBINER_SLEEP 2
+
+			struct mum_combiner_node {
+				void (*operation)(void* args);
+				void* args;
+				void* volatile next;
+				uint32_m wait;
+				uint32_m done;
+				uint8_m pad[MUM_CACHE_LINE - 2 * sizeof(void*) - sizeof(void*) - 2 * sizeof(uint32_m)];
+			};
+			typedef struct mum_combiner_node mum_combiner_node;
+
+			struct mum_combiner {
+				void* volatile tail;
+				uint32_m batch_limit;
+				uint8_m pad[MUM_CACHE_LINE - sizeof(void*) - sizeof(uint32_m)];
+			};
+			typedef struct mum_combiner mum_combiner;
+
+			static MUM_THREAD_LOCAL mum_combiner_node* mum_combiner_spare = 0;
+
+			static void mum_combiner_thread_exit(void* value) {
+				if (mum_combiner_spare == value) {
+					mum_combiner_spare = 0;
+				}
+				mu_free(value);
+			}
+
+			MUDEF muCombiner mu_combiner_create_(mumResult* result, uint32_m batch_limit) {
+				mum_combiner* p = (mum_combiner*)mu_malloc(sizeof(mum_combiner));
+				mum_combiner_node* node = (mum_combiner_node*)mu_malloc(sizeof(mum_combiner_node));
+				if (!p || !node) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					mu_free(p);
+					mu_free(node);
+					return 0;
+				}
+
+				// The first node starts out ready, so that the first submitter runs the queue
+				node->next = 0;
+				node->wait = MUM_COMBINER_READY;
+				node->done = 0;
+				p->tail = node;
+				p->batch_limit = batch_limit ? batch_limit : MUM_COMBINER_DEFAULT_LIMIT;
+				return p;
+			}
+
+			MUDEF muCombiner mu_combiner_destroy_(mumResult* result, muCombiner combiner) {
+				mum_combiner* p = (mum_combiner*)combiner;
+				mu_free(p->tail);
+				mu_free(p);
+				return 0; if (result) {}
+			}
+
+			static inline void mum_combiner_release(mum_combiner_node* node, uint32_m done) {
+				mum_atomic_store32(&node->done, done, MUM_RELAXED);
+				if (mum_atomic_exchange32(&node->wait, MUM_COMBINER_READY) == MUM_COMBINER_SLEEP) {
+					mum_futex_wake(&node->wait, MU_FALSE);
+				}
+			}
+
+			MUDEF void mu_combiner_execute_(mumResult* result, muCombiner combiner, void (*operation)(void* args), void* args) {
+				mum_combiner* p = (mum_combiner*)combiner;
+
+				mum_combiner_node* spare = mum_combiner_spare;
+				if (!spare) {
+					spare = (mum_combiner_node*)mu_malloc(sizeof(mum_combiner_node));
+					if (!spare) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return;
+					}
+				}
+
+				spare->next = 0;
+				spare->wait = MUM_COMBINER_WAIT;
+				spare->done = 0;
+				mum_combiner_node* node = (mum_combiner_node*)mum_atomic_exchange_ptr(&p->tail, spare);
+				node->operation = operation;
+				node->args = args;
+				mum_atomic_store_ptr(&node->next, spare, MUM_RELEASE);
+
+				// The old tail is ours from now on; tell the exit hook about it
+				mum_combiner_spare = node;
+				mum_thread_exit_hook_set(MUM_EXIT_HOOK_COMBINER, node);
+
+				uint32_m spins = 0;
+				uint32_m wait;
+				while ((wait = mum_atomic_load32(&node->wait, MUM_ACQUIRE)) != MUM_COMBINER_READY) {
+					if (spins < MUM_LOCK_SPINS) {
+						mum_spin_backoff(&spins);
+						continue;
+					}
+					uint32_m expected = MUM_COMBINER_WAIT;
+					if (wait == MUM_COMBINER_SLEEP || mum_atomic_cas32(&node->wait, &expected, MUM_COMBINER_SLEEP)) {
+						mum_futex_wait(&node->wait, MUM_COMBINER_SLEEP, MUM_NO_TIMEOUT);
+					}
+				}
+				if (mum_atomic_load32(&node->done, MUM_RELAXED)) {
+					return;
+				}
+
+				// Run everything queued from here on, up to the limit; a node whose next is still 0
+				// is either the tail or one whose operation isn't filled in yet, so its owner runs
+				// the queue from there
+				uint32_m count = 0;
+				mum_combiner_node* next;
+				while ((next = (mum_combiner_node*)mum_atomic_load_ptr(&node->next, MUM_ACQUIRE)) != 0 && count < p->batch_limit) {
+					node->operation(node->args);
+					mum_combiner_release(node, 1);
+					node = next;
+					count++;
+				}
+				mum_combiner_release(node, 0);
+			}
+
+		/* Counters and accumulators */
+
+			// Both are an array of shards, one cache line each, indexed by CPU masked to a power of
+			// 2; the shard array is aligned within an allocation one line larger than it needs.
+			// Signed values are kept as their unsigned bit patterns so that the 64-bit atomics can
+			// be used, and wrap around the same way.
+
+			struct mum_shards {
+				uint32_m mask;
+				uint8_m* shards;
+			};
+
+			static inline uint32_m mum_shard_count(void) {
+				uint32_m count = 1;
+				while (count < mu_topology_cpu_count()) {
+					count *= 2;
+				}
+				return count;
+			}
+
+			static struct mum_shards* mum_shards_alloc(mumResult* result) {
+				uint32_m count = mum_shard_count();
+				struct mum_shards* p = (struct mum_shards*)mu_malloc(sizeof(struct mum_shards) + MUM_CACHE_LINE * (count + 1));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				p->mask = count - 1;
+				p->shards = (uint8_m*)(((size_m)(p + 1) + MUM_CACHE_LINE - 1) & ~(size_m)(MUM_CACHE_LINE - 1));
+				return p;
+			}
+
+			static inline void* mum_shard(struct mum_shards* p, uint32_m index) {
+				return p->shards + MUM_CACHE_LINE * index;
+			}
+
+			static inline void* mum_shard_local(struct mum_shards* p) {
+				return mum_shard(p, mum_current_cpu_cached() & p->mask);
+			}
+
+			struct mum_accumulator_shard {
+				uint64_m count;
+				uint64_m sum;
+				uint64_m min;
+				uint64_m max;
+			};
+
+			static void mum_accumulator_clear(struct mum_accumulator_shard* shard) {
+				mum_atomic_store64(&shard->count, 0, MUM_RELAXED);
+				mum_atomic_store64(&shard->sum, 0, MUM_RELAXED);
+				mum_atomic_store64(&shard->min, (uint64_m)0x7FFFFFFFFFFFFFFFull, MUM_RELAXED);
+				mum_atomic_store64(&shard->max, (uint64_m)0x8000000000000000ull, MUM_RELAXED);
+			}
+
+			MUDEF muCounter mu_counter_create_(mumResult* result) {
+				struct mum_shards* p = mum_shards_alloc(result);
+				if (!p) {
+					return 0;
+				}
+
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					*(uint64_m*)mum_shard(p, i) = 0;
+				}
+				return p;
+			}
+
+			MUDEF muCounter mu_counter_destroy_(mumResult* result, muCounter counter) {
+				mu_free(counter);
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_counter_add(muCounter counter, int64_m amount) {
+				mum_atomic_fetch_add64((uint64_m*)mum_shard_local((struct mum_shards*)counter), (uint64_m)amount);
+			}
+
+			MUDEF int64_m mu_counter_read(muCounter counter) {
+				struct mum_shards* p = (struct mum_shards*)counter;
+				uint64_m total = 0;
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					total += mum_atomic_load64((uint64_m*)mum_shard(p, i), MUM_RELAXED);
+				}
+				return (int64_m)total;
+			}
+
+			MUDEF int64_m mu_counter_take(muCounter counter) {
+				struct mum_shards* p = (struct mum_shards*)counter;
+				uint64_m total = 0;
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					uint64_m* shard = (uint64_m*)mum_shard(p, i);
+					uint64_m value = mum_atomic_load64(shard, MUM_RELAXED);
+					while (!mum_atomic_cas64(shard, &value, 0)) {}
+					total += value;
+				}
+				return (int64_m)total;
+			}
+
+			MUDEF muAccumulator mu_accumulator_create_(mumResult* result) {
+				struct mum_shards* p = mum_shards_alloc(result);
+				if (!p) {
+					return 0;
+				}
+
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					mum_accumulator_clear((struct mum_accumulator_shard*)mum_shard(p, i));
+				}
+				return p;
+			}
+
+			MUDEF muAccumulator mu_accumulator_destroy_(mumResult* result, muAccumulator accumulator) {
+				mu_free(accumulator);
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_accumulator_record(muAccumulator accumulator, int64_m value) {
+				struct mum_accumulator_shard* shard = (struct mum_accumulator_shard*)mum_shard_local((struct mum_shards*)accumulator);
+				mum_atomic_fetch_add64(&shard->count, 1);
+				mum_atomic_fetch_add64(&shard->sum, (uint64_m)value);
+
+				uint64_m min = mum_atomic_load64(&shard->min, MUM_RELAXED);
+				while (value < (int64_m)min && !mum_atomic_cas64(&shard->min, &min, (uint64_m)value)) {}
+				uint64_m max = mum_atomic_load64(&shard->max, MUM_RELAXED);
+				while (value > (int64_m)max && !mum_atomic_cas64(&shard->max, &max, (uint64_m)value)) {}
+			}
+
+			MUDEF void mu_accumulator_read(muAccumulator accumulator, uint64_m* count, int64_m* sum, int64_m* min, int64_m* max) {
+				struct mum_shards* p = (struct mum_shards*)accumulator;
+				uint64_m total_count = 0, total_sum = 0;
+				int64_m total_min = 0, total_max = 0;
+				muBool any = MU_FALSE;
+
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					struct mum_accumulator_shard* shard = (struct mum_accumulator_shard*)mum_shard(p, i);
+					total_count += mum_atomic_load64(&shard->count, MUM_RELAXED);
+					total_sum += mum_atomic_load64(&shard->sum, MUM_RELAXED);
+
+					// A shard that hasn't recorded anything still has its minimum above its maximum
+					int64_m shard_min = (int64_m)mum_atomic_load64(&shard->min, MUM_RELAXED);
+					int64_m shard_max = (int64_m)mum_atomic_load64(&shard->max, MUM_RELAXED);
+					if (shard_min > shard_max) {
+						continue;
+					}
+					if (!any || shard_min < total_min) {
+						total_min = shard_min;
+					}
+					if (!any || shard_max > total_max) {
+						total_max = shard_max;
+					}
+					any = MU_TRUE;
+				}
+
+				if (count) {
+					*count = total_count;
+				}
+				if (sum) {
+					*sum = (int64_m)total_sum;
+				}
+				if (min) {
+					*min = total_min;
+				}
+				if (max) {
+					*max = total_max;
+				}
+			}
+
+			MUDEF void mu_accumulator_reset(muAccumulator accumulator) {
+				struct mum_shards* p = (struct mum_shards*)accumulator;
+				for (uint32_m i = 0; i <= p->mask; i++) {
+					mum_accumulator_clear((struct mum_accumulator_shard*)mum_shard(p, i));
+				}
+			}
+
+		/* Object pool */
+
+			// Free objects are chained into magazines through their first member. The depot is a
+			// Treiber stack of magazines, linked by object index rather than by pointer so that its
+			// top fits in 64 bits with a tag that changes on every push and pop. Object memory is
+			// never freed before the pool is, so reading the link of a magazine that another thread
+			// has just popped is harmless; the tag makes the compare-exchange fail.
+			//
+			// Chunk c holds MUM_POOL_FIRST << c objects, starting at index
+			// MUM_POOL_FIRST * (2^c - 1), so an index's chunk is found from its highest set bit.
+			//
+			// Threads keep their magazines for each pool in a thread-local list, tagged with the
+			// pool's id since a pool's address can be reused once it's destroyed. A global registry
+			// of live pools tells which entries are stale, when a thread exits or adds an entry.
+
+			#define MUM_POOL_MAGAZINE 32
+			#define MUM_POOL_FIRST 64u
+			#define MUM_POOL_CHUNKS 26
+
+			struct mum_pool_object {
+				struct mum_pool_object* next;
+				// Only used by the first object of a magazine whilst it's in the depot
+				uint32_m depot_next;
+				uint32_m count;
+			};
+			typedef struct mum_pool_object mum_pool_object;
+
+			struct mum_pool {
+				// Tag in the high half, index of the top magazine's first object plus one in the low
+				uint64_m depot;
+				uint8_m pad[MUM_CACHE_LINE - sizeof(uint64_m)];
+
+				size_m object_size;
+				uint64_m id;
+				// Guards growing the pool
+				uint32_m lock;
+				uint32_m chunk_count;
+				// Indices from fresh up to end have never been handed out
+				uint32_m fresh;
+				uint32_m end;
+				void* chunks[MUM_POOL_CHUNKS];
+				struct mum_pool* registry_next;
+			};
+			typedef struct mum_pool mum_pool;
+
+			struct mum_pool_cache {
+				mum_pool* pool;
+				uint64_m id;
+				struct mum_pool_cache* next;
+				// The loaded magazine may be partly full; the previous one is either full or empty
+				mum_pool_object* loaded;
+				mum_pool_object* previous;
+				uint32_m loaded_count;
+				uint32_m previous_count;
+			};
+			typedef struct mum_pool_cache mum_pool_cache;
+
+			static MUM_THREAD_LOCAL mum_pool_cache* mum_pool_caches = 0;
+
+			static uint32_m mum_pool_registry_lock = 0;
+			static mum_pool* mum_pool_registry = 0;
+			static uint64_m mum_pool_next_id = 0;
+
+			static inline mum_pool_object* mum_pool_object_get(mum_pool* p, uint32_m index) {
+				uint32_m c = 0;
+				uint32_m n = index / MUM_POOL_FIRST + 1;
+				while (n >>= 1) {
+					c++;
+				}
+				uint8_m* chunk = (uint8_m*)mum_atomic_load_ptr(&p->chunks[c], MUM_RELAXED);
+				return (mum_pool_object*)(chunk + (size_m)(index - MUM_POOL_FIRST * ((1u << c) - 1)) * p->object_size);
+			}
+
+			static uint32_m mum_pool_index(mum_pool* p, mum_pool_object* o) {
+				uint8_m* b = (uint8_m*)o;
+				uint32_m c = 0;
+				for (;;) {
+					uint8_m* chunk = (uint8_m*)mum_atomic_load_ptr(&p->chunks[c], MUM_RELAXED);
+					if (b >= chunk && b < chunk + ((size_m)MUM_POOL_FIRST << c) * p->object_size) {
+						return MUM_POOL_FIRST * ((1u << c) - 1) + (uint32_m)((size_m)(b - chunk) / p->object_size);
+					}
+					c++;
+				}
+			}
+
+			static void mum_pool_depot_push(mum_pool* p, mum_pool_object* first, uint32_m count) {
+				uint64_m top = (uint64_m)mum_pool_index(p, first) + 1;
+				first->count = count;
+
+				uint64_m old = mum_atomic_load64(&p->depot, MUM_RELAXED);
+				do {
+					mum_atomic_store32(&first->depot_next, (uint32_m)old, MUM_RELAXED);
+				} while (!mum_atomic_cas64(&p->depot, &old, (((old >> 32) + 1) << 32) | top));
+			}
+
+			static mum_pool_object* mum_pool_depot_pop(mum_pool* p, uint32_m* count) {
+				uint64_m old = mum_atomic_load64(&p->depot, MUM_ACQUIRE);
+				for (;;) {
+					uint32_m top = (uint32_m)old;
+					if (top == 0) {
+						return 0;
+					}
+					mum_pool_object* first = mum_pool_object_get(p, top - 1);
+					uint32_m next = mum_atomic_load32(&first->depot_next, MUM_RELAXED);
+					if (mum_atomic_cas64(&p->depot, &old, (((old >> 32) + 1) << 32) | next)) {
+						*count = first->count;
+						return first;
+					}
+				}
+			}
+
+			// Hands out a magazine of objects that have never been used, growing the pool if needed
+			static mum_pool_object* mum_pool_fresh(mum_pool* p, uint32_m* count) {
+				mum_lock_acquire(&p->lock);
+				if (p->fresh == p->end) {
+					if (p->chunk_count == MUM_POOL_CHUNKS) {
+						mum_lock_release(&p->lock);
+						return 0;
+					}
+					size_m objects = (size_m)MUM_POOL_FIRST << p->chunk_count;
+					void* chunk = mu_malloc(objects * p->object_size);
+					if (!chunk) {
+						mum_lock_release(&p->lock);
+						return 0;
+					}
+					mum_atomic_store_ptr(&p->chunks[p->chunk_count], chunk, MUM_RELEASE);
+					p->chunk_count++;
+					p->end += (uint32_m)objects;
+				}
+
+				uint32_m n = p->end - p->fresh;
+				n = n < MUM_POOL_MAGAZINE ? n : MUM_POOL_MAGAZINE;
+				// Never-used indices are all in the last chunk, so they're next to each other
+				uint8_m* first = (uint8_m*)mum_pool_object_get(p, p->fresh);
+				for (uint32_m i = 0; i < n; i++) {
+					((mum_pool_object*)(first + i * p->object_size))->next = i + 1 < n ? (mum_pool_object*)(first + (i + 1) * p->object_size) : 0;
+				}
+				p->fresh += n;
+				mum_lock_release(&p->lock);
+
+				*count = n;
+				return (mum_pool_object*)first;
+			}
+
+			// Must be called with the registry locked
+			static muBool mum_pool_cache_live(mum_pool_cache* c) {
+				for (mum_pool* p = mum_pool_registry; p; p = p->registry_next) {
+					if (p == c->pool && p->id == c->id) {
+						return MU_TRUE;
+					}
+				}
+				return MU_FALSE;
+			}
+
+			static void mum_pool_thread_exit(void* value) {
+				mum_pool_cache* c = (mum_pool_cache*)value;
+
+				mum_lock_acquire(&mum_pool_registry_lock);
+				while (c) {
+					mum_pool_cache* next = c->next;
+					if (mum_pool_cache_live(c)) {
+						if (c->loaded_count) {
+							mum_pool_depot_push(c->pool, c->loaded, c->loaded_count);
+						}
+						if (c->previous_count) {
+							mum_pool_depot_push(c->pool, c->previous, c->previous_count);
+						}
+					}
+					mu_free(c);
+					c = next;
+				}
+				mum_lock_release(&mum_pool_registry_lock);
+
+				mum_pool_caches = 0;
+			}
+
+			static mum_pool_cache* mum_pool_cache_get(mum_pool* p) {
+				for (mum_pool_cache* c = mum_pool_caches; c; c = c->next) {
+					if (c->pool == p && c->id == p->id) {
+						return c;
+					}
+				}
+
+				// Drop the entries of pools destroyed since; their objects went with them
+				mum_lock_acquire(&mum_pool_registry_lock);
+				mum_pool_cache** link = &mum_pool_caches;
+				while (*link) {
+					mum_pool_cache* c = *link;
+					if (mum_pool_cache_live(c)) {
+						link = &c->next;
+					} else {
+						*link = c->next;
+						mu_free(c);
+					}
+				}
+				mum_lock_release(&mum_pool_registry_lock);
+
+				mum_pool_cache* c = (mum_pool_cache*)mu_malloc(sizeof(mum_pool_cache));
+				if (c) {
+					c->pool = p;
+					c->id = p->id;
+					c->loaded = 0;
+					c->previous = 0;
+					c->loaded_count = 0;
+					c->previous_count = 0;
+					c->next = mum_pool_caches;
+					mum_pool_caches = c;
+				}
+				mum_thread_exit_hook_set(MUM_EXIT_HOOK_POOL, mum_pool_caches);
+				return c;
+			}
+
+			MUDEF muPool mu_pool_create_(mumResult* result, size_m object_size) {
+				mum_pool* p = (mum_pool*)mu_malloc(sizeof(mum_pool));
+				if (!p) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				object_size = object_size < sizeof(mum_pool_object) ? sizeof(mum_pool_object) : object_size;
+				p->depot = 0;
+				p->object_size = (object_size + 15) & ~(size_m)15;
+				p->lock = 0;
+				p->chunk_count = 0;
+				p->fresh = 0;
+				p->end = 0;
+				for (uint32_m c = 0; c < MUM_POOL_CHUNKS; c++) {
+					p->chunks[c] = 0;
+				}
+
+				mum_lock_acquire(&mum_pool_registry_lock);
+				p->id = ++mum_pool_next_id;
+				p->registry_next = mum_pool_registry;
+				mum_pool_registry = p;
+				mum_lock_release(&mum_pool_registry_lock);
+				return p;
+			}
+
+			MUDEF muPool mu_pool_destroy_(mumResult* result, muPool pool) {
+				mum_pool* p = (mum_pool*)pool;
+
+				mum_lock_acquire(&mum_pool_registry_lock);
+				mum_pool** link = &mum_pool_registry;
+				while (*link != p) {
+					link = &(*link)->registry_next;
+				}
+				*link = p->registry_next;
+				mum_lock_release(&mum_pool_registry_lock);
+
+				for (uint32_m c = 0; c < p->chunk_count; c++) {
+					mu_free(p->chunks[c]);
+				}
+				mu_free(p);
+				return 0; if (result) {}
+			}
+
+			MUDEF void* mu_pool_alloc_(mumResult* result, muPool pool) {
+				mum_pool* p = (mum_pool*)pool;
+
+				mum_pool_cache* c = mum_pool_caches;
+				if (!c || c->pool != p || c->id != p->id) {
+					c = mum_pool_cache_get(p);
+					if (!c) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return 0;
+					}
+				}
+
+				if (c->loaded_count == 0) {
+					if (c->previous_count) {
+						c->loaded = c->previous;
+						c->loaded_count = c->previous_count;
+						c->previous = 0;
+						c->previous_count = 0;
+					} else {
+						uint32_m count;
+						mum_pool_object* o = mum_pool_depot_pop(p, &count);
+						if (!o) {
+							o = mum_pool_fresh(p, &count);
+							if (!o) {
+								MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+								return 0;
+							}
+						}
+						c->loaded = o;
+						c->loaded_count = count;
+					}
+				}
+
+				mum_pool_object* o = c->loaded;
+				c->loaded = o->next;
+				c->loaded_count--;
+				return o;
+			}
+
+			MUDEF void mu_pool_free(muPool pool, void* object) {
+				mum_pool* p = (mum_pool*)pool;
+				mum_pool_object* o = (mum_pool_object*)object;
+				if (!o) {
+					return;
+				}
+
+				mum_pool_cache* c = mum_pool_caches;
+				if (!c || c->pool != p || c->id != p->id) {
+					c = mum_pool_cache_get(p);
+					if (!c) {
+						// Give it straight back to the depot as a magazine of its own
+						o->next = 0;
+						mum_pool_depot_push(p, o, 1);
+						return;
+					}
+				}
+
+				if (c->loaded_count == MUM_POOL_MAGAZINE) {
+					if (c->previous_count) {
+						mum_pool_depot_push(p, c->previous, c->previous_count);
+					}
+					c->previous = c->loaded;
+					c->previous_count = c->loaded_count;
+					c->loaded = 0;
+					c->loaded_count = 0;
+				}
+				o->next = c->loaded;
+				c->loaded = o;
+				c->loaded_count++;
+			}
+
+		/* Scheduler */
+
+			// Every worker has a lock-free inbox per priority that anyone can push onto, and a heap
+			// per priority, ordered by deadline. A worker moves its inboxes into its heaps when it
+			// picks its next task; idle workers steal whole inboxes from other workers, and failing
+			// that, the least urgent half of another worker's heaps, so that tasks a worker has
+			// already taken in aren't stuck behind whatever it's running. The heaps are guarded by a
+			// lock that the worker only holds whilst picking, and that thieves only try to take.
+
+			#define MUM_SCHED_LEVELS 4
+			#define MUM_SCHED_DEFAULT_AGING 50000000ull
+
+			struct mum_scheduler;
+
+			// Defined with the event loop; lets an idle worker poll for I/O instead of sleeping,
+			// returning whether it did, and wakes a worker that's doing so
+			static muBool mum_event_loop_idle(struct mum_scheduler* s, uint32_m epoch);
+			static void mum_event_loop_nudge(struct mum_scheduler* s);
+
+			struct mum_task {
+				struct mum_task* next;
+				void (*func)(void* args);
+				void* args;
+				uint64_m submitted;
+				// Absolute; ~0 if the task has none
+				uint64_m deadline;
+				// Breaks ties between equal deadlines in submission order
+				uint32_m seq;
+				uint32_m level;
+			};
+			typedef struct mum_task mum_task;
+
+			struct mum_task_heap {
+				mum_task** items;
+				size_m count;
+				size_m capacity;
+			};
+
+			// Statistics of the tasks a worker has run, per priority; only written by the worker,
+			// and added up over every worker when read, so running a task touches no shared lines
+			struct mum_sched_run_stats {
+				uint64_m started;
+				uint64_m completed;
+				uint64_m latency_sum;
+				uint64_m latency_max;
+			};
+
+			struct mum_sched_worker {
+				void* volatile inbox[MUM_SCHED_LEVELS];
+				struct mum_task_heap heaps[MUM_SCHED_LEVELS];
+				uint32_m heap_lock;
+				// How many tasks are in the heaps, so that thieves can skip workers with none
+				uint32_m heaped;
+				struct mum_sched_run_stats stats[MUM_SCHED_LEVELS];
+				struct mum_scheduler* sched;
+				muThread thread;
+				uint8_m pad[MUM_CACHE_LINE];
+			};
+			typedef struct mum_sched_worker mum_sched_worker;
+
+			struct mum_sched_stats {
+				uint32_m queued;
+				uint8_m pad[MUM_CACHE_LINE];
+			};
+
+			struct mum_scheduler {
+				mum_sched_worker* workers;
+				uint32_m worker_count;
+				uint64_m aging_ns;
+				uint32_m next_worker;
+				uint32_m seq;
+				// Bumped on every submission; what idle workers sleep on
+				uint32_m epoch;
+				uint32_m sleepers;
+				// The idle strategy that idle workers look for work with
+				void* volatile idle;
+				uint32_m stopping;
+				// Tasks submitted but not finished; what mu_scheduler_wait sleeps on
+				uint32_m pending;
+				// The event loop idle workers poll, and how many threads are looking at it
+				void* volatile event_loop;
+				uint32_m event_loop_users;
+				struct mum_sched_stats stats[MUM_SCHED_LEVELS];
+			};
+			typedef struct mum_scheduler mum_scheduler;
+
+			static MUM_THREAD_LOCAL mum_sched_worker* mum_sched_current = 0;
+
+			static inline muBool mum_task_before(mum_task* a, mum_task* b) {
+				if (a->deadline != b->deadline) {
+					return a->deadline < b->deadline;
+				}
+				return (int32_m)(a->seq - b->seq) < 0;
+			}
+
+			static muBool mum_task_heap_push(struct mum_task_heap* h, mum_task* task) {
+				if (h->count == h->capacity) {
+					size_m capacity = h->capacity ? h->capacity * 2 : 64;
+					mum_task** items = (mum_task**)mu_malloc(capacity * sizeof(mum_task*));
+					if (!items) {
+						return MU_FALSE;
+					}
+					if (h->items) {
+						mu_memcpy(items, h->items, h->count * sizeof(mum_task*));
+						mu_free(h->items);
+					}
+					h->items = items;
+					h->capacity = capacity;
+				}
+
+				size_m i = h->count++;
+				while (i > 0) {
+					size_m parent = (i - 1) / 2;
+					if (!mum_task_before(task, h->items[parent])) {
+						break;
+					}
+					h->items[i] = h->items[parent];
+					i = parent;
+				}
+				h->items[i] = task;
+				return MU_TRUE;
+			}
+
+			static mum_task* mum_task_heap_pop(struct mum_task_heap* h) {
+				mum_task* top = h->items[0];
+				mum_task* last = h->items[--h->count];
+
+				size_m i = 0;
+				for (;;) {
+					size_m child = i * 2 + 1;
+					if (child >= h->count) {
+						break;
+					}
+					if (child + 1 < h->count && mum_task_before(h->items[child + 1], h->items[child])) {
+						child++;
+					}
+					if (!mum_task_before(h->items[child], last)) {
+						break;
+					}
+					h->items[i] = h->items[child];
+					i = child;
+				}
+				if (h->count) {
+					h->items[i] = last;
+				}
+				return top;
+			}
+
+			static inline void mum_task_push(void* volatile* inbox, mum_task* task) {
+				void* head = mum_atomic_load_ptr(inbox, MUM_RELAXED);
+				do {
+					task->next = (mum_task*)head;
+				} while (!mum_atomic_cas_ptr(inbox, &head, task));
+			}
+
+			static inline mum_task* mum_task_take_all(void* volatile* inbox) {
+				if (!mum_atomic_load_ptr(inbox, MUM_RELAXED)) {
+					return 0;
+				}
+				void* head = mum_atomic_load_ptr(inbox, MUM_RELAXED);
+				while (!mum_atomic_cas_ptr(inbox, &head, 0)) {}
+				return (mum_task*)head;
+			}
+
+			// Moves a list of tasks into a worker's heaps; anything that doesn't fit goes back onto
+			// the worker's inbox to be tried again later
+			static void mum_sched_absorb(mum_sched_worker* w, mum_task* list) {
+				while (list) {
+					mum_task* next = list->next;
+					if (!mum_task_heap_push(&w->heaps[list->level], list)) {
+						mum_task_push(&w->inbox[list->level], list);
+					}
+					list = next;
+				}
+			}
+
+			// Publishes how many tasks are in a worker's heaps; called with the heaps locked
+			static uint32_m mum_sched_heaped(mum_sched_worker* w) {
+				size_m count = 0;
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+					count += w->heaps[level].count;
+				}
+				mum_atomic_store32(&w->heaped, (uint32_m)count, MUM_RELAXED);
+				return (uint32_m)count;
+			}
+
+			// Pops the most urgent task out of a worker's heaps, counting a task as one level more
+			// urgent for every aging period it has waited
+			static mum_task* mum_sched_pick(mum_sched_worker* w) {
+				mum_lock_acquire(&w->heap_lock);
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+					mum_sched_absorb(w, mum_task_take_all(&w->inbox[level]));
+				}
+
+				uint64_m now = mum_time_ns();
+				uint32_m best_level = MUM_SCHED_LEVELS;
+				uint64_m best_rank = 0;
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+					struct mum_task_heap* h = &w->heaps[level];
+					if (h->count == 0) {
+						continue;
+					}
+
+					uint64_m waited = now > h->items[0]->submitted ? now - h->items[0]->submitted : 0;
+					uint64_m boost = waited / w->sched->aging_ns;
+					uint64_m rank = boost >= level ? 0 : level - boost;
+					if (best_level == MUM_SCHED_LEVELS || rank < best_rank || (rank == best_rank && mum_task_before(h->items[0], w->heaps[best_level].items[0]))) {
+						best_level = level;
+						best_rank = rank;
+					}
+				}
+
+				mum_task* task = 0;
+				if (best_level != MUM_SCHED_LEVELS) {
+					task = mum_task_heap_pop(&w->heaps[best_level]);
+				}
+				uint32_m heaped = mum_sched_heaped(w);
+				mum_lock_release(&w->heap_lock);
+
+				// Wake idle workers to take what's left, as they might not find it otherwise
+				if (heaped != 0 && mum_atomic_load32(&w->sched->sleepers, MUM_RELAXED) != 0) {
+					mum_atomic_fetch_add32(&w->sched->epoch, 1);
+					mum_futex_wake(&w->sched->epoch, MU_TRUE);
+					mum_event_loop_nudge(w->sched);
+				}
+				return task;
+			}
+
+			// Takes the last half of each of another worker's heaps (which are leaves, so the heap
+			// stays valid, and are likely the least urgent tasks), unless it's busy picking
+			static mum_task* mum_sched_steal_heaps(mum_sched_worker* victim) {
+				uint32_m expected = 0;
+				if (mum_atomic_load32(&victim->heaped, MUM_RELAXED) == 0 || !mum_atomic_cas32(&victim->heap_lock, &expected, 1)) {
+					return 0;
+				}
+
+				mum_task* list = 0;
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+					struct mum_task_heap* h = &victim->heaps[level];
+					size_m keep = h->count / 2;
+					while (h->count > keep) {
+						mum_task* task = h->items[--h->count];
+						task->next = list;
+						list = task;
+					}
+				}
+				mum_sched_heaped(victim);
+				mum_lock_release(&victim->heap_lock);
+				return list;
+			}
+
+			// Takes another worker's inbox, most urgent level first, or failing that, part of its
+			// heaps
+			static muBool mum_sched_steal(mum_sched_worker* w) {
+				mum_scheduler* s = w->sched;
+				uint32_m start = (uint32_m)(w - s->workers);
+
+				mum_task* list = 0;
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS && !list; level++) {
+					for (uint32_m i = 1; i < s->worker_count && !list; i++) {
+						list = mum_task_take_all(&s->workers[(start + i) % s->worker_count].inbox[level]);
+					}
+				}
+				for (uint32_m i = 1; i < s->worker_count && !list; i++) {
+					list = mum_sched_steal_heaps(&s->workers[(start + i) % s->worker_count]);
+				}
+				if (!list) {
+					return MU_FALSE;
+				}
+
+				mum_lock_acquire(&w->heap_lock);
+				mum_sched_absorb(w, list);
+				mum_sched_heaped(w);
+				mum_lock_release(&w->heap_lock);
+				return MU_TRUE;
+			}
+
+			static void mum_sched_run(mum_sched_worker* w, mum_task* task) {
+				mum_scheduler* s = w->sched;
+				struct mum_sched_run_stats* stats = &w->stats[task->level];
+
+				uint64_m now = mum_time_ns();
+				uint64_m latency = now > task->submitted ? now - task->submitted : 0;
+				mum_atomic_fetch_sub32(&s->stats[task->level].queued, 1);
+				mum_atomic_store64(&stats->started, stats->started + 1, MUM_RELAXED);
+				mum_atomic_store64(&stats->latency_sum, stats->latency_sum + latency, MUM_RELAXED);
+				if (latency > stats->latency_max) {
+					mum_atomic_store64(&stats->latency_max, latency, MUM_RELAXED);
+				}
+
+				task->func(task->args);
+				mu_free(task);
+
+				mum_atomic_store64(&stats->completed, stats->completed + 1, MUM_RELAXED);
+				if (mum_atomic_fetch_sub32(&s->pending, 1) == 1) {
+					mum_futex_wake(&s->pending, MU_TRUE);
+				}
+			}
+
+			static void mum_sched_worker_main(void* args) {
+				mum_sched_worker* w = (mum_sched_worker*)args;
+				mum_scheduler* s = w->sched;
+				mum_sched_current = w;
+
+				// The strategy the worker is idle with, if it's idle
+				mum_idle* idle = 0;
+				struct mum_idle_state st;
+				st.phase = MUM_IDLE_PHASE_NONE;
+
+				for (;;) {
+					uint32_m epoch = mum_atomic_load32(&s->epoch, MUM_SEQ_CST);
+
+					mum_task* task = mum_sched_pick(w);
+					if (!task && mum_sched_steal(w)) {
+						task = mum_sched_pick(w);
+					}
+					if (task) {
+						mum_idle_end(idle, &st);
+						mum_sched_run(w, task);
+						continue;
+					}
+
+					if (mum_atomic_load32(&s->stopping, MUM_ACQUIRE)) {
+						break;
+					}
+
+					// Keep looking for as long as the strategy spins or yields
+					if (st.phase == MUM_IDLE_PHASE_NONE) {
+						idle = (mum_idle*)mum_atomic_load_ptr(&s->idle, MUM_RELAXED);
+					}
+					if (!mum_idle_step(idle, &st)) {
+						continue;
+					}
+
+					// Nothing was found since the epoch was read; if nothing has been submitted
+					// since either, sleep until something is
+					mum_atomic_fetch_add32(&s->sleepers, 1);
+					if (!mum_event_loop_idle(s, epoch)) {
+						mum_futex_wait(&s->epoch, epoch, mum_idle_park_ns(idle));
+					}
+					mum_atomic_fetch_sub32(&s->sleepers, 1);
+				}
+
+				mum_idle_end(idle, &st);
+				mum_sched_current = 0;
+			}
+
+			static void mum_scheduler_free(mum_scheduler* s) {
+				for (uint32_m i = 0; i < s->worker_count; i++) {
+					for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+						if (s->workers[i].heaps[level].items) {
+							mu_free(s->workers[i].heaps[level].items);
+						}
+					}
+				}
+				mu_free(s->workers);
+				mu_free(s);
+			}
+
+			static void mum_scheduler_stop(mum_scheduler* s, uint32_m started) {
+				mum_atomic_store32(&s->stopping, 1, MUM_SEQ_CST);
+				mum_atomic_fetch_add32(&s->epoch, 1);
+				mum_futex_wake(&s->epoch, MU_TRUE);
+				mum_event_loop_nudge(s);
+
+				for (uint32_m i = 0; i < started; i++) {
+					mumResult thread_result = MUM_SUCCESS;
+					mu_thread_destroy_mode_(&thread_result, s->workers[i].thread, MUM_THREAD_DESTROY_JOIN);
+				}
+			}
+
+			MUDEF muScheduler mu_scheduler_create_(mumResult* result, uint32_m worker_count, uint64_m aging_ns) {
+				if (worker_count == 0) {
+					worker_count = mu_topology_cpu_count();
+				}
+
+				mum_scheduler* s = (mum_scheduler*)mu_malloc(sizeof(mum_scheduler));
+				if (!s) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+				s->workers = (mum_sched_worker*)mu_malloc(sizeof(mum_sched_worker) * worker_count);
+				if (!s->workers) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					mu_free(s);
+					return 0;
+				}
+
+				s->worker_count = worker_count;
+				s->aging_ns = aging_ns ? aging_ns : MUM_SCHED_DEFAULT_AGING;
+				s->next_worker = 0;
+				s->seq = 0;
+				s->epoch = 0;
+				s->sleepers = 0;
+				s->idle = 0;
+				s->stopping = 0;
+				s->pending = 0;
+				s->event_loop = 0;
+				s->event_loop_users = 0;
+				for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+					s->stats[level].queued = 0;
+				}
+
+				for (uint32_m i = 0; i < worker_count; i++) {
+					mum_sched_worker* w = &s->workers[i];
+					w->sched = s;
+					w->thread = 0;
+					w->heap_lock = 0;
+					w->heaped = 0;
+					for (uint32_m level = 0; level < MUM_SCHED_LEVELS; level++) {
+						w->inbox[level] = 0;
+						w->heaps[level].items = 0;
+						w->heaps[level].count = 0;
+						w->heaps[level].capacity = 0;
+						w->stats[level].started = 0;
+						w->stats[level].completed = 0;
+						w->stats[level].latency_sum = 0;
+						w->stats[level].latency_max = 0;
+					}
+				}
+
+				for (uint32_m i = 0; i < worker_count; i++) {
+					mumResult thread_result = MUM_SUCCESS;
+					s->workers[i].thread = mu_thread_create_(&thread_result, mum_sched_worker_main, &s->workers[i]);
+					if (thread_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, thread_result)
+						mum_scheduler_stop(s, i);
+						mum_scheduler_free(s);
+						return 0;
+					}
+				}
+
+				return s;
+			}
+
+			// Waits until no tasks are pending, returning MU_FALSE if a stop was requested for the
+			// calling thread first and the wait is stoppable
+			static muBool mum_scheduler_drain(mum_scheduler* s, muBool stoppable) {
+				uint32_m pending;
+				while ((pending = mum_atomic_load32(&s->pending, MUM_ACQUIRE)) != 0) {
+					if (!stoppable) {
+						mum_futex_wait(&s->pending, pending, MUM_NO_TIMEOUT);
+					} else if (!mum_park_stoppable(&s->pending, pending, MUM_NO_TIMEOUT)) {
+						return MU_FALSE;
+					}
+				}
+				return MU_TRUE;
+			}
+
+			MUDEF void mu_scheduler_wait_(mumResult* result, muScheduler scheduler) {
+				if (!mum_scheduler_drain((mum_scheduler*)scheduler, MU_TRUE)) {
+					MU_SET_RESULT(result, MUM_STOP_REQUESTED)
+				}
+			}
+
+			MUDEF muScheduler mu_scheduler_destroy_(mumResult* result, muScheduler scheduler) {
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+
+				// Not stoppable, as every submitted task has to run before the workers stop
+				mum_scheduler_drain(s, MU_FALSE);
+				mum_scheduler_stop(s, s->worker_count);
+				mum_scheduler_free(s);
+
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_scheduler_submit_(mumResult* result, muScheduler scheduler, void (*task)(void* args), void* args, mumTaskPriority priority, uint64_m deadline_ns) {
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+
+				mum_task* t = (mum_task*)mu_malloc(sizeof(mum_task));
+				if (!t) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+
+				t->func = task;
+				t->args = args;
+				t->submitted = mum_time_ns();
+				t->deadline = deadline_ns ? t->submitted + deadline_ns : ~(uint64_m)0;
+				t->seq = mum_atomic_fetch_add32(&s->seq, 1);
+				t->level = (uint32_m)priority < MUM_SCHED_LEVELS ? (uint32_m)priority : MUM_SCHED_LEVELS - 1;
+
+				mum_atomic_fetch_add32(&s->pending, 1);
+				mum_atomic_fetch_add32(&s->stats[t->level].queued, 1);
+
+				// Tasks submitted from a task stay on the same worker, which likely has their data
+				// in cache; anything else is spread around
+				mum_sched_worker* w = mum_sched_current;
+				if (!w || w->sched != s) {
+					w = &s->workers[mum_atomic_fetch_add32(&s->next_worker, 1) % s->worker_count];
+				}
+				mum_task_push(&w->inbox[t->level], t);
+
+				mum_atomic_fetch_add32(&s->epoch, 1);
+				if (mum_atomic_load32(&s->sleepers, MUM_SEQ_CST) != 0) {
+					mum_futex_wake(&s->epoch, MU_FALSE);
+					mum_event_loop_nudge(s);
+				}
+			}
+
+			MUDEF void mu_scheduler_set_idle(muScheduler scheduler, muIdleStrategy strategy) {
+				mum_atomic_store_ptr(&((mum_scheduler*)scheduler)->idle, strategy, MUM_RELAXED);
+			}
+
+			MUDEF void mu_scheduler_stats_(mumResult* result, muScheduler scheduler, mumTaskPriority priority, size_m* queued, uint64_m* completed, uint64_m* average_latency_ns, uint64_m* max_latency_ns) {
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+				uint32_m level = (uint32_m)priority < MUM_SCHED_LEVELS ? (uint32_m)priority : MUM_SCHED_LEVELS - 1;
+				struct mum_sched_stats* stats = &s->stats[level];
+
+				if (queued) {
+					*queued = (size_m)mum_atomic_load32(&stats->queued, MUM_RELAXED);
+				}
+
+				uint64_m started = 0, done = 0, latency_sum = 0, latency_max = 0;
+				for (uint32_m i = 0; i < s->worker_count; i++) {
+					struct mum_sched_run_stats* run = &s->workers[i].stats[level];
+					started += mum_atomic_load64(&run->started, MUM_RELAXED);
+					done += mum_atomic_load64(&run->completed, MUM_RELAXED);
+					latency_sum += mum_atomic_load64(&run->latency_sum, MUM_RELAXED);
+					uint64_m max = mum_atomic_load64(&run->latency_max, MUM_RELAXED);
+					latency_max = max > latency_max ? max : latency_max;
+				}
+
+				if (completed) {
+					*completed = done;
+				}
+				if (average_latency_ns) {
+					*average_latency_ns = started ? latency_sum / started : 0;
+				}
+				if (max_latency_ns) {
+					*max_latency_ns = latency_max;
+				}
+
+				return; if (result) {}
+			}
+
+		/* Timer wheel */
+
+			// Timers live in a pool, and are linked by index into the slots of five wheels of 64
+			// slots each, where every slot of a wheel spans a whole turn of the wheel below it. A
+			// timer is put into the lowest wheel that its expiry is within one turn of, and is moved
+			// down whenever the timer thread reaches the slot it's in, so it ends up in the lowest
+			// wheel exactly in time to expire. A bitmap of occupied slots per wheel lets the timer
+			// thread skip straight to the next tick with anything to do. Everything is guarded by
+			// one lock, since it's held only for a few pointer updates at a time.
+
+			#define MUM_WHEEL_LEVELS 5
+			#define MUM_WHEEL_BITS 6
+			#define MUM_WHEEL_SLOTS 64
+			#define MUM_WHEEL_NONE 0xFFFFFFFF
+			#define MUM_WHEEL_NEVER (~(uint64_m)0)
+			// Timers further out than what the top wheel reaches wait in its furthest slot
+			#define MUM_WHEEL_SPAN (((uint64_m)1 << (MUM_WHEEL_BITS * MUM_WHEEL_LEVELS)) - 1)
+			#define MUM_WHEEL_DEFAULT_TICK 1000000ull
+
+			struct mum_timer {
+				// Neighbours within the slot, or the next free timer if unused
+				uint32_m prev;
+				uint32_m next;
+				// Bumped every time the timer is freed, so stale identifiers don't match
+				uint32_m gen;
+				// Index into the slot heads, or MUM_WHEEL_NONE if the timer is unused
+				uint32_m slot;
+				// In ticks
+				uint64_m expires;
+				uint64_m period;
+				void (*callback)(void* args);
+				void* args;
+				mumTaskPriority priority;
+			};
+			typedef struct mum_timer mum_timer;
+
+			struct mum_timer_wheel {
+				muScheduler scheduler;
+				uint64_m tick_ns;
+				uint64_m start;
+				// The next tick to be processed
+				uint64_m now;
+				uint32_m lock;
+				mum_timer* timers;
+				uint32_m count;
+				uint32_m capacity;
+				uint32_m free;
+				uint32_m heads[MUM_WHEEL_LEVELS * MUM_WHEEL_SLOTS];
+				uint64_m occupied[MUM_WHEEL_LEVELS];
+				// The tick the timer thread sleeps until; scheduling an earlier timer wakes it
+				uint64_m sleep_until;
+				uint32_m wake;
+				uint32_m stopping;
+				muThread thread;
+			};
+			typedef struct mum_timer_wheel mum_timer_wheel;
+
+			static inline uint32_m mum_ctz64(uint64_m x) {
+				#if defined(__GNUC__) || defined(__clang__)
+					return (uint32_m)__builtin_ctzll(x);
+				#else
+					uint32_m n = 0;
+					while (!(x & 1)) {
+						x >>= 1;
+						n++;
+					}
+					return n;
+				#endif
+			}
+
+			static void mum_wheel_insert(mum_timer_wheel* w, uint32_m index) {
+				mum_timer* t = &w->timers[index];
+
+				uint64_m place = t->expires;
+				if (place < w->now) {
+					place = w->now;
+				}
+				if (place - w->now > MUM_WHEEL_SPAN) {
+					place = w->now + MUM_WHEEL_SPAN;
+				}
+
+				uint64_m delta = place - w->now;
+				uint32_m level = 0;
+				while (level < MUM_WHEEL_LEVELS - 1 && delta >= ((uint64_m)1 << (MUM_WHEEL_BITS * (level + 1)))) {
+					level++;
+				}
+				uint32_m slot = (uint32_m)(place >> (MUM_WHEEL_BITS * level)) & (MUM_WHEEL_SLOTS - 1);
+				uint32_m head = level * MUM_WHEEL_SLOTS + slot;
+
+				t->slot = head;
+				t->prev = MUM_WHEEL_NONE;
+				t->next = w->heads[head];
+				if (t->next != MUM_WHEEL_NONE) {
+					w->timers[t->next].prev = index;
+				}
+				w->heads[head] = index;
+				w->occupied[level] |= (uint64_m)1 << slot;
+			}
+
+			static void mum_wheel_unlink(mum_timer_wheel* w, uint32_m index) {
+				mum_timer* t = &w->timers[index];
+
+				if (t->prev != MUM_WHEEL_NONE) {
+					w->timers[t->prev].next = t->next;
+				} else {
+					w->heads[t->slot] = t->next;
+					if (t->next == MUM_WHEEL_NONE) {
+						w->occupied[t->slot / MUM_WHEEL_SLOTS] &= ~((uint64_m)1 << (t->slot % MUM_WHEEL_SLOTS));
+					}
+				}
+				if (t->next != MUM_WHEEL_NONE) {
+					w->timers[t->next].prev = t->prev;
+				}
+			}
+
+			static void mum_wheel_release(mum_timer_wheel* w, uint32_m index) {
+				mum_timer* t = &w->timers[index];
+				t->slot = MUM_WHEEL_NONE;
+				t->gen++;
+				t->next = w->free;
+				w->free = index;
+			}
+
+			// Detaches a slot, returning the first timer of it
+			static uint32_m mum_wheel_take(mum_timer_wheel* w, uint32_m level, uint32_m slot) {
+				uint32_m first = w->heads[level * MUM_WHEEL_SLOTS + slot];
+				w->heads[level * MUM_WHEEL_SLOTS + slot] = MUM_WHEEL_NONE;
+				w->occupied[level] &= ~((uint64_m)1 << slot);
+				return first;
+			}
+
+			// Returns the next tick, from the current one on, that needs processing: one whose slot
+			// holds timers, or one where higher wheels need to be moved down
+			static uint64_m mum_wheel_next(mum_timer_wheel* w) {
+				uint32_m pos = (uint32_m)(w->now & (MUM_WHEEL_SLOTS - 1));
+				uint64_m turn = w->now - pos;
+
+				uint64_m upper = 0;
+				for (uint32_m level = 1; level < MUM_WHEEL_LEVELS; level++) {
+					upper |= w->occupied[level];
+				}
+				if (pos == 0 && upper) {
+					return w->now;
+				}
+
+				uint64_m ahead = w->occupied[0] & (~(uint64_m)0 << pos);
+				if (ahead) {
+					return turn + mum_ctz64(ahead);
+				}
+				if (upper) {
+					return turn + MUM_WHEEL_SLOTS;
+				}
+				if (w->occupied[0]) {
+					return turn + MUM_WHEEL_SLOTS + mum_ctz64(w->occupied[0]);
+				}
+				return MUM_WHEEL_NEVER;
+			}
+
+			// Processes the current tick: moves down the slots of higher wheels that have come
+			// around, then submits every timer in the lowest wheel's slot
+			static void mum_wheel_tick(mum_timer_wheel* w) {
+				uint64_m now = w->now;
+
+				if ((now & (MUM_WHEEL_SLOTS - 1)) == 0) {
+					for (uint32_m level = 1; level < MUM_WHEEL_LEVELS; level++) {
+						uint32_m slot = (uint32_m)(now >> (MUM_WHEEL_BITS * level)) & (MUM_WHEEL_SLOTS - 1);
+						uint32_m index = mum_wheel_take(w, level, slot);
+						while (index != MUM_WHEEL_NONE) {
+							uint32_m next = w->timers[index].next;
+							mum_wheel_insert(w, index);
+							index = next;
+						}
+						if (slot != 0) {
+							break;
+						}
+					}
+				}
+
+				uint32_m index = mum_wheel_take(w, 0, (uint32_m)(now & (MUM_WHEEL_SLOTS - 1)));
+				while (index != MUM_WHEEL_NONE) {
+					mum_timer* t = &w->timers[index];
+					uint32_m next = t->next;
+
+					mumResult submit_result = MUM_SUCCESS;
+					mu_scheduler_submit_(&submit_result, w->scheduler, t->callback, t->args, t->priority, 0);
+					if (submit_result != MUM_SUCCESS) {
+						// Try again next tick
+						t->expires = now + 1;
+						mum_wheel_insert(w, index);
+					} else if (t->period) {
+						while (t->expires <= now) {
+							t->expires += t->period;
+						}
+						mum_wheel_insert(w, index);
+					} else {
+						mum_wheel_release(w, index);
+					}
+
+					index = next;
+				}
+
+				w->now = now + 1;
+			}
+
+			static void mum_wheel_main(void* args) {
+				mum_timer_wheel* w = (mum_timer_wheel*)args;
+
+				for (;;) {
+					mum_lock_acquire(&w->lock);
+					if (w->stopping) {
+						mum_lock_release(&w->lock);
+						break;
+					}
+
+					uint64_m elapsed = (mum_time_ns() - w->start) / w->tick_ns;
+					uint64_m next;
+					while ((next = mum_wheel_next(w)) <= elapsed) {
+						w->now = next;
+						mum_wheel_tick(w);
+					}
+					// Nothing is due up to the elapsed tick, so it can be skipped over
+					if (w->now <= elapsed) {
+						w->now = elapsed + 1;
+					}
+
+					w->sleep_until = next;
+					uint32_m wake = mum_atomic_load32(&w->wake, MUM_SEQ_CST);
+					mum_lock_release(&w->lock);
+
+					uint64_m timeout = MUM_NO_TIMEOUT;
+					if (next != MUM_WHEEL_NEVER) {
+						uint64_m due = w->start + next * w->tick_ns;
+						uint64_m time = mum_time_ns();
+						if (due <= time) {
+							continue;
+						}
+						timeout = due - time;
+					}
+					mum_futex_wait(&w->wake, wake, timeout);
+				}
+			}
+
+			MUDEF muTimerWheel mu_timer_wheel_create_(mumResult* result, muScheduler scheduler, uint64_m tick_ns) {
+				mum_timer_wheel* w = (mum_timer_wheel*)mu_malloc(sizeof(mum_timer_wheel));
+				if (!w) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				w->scheduler = scheduler;
+				w->tick_ns = tick_ns ? tick_ns : MUM_WHEEL_DEFAULT_TICK;
+				w->start = mum_time_ns();
+				w->now = 0;
+				w->lock = 0;
+				w->timers = 0;
+				w->count = 0;
+				w->capacity = 0;
+				w->free = MUM_WHEEL_NONE;
+				for (uint32_m i = 0; i < MUM_WHEEL_LEVELS * MUM_WHEEL_SLOTS; i++) {
+					w->heads[i] = MUM_WHEEL_NONE;
+				}
+				for (uint32_m level = 0; level < MUM_WHEEL_LEVELS; level++) {
+					w->occupied[level] = 0;
+				}
+				w->sleep_until = MUM_WHEEL_NEVER;
+				w->wake = 0;
+				w->stopping = 0;
+
+				mumResult thread_result = MUM_SUCCESS;
+				w->thread = mu_thread_create_(&thread_result, mum_wheel_main, w);
+				if (thread_result != MUM_SUCCESS) {
+					MU_SET_RESULT(result, thread_result)
+					mu_free(w);
+					return 0;
+				}
+
+				return w;
+			}
+
+			MUDEF muTimerWheel mu_timer_wheel_destroy_(mumResult* result, muTimerWheel wheel) {
+				mum_timer_wheel* w = (mum_timer_wheel*)wheel;
+
+				mum_lock_acquire(&w->lock);
+				w->stopping = 1;
+				mum_atomic_fetch_add32(&w->wake, 1);
+				mum_lock_release(&w->lock);
+				mum_futex_wake(&w->wake, MU_FALSE);
+
+				mumResult thread_result = MUM_SUCCESS;
+				mu_thread_destroy_mode_(&thread_result, w->thread, MUM_THREAD_DESTROY_JOIN);
+
+				if (w->timers) {
+					mu_free(w->timers);
+				}
+				mu_free(w);
+
+				return 0; if (result) {}
+			}
+
+			MUDEF uint64_m mu_timer_schedule_(mumResult* result, muTimerWheel wheel, uint64_m delay_ns, uint64_m period_ns, void (*callback)(void* args), void* args, mumTaskPriority priority) {
+				mum_timer_wheel* w = (mum_timer_wheel*)wheel;
+
+				// Rounded up, so that timers never fire early
+				uint64_m expires = (mum_time_ns() - w->start + delay_ns + w->tick_ns - 1) / w->tick_ns;
+				uint64_m period = 0;
+				if (period_ns) {
+					period = (period_ns + w->tick_ns - 1) / w->tick_ns;
+				}
+
+				mum_lock_acquire(&w->lock);
+
+				if (w->free == MUM_WHEEL_NONE && w->count == w->capacity) {
+					uint32_m capacity = w->capacity ? w->capacity * 2 : 64;
+					mum_timer* timers = (mum_timer*)mu_malloc(capacity * sizeof(mum_timer));
+					if (!timers) {
+						mum_lock_release(&w->lock);
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return 0;
+					}
+					if (w->timers) {
+						mu_memcpy(timers, w->timers, w->count * sizeof(mum_timer));
+						mu_free(w->timers);
+					}
+					w->timers = timers;
+					w->capacity = capacity;
+				}
+
+				uint32_m index;
+				if (w->free != MUM_WHEEL_NONE) {
+					index = w->free;
+					w->free = w->timers[index].next;
+				} else {
+					index = w->count++;
+					w->timers[index].gen = 0;
+				}
+
+				mum_timer* t = &w->timers[index];
+				t->expires = expires < w->now ? w->now : expires;
+				t->period = period;
+				t->callback = callback;
+				t->args = args;
+				t->priority = priority;
+				mum_wheel_insert(w, index);
+				uint64_m id = ((uint64_m)t->gen << 32) | (uint64_m)(index + 1);
+
+				muBool wake = t->expires < w->sleep_until;
+				if (wake) {
+					w->sleep_until = t->expires;
+					mum_atomic_fetch_add32(&w->wake, 1);
+				}
+				mum_lock_release(&w->lock);
+
+				if (wake) {
+					mum_futex_wake(&w->wake, MU_FALSE);
+				}
+				return id;
+			}
+
+			MUDEF muBool mu_timer_cancel(muTimerWheel wheel, uint64_m timer) {
+				mum_timer_wheel* w = (mum_timer_wheel*)wheel;
+				uint32_m index = (uint32_m)(timer & 0xFFFFFFFF) - 1;
+				uint32_m gen = (uint32_m)(timer >> 32);
+
+				muBool cancelled = MU_FALSE;
+				mum_lock_acquire(&w->lock);
+				if (index < w->count && w->timers[index].gen == gen && w->timers[index].slot != MUM_WHEEL_NONE) {
+					mum_wheel_unlink(w, index);
+					mum_wheel_release(w, index);
+					cancelled = MU_TRUE;
+				}
+				mum_lock_release(&w->lock);
+
+				return cancelled;
+			}
+
+		/* Event loop */
+
+		#ifdef MUM_EPOLL
+
+			// Every file descriptor is added with EPOLLONESHOT, and is only re-armed once its
+			// callback has returned, so each readiness is handed to exactly one worker. Sources are
+			// named in epoll by a generation and index into a table, rather than by pointer, so that
+			// events still in flight for a removed source are recognized and dropped; a source
+			// itself is reference counted, and lives until its last submitted callback returns.
+
+			#define MUM_EVENT_BATCH 64
+			#define MUM_EVENT_NONE 0xFFFFFFFF
+
+			struct mum_event_loop;
+
+			struct mum_event_source {
+				struct mum_event_loop* loop;
+				uint64_m id;
+				int fd;
+				uint32_m events;
+				void (*callback)(int fd, uint32_m events, void* args);
+				void* args;
+				mumTaskPriority priority;
+				// The flags that were ready when the callback was submitted
+				uint32_m ready;
+				uint32_m refs;
+				// Keeps re-arming from racing with removal
+				uint32_m lock;
+				uint32_m removed;
+			};
+			typedef struct mum_event_source mum_event_source;
+
+			struct mum_event_slot {
+				mum_event_source* source;
+				uint32_m gen;
+				uint32_m next_free;
+			};
+
+			struct mum_event_loop {
+				int epoll_fd;
+				int wake_fd;
+				mum_scheduler* sched;
+				// Guards the table
+				uint32_m lock;
+				struct mum_event_slot* slots;
+				uint32_m count;
+				uint32_m capacity;
+				uint32_m free;
+				// Whether an idle worker is polling, and whether it may be blocked doing so
+				uint32_m idle_poller;
+				uint32_m idle_blocked;
+			};
+			typedef struct mum_event_loop mum_event_loop;
+
+			static inline uint32_m mum_event_to_epoll(uint32_m events) {
+				uint32_m epoll_events = 0;
+				if (events & MUM_EVENT_READ) {
+					epoll_events |= EPOLLIN | EPOLLRDHUP;
+				}
+				if (events & MUM_EVENT_WRITE) {
+					epoll_events |= EPOLLOUT;
+				}
+				return epoll_events;
+			}
+
+			static inline uint32_m mum_event_from_epoll(uint32_m epoll_events) {
+				uint32_m events = 0;
+				if (epoll_events & EPOLLIN) {
+					events |= MUM_EVENT_READ;
+				}
+				if (epoll_events & EPOLLOUT) {
+					events |= MUM_EVENT_WRITE;
+				}
+				if (epoll_events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+					events |= MUM_EVENT_HANGUP;
+				}
+				return events;
+			}
+
+			static inline void mum_event_source_release(mum_event_source* src) {
+				if (mum_atomic_fetch_sub32(&src->refs, 1) == 1) {
+					mu_free(src);
+				}
+			}
+
+			static void mum_event_dispatch(void* args) {
+				mum_event_source* src = (mum_event_source*)args;
+				src->callback(src->fd, mum_atomic_exchange32(&src->ready, 0), src->args);
+
+				mum_lock_acquire(&src->lock);
+				if (!src->removed) {
+					struct epoll_event e;
+					e.events = src->events | EPOLLONESHOT;
+					e.data.u64 = src->id;
+					epoll_ctl(src->loop->epoll_fd, EPOLL_CTL_MOD, src->fd, &e);
+				}
+				mum_lock_release(&src->lock);
+
+				mum_event_source_release(src);
+			}
+
+			// Takes a source out of the table, returning it, or 0 if the identifier is stale.
+			// Must be called with the table locked.
+			static mum_event_source* mum_event_slot_take(mum_event_loop* l, uint64_m id) {
+				uint32_m index = (uint32_m)(id & 0xFFFFFFFF) - 1;
+				if (index >= l->count || l->slots[index].gen != (uint32_m)(id >> 32) || !l->slots[index].source) {
+					return 0;
+				}
+
+				mum_event_source* src = l->slots[index].source;
+				l->slots[index].source = 0;
+				l->slots[index].gen++;
+				l->slots[index].next_free = l->free;
+				l->free = index;
+				return src;
+			}
+
+			static void mum_event_source_remove(mum_event_loop* l, mum_event_source* src) {
+				mum_lock_acquire(&src->lock);
+				src->removed = 1;
+				epoll_ctl(l->epoll_fd, EPOLL_CTL_DEL, src->fd, 0);
+				mum_lock_release(&src->lock);
+
+				mum_event_source_release(src);
+			}
+
+			static size_m mum_event_loop_wait(mum_event_loop* l, int timeout_ms) {
+				struct epoll_event events[MUM_EVENT_BATCH];
+				int count = epoll_wait(l->epoll_fd, events, MUM_EVENT_BATCH, timeout_ms);
+				if (count <= 0) {
+					return 0;
+				}
+
+				mum_event_source* ready[MUM_EVENT_BATCH];
+				size_m ready_count = 0;
+				muBool woken = MU_FALSE;
+
+				mum_lock_acquire(&l->lock);
+				for (int i = 0; i < count; i++) {
+					uint64_m id = events[i].data.u64;
+					if (id == 0) {
+						woken = MU_TRUE;
+						continue;
+					}
+
+					uint32_m index = (uint32_m)(id & 0xFFFFFFFF) - 1;
+					if (index < l->count && l->slots[index].gen == (uint32_m)(id >> 32) && l->slots[index].source) {
+						mum_event_source* src = l->slots[index].source;
+						mum_atomic_fetch_add32(&src->refs, 1);
+						mum_atomic_store32(&src->ready, mum_event_from_epoll(events[i].events), MUM_RELAXED);
+						ready[ready_count++] = src;
+					}
+				}
+				mum_lock_release(&l->lock);
+
+				if (woken) {
+					uint64_m value;
+					if (read(l->wake_fd, &value, sizeof(value)) < 0) {}
+				}
+
+				for (size_m i = 0; i < ready_count; i++) {
+					mumResult submit_result = MUM_SUCCESS;
+					mu_scheduler_submit_(&submit_result, l->sched, mum_event_dispatch, ready[i], ready[i]->priority, 0);
+					if (submit_result != MUM_SUCCESS) {
+						// Better late than never
+						mum_event_dispatch(ready[i]);
+					}
+				}
+				return ready_count;
+			}
+
+			static muBool mum_event_loop_idle(mum_scheduler* s, uint32_m epoch) {
+				// Without an event loop, the users count (and its cache line) isn't touched at all
+				if (!mum_atomic_load_ptr(&s->event_loop, MUM_SEQ_CST)) {
+					return MU_FALSE;
+				}
+				muBool polled = MU_FALSE;
+
+				mum_atomic_fetch_add32(&s->event_loop_users, 1);
+				mum_event_loop* l = (mum_event_loop*)mum_atomic_load_ptr(&s->event_loop, MUM_SEQ_CST);
+				uint32_m expected = 0;
+				if (l && mum_atomic_cas32(&l->idle_poller, &expected, 1)) {
+					// Nothing has been submitted since the epoch was read, so block until something
+					// is ready or a submission nudges the event loop
+					mum_atomic_store32(&l->idle_blocked, 1, MUM_SEQ_CST);
+					if (mum_atomic_load32(&s->epoch, MUM_SEQ_CST) == epoch && !mum_atomic_load32(&s->stopping, MUM_SEQ_CST)) {
+						mum_event_loop_wait(l, -1);
+					}
+					mum_atomic_store32(&l->idle_blocked, 0, MUM_SEQ_CST);
+					mum_atomic_store32(&l->idle_poller, 0, MUM_RELEASE);
+					polled = MU_TRUE;
+				}
+				mum_atomic_fetch_sub32(&s->event_loop_users, 1);
+
+				return polled;
+			}
+
+			static void mum_event_loop_nudge(mum_scheduler* s) {
+				// Run on every submission, so the common case of no event loop is a single load; a
+				// sequentially consistent one (a plain load on x86), so that it can't miss a loop
+				// whose poller already saw this submission's epoch unchanged
+				if (!mum_atomic_load_ptr(&s->event_loop, MUM_SEQ_CST)) {
+					return;
+				}
+				mum_atomic_fetch_add32(&s->event_loop_users, 1);
+				mum_event_loop* l = (mum_event_loop*)mum_atomic_load_ptr(&s->event_loop, MUM_SEQ_CST);
+				if (l && mum_atomic_load32(&l->idle_blocked, MUM_SEQ_CST)) {
+					mu_event_loop_wake(l);
+				}
+				mum_atomic_fetch_sub32(&s->event_loop_users, 1);
+			}
+
+			MUDEF muEventLoop mu_event_loop_create_(mumResult* result, muScheduler scheduler) {
+				mum_event_loop* l = (mum_event_loop*)mu_malloc(sizeof(mum_event_loop));
+				if (!l) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				l->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+				if (l->epoll_fd < 0) {
+					MU_SET_RESULT(result, MUM_FAILED_EPOLL_CREATE)
+					mu_free(l);
+					return 0;
+				}
+				l->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+				if (l->wake_fd < 0) {
+					MU_SET_RESULT(result, MUM_FAILED_EVENTFD)
+					close(l->epoll_fd);
+					mu_free(l);
+					return 0;
+				}
+
+				// The wakeup eventfd is level-triggered, so every poller sees it until it's drained
+				struct epoll_event e;
+				e.events = EPOLLIN;
+				e.data.u64 = 0;
+				if (epoll_ctl(l->epoll_fd, EPOLL_CTL_ADD, l->wake_fd, &e) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_EPOLL_CTL)
+					close(l->wake_fd);
+					close(l->epoll_fd);
+					mu_free(l);
+					return 0;
+				}
+
+				l->sched = (mum_scheduler*)scheduler;
+				l->lock = 0;
+				l->slots = 0;
+				l->count = 0;
+				l->capacity = 0;
+				l->free = MUM_EVENT_NONE;
+				l->idle_poller = 0;
+				l->idle_blocked = 0;
+
+				// Workers already asleep need waking to start polling the event loop instead
+				void* expected = 0;
+				if (mum_atomic_cas_ptr(&l->sched->event_loop, &expected, l)) {
+					mum_atomic_fetch_add32(&l->sched->epoch, 1);
+					mum_futex_wake(&l->sched->epoch, MU_TRUE);
+				}
+
+				return l;
+			}
+
+			MUDEF muEventLoop mu_event_loop_destroy_(mumResult* result, muEventLoop loop) {
+				mum_event_loop* l = (mum_event_loop*)loop;
+				mum_scheduler* s = l->sched;
+
+				// Detach from the scheduler, and kick out any worker still looking at the loop
+				void* expected = l;
+				if (mum_atomic_cas_ptr(&s->event_loop, &expected, 0)) {
+					while (mum_atomic_load32(&s->event_loop_users, MUM_SEQ_CST) != 0) {
+						mu_event_loop_wake(l);
+						mum_thread_yield();
+					}
+				}
+
+				for (uint32_m i = 0; i < l->count; i++) {
+					if (l->slots[i].source) {
+						mum_event_source* src = l->slots[i].source;
+						l->slots[i].source = 0;
+						mum_event_source_remove(l, src);
+					}
+				}
+
+				close(l->wake_fd);
+				close(l->epoll_fd);
+				if (l->slots) {
+					mu_free(l->slots);
+				}
+				mu_free(l);
+
+				return 0; if (result) {}
+			}
+
+			MUDEF uint64_m mu_event_loop_add_(mumResult* result, muEventLoop loop, int fd, uint32_m events, void (*callback)(int fd, uint32_m events, void* args), void* args, mumTaskPriority priority) {
+				mum_event_loop* l = (mum_event_loop*)loop;
+
+				mum_event_source* src = (mum_event_source*)mu_malloc(sizeof(mum_event_source));
+				if (!src) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+				src->loop = l;
+				src->fd = fd;
+				src->events = mum_event_to_epoll(events);
+				src->callback = callback;
+				src->args = args;
+				src->priority = priority;
+				src->ready = 0;
+				src->refs = 1;
+				src->lock = 0;
+				src->removed = 0;
+
+				mum_lock_acquire(&l->lock);
+
+				if (l->free == MUM_EVENT_NONE && l->count == l->capacity) {
+					uint32_m capacity = l->capacity ? l->capacity * 2 : 64;
+					struct mum_event_slot* slots = (struct mum_event_slot*)mu_malloc(capacity * sizeof(struct mum_event_slot));
+					if (!slots) {
+						mum_lock_release(&l->lock);
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						mu_free(src);
+						return 0;
+					}
+					if (l->slots) {
+						mu_memcpy(slots, l->slots, l->count * sizeof(struct mum_event_slot));
+						mu_free(l->slots);
+					}
+					l->slots = slots;
+					l->capacity = capacity;
+				}
+
+				uint32_m index;
+				if (l->free != MUM_EVENT_NONE) {
+					index = l->free;
+					l->free = l->slots[index].next_free;
+				} else {
+					index = l->count++;
+					l->slots[index].gen = 0;
+				}
+				l->slots[index].source = src;
+				src->id = ((uint64_m)l->slots[index].gen << 32) | (uint64_m)(index + 1);
+
+				mum_lock_release(&l->lock);
+
+				struct epoll_event e;
+				e.events = src->events | EPOLLONESHOT;
+				e.data.u64 = src->id;
+				if (epoll_ctl(l->epoll_fd, EPOLL_CTL_ADD, fd, &e) != 0) {
+					MU_SET_RESULT(result, MUM_FAILED_EPOLL_CTL)
+					mum_lock_acquire(&l->lock);
+					mum_event_slot_take(l, src->id);
+					mum_lock_release(&l->lock);
+					mu_free(src);
+					return 0;
+				}
+
+				return src->id;
+			}
+
+			MUDEF void mu_event_loop_remove_(mumResult* result, muEventLoop loop, uint64_m source) {
+				mum_event_loop* l = (mum_event_loop*)loop;
+
+				mum_lock_acquire(&l->lock);
+				mum_event_source* src = mum_event_slot_take(l, source);
+				mum_lock_release(&l->lock);
+
+				if (src) {
+					mum_event_source_remove(l, src);
+				}
+				return; if (result) {}
+			}
+
+			MUDEF size_m mu_event_loop_poll(muEventLoop loop, int32_m timeout_ms) {
+				return mum_event_loop_wait((mum_event_loop*)loop, (int)timeout_ms);
+			}
+
+			MUDEF void mu_event_loop_wake(muEventLoop loop) {
+				mum_event_loop* l = (mum_event_loop*)loop;
+				uint64_m value = 1;
+				if (write(l->wake_fd, &value, sizeof(value)) < 0) {}
+			}
+
+		#else
+
+			static muBool mum_event_loop_idle(mum_scheduler* s, uint32_m epoch) {
+				return MU_FALSE; if (s) {} if (epoch) {}
+			}
+
+			static void mum_event_loop_nudge(mum_scheduler* s) {
+				return; if (s) {}
+			}
+
+			MUDEF muEventLoop mu_event_loop_create_(mumResult* result, muScheduler scheduler) {
+				MU_SET_RESULT(result, MUM_EVENT_LOOP_UNSUPPORTED)
+				return 0; if (scheduler) {}
+			}
+
+			MUDEF muEventLoop mu_event_loop_destroy_(mumResult* result, muEventLoop loop) {
+				MU_SET_RESULT(result, MUM_EVENT_LOOP_UNSUPPORTED)
+				return 0; if (loop) {}
+			}
+
+			MUDEF uint64_m mu_event_loop_add_(mumResult* result, muEventLoop loop, int fd, uint32_m events, void (*callback)(int fd, uint32_m events, void* args), void* args, mumTaskPriority priority) {
+				MU_SET_RESULT(result, MUM_EVENT_LOOP_UNSUPPORTED)
+				return 0; if (loop) {} if (fd) {} if (events) {} if (callback) {} if (args) {} if (priority) {}
+			}
+
+			MUDEF void mu_event_loop_remove_(mumResult* result, muEventLoop loop, uint64_m source) {
+				MU_SET_RESULT(result, MUM_EVENT_LOOP_UNSUPPORTED)
+				return; if (loop) {} if (source) {}
+			}
+
+			MUDEF size_m mu_event_loop_poll(muEventLoop loop, int32_m timeout_ms) {
+				return 0; if (loop) {} if (timeout_ms) {}
+			}
+
+			MUDEF void mu_event_loop_wake(muEventLoop loop) {
+				return; if (loop) {}
+			}
+
+		#endif
+
+		/* Task graph */
+
+			// Edges are only recorded as they're added. Before the first run after a change, they're
+			// sorted into a compressed list of successors per node, and the nodes into topological
+			// order (which also finds cycles); a run then only resets each node's counter of
+			// unfinished inputs.
+
+			#define MUM_GRAPH_NONE 0xFFFFFFFF
+
+			struct mum_graph_node {
+				struct mum_task_graph* graph;
+				void (*task)(void* args);
+				void* args;
+				mumTaskPriority priority;
+				// Inputs that haven't finished yet in the current run
+				uint32_m pending;
+				uint64_m start;
+				uint64_m end;
+			};
+			typedef struct mum_graph_node mum_graph_node;
+
+			struct mum_task_graph {
+				muScheduler scheduler;
+				mum_graph_node* nodes;
+				uint32_m node_count;
+				uint32_m node_capacity;
+				// Pairs of from and to
+				uint32_m* edges;
+				uint32_m edge_count;
+				uint32_m edge_capacity;
+
+				// Built from the edges, all in one allocation; successors of node i are
+				// succ[succ_start[i]] up to succ[succ_start[i + 1]]
+				muBool dirty;
+				void* built;
+				uint32_m built_nodes;
+				uint32_m built_edges;
+				uint32_m* succ_start;
+				uint32_m* succ;
+				uint32_m* indegree;
+				uint32_m* order;
+				// Scratch space for finding the critical path
+				uint64_m* path;
+				uint32_m* parent;
+
+				// Nodes unfinished in the current run; what a run sleeps on
+				uint32_m remaining;
+			};
+			typedef struct mum_task_graph mum_task_graph;
+
+			// Grows an array to fit at least the given amount of elements, keeping its contents
+			static muBool mum_graph_reserve(void** array, uint32_m* capacity, uint32_m count, uint32_m needed, size_m size) {
+				if (needed <= *capacity) {
+					return MU_TRUE;
+				}
+				uint32_m new_capacity = *capacity ? *capacity : 16;
+				while (new_capacity < needed) {
+					new_capacity *= 2;
+				}
+
+				void* new_array = mu_malloc(new_capacity * size);
+				if (!new_array) {
+					return MU_FALSE;
+				}
+				if (*array) {
+					mu_memcpy(new_array, *array, count * size);
+					mu_free(*array);
+				}
+				*array = new_array;
+				*capacity = new_capacity;
+				return MU_TRUE;
+			}
+
+			static void mum_graph_node_main(void* args);
+
+			static void mum_graph_submit(mum_graph_node* node) {
+				mumResult submit_result = MUM_SUCCESS;
+				mu_scheduler_submit_(&submit_result, node->graph->scheduler, mum_graph_node_main, node, node->priority, 0);
+				if (submit_result != MUM_SUCCESS) {
+					// Better late than never
+					mum_graph_node_main(node);
+				}
+			}
+
+			static void mum_graph_node_main(void* args) {
+				mum_graph_node* node = (mum_graph_node*)args;
+				mum_task_graph* g = node->graph;
+
+				node->start = mum_time_ns();
+				node->task(node->args);
+				node->end = mum_time_ns();
+
+				// Start every successor this was the last unfinished input of
+				uint32_m index = (uint32_m)(node - g->nodes);
+				for (uint32_m i = g->succ_start[index]; i < g->succ_start[index + 1]; i++) {
+					mum_graph_node* next = &g->nodes[g->succ[i]];
+					if (mum_atomic_fetch_sub32(&next->pending, 1) == 1) {
+						mum_graph_submit(next);
+					}
+				}
+
+				if (mum_atomic_fetch_sub32(&g->remaining, 1) == 1) {
+					mum_futex_wake(&g->remaining, MU_TRUE);
+				}
+			}
+
+			static void mum_graph_build(mumResult* result, mum_task_graph* g) {
+				uint32_m n = g->node_count;
+				uint32_m e = g->edge_count;
+
+				if (!g->built || n > g->built_nodes || e > g->built_edges) {
+					void* built = mu_malloc(n * sizeof(uint64_m) + (n * 4 + e + 1) * sizeof(uint32_m));
+					if (!built) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return;
+					}
+					if (g->built) {
+						mu_free(g->built);
+					}
+					g->built = built;
+					g->built_nodes = n;
+					g->built_edges = e;
+
+					g->path = (uint64_m*)built;
+					g->succ_start = (uint32_m*)(g->path + n);
+					g->succ = g->succ_start + n + 1;
+					g->indegree = g->succ + e;
+					g->order = g->indegree + n;
+					g->parent = g->order + n;
+				}
+
+				// Counting sort of the edges by where they come from
+				for (uint32_m i = 0; i <= n; i++) {
+					g->succ_start[i] = 0;
+				}
+				for (uint32_m i = 0; i < n; i++) {
+					g->indegree[i] = 0;
+				}
+				for (uint32_m i = 0; i < e; i++) {
+					g->succ_start[g->edges[i * 2] + 1]++;
+					g->indegree[g->edges[i * 2 + 1]]++;
+				}
+				for (uint32_m i = 0; i < n; i++) {
+					g->succ_start[i + 1] += g->succ_start[i];
+				}
+				// (Parents double as the insertion cursors here)
+				for (uint32_m i = 0; i < n; i++) {
+					g->parent[i] = g->succ_start[i];
+				}
+				for (uint32_m i = 0; i < e; i++) {
+					g->succ[g->parent[g->edges[i * 2]]++] = g->edges[i * 2 + 1];
+				}
+
+				// Kahn's algorithm, with the order doubling as the queue; anything left over is on
+				// a cycle. (Parents double as the remaining input counters here)
+				uint32_m ordered = 0;
+				for (uint32_m i = 0; i < n; i++) {
+					g->parent[i] = g->indegree[i];
+					if (g->indegree[i] == 0) {
+						g->order[ordered++] = i;
+					}
+				}
+				for (uint32_m k = 0; k < ordered; k++) {
+					uint32_m i = g->order[k];
+					for (uint32_m j = g->succ_start[i]; j < g->succ_start[i + 1]; j++) {
+						if (--g->parent[g->succ[j]] == 0) {
+							g->order[ordered++] = g->succ[j];
+						}
+					}
+				}
+				if (ordered != n) {
+					MU_SET_RESULT(result, MUM_TASK_GRAPH_CYCLE)
+					return;
+				}
+
+				g->dirty = MU_FALSE;
+			}
+
+			MUDEF muTaskGraph mu_task_graph_create_(mumResult* result, muScheduler scheduler) {
+				mum_task_graph* g = (mum_task_graph*)mu_malloc(sizeof(mum_task_graph));
+				if (!g) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				g->scheduler = scheduler;
+				g->nodes = 0;
+				g->node_count = 0;
+				g->node_capacity = 0;
+				g->edges = 0;
+				g->edge_count = 0;
+				g->edge_capacity = 0;
+				g->dirty = MU_TRUE;
+				g->built = 0;
+				g->built_nodes = 0;
+				g->built_edges = 0;
+				g->remaining = 0;
+
+				return g;
+			}
+
+			MUDEF muTaskGraph mu_task_graph_destroy_(mumResult* result, muTaskGraph graph) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+
+				if (g->built) {
+					mu_free(g->built);
+				}
+				if (g->nodes) {
+					mu_free(g->nodes);
+				}
+				if (g->edges) {
+					mu_free(g->edges);
+				}
+				mu_free(g);
+
+				return 0; if (result) {}
+			}
+
+			MUDEF uint32_m mu_task_graph_add_node_(mumResult* result, muTaskGraph graph, void (*task)(void* args), void* args, mumTaskPriority priority) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+
+				if (!mum_graph_reserve((void**)&g->nodes, &g->node_capacity, g->node_count, g->node_count + 1, sizeof(mum_graph_node))) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				mum_graph_node* node = &g->nodes[g->node_count];
+				node->graph = g;
+				node->task = task;
+				node->args = args;
+				node->priority = priority;
+				node->pending = 0;
+				node->start = 0;
+				node->end = 0;
+
+				g->dirty = MU_TRUE;
+				return g->node_count++;
+			}
+
+			MUDEF void mu_task_graph_add_edge_(mumResult* result, muTaskGraph graph, uint32_m from, uint32_m to) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+
+				if (from >= g->node_count || to >= g->node_count) {
+					MU_SET_RESULT(result, MUM_TASK_GRAPH_INVALID_NODE)
+					return;
+				}
+				if (!mum_graph_reserve((void**)&g->edges, &g->edge_capacity, g->edge_count * 2, g->edge_count * 2 + 2, sizeof(uint32_m))) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+
+				g->edges[g->edge_count * 2] = from;
+				g->edges[g->edge_count * 2 + 1] = to;
+				g->edge_count++;
+				g->dirty = MU_TRUE;
+			}
+
+			MUDEF uint64_m mu_task_graph_run_(mumResult* result, muTaskGraph graph) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+
+				if (g->dirty) {
+					mumResult build_result = MUM_SUCCESS;
+					mum_graph_build(&build_result, g);
+					if (build_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, build_result)
+						return 0;
+					}
+				}
+				if (g->node_count == 0) {
+					return 0;
+				}
+
+				// Every counter is reset before anything is submitted, as a node can finish and
+				// count down its successors right away
+				for (uint32_m i = 0; i < g->node_count; i++) {
+					mum_atomic_store32(&g->nodes[i].pending, g->indegree[i], MUM_RELAXED);
+				}
+				mum_atomic_store32(&g->remaining, g->node_count, MUM_SEQ_CST);
+
+				uint64_m start = mum_time_ns();
+				for (uint32_m i = 0; i < g->node_count && g->indegree[g->order[i]] == 0; i++) {
+					mum_graph_submit(&g->nodes[g->order[i]]);
+				}
+
+				uint32_m remaining;
+				while ((remaining = mum_atomic_load32(&g->remaining, MUM_ACQUIRE)) != 0) {
+					mum_futex_wait(&g->remaining, remaining, MUM_NO_TIMEOUT);
+				}
+				return mum_time_ns() - start;
+			}
+
+			MUDEF uint64_m mu_task_graph_node_time(muTaskGraph graph, uint32_m node) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+				if (node >= g->node_count) {
+					return 0;
+				}
+				return g->nodes[node].end - g->nodes[node].start;
+			}
+
+			MUDEF uint64_m mu_task_graph_critical_path(muTaskGraph graph, uint32_m* nodes, uint32_m* node_count) {
+				mum_task_graph* g = (mum_task_graph*)graph;
+
+				if (node_count) {
+					*node_count = 0;
+				}
+				if (g->dirty || g->node_count == 0) {
+					return 0;
+				}
+
+				// Longest path ending at each node, relaxed in topological order
+				for (uint32_m i = 0; i < g->node_count; i++) {
+					g->path[i] = g->nodes[i].end - g->nodes[i].start;
+					g->parent[i] = MUM_GRAPH_NONE;
+				}
+				uint32_m last = g->order[0];
+				for (uint32_m k = 0; k < g->node_count; k++) {
+					uint32_m i = g->order[k];
+					if (g->path[i] > g->path[last]) {
+						last = i;
+					}
+					for (uint32_m j = g->succ_start[i]; j < g->succ_start[i + 1]; j++) {
+						uint32_m next = g->succ[j];
+						uint64_m length = g->path[i] + (g->nodes[next].end - g->nodes[next].start);
+						if (length > g->path[next]) {
+							g->path[next] = length;
+							g->parent[next] = i;
+						}
+					}
+				}
+
+				uint32_m count = 0;
+				for (uint32_m i = last; i != MUM_GRAPH_NONE; i = g->parent[i]) {
+					count++;
+				}
+				if (nodes) {
+					uint32_m k = count;
+					for (uint32_m i = last; i != MUM_GRAPH_NONE; i = g->parent[i]) {
+						nodes[--k] = i;
+					}
+				}
+				if (node_count) {
+					*node_count = count;
+				}
+				return g->path[last];
+			}
+
+		/* Parallel algorithms */
+
+			// Every algorithm is a few passes over blocks of the array, with serial work between
+			// them. A pass is a job of numbered chunks that the calling thread and some helper tasks
+			// on the scheduler claim one at a time; the caller only waits for chunks to finish,
+			// never for the helpers to start, since it can always run every chunk itself. The job
+			// is freed by whichever of them lets go of it last.
+
+			#ifndef MUM_PARALLEL_SERIAL
+				#define MUM_PARALLEL_SERIAL 16384
+			#endif
+
+			// Blocks handed out per worker, so that one slow block doesn't hold everyone up
+			#define MUM_PARALLEL_SPLIT 4
+			// Runs insertion sorted before merging
+			#define MUM_SORT_RUN 16
+
+			struct mum_par_job {
+				void (*run)(void* context, uint32_m chunk);
+				void* context;
+				uint32_m chunks;
+				uint32_m next;
+				// Chunks finished; what the caller sleeps on
+				uint32_m done;
+				uint32_m refs;
+			};
+			typedef struct mum_par_job mum_par_job;
+
+			static void mum_par_job_work(mum_par_job* job) {
+				uint32_m chunk;
+				while ((chunk = mum_atomic_fetch_add32(&job->next, 1)) < job->chunks) {
+					job->run(job->context, chunk);
+					if (mum_atomic_fetch_add32(&job->done, 1) + 1 == job->chunks) {
+						mum_futex_wake(&job->done, MU_TRUE);
+					}
+				}
+			}
+
+			static void mum_par_job_release(mum_par_job* job) {
+				if (mum_atomic_fetch_sub32(&job->refs, 1) == 1) {
+					mu_free(job);
+				}
+			}
+
+			static void mum_par_helper_main(void* args) {
+				mum_par_job* job = (mum_par_job*)args;
+				mum_par_job_work(job);
+				mum_par_job_release(job);
+			}
+
+			static void mum_par_run(mum_scheduler* s, uint32_m chunks, void (*run)(void* context, uint32_m chunk), void* context) {
+				mum_par_job* job = 0;
+				if (s && chunks > 1) {
+					job = (mum_par_job*)mu_malloc(sizeof(mum_par_job));
+				}
+				if (!job) {
+					for (uint32_m i = 0; i < chunks; i++) {
+						run(context, i);
+					}
+					return;
+				}
+
+				job->run = run;
+				job->context = context;
+				job->chunks = chunks;
+				job->next = 0;
+				job->done = 0;
+
+				uint32_m helpers = chunks - 1 < s->worker_count ? chunks - 1 : s->worker_count;
+				job->refs = helpers + 1;
+				for (uint32_m i = 0; i < helpers; i++) {
+					mumResult submit_result = MUM_SUCCESS;
+					mu_scheduler_submit_(&submit_result, (muScheduler)s, mum_par_helper_main, job, MUM_TASK_PRIORITY_NORMAL, 0);
+					if (submit_result != MUM_SUCCESS) {
+						// One helper fewer; the caller's reference keeps the job alive
+						mum_atomic_fetch_sub32(&job->refs, 1);
+					}
+				}
+
+				mum_par_job_work(job);
+				uint32_m done;
+				while ((done = mum_atomic_load32(&job->done, MUM_ACQUIRE)) != chunks) {
+					mum_futex_wait(&job->done, done, MUM_NO_TIMEOUT);
+				}
+				mum_par_job_release(job);
+			}
+
+			// How many blocks to split an array into; 1 means doing it serially
+			static uint32_m mum_par_blocks(muScheduler scheduler, size_m count) {
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+				if (!s || count < MUM_PARALLEL_SERIAL) {
+					return 1;
+				}
+				size_m blocks = (size_m)s->worker_count * MUM_PARALLEL_SPLIT;
+				size_m most = count / (MUM_PARALLEL_SERIAL / MUM_PARALLEL_SPLIT);
+				if (blocks > most) {
+					blocks = most;
+				}
+				return blocks ? (uint32_m)blocks : 1;
+			}
+
+			// Where block i of an array starts; block i ends where block i + 1 starts
+			static inline size_m mum_par_bound(size_m count, uint32_m blocks, uint32_m i) {
+				return (size_m)(((uint64_m)count * i) / blocks);
+			}
+
+			// Sorting
+
+			struct mum_sort_ctx {
+				uint8_m* base;
+				uint8_m* temp;
+				size_m count;
+				size_m size;
+				int (*compare)(const void* a, const void* b, void* args);
+				void* args;
+				uint32_m blocks;
+				// The current merge round, merging runs of width blocks from src into dst, with
+				// each merge split into per_merge chunks
+				uint8_m* src;
+				uint8_m* dst;
+				uint32_m width;
+				uint32_m per_merge;
+			};
+			typedef struct mum_sort_ctx mum_sort_ctx;
+
+			// Merges a and b into out, taking from a first when elements are equal
+			static void mum_sort_merge(mum_sort_ctx* c, const uint8_m* a, size_m a_count, const uint8_m* b, size_m b_count, uint8_m* out) {
+				size_m size = c->size;
+				const uint8_m* a_end = a + a_count * size;
+				const uint8_m* b_end = b + b_count * size;
+				while (a != a_end && b != b_end) {
+					if (c->compare(b, a, c->args) < 0) {
+						mu_memcpy(out, b, size);
+						b += size;
+					} else {
+						mu_memcpy(out, a, size);
+						a += size;
+					}
+					out += size;
+				}
+				if (a != a_end) {
+					mu_memcpy(out, a, (size_m)(a_end - a));
+				}
+				if (b != b_end) {
+					mu_memcpy(out, b, (size_m)(b_end - b));
+				}
+			}
+
+			// Sorts an array serially, using temp (as big as it) as scratch space
+			static void mum_sort_serial(mum_sort_ctx* c, uint8_m* base, uint8_m* temp, size_m count) {
+				size_m size = c->size;
+
+				// Insertion sort runs, holding the element being inserted in temp
+				for (size_m run = 0; run < count; run += MUM_SORT_RUN) {
+					size_m run_end = run + MUM_SORT_RUN < count ? run + MUM_SORT_RUN : count;
+					for (size_m i = run + 1; i < run_end; i++) {
+						size_m j = i;
+						while (j > run && c->compare(base + i * size, base + (j - 1) * size, c->args) < 0) {
+							j--;
+						}
+						if (j != i) {
+							mu_memcpy(temp, base + i * size, size);
+							mu_memmove(base + (j + 1) * size, base + j * size, (i - j) * size);
+							mu_memcpy(base + j * size, temp, size);
+						}
+					}
+				}
+
+				// Merge runs back and forth between the two arrays
+				uint8_m* src = base;
+				uint8_m* dst = temp;
+				for (size_m width = MUM_SORT_RUN; width < count; width *= 2) {
+					for (size_m left = 0; left < count; left += width * 2) {
+						size_m middle = left + width < count ? left + width : count;
+						size_m right = middle + width < count ? middle + width : count;
+						mum_sort_merge(c, src + left * size, middle - left, src + middle * size, right - middle, dst + left * size);
+					}
+					uint8_m* swap = src;
+					src = dst;
+					dst = swap;
+				}
+				if (src != base) {
+					mu_memcpy(base, src, count * size);
+				}
+			}
+
+			static void mum_sort_block(void* context, uint32_m chunk) {
+				mum_sort_ctx* c = (mum_sort_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				mum_sort_serial(c, c->base + begin * c->size, c->temp + begin * c->size, end - begin);
+			}
+
+			// How many of the first `diagonal` elements of merging a and b come from a; this is a
+			// binary search along the diagonal of the merge path (Odeh et al. (2012), "Merge Path -
+			// Parallel Merging Made Simple")
+			static size_m mum_sort_split(mum_sort_ctx* c, const uint8_m* a, size_m a_count, const uint8_m* b, size_m b_count, size_m diagonal) {
+				size_m low = diagonal > b_count ? diagonal - b_count : 0;
+				size_m high = diagonal < a_count ? diagonal : a_count;
+				while (low < high) {
+					size_m middle = low + (high - low) / 2;
+					if (c->compare(b + (diagonal - middle - 1) * c->size, a + middle * c->size, c->args) < 0) {
+						high = middle;
+					} else {
+						low = middle + 1;
+					}
+				}
+				return low;
+			}
+
+			static void mum_sort_merge_chunk(void* context, uint32_m chunk) {
+				mum_sort_ctx* c = (mum_sort_ctx*)context;
+				size_m size = c->size;
+				uint32_m merge = chunk / c->per_merge;
+				uint32_m part = chunk % c->per_merge;
+
+				uint32_m first = merge * c->width * 2;
+				size_m a_begin = mum_par_bound(c->count, c->blocks, first);
+				size_m b_begin = mum_par_bound(c->count, c->blocks, first + c->width);
+				size_m b_end = mum_par_bound(c->count, c->blocks, first + c->width * 2);
+				const uint8_m* a = c->src + a_begin * size;
+				const uint8_m* b = c->src + b_begin * size;
+				size_m a_count = b_begin - a_begin;
+				size_m b_count = b_end - b_begin;
+
+				size_m total = a_count + b_count;
+				size_m start = (size_m)(((uint64_m)total * part) / c->per_merge);
+				size_m stop = (size_m)(((uint64_m)total * (part + 1)) / c->per_merge);
+				size_m a_start = mum_sort_split(c, a, a_count, b, b_count, start);
+				size_m a_stop = mum_sort_split(c, a, a_count, b, b_count, stop);
+
+				mum_sort_merge(c,
+					a + a_start * size, a_stop - a_start,
+					b + (start - a_start) * size, (stop - a_stop) - (start - a_start),
+					c->dst + (a_begin + start) * size
+				);
+			}
+
+			static void mum_sort_copy_chunk(void* context, uint32_m chunk) {
+				mum_sort_ctx* c = (mum_sort_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				mu_memcpy(c->base + begin * c->size, c->temp + begin * c->size, (end - begin) * c->size);
+			}
+
+			MUDEF void mu_parallel_sort_(mumResult* result, muScheduler scheduler, void* base, size_m count, size_m size, int (*compare)(const void* a, const void* b, void* args), void* args) {
+				if (count < 2) {
+					return;
+				}
+
+				mum_sort_ctx c;
+				c.temp = (uint8_m*)mu_malloc(count * size);
+				if (!c.temp) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+				c.base = (uint8_m*)base;
+				c.count = count;
+				c.size = size;
+				c.compare = compare;
+				c.args = args;
+
+				// Merge rounds halve the amount of sorted blocks, so keep it a power of 2
+				uint32_m blocks = mum_par_blocks(scheduler, count);
+				c.blocks = 1;
+				while (c.blocks * 2 <= blocks) {
+					c.blocks *= 2;
+				}
+
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+				mum_par_run(s, c.blocks, mum_sort_block, &c);
+
+				// Each round merges pairs of runs, splitting every merge so that there are always as
+				// many chunks as blocks
+				c.src = c.base;
+				c.dst = c.temp;
+				for (c.width = 1; c.width < c.blocks; c.width *= 2) {
+					c.per_merge = c.width * 2;
+					mum_par_run(s, c.blocks, mum_sort_merge_chunk, &c);
+					uint8_m* swap = c.src;
+					c.src = c.dst;
+					c.dst = swap;
+				}
+				if (c.src != c.base) {
+					mum_par_run(s, c.blocks, mum_sort_copy_chunk, &c);
+				}
+
+				mu_free(c.temp);
+			}
+
+			// Scanning
+
+			struct mum_scan_ctx {
+				const uint8_m* input;
+				uint8_m* output;
+				size_m count;
+				size_m size;
+				const void* identity;
+				void (*reduce)(void* accumulator, const void* value, void* args);
+				void* args;
+				muBool inclusive;
+				uint32_m blocks;
+				// The sum of each block, then the sum of the blocks before each block
+				uint8_m* sums;
+				// An element of scratch space for each block
+				uint8_m* scratch;
+			};
+			typedef struct mum_scan_ctx mum_scan_ctx;
+
+			static void mum_scan_sum_chunk(void* context, uint32_m chunk) {
+				mum_scan_ctx* c = (mum_scan_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				uint8_m* sum = c->sums + chunk * c->size;
+
+				mu_memcpy(sum, c->identity, c->size);
+				for (size_m i = begin; i < end; i++) {
+					c->reduce(sum, c->input + i * c->size, c->args);
+				}
+			}
+
+			static void mum_scan_chunk(void* context, uint32_m chunk) {
+				mum_scan_ctx* c = (mum_scan_ctx*)context;
+				size_m size = c->size;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				uint8_m* sum = c->sums + chunk * size;
+				uint8_m* scratch = c->scratch + chunk * size;
+
+				// The input is read before the output is written, so that they can be the same
+				if (c->inclusive) {
+					for (size_m i = begin; i < end; i++) {
+						c->reduce(sum, c->input + i * size, c->args);
+						mu_memcpy(c->output + i * size, sum, size);
+					}
+				} else {
+					for (size_m i = begin; i < end; i++) {
+						mu_memcpy(scratch, c->input + i * size, size);
+						mu_memcpy(c->output + i * size, sum, size);
+						c->reduce(sum, scratch, c->args);
+					}
+				}
+			}
+
+			MUDEF void mu_parallel_scan_(mumResult* result, muScheduler scheduler, const void* input, void* output, size_m count, size_m size, const void* identity, void (*reduce)(void* accumulator, const void* value, void* args), void* args, muBool inclusive) {
+				if (count == 0) {
+					return;
+				}
+
+				mum_scan_ctx c;
+				c.blocks = mum_par_blocks(scheduler, count);
+				// Two more elements of scratch space for adding up the sums of the blocks
+				c.sums = (uint8_m*)mu_malloc((c.blocks * 2 + 2) * size);
+				if (!c.sums) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+				c.scratch = c.sums + c.blocks * size;
+				c.input = (const uint8_m*)input;
+				c.output = (uint8_m*)output;
+				c.count = count;
+				c.size = size;
+				c.identity = identity;
+				c.reduce = reduce;
+				c.args = args;
+				c.inclusive = inclusive;
+
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+				if (c.blocks > 1) {
+					mum_par_run(s, c.blocks, mum_scan_sum_chunk, &c);
+				}
+
+				// Turn the sums of each block into the sums of the blocks before them
+				uint8_m* running = c.scratch + c.blocks * size;
+				uint8_m* block_sum = running + size;
+				mu_memcpy(running, identity, size);
+				for (uint32_m i = 0; i < c.blocks; i++) {
+					uint8_m* sum = c.sums + i * size;
+					mu_memcpy(block_sum, sum, size);
+					mu_memcpy(sum, running, size);
+					reduce(running, block_sum, args);
+				}
+
+				mum_par_run(s, c.blocks, mum_scan_chunk, &c);
+				mu_free(c.sums);
+			}
+
+			// Partitioning
+
+			struct mum_partition_ctx {
+				uint8_m* base;
+				uint8_m* temp;
+				// Whether each element matched
+				uint8_m* matched;
+				size_m count;
+				size_m size;
+				muBool (*predicate)(const void* element, void* args);
+				void* args;
+				uint32_m blocks;
+				// The amount of matches in each block, then the amount in the blocks before each
+				size_m* matches;
+				size_m total;
+			};
+			typedef struct mum_partition_ctx mum_partition_ctx;
+
+			static void mum_partition_count_chunk(void* context, uint32_m chunk) {
+				mum_partition_ctx* c = (mum_partition_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+
+				size_m matches = 0;
+				for (size_m i = begin; i < end; i++) {
+					muBool match = c->predicate(c->base + i * c->size, c->args);
+					c->matched[i] = match ? 1 : 0;
+					matches += c->matched[i];
+				}
+				c->matches[chunk] = matches;
+			}
+
+			static void mum_partition_scatter_chunk(void* context, uint32_m chunk) {
+				mum_partition_ctx* c = (mum_partition_ctx*)context;
+				size_m size = c->size;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+
+				// Matches go after those of the blocks before; the rest go after all matches and
+				// the rest of the blocks before
+				size_m match = c->matches[chunk];
+				size_m other = c->total + (begin - match);
+				for (size_m i = begin; i < end; i++) {
+					size_m to = c->matched[i] ? match++ : other++;
+					mu_memcpy(c->temp + to * size, c->base + i * size, size);
+				}
+			}
+
+			static void mum_partition_copy_chunk(void* context, uint32_m chunk) {
+				mum_partition_ctx* c = (mum_partition_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				mu_memcpy(c->base + begin * c->size, c->temp + begin * c->size, (end - begin) * c->size);
+			}
 
-			MUDEF muMutex mu_mutex_destroy_(mumResult* result, muMutex mutex) {
-				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+			MUDEF size_m mu_parallel_partition_(mumResult* result, muScheduler scheduler, void* base, size_m count, size_m size, muBool (*predicate)(const void* element, void* args), void* args) {
+				if (count == 0) {
+					return 0;
+				}
+
+				mum_partition_ctx c;
+				c.blocks = mum_par_blocks(scheduler, count);
+				// All in one allocation, with the counts first for their alignment
+				c.matches = (size_m*)mu_malloc(c.blocks * sizeof(size_m) + count * size + count);
+				if (!c.matches) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+				c.temp = (uint8_m*)(c.matches + c.blocks);
+				c.matched = c.temp + count * size;
+				c.base = (uint8_m*)base;
+				c.count = count;
+				c.size = size;
+				c.predicate = predicate;
+				c.args = args;
+
+				mum_scheduler* s = (mum_scheduler*)scheduler;
+				mum_par_run(s, c.blocks, mum_partition_count_chunk, &c);
+
+				c.total = 0;
+				for (uint32_m i = 0; i < c.blocks; i++) {
+					size_m matches = c.matches[i];
+					c.matches[i] = c.total;
+					c.total += matches;
+				}
+
+				mum_par_run(s, c.blocks, mum_partition_scatter_chunk, &c);
+				mum_par_run(s, c.blocks, mum_partition_copy_chunk, &c);
+
+				size_m total = c.total;
+				mu_free(c.matches);
+				return total;
+			}
+
+			// Transform-reduce
+
+			struct mum_reduce_ctx {
+				const uint8_m* input;
+				size_m count;
+				size_m size;
+				size_m output_size;
+				const void* identity;
+				void (*transform)(void* value, const void* element, void* args);
+				void (*reduce)(void* accumulator, const void* value, void* args);
+				void* args;
+				uint32_m blocks;
+				// The sum of each block, and space for a transformed value for each block
+				uint8_m* sums;
+				uint8_m* values;
+			};
+			typedef struct mum_reduce_ctx mum_reduce_ctx;
+
+			static void mum_reduce_chunk(void* context, uint32_m chunk) {
+				mum_reduce_ctx* c = (mum_reduce_ctx*)context;
+				size_m begin = mum_par_bound(c->count, c->blocks, chunk);
+				size_m end = mum_par_bound(c->count, c->blocks, chunk + 1);
+				uint8_m* sum = c->sums + chunk * c->output_size;
+				uint8_m* value = c->values + chunk * c->output_size;
+
+				mu_memcpy(sum, c->identity, c->output_size);
+				for (size_m i = begin; i < end; i++) {
+					c->transform(value, c->input + i * c->size, c->args);
+					c->reduce(sum, value, c->args);
+				}
+			}
+
+			MUDEF void mu_parallel_transform_reduce_(mumResult* result, muScheduler scheduler, const void* input, size_m count, size_m size, void* output, size_m output_size, const void* identity, void (*transform)(void* value, const void* element, void* args), void (*reduce)(void* accumulator, const void* value, void* args), void* args) {
+
+				mum_reduce_ctx c;
+				c.blocks = mum_par_blocks(scheduler, count);
+				c.sums = (uint8_m*)mu_malloc(c.blocks * 2 * output_size);
+				if (!c.sums) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+				c.values = c.sums + c.blocks * output_size;
+				c.input = (const uint8_m*)input;
+				c.count = count;
+				c.size = size;
+				c.output_size = output_size;
+				c.identity = identity;
+				c.transform = transform;
+				c.reduce = reduce;
+				c.args = args;
+
+				mum_par_run((mum_scheduler*)scheduler, c.blocks, mum_reduce_chunk, &c);
+
+				// Blocks are added up in order, for reductions that aren't commutative
+				mu_memcpy(output, identity, output_size);
+				for (uint32_m i = 0; i < c.blocks; i++) {
+					reduce(output, c.sums + i * output_size, args);
+				}
+				mu_free(c.sums);
+			}
+
+		/* Work-stealing deque */
+
+			// The deque of Chase and Lev, with the memory orderings of Lê et al. (2013), "Correct
+			// and Efficient Work-Stealing for Weak Memory Models". Indices only ever grow (bottom
+			// drops by one while popping), and index i lives at i masked by the array size. Arrays
+			// that were grown out of are kept until the deque is destroyed, as a thief may still be
+			// reading from one; they add up to less than the current array.
+
+			#define MUM_WS_DEFAULT_CAPACITY 64
+
+			struct mum_ws_array {
+				uint64_m mask;
+				void* volatile* items;
+				struct mum_ws_array* retired;
+			};
+			typedef struct mum_ws_array mum_ws_array;
+
+			struct mum_ws_deque {
+				// Taken from by thieves
+				uint64_m top;
+				uint8_m pad0[MUM_CACHE_LINE - sizeof(uint64_m)];
+				// Pushed and popped by the owner
+				uint64_m bottom;
+				uint8_m pad1[MUM_CACHE_LINE - sizeof(uint64_m)];
+				void* volatile array;
+			};
+			typedef struct mum_ws_deque mum_ws_deque;
+
+			static mum_ws_array* mum_ws_array_create(uint64_m capacity) {
+				mum_ws_array* a = (mum_ws_array*)mu_malloc(sizeof(mum_ws_array) + capacity * sizeof(void*));
+				if (!a) {
+					return 0;
+				}
+				a->mask = capacity - 1;
+				a->items = (void* volatile*)(a + 1);
+				a->retired = 0;
+				return a;
+			}
+
+			static mum_ws_array* mum_ws_grow(mum_ws_deque* d, mum_ws_array* old, uint64_m top, uint64_m bottom) {
+				mum_ws_array* a = mum_ws_array_create((old->mask + 1) * 2);
+				if (!a) {
+					return 0;
+				}
+				for (uint64_m i = top; i != bottom; i++) {
+					mum_atomic_store_ptr(&a->items[i & a->mask], mum_atomic_load_ptr(&old->items[i & old->mask], MUM_RELAXED), MUM_RELAXED);
+				}
+				a->retired = old;
+				mum_atomic_store_ptr(&d->array, a, MUM_RELEASE);
+				return a;
+			}
+
+			MUDEF muWSDeque mu_ws_deque_create_(mumResult* result, size_m capacity) {
+				uint64_m size = 2;
+				while (size < (uint64_m)(capacity ? capacity : MUM_WS_DEFAULT_CAPACITY)) {
+					size *= 2;
+				}
+
+				mum_ws_deque* d = (mum_ws_deque*)mu_malloc(sizeof(mum_ws_deque));
+				if (!d) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+				mum_ws_array* a = mum_ws_array_create(size);
+				if (!a) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					mu_free(d);
+					return 0;
+				}
+
+				d->top = 0;
+				d->bottom = 0;
+				d->array = a;
+				return d;
+			}
+
+			MUDEF muWSDeque mu_ws_deque_destroy_(mumResult* result, muWSDeque deque) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				mum_ws_array* a = (mum_ws_array*)d->array;
+				while (a) {
+					mum_ws_array* retired = a->retired;
+					mu_free(a);
+					a = retired;
+				}
+				mu_free(d);
+
+				return 0; if (result) {}
+			}
+
+			MUDEF void mu_ws_deque_push_(mumResult* result, muWSDeque deque, void* item) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				uint64_m b = mum_atomic_load64(&d->bottom, MUM_RELAXED);
+				uint64_m t = mum_atomic_load64(&d->top, MUM_ACQUIRE);
+				mum_ws_array* a = (mum_ws_array*)mum_atomic_load_ptr(&d->array, MUM_RELAXED);
+				if (b - t > a->mask) {
+					a = mum_ws_grow(d, a, t, b);
+					if (!a) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return;
+					}
+				}
+
+				mum_atomic_store_ptr(&a->items[b & a->mask], item, MUM_RELAXED);
+				mum_atomic_fence(MUM_RELEASE);
+				mum_atomic_store64(&d->bottom, b + 1, MUM_RELAXED);
+			}
+
+			MUDEF void* mu_ws_deque_pop(muWSDeque deque) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				// Claim the bottom item before looking at the top, so that a thief either sees it
+				// claimed or gets seen by the owner
+				uint64_m b = mum_atomic_load64(&d->bottom, MUM_RELAXED) - 1;
+				mum_ws_array* a = (mum_ws_array*)mum_atomic_load_ptr(&d->array, MUM_RELAXED);
+				mum_atomic_store64(&d->bottom, b, MUM_RELAXED);
+				mum_atomic_fence(MUM_SEQ_CST);
+				uint64_m t = mum_atomic_load64(&d->top, MUM_RELAXED);
+
+				if ((int64_m)(b - t) < 0) {
+					mum_atomic_store64(&d->bottom, b + 1, MUM_RELAXED);
+					return 0;
+				}
+
+				void* item = mum_atomic_load_ptr(&a->items[b & a->mask], MUM_RELAXED);
+				if (b == t) {
+					// The last item; thieves may be after it too
+					if (!mum_atomic_cas64(&d->top, &t, t + 1)) {
+						item = 0;
+					}
+					mum_atomic_store64(&d->bottom, b + 1, MUM_RELAXED);
+				}
+				return item;
+			}
+
+			MUDEF void* mu_ws_deque_steal(muWSDeque deque) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				uint64_m t = mum_atomic_load64(&d->top, MUM_ACQUIRE);
+				mum_atomic_fence(MUM_SEQ_CST);
+				uint64_m b = mum_atomic_load64(&d->bottom, MUM_ACQUIRE);
+				if ((int64_m)(b - t) <= 0) {
+					return 0;
+				}
+
+				mum_ws_array* a = (mum_ws_array*)mum_atomic_load_ptr(&d->array, MUM_ACQUIRE);
+				void* item = mum_atomic_load_ptr(&a->items[t & a->mask], MUM_RELAXED);
+				if (!mum_atomic_cas64(&d->top, &t, t + 1)) {
+					return 0;
+				}
+				return item;
+			}
+
+			MUDEF size_m mu_ws_deque_steal_half(muWSDeque deque, void** items, size_m max_count) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				size_m count = 0;
+				size_m goal = max_count;
+				while (count < goal) {
+					uint64_m t = mum_atomic_load64(&d->top, MUM_ACQUIRE);
+					mum_atomic_fence(MUM_SEQ_CST);
+					uint64_m b = mum_atomic_load64(&d->bottom, MUM_ACQUIRE);
+					int64_m size = (int64_m)(b - t);
+					if (size <= 0) {
+						break;
+					}
+					// Half of what was there to begin with, rounded up so that a lone item still
+					// gets stolen
+					if (count == 0 && (uint64_m)(size + 1) / 2 < (uint64_m)goal) {
+						goal = (size_m)((size + 1) / 2);
+					}
+
+					mum_ws_array* a = (mum_ws_array*)mum_atomic_load_ptr(&d->array, MUM_ACQUIRE);
+					void* item = mum_atomic_load_ptr(&a->items[t & a->mask], MUM_RELAXED);
+					if (!mum_atomic_cas64(&d->top, &t, t + 1)) {
+						break;
+					}
+					items[count++] = item;
+				}
+				return count;
+			}
+
+			MUDEF size_m mu_ws_deque_size(muWSDeque deque) {
+				mum_ws_deque* d = (mum_ws_deque*)deque;
+
+				uint64_m t = mum_atomic_load64(&d->top, MUM_RELAXED);
+				uint64_m b = mum_atomic_load64(&d->bottom, MUM_RELAXED);
+				int64_m size = (int64_m)(b - t);
+				return size > 0 ? (size_m)size : 0;
+			}
+
+		/* Channels */
+
+			// The buffer is Vyukov's bounded queue, with a sequence number in each slot: at position
+			// p, the slot is free when its sequence is twice p's lap around the ring, and full when
+			// it's one more, which works for any capacity, 1 included. Closing sets the top bit of
+			// the tail, so that any send that hasn't claimed a slot yet fails.
+
+			// A thread that has to block queues a waiter on the channel, under its lock, and sleeps
+			// on a state word. Another thread completes a waiter by taking it off the queue and
+			// claiming its state word with a compare-and-swap, after which it copies the value and
+			// stores the outcome. A select shares one state word between the waiters of all of its
+			// cases, so only one of them can ever be claimed; the rest are left for their owner, or
+			// for whoever comes across them first, to take off their queues.
+
+			// Sends and receives that don't block only take the lock if somebody is waiting: after
+			// putting a value in the buffer, one waiting receiver is woken to try again, and after
+			// taking one out, so is one waiting sender. Both check for waiters after a full fence,
+			// and waiters look at the buffer again after queueing, so neither side can miss the other.
+
+			// Unbounded channels keep their values in a list of segments instead of a ring, as in
+			// crossbeam's list channel. Positions count slots as before, MUM_CHAN_SEGMENT per
+			// segment, but the last position of each segment has no slot: a sender that takes the
+			// last real slot links in the next segment and then moves the tail past it, so a thread
+			// that finds a position there waits for that. Each slot's state records that it's been
+			// written and read; the reader of a segment's last slot frees the segment, unless a
+			// reader of an earlier slot is still busy with it, in which case that reader frees it.
+
+			#define MUM_CHAN_CLOSED_BIT ((uint64_m)1 << 63)
+			// Set in head when the tail is known to be in a later segment, so that receivers needn't
+			// look at the tail to know there's a value
+			#define MUM_CHAN_AHEAD_BIT ((uint64_m)1 << 63)
+			#define MUM_CHAN_SELECT_STACK 8
+
+			#define MUM_CHAN_SEGMENT 32
+			#define MUM_CHAN_SLOT_WRITTEN 1
+			#define MUM_CHAN_SLOT_READ 2
+			#define MUM_CHAN_SLOT_DESTROY 4
+
+			// State word values; once finished, the state also holds the index of the case
+			#define MUM_CHAN_WAITING 0
+			#define MUM_CHAN_BUSY 1
+			#define MUM_CHAN_GAVE_UP 2
+			#define MUM_CHAN_GAVE_UP_STOPPED 3
+			#define MUM_CHAN_FINISHED 4
+			#define MUM_CHAN_FINISHED_OK 4
+			#define MUM_CHAN_FINISHED_CLOSED 5
+			#define MUM_CHAN_FINISHED_RETRY 6
+
+			struct mum_chan_waiter {
+				struct mum_chan_waiter* prev;
+				struct mum_chan_waiter* next;
+				// What's being sent, or where to receive into
+				void* value;
+				uint32_m* state;
+				uint32_m index;
+				muBool queued;
+			};
+			typedef struct mum_chan_waiter mum_chan_waiter;
+
+			struct mum_chan_queue {
+				mum_chan_waiter* head;
+				mum_chan_waiter* tail;
+				// Read without the lock by operations that don't segment
+				uint32_m count;
+			};
+
+			struct mum_chan {
+				// Positions of the next value to receive (with the ahead bit), and to send (with the
+				// closed bit), along with, if unbounded, the segments they're in
+				uint64_m head;
+				void* volatile head_segment;
+				uint8_m head_pad[MUM_CACHE_LINE - sizeof(uint64_m) - sizeof(void*)];
+				uint64_m tail;
+				void* volatile tail_segment;
+				uint8_m tail_pad[MUM_CACHE_LINE - sizeof(uint64_m) - sizeof(void*)];
+
+				size_m element_size;
+				size_m capacity;
+				// Each slot is its sequence number followed by its value
+				size_m stride;
+				uint8_m* slots;
+
+				uint32_m lock;
+				struct mum_chan_queue senders;
+				struct mum_chan_queue receivers;
+				// The idle strategy blocked threads wait with
+				void* volatile idle;
+			};
+			typedef struct mum_chan mum_chan;
+
+			// Followed by MUM_CHAN_SEGMENT - 1 slots, each its state followed by its value
+			struct mum_chan_segment {
+				void* volatile next;
+				uint64_m align;
+			};
+			typedef struct mum_chan_segment mum_chan_segment;
+
+			static MUM_THREAD_LOCAL uint32_m mum_chan_random = 0;
+
+			static inline uint64_m* mum_chan_slot(mum_chan* c, uint64_m position) {
+				return (uint64_m*)(c->slots + (size_m)(position % c->capacity) * c->stride);
+			}
+
+			static inline uint32_m* mum_chan_segment_slot(mum_chan* c, mum_chan_segment* b, uint64_m offset) {
+				return (uint32_m*)((uint8_m*)(b + 1) + (size_m)offset * c->stride);
+			}
+
+			static mum_chan_segment* mum_chan_segment_alloc(mum_chan* c) {
+				mum_chan_segment* b = (mum_chan_segment*)mu_malloc(sizeof(mum_chan_segment) + (MUM_CHAN_SEGMENT - 1) * c->stride);
+				if (b) {
+					b->next = 0;
+					for (uint64_m i = 0; i < MUM_CHAN_SEGMENT - 1; i++) {
+						*mum_chan_segment_slot(c, b, i) = 0;
+					}
+				}
+				return b;
+			}
+
+			// Frees a segment once every slot from start on has been read, or leaves it to the
+			// reader of the first one that hasn't
+			static void mum_chan_segment_destroy(mum_chan* c, mum_chan_segment* b, uint64_m start) {
+				// The last slot's reader is the one that starts this, so it's never marked
+				for (uint64_m i = start; i < MUM_CHAN_SEGMENT - 2; i++) {
+					uint32_m* state = mum_chan_segment_slot(c, b, i);
+					if (!(mum_atomic_load32(state, MUM_ACQUIRE) & MUM_CHAN_SLOT_READ) && !(mum_atomic_fetch_add32(state, MUM_CHAN_SLOT_DESTROY) & MUM_CHAN_SLOT_READ)) {
+						return;
+					}
+				}
+				mu_free(b);
+			}
+
+			// mum_chan_push for unbounded channels
+			static int mum_chan_list_push(mum_chan* c, const void* value) {
+				// Allocated ahead of taking the last slot of a segment, so that linking it in is quick
+				mum_chan_segment* next_segment = 0;
+				uint64_m position = mum_atomic_load64(&c->tail, MUM_ACQUIRE);
+				mum_chan_segment* segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->tail_segment, MUM_ACQUIRE);
+
+				for (;;) {
+					if (position & MUM_CHAN_CLOSED_BIT) {
+						if (next_segment) {
+							mu_free(next_segment);
+						}
+						return -1;
+					}
+
+					uint64_m offset = position % MUM_CHAN_SEGMENT;
+					if (offset == MUM_CHAN_SEGMENT - 1) {
+						// Another sender is linking in the next segment
+						mum_cpu_relax();
+						position = mum_atomic_load64(&c->tail, MUM_ACQUIRE);
+						segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->tail_segment, MUM_ACQUIRE);
+						continue;
+					}
+					if (offset + 2 == MUM_CHAN_SEGMENT && !next_segment) {
+						next_segment = mum_chan_segment_alloc(c);
+						if (!next_segment) {
+							return 0;
+						}
+					}
+
+					if (!segment) {
+						// The first value sent installs the first segment; a sender that loses the
+						// race to do so uses the winner's instead
+						mum_chan_segment* first = mum_chan_segment_alloc(c);
+						if (!first) {
+							if (next_segment) {
+								mu_free(next_segment);
+							}
+							return 0;
+						}
+						void* expected = 0;
+						if (mum_atomic_cas_ptr(&c->tail_segment, &expected, first)) {
+							mum_atomic_store_ptr(&c->head_segment, first, MUM_RELEASE);
+							segment = first;
+						} else {
+							mu_free(first);
+							position = mum_atomic_load64(&c->tail, MUM_ACQUIRE);
+							segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->tail_segment, MUM_ACQUIRE);
+							continue;
+						}
+					}
+
+					if (mum_atomic_cas64(&c->tail, &position, position + 1)) {
+						if (offset + 2 == MUM_CHAN_SEGMENT) {
+							mum_atomic_store_ptr(&c->tail_segment, next_segment, MUM_RELEASE);
+							mum_atomic_fetch_add64(&c->tail, 1);
+							mum_atomic_store_ptr(&segment->next, next_segment, MUM_RELEASE);
+							next_segment = 0;
+						}
+
+						uint32_m* state = mum_chan_segment_slot(c, segment, offset);
+						if (c->element_size) {
+							mu_memcpy((uint64_m*)state + 1, value, c->element_size);
+						}
+						// Added rather than stored, as a destroy mark may already be there
+						mum_atomic_fetch_add32(state, MUM_CHAN_SLOT_WRITTEN);
+						if (next_segment) {
+							mu_free(next_segment);
+						}
+						return 1;
+					}
+					segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->tail_segment, MUM_ACQUIRE);
+				}
+			}
+
+			// mum_chan_pop for unbounded channels
+			static muBool mum_chan_list_pop(mum_chan* c, void* value) {
+				uint64_m position = mum_atomic_load64(&c->head, MUM_ACQUIRE);
+				mum_chan_segment* segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->head_segment, MUM_ACQUIRE);
+
+				for (;;) {
+					uint64_m offset = (position & ~MUM_CHAN_AHEAD_BIT) % MUM_CHAN_SEGMENT;
+					if (offset == MUM_CHAN_SEGMENT - 1) {
+						// The receiver of the last slot is moving the head to the next segment
+						mum_cpu_relax();
+						position = mum_atomic_load64(&c->head, MUM_ACQUIRE);
+						segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->head_segment, MUM_ACQUIRE);
+						continue;
+					}
+
+					uint64_m next = position + 1;
+					if (!(next & MUM_CHAN_AHEAD_BIT)) {
+						mum_atomic_fence(MUM_SEQ_CST);
+						uint64_m tail = mum_atomic_load64(&c->tail, MUM_RELAXED) & ~MUM_CHAN_CLOSED_BIT;
+						if (position == tail) {
+							return MU_FALSE;
+						}
+						if (position / MUM_CHAN_SEGMENT != tail / MUM_CHAN_SEGMENT) {
+							next |= MUM_CHAN_AHEAD_BIT;
+						}
+					}
+
+					if (!segment) {
+						// The first segment is still being installed
+						mum_cpu_relax();
+						position = mum_atomic_load64(&c->head, MUM_ACQUIRE);
+						segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->head_segment, MUM_ACQUIRE);
+						continue;
+					}
+
+					if (mum_atomic_cas64(&c->head, &position, next)) {
+						if (offset + 2 == MUM_CHAN_SEGMENT) {
+							mum_chan_segment* next_segment;
+							while ((next_segment = (mum_chan_segment*)mum_atomic_load_ptr(&segment->next, MUM_ACQUIRE)) == 0) {
+								mum_cpu_relax();
+							}
+							uint64_m next_position = (next & ~MUM_CHAN_AHEAD_BIT) + 1;
+							if (mum_atomic_load_ptr(&next_segment->next, MUM_RELAXED)) {
+								next_position |= MUM_CHAN_AHEAD_BIT;
+							}
+							mum_atomic_store_ptr(&c->head_segment, next_segment, MUM_RELEASE);
+							mum_atomic_store64(&c->head, next_position, MUM_RELEASE);
+						}
+
+						uint32_m* state = mum_chan_segment_slot(c, segment, offset);
+						while (!(mum_atomic_load32(state, MUM_ACQUIRE) & MUM_CHAN_SLOT_WRITTEN)) {
+							mum_cpu_relax();
+						}
+						if (value && c->element_size) {
+							mu_memcpy(value, (uint64_m*)state + 1, c->element_size);
+						}
+
+						if (offset + 2 == MUM_CHAN_SEGMENT) {
+							mum_chan_segment_destroy(c, segment, 0);
+						} else if (mum_atomic_fetch_add32(state, MUM_CHAN_SLOT_READ) & MUM_CHAN_SLOT_DESTROY) {
+							mum_chan_segment_destroy(c, segment, offset + 1);
+						}
+						return MU_TRUE;
+					}
+					segment = (mum_chan_segment*)mum_atomic_load_ptr(&c->head_segment, MUM_ACQUIRE);
+				}
+			}
+
+			// Returns 1 if the value was put in the buffer, 0 if it's full, and -1 if the channel is
+			// closed
+			static int mum_chan_push(mum_chan* c, const void* value) {
+				if (c->capacity == MUM_CHAN_UNBOUNDED) {
+					return mum_chan_list_push(c, value);
+				}
+
+				uint64_m position = mum_atomic_load64(&c->tail, MUM_RELAXED);
+				for (;;) {
+					if (position & MUM_CHAN_CLOSED_BIT) {
+						return -1;
+					}
+					if (c->capacity == 0) {
+						return 0;
+					}
+
+					uint64_m* slot = mum_chan_slot(c, position);
+					uint64_m lap = (position / c->capacity) * 2;
+					uint64_m seq = mum_atomic_load64(slot, MUM_ACQUIRE);
+					if (seq == lap) {
+						if (mum_atomic_cas64(&c->tail, &position, position + 1)) {
+							if (c->element_size) {
+								mu_memcpy(slot + 1, value, c->element_size);
+							}
+							mum_atomic_store64(slot, lap + 1, MUM_RELEASE);
+							return 1;
+						}
+					} else if ((int64_m)(seq - lap) < 0) {
+						// Still holds the value from the last lap
+						return 0;
+					} else {
+						position = mum_atomic_load64(&c->tail, MUM_RELAXED);
+					}
+				}
+			}
+
+			static muBool mum_chan_pop(mum_chan* c, void* value) {
+				if (c->capacity == 0) {
+					return MU_FALSE;
+				}
+				if (c->capacity == MUM_CHAN_UNBOUNDED) {
+					return mum_chan_list_pop(c, value);
+				}
+
+				uint64_m position = mum_atomic_load64(&c->head, MUM_RELAXED);
+				for (;;) {
+					uint64_m* slot = mum_chan_slot(c, position);
+					uint64_m lap = (position / c->capacity) * 2;
+					uint64_m seq = mum_atomic_load64(slot, MUM_ACQUIRE);
+					if (seq == lap + 1) {
+						if (mum_atomic_cas64(&c->head, &position, position + 1)) {
+							if (value && c->element_size) {
+								mu_memcpy(value, slot + 1, c->element_size);
+							}
+							mum_atomic_store64(slot, lap + 2, MUM_RELEASE);
+							return MU_TRUE;
+						}
+					} else if ((int64_m)(seq - (lap + 1)) < 0) {
+						return MU_FALSE;
+					} else {
+						position = mum_atomic_load64(&c->head, MUM_RELAXED);
+					}
+				}
+			}
+
+			static void mum_chan_enqueue(struct mum_chan_queue* q, mum_chan_waiter* w) {
+				w->prev = q->tail;
+				w->next = 0;
+				if (q->tail) {
+					q->tail->next = w;
+				} else {
+					q->head = w;
+				}
+				q->tail = w;
+				w->queued = MU_TRUE;
+				mum_atomic_fetch_add32(&q->count, 1);
+			}
+
+			static void mum_chan_dequeue(struct mum_chan_queue* q, mum_chan_waiter* w) {
+				if (w->prev) {
+					w->prev->next = w->next;
+				} else {
+					q->head = w->next;
+				}
+				if (w->next) {
+					w->next->prev = w->prev;
+				} else {
+					q->tail = w->prev;
+				}
+				w->queued = MU_FALSE;
+				mum_atomic_fetch_sub32(&q->count, 1);
+			}
+
+			// Takes the first waiter that can still be claimed off a locked queue, and claims it.
+			// Waiters sharing the state word own are skipped, and any already claimed through
+			// another channel, or that gave up, are dropped along the way.
+			static mum_chan_waiter* mum_chan_claim(struct mum_chan_queue* q, uint32_m* own) {
+				mum_chan_waiter* w = q->head;
+				while (w) {
+					mum_chan_waiter* next = w->next;
+					if (w->state != own) {
+						mum_chan_dequeue(q, w);
+						uint32_m expected = MUM_CHAN_WAITING;
+						if (mum_atomic_cas32(w->state, &expected, MUM_CHAN_BUSY)) {
+							return w;
+						}
+					}
+					w = next;
+				}
+				return 0;
+			}
+
+			// The waiter's owner can return as soon as the state is stored, so the waiter can't be
+			// touched afterwards
+			static void mum_chan_finish(mum_chan_waiter* w, uint32_m outcome) {
+				uint32_m* state = w->state;
+				mum_atomic_store32(state, outcome | (w->index << 3), MUM_RELEASE);
+				mum_futex_wake(state, MU_FALSE);
+			}
+
+			// Wakes a waiter up to try again, after the buffer changed under it
+			static void mum_chan_nudge(mum_chan* c, struct mum_chan_queue* q, uint32_m* own, muBool locked) {
+				mum_atomic_fence(MUM_SEQ_CST);
+				if (mum_atomic_load32(&q->count, MUM_RELAXED) == 0) {
+					return;
+				}
+
+				if (!locked) {
+					mum_lock_acquire(&c->lock);
+				}
+				mum_chan_waiter* w = mum_chan_claim(q, own);
+				if (w) {
+					mum_chan_finish(w, MUM_CHAN_FINISHED_RETRY);
+				}
+				if (!locked) {
+					mum_lock_release(&c->lock);
+				}
+			}
+
+			// Tries to do a case without blocking. Without the lock, it's only taken if there are
+			// waiters to hand a value to or take one from; own is the state word of the calling
+			// thread's waiters, if any are queued.
+			static mumChanStatus mum_chan_try(mum_chan* c, muChanCase* k, uint32_m* own, muBool locked) {
+				if (k->send) {
+					if (mum_atomic_load32(&c->receivers.count, MUM_SEQ_CST) != 0) {
+						if (!locked) {
+							mum_lock_acquire(&c->lock);
+							mumChanStatus status = mum_chan_try(c, k, own, MU_TRUE);
+							mum_lock_release(&c->lock);
+							return status;
+						}
+						if (!(mum_atomic_load64(&c->tail, MUM_RELAXED) & MUM_CHAN_CLOSED_BIT)) {
+							mum_chan_waiter* w = mum_chan_claim(&c->receivers, own);
+							if (w) {
+								if (w->value && c->element_size) {
+									mu_memcpy(w->value, k->value, c->element_size);
+								}
+								mum_chan_finish(w, MUM_CHAN_FINISHED_OK);
+								return MUM_CHAN_OK;
+							}
+						}
+					}
+
+					int pushed = mum_chan_push(c, k->value);
+					if (pushed < 0) {
+						return MUM_CHAN_CLOSED;
+					}
+					if (pushed == 0) {
+						return MUM_CHAN_WOULD_BLOCK;
+					}
+					mum_chan_nudge(c, &c->receivers, own, locked);
+					return MUM_CHAN_OK;
+				}
+
+				for (;;) {
+					if (mum_chan_pop(c, k->value)) {
+						mum_chan_nudge(c, &c->senders, own, locked);
+						return MUM_CHAN_OK;
+					}
+
+					if (mum_atomic_load32(&c->senders.count, MUM_SEQ_CST) != 0) {
+						if (!locked) {
+							mum_lock_acquire(&c->lock);
+							mumChanStatus status = mum_chan_try(c, k, own, MU_TRUE);
+							mum_lock_release(&c->lock);
+							return status;
+						}
+						mum_chan_waiter* w = mum_chan_claim(&c->senders, own);
+						if (w) {
+							if (k->value && c->element_size) {
+								mu_memcpy(k->value, w->value, c->element_size);
+							}
+							mum_chan_finish(w, MUM_CHAN_FINISHED_OK);
+							return MUM_CHAN_OK;
+						}
+					}
+
+					uint64_m tail = mum_atomic_load64(&c->tail, MUM_SEQ_CST);
+					if (!(tail & MUM_CHAN_CLOSED_BIT)) {
+						return MUM_CHAN_WOULD_BLOCK;
+					}
+					if ((mum_atomic_load64(&c->head, MUM_SEQ_CST) & ~MUM_CHAN_AHEAD_BIT) == (tail & ~MUM_CHAN_CLOSED_BIT)) {
+						return MUM_CHAN_CLOSED;
+					}
+					// Closed, but a value sent just before is still being put in the buffer
+					mum_cpu_relax();
+				}
+			}
+
+			// Channels are locked in order of address, so that selects can't deadlock each other;
+			// order is sorted, and may have the same channel several times in a row
+			static void mum_chan_lock_all(mum_chan** order, size_m count) {
+				for (size_m i = 0; i < count; i++) {
+					if (i == 0 || order[i] != order[i - 1]) {
+						mum_lock_acquire(&order[i]->lock);
+					}
+				}
+			}
+
+			static void mum_chan_unlock_all(mum_chan** order, size_m count) {
+				for (size_m i = 0; i < count; i++) {
+					if (i == 0 || order[i] != order[i - 1]) {
+						mum_lock_release(&order[i]->lock);
+					}
+				}
+			}
+
+			// Takes the waiters still queued off their queues, with their channels locked
+			static void mum_chan_dequeue_all(muChanCase* cases, mum_chan_waiter* waiters, size_m count) {
+				for (size_m i = 0; i < count; i++) {
+					if (waiters[i].queued) {
+						mum_chan* c = (mum_chan*)cases[i].chan;
+						mum_chan_dequeue(cases[i].send ? &c->senders : &c->receivers, &waiters[i]);
+					}
+				}
+			}
+
+			// Waits in the way of the idle strategy until a waiter is finished, or the deadline
+			// passes, or a stop is requested for the calling thread; returns the final state
+			static uint32_m mum_chan_wait(mum_idle* idle, uint32_m* state, uint64_m deadline) {
+				struct mum_idle_state st;
+				st.phase = MUM_IDLE_PHASE_NONE;
+
+				for (;;) {
+					uint32_m s = mum_atomic_load32(state, MUM_ACQUIRE);
+					if (s & MUM_CHAN_FINISHED) {
+						mum_idle_end(idle, &st);
+						return s;
+					}
+
+					uint64_m wait = mum_idle_park_ns(idle);
+					// Once claimed, it's only a copy away from being finished
+					if (s == MUM_CHAN_WAITING && mum_stop_requested_self()) {
+						uint32_m expected = MUM_CHAN_WAITING;
+						if (mum_atomic_cas32(state, &expected, MUM_CHAN_GAVE_UP_STOPPED)) {
+							mum_idle_end(idle, &st);
+							return MUM_CHAN_GAVE_UP_STOPPED;
+						}
+						continue;
+					}
+					if (s == MUM_CHAN_WAITING && deadline != MUM_NO_TIMEOUT) {
+						uint64_m time = mum_time_ns();
+						if (time >= deadline) {
+							uint32_m expected = MUM_CHAN_WAITING;
+							if (mum_atomic_cas32(state, &expected, MUM_CHAN_GAVE_UP)) {
+								mum_idle_end(idle, &st);
+								return MUM_CHAN_GAVE_UP;
+							}
+							continue;
+						}
+						if (deadline - time < wait) {
+							wait = deadline - time;
+						}
+					}
+					if (mum_idle_step(idle, &st)) {
+						mum_park_stoppable(state, s, wait);
+					}
+				}
+			}
+
+			MUDEF muChan mu_chan_create_(mumResult* result, size_m element_size, size_m capacity) {
+				mum_chan* c = (mum_chan*)mu_malloc(sizeof(mum_chan));
+				if (!c) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+
+				c->element_size = element_size;
+				c->capacity = capacity;
+				c->stride = (sizeof(uint64_m) + element_size + sizeof(uint64_m) - 1) & ~(sizeof(uint64_m) - 1);
+				c->slots = 0;
+				if (capacity && capacity != MUM_CHAN_UNBOUNDED) {
+					c->slots = (uint8_m*)mu_malloc(capacity * c->stride);
+					if (!c->slots) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						mu_free(c);
+						return 0;
+					}
+					for (size_m i = 0; i < capacity; i++) {
+						*(uint64_m*)(c->slots + i * c->stride) = 0;
+					}
+				}
+
+				c->head = 0;
+				c->head_segment = 0;
+				c->tail = 0;
+				c->tail_segment = 0;
+				c->lock = 0;
+				c->senders.head = c->senders.tail = 0;
+				c->senders.count = 0;
+				c->receivers.head = c->receivers.tail = 0;
+				c->receivers.count = 0;
+				c->idle = 0;
+				return c;
+			}
+
+			MUDEF muChan mu_chan_destroy_(mumResult* result, muChan chan) {
+				mum_chan* c = (mum_chan*)chan;
+				if (c->slots) {
+					mu_free(c->slots);
+				}
+				// Segments before the head's have been freed by their readers
+				mum_chan_segment* b = (mum_chan_segment*)c->head_segment;
+				while (b) {
+					mum_chan_segment* next = (mum_chan_segment*)b->next;
+					mu_free(b);
+					b = next;
+				}
+				mu_free(c);
+
+				return 0; if (result) {}
+			}
+
+			// Picks which case to try first, so that none is always beaten by the ones before it
+			static size_m mum_chan_start(size_m case_count) {
+				if (case_count == 1) {
+					return 0;
+				}
+				uint32_m random = mum_chan_random;
+				if (!random) {
+					random = (uint32_m)mum_time_ns() | 1;
+				}
+				random ^= random << 13;
+				random ^= random >> 17;
+				random ^= random << 5;
+				mum_chan_random = random;
+				return (size_m)random % case_count;
+			}
+
+			// Tries every case once, without queueing
+			static mumChanStatus mum_chan_try_all(muChanCase* cases, size_m case_count, size_m* index) {
+				size_m start = mum_chan_start(case_count);
+				for (size_m i = 0; i < case_count; i++) {
+					size_m k = (start + i) % case_count;
+					mumChanStatus status = mum_chan_try((mum_chan*)cases[k].chan, &cases[k], 0, MU_FALSE);
+					if (status != MUM_CHAN_WOULD_BLOCK) {
+						*index = k;
+						return status;
+					}
+				}
+				return MUM_CHAN_WOULD_BLOCK;
+			}
+
+			// Combines the idle strategies of the cases' channels: it parks straight away if any of
+			// them would, and otherwise waits in the way of the one with the shortest spin phase
+			static mum_idle* mum_chan_select_idle(muChanCase* cases, size_m case_count) {
+				mum_idle* best = 0;
+				for (size_m i = 0; i < case_count; i++) {
+					mum_idle* idle = (mum_idle*)mum_atomic_load_ptr(&((mum_chan*)cases[i].chan)->idle, MUM_RELAXED);
+					if (!idle || idle->kind == MUM_IDLE_PARK) {
+						return 0;
+					}
+					// Spinning without end is the longest spin phase there is
+					if (!best || (best->kind == MUM_IDLE_SPIN && idle->kind != MUM_IDLE_SPIN)
+						|| (idle->kind != MUM_IDLE_SPIN && idle->spin_ns < best->spin_ns)) {
+						best = idle;
+					}
+				}
+				return best;
+			}
+
+			// Queues a waiter for every case and sleeps, until one of them is done; order is the
+			// cases' channels, sorted
+			static mumChanStatus mum_chan_block(muChanCase* cases, size_m case_count, uint64_m deadline, size_m* index, mum_chan_waiter* waiters, mum_chan** order) {
+				for (;;) {
+					if (deadline != MUM_NO_TIMEOUT && mum_time_ns() >= deadline) {
+						return MUM_CHAN_TIMEOUT;
+					}
+
+					// Try every case again before sleeping, now that no other thread can do any of
+					// them without seeing the waiters
+					uint32_m state = MUM_CHAN_WAITING;
+					mum_chan_lock_all(order, case_count);
+					for (size_m i = 0; i < case_count; i++) {
+						mum_chan* c = (mum_chan*)cases[i].chan;
+						waiters[i].value = cases[i].value;
+						waiters[i].state = &state;
+						waiters[i].index = (uint32_m)i;
+						mum_chan_enqueue(cases[i].send ? &c->senders : &c->receivers, &waiters[i]);
+					}
+					mum_atomic_fence(MUM_SEQ_CST);
+
+					size_m start = mum_chan_start(case_count);
+					for (size_m i = 0; i < case_count; i++) {
+						size_m k = (start + i) % case_count;
+						mumChanStatus status = mum_chan_try((mum_chan*)cases[k].chan, &cases[k], &state, MU_TRUE);
+						if (status != MUM_CHAN_WOULD_BLOCK) {
+							mum_chan_dequeue_all(cases, waiters, case_count);
+							mum_chan_unlock_all(order, case_count);
+							*index = k;
+							return status;
+						}
+					}
+					mum_chan_unlock_all(order, case_count);
+
+					mum_idle* idle = mum_chan_select_idle(cases, case_count);
+					uint32_m outcome = mum_chan_wait(idle, &state, deadline);
+					// Whoever finished a waiter took it off its queue, but the others are still on
+					// theirs
+					if (case_count > 1 || outcome == MUM_CHAN_GAVE_UP || outcome == MUM_CHAN_GAVE_UP_STOPPED) {
+						mum_chan_lock_all(order, case_count);
+						mum_chan_dequeue_all(cases, waiters, case_count);
+						mum_chan_unlock_all(order, case_count);
+					}
+
+					if (outcome == MUM_CHAN_GAVE_UP) {
+						return MUM_CHAN_TIMEOUT;
+					}
+					if (outcome == MUM_CHAN_GAVE_UP_STOPPED) {
+						return MUM_CHAN_STOPPED;
+					}
+					if ((outcome & 7) != MUM_CHAN_FINISHED_RETRY) {
+						*index = (size_m)(outcome >> 3);
+						return (outcome & 7) == MUM_CHAN_FINISHED_OK ? MUM_CHAN_OK : MUM_CHAN_CLOSED;
+					}
+
+					mumChanStatus status = mum_chan_try_all(cases, case_count, index);
+					if (status != MUM_CHAN_WOULD_BLOCK) {
+						return status;
+					}
+				}
+			}
+
+			MUDEF mumChanStatus mu_chan_select_(mumResult* result, muChanCase* cases, size_m case_count, int32_m timeout_ms, size_m* index) {
+				if (case_count == 0) {
+					return MUM_CHAN_WOULD_BLOCK;
+				}
+
+				uint64_m deadline = MUM_NO_TIMEOUT;
+				if (timeout_ms > 0) {
+					deadline = mum_time_ns() + (uint64_m)timeout_ms * 1000000;
+				}
+
+				mumChanStatus status = mum_chan_try_all(cases, case_count, index);
+				if (status != MUM_CHAN_WOULD_BLOCK || timeout_ms == 0) {
+					return status;
+				}
+
+				mum_chan_waiter stack_waiters[MUM_CHAN_SELECT_STACK];
+				mum_chan* stack_order[MUM_CHAN_SELECT_STACK];
+				mum_chan_waiter* waiters = stack_waiters;
+				mum_chan** order = stack_order;
+				if (case_count > MUM_CHAN_SELECT_STACK) {
+					waiters = (mum_chan_waiter*)mu_malloc(case_count * (sizeof(mum_chan_waiter) + sizeof(mum_chan*)));
+					if (!waiters) {
+						MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+						return MUM_CHAN_WOULD_BLOCK;
+					}
+					order = (mum_chan**)(waiters + case_count);
+				}
+
+				// Insertion sort, as there are rarely many cases
+				for (size_m i = 0; i < case_count; i++) {
+					mum_chan* c = (mum_chan*)cases[i].chan;
+					size_m j = i;
+					while (j > 0 && (size_m)order[j - 1] > (size_m)c) {
+						order[j] = order[j - 1];
+						j--;
+					}
+					order[j] = c;
+				}
 
-				if (CloseHandle(p->handle) == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_CLOSE_HANDLE)
-					return p;
+				status = mum_chan_block(cases, case_count, deadline, index, waiters, order);
+				if (waiters != stack_waiters) {
+					mu_free(waiters);
 				}
+				return status;
+			}
 
-				mu_free(p);
-				return 0;
+			// A select of a single case
+			static mumChanStatus mum_chan_single(muChan chan, void* value, muBool send, int32_m timeout_ms) {
+				muChanCase k;
+				k.chan = chan;
+				k.value = value;
+				k.send = send;
+				size_m index;
+				return mu_chan_select_(0, &k, 1, timeout_ms, &index);
 			}
 
-			MUDEF void mu_mutex_lock_(mumResult* result, muMutex mutex) {
-				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+			MUDEF mumChanStatus mu_chan_send(muChan chan, const void* value) {
+				return mum_chan_single(chan, (void*)value, MU_TRUE, -1);
+			}
 
-				DWORD wait_result = WaitForSingleObject(p->handle, INFINITE);
+			MUDEF mumChanStatus mu_chan_try_send(muChan chan, const void* value) {
+				return mum_chan_single(chan, (void*)value, MU_TRUE, 0);
+			}
 
-				switch (wait_result) {
-					// The mutex has most likely been closed. This should pretty much never happen with
-					// the way mum is set up, but if it has, that's really bad. Most likely, rather mum
-					// is not working as intended at all, or the user has modified things that they
-					// shouldn't.
-					case WAIT_FAILED: {
-						MU_SET_RESULT(result, MUM_MUTEX_WAIT_FAILED)
-					} break;
+			MUDEF mumChanStatus mu_chan_send_timed(muChan chan, const void* value, int32_m timeout_ms) {
+				return mum_chan_single(chan, (void*)value, MU_TRUE, timeout_ms);
+			}
 
-					// The thread holding the mutex has died. This can be due to a few things:
-					// * The thread crashed or otherwise imploded in on itself.
-					// * The user has fiddled around with values they shouldn't.
-					// Either way, this is REALLY, REALLY bad, and will lead to sporadic random bugs &
-					// crashes.
-					// Note: we still have ownership due to this, but ehhhhh.
-					// https://devblogs.microsoft.com/oldnewthing/20050912-14/?p=34253
-					// (Raymond Chen is awesome btw)
-					case WAIT_ABANDONED: {
-						MU_SET_RESULT(result, MUM_MUTEX_WAIT_ABANDONED)
-					} break;
-				}
+			MUDEF mumChanStatus mu_chan_recv(muChan chan, void* value) {
+				return mum_chan_single(chan, value, MU_FALSE, -1);
 			}
 
-			MUDEF void mu_mutex_unlock_(mumResult* result, muMutex mutex) {
-				mum_win32_mutex* p = (mum_win32_mutex*)mutex;
+			MUDEF mumChanStatus mu_chan_try_recv(muChan chan, void* value) {
+				return mum_chan_single(chan, value, MU_FALSE, 0);
+			}
 
-				if (ReleaseMutex(p->handle) == 0) {
-					MU_SET_RESULT(result, MUM_FAILED_RELEASE_MUTEX)
+			MUDEF mumChanStatus mu_chan_recv_timed(muChan chan, void* value, int32_m timeout_ms) {
+				return mum_chan_single(chan, value, MU_FALSE, timeout_ms);
+			}
+
+			MUDEF void mu_chan_set_idle(muChan chan, muIdleStrategy strategy) {
+				mum_atomic_store_ptr(&((mum_chan*)chan)->idle, strategy, MUM_RELAXED);
+			}
+
+			MUDEF void mu_chan_close(muChan chan) {
+				mum_chan* c = (mum_chan*)chan;
+
+				mum_lock_acquire(&c->lock);
+				uint64_m tail = mum_atomic_load64(&c->tail, MUM_RELAXED);
+				while (!(tail & MUM_CHAN_CLOSED_BIT) && !mum_atomic_cas64(&c->tail, &tail, tail | MUM_CHAN_CLOSED_BIT)) {}
+
+				// Everyone waiting tries again, finding the channel closed, or values still in it
+				mum_chan_waiter* w;
+				while ((w = mum_chan_claim(&c->senders, 0)) != 0) {
+					mum_chan_finish(w, MUM_CHAN_FINISHED_RETRY);
+				}
+				while ((w = mum_chan_claim(&c->receivers, 0)) != 0) {
+					mum_chan_finish(w, MUM_CHAN_FINISHED_RETRY);
 				}
+				mum_lock_release(&c->lock);
 			}
 
-		/* Spinlock */
+		/* Shard executor */
+
+			// The ring from shard i to shard j is rings[i * count + j]. Only shard i writes its tail
+			// and only shard j its head, each on its own cache line; the sender also keeps, on its
+			// own line, how far it has written (next_tail) and the last head it saw, so that it only
+			// reads the receiver's line once the ring looks full. Tails are published, and
+			// receivers rung, once per pass of the sender's loop, for the rings in its dirty list.
+			//
+			// To know when everything has been run, each shard counts what it has sent and what it
+			// has run, publishing both once per pass, sent before run and before the tasks sent are
+			// visible; tasks sent from outside are counted in one shared counter. If the sum of what
+			// has been run, read first, equals the sum of what has been sent, read after, nothing was
+			// in flight at the time the first sum was read, since a task that's running hasn't been
+			// counted as run yet. Shards bump idle_epoch when they go to sleep for waiters to check.
+
+			#define MUM_SHARD_DEFAULT_RING 1024
+			// The most tasks run from one ring before moving on to the next
+			#define MUM_SHARD_BATCH 64
+
+			struct mum_shard_message {
+				void (*task)(void* args);
+				void* args;
+			};
 
-			struct mum_win32_spinlock {
-				LONG volatile locked;
+			// Sent through a shard's list
+			struct mum_shard_task {
+				struct mum_shard_task* next;
+				void (*task)(void* args);
+				void* args;
 			};
-			typedef struct mum_win32_spinlock mum_win32_spinlock;
+			typedef struct mum_shard_task mum_shard_task;
+
+			struct mum_shard_ring {
+				// Written by the sender, read by the receiver
+				uint32_m tail;
+				uint8_m pad0[MUM_CACHE_LINE - sizeof(uint32_m)];
+				// Only touched by the sender
+				uint32_m next_tail;
+				uint32_m head_seen;
+				uint8_m pad1[MUM_CACHE_LINE - 2 * sizeof(uint32_m)];
+				// Written by the receiver, read by the sender
+				uint32_m head;
+				uint8_m pad2[MUM_CACHE_LINE - sizeof(uint32_m)];
+			};
+			typedef struct mum_shard_ring mum_shard_ring;
+
+			struct mum_shard_executor;
+
+			struct mum_shard_worker {
+				// Written by other threads
+				void* volatile list;
+				uint32_m doorbell;
+				uint32_m sleeping;
+				uint8_m pad0[MUM_CACHE_LINE - sizeof(void*) - 2 * sizeof(uint32_m)];
+
+				// Written by the shard itself
+				uint64_m sent;
+				uint64_m run;
+				uint32_m unpublished;
+				uint32_m dirty_count;
+				uint32_m* dirty;
+				struct mum_shard_executor* executor;
+				uint32_m index;
+				muThread thread;
+				uint8_m pad1[MUM_CACHE_LINE];
+			};
+			typedef struct mum_shard_worker mum_shard_worker;
+
+			struct mum_shard_executor {
+				mum_shard_worker* shards;
+				uint32_m count;
+				uint32_m mask;
+				mum_shard_ring* rings;
+				struct mum_shard_message* slots;
+				uint32_m* dirty;
+				uint32_m stopping;
+				uint32_m idle_epoch;
+				uint32_m waiters;
+				// The idle strategy of shards with nothing to do
+				void* volatile idle;
+				uint8_m pad[MUM_CACHE_LINE];
+				uint64_m external_sent;
+			};
+			typedef struct mum_shard_executor mum_shard_executor;
 
-			MUDEF muSpinlock mu_spinlock_create_(mumResult* result) {
-				mum_win32_spinlock* p = (mum_win32_spinlock*)mu_malloc(sizeof(mum_win32_spinlock));
-				if (!p) {
-					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
-					return 0;
+			static MUM_THREAD_LOCAL mum_shard_worker* mum_shard_self = 0;
+
+			static inline void mum_shard_ring_bell(mum_shard_worker* s) {
+				mum_atomic_fetch_add32(&s->doorbell, 1);
+				if (mum_atomic_load32(&s->sleeping, MUM_SEQ_CST)) {
+					mum_futex_wake(&s->doorbell, MU_FALSE);
 				}
+			}
 
-				p->locked = 0;
-				return p;
+			static inline void mum_shard_list_push(mum_shard_worker* s, mum_shard_task* t) {
+				void* head = mum_atomic_load_ptr(&s->list, MUM_RELAXED);
+				do {
+					t->next = (mum_shard_task*)head;
+				} while (!mum_atomic_cas_ptr(&s->list, &head, t));
 			}
 
-			MUDEF muSpinlock mu_spinlock_destroy_(mumResult* result, muSpinlock spinlock) {
-				mu_free(spinlock);
-				return 0; if (result) {}
+			// Counts what this shard has sent, then makes it visible and rings the receivers
+			static void mum_shard_publish(mum_shard_worker* s) {
+				mum_shard_executor* e = s->executor;
+				if (s->unpublished == 0) {
+					return;
+				}
+				mum_atomic_store64(&s->sent, s->sent + s->unpublished, MUM_SEQ_CST);
+				s->unpublished = 0;
+
+				for (uint32_m i = 0; i < s->dirty_count; i++) {
+					uint32_m to = s->dirty[i];
+					mum_shard_ring* r = &e->rings[s->index * e->count + to];
+					mum_atomic_store32(&r->tail, r->next_tail, MUM_RELEASE);
+					if (to != s->index) {
+						mum_shard_ring_bell(&e->shards[to]);
+					}
+				}
+				s->dirty_count = 0;
 			}
 
-			MUDEF void mu_spinlock_lock_(mumResult* result, muSpinlock spinlock) {
-				mum_win32_spinlock* p = (mum_win32_spinlock*)spinlock;
+			// Runs what's been sent to a shard, and returns how many tasks it ran
+			static uint32_m mum_shard_drain(mum_shard_worker* s) {
+				mum_shard_executor* e = s->executor;
+				uint32_m ran = 0;
+
+				// The list is pushed onto at the front, so reverse it to run it in order
+				mum_shard_task* list = 0;
+				if (mum_atomic_load_ptr(&s->list, MUM_RELAXED)) {
+					mum_shard_task* t = (mum_shard_task*)mum_atomic_exchange_ptr(&s->list, 0);
+					while (t) {
+						mum_shard_task* next = t->next;
+						t->next = list;
+						list = t;
+						t = next;
+					}
+				}
+				while (list) {
+					mum_shard_task* next = list->next;
+					list->task(list->args);
+					mu_free(list);
+					list = next;
+					ran++;
+				}
+
+				for (uint32_m from = 0; from < e->count; from++) {
+					mum_shard_ring* r = &e->rings[from * e->count + s->index];
+					struct mum_shard_message* slots = &e->slots[(size_m)(from * e->count + s->index) * (e->mask + 1)];
+					uint32_m head = r->head;
+					uint32_m tail = mum_atomic_load32(&r->tail, MUM_ACQUIRE);
+					if (head == tail) {
+						continue;
+					}
 
-				while (InterlockedCompareExchange(&p->locked, 1, 0) == 1) {}
+					uint32_m end = tail - head > MUM_SHARD_BATCH ? head + MUM_SHARD_BATCH : tail;
+					while (head != end) {
+						// The slot isn't given back until the head is published below
+						struct mum_shard_message m = slots[head & e->mask];
+						m.task(m.args);
+						head++;
+						ran++;
+					}
+					mum_atomic_store32(&r->head, head, MUM_RELEASE);
+				}
 
-				return; if (result) {}
+				mum_shard_publish(s);
+				if (ran) {
+					mum_atomic_store64(&s->run, s->run + ran, MUM_SEQ_CST);
+				}
+				return ran;
 			}
 
-			MUDEF void mu_spinlock_unlock_(mumResult* result, muSpinlock spinlock) {
-				mum_win32_spinlock* p = (mum_win32_spinlock*)spinlock;
+			// Lets mu_shard_executor_wait check again whether everything has been run
+			static inline void mum_shard_went_idle(mum_shard_executor* e) {
+				mum_atomic_fetch_add32(&e->idle_epoch, 1);
+				if (mum_atomic_load32(&e->waiters, MUM_SEQ_CST)) {
+					mum_futex_wake(&e->idle_epoch, MU_TRUE);
+				}
+			}
 
-				_interlockedbittestandreset(&p->locked, 0);
+			static void mum_shard_main(void* args) {
+				mum_shard_worker* s = (mum_shard_worker*)args;
+				mum_shard_executor* e = s->executor;
+				mum_shard_self = s;
+
+				// The strategy the shard is idle with, if it's idle
+				mum_idle* idle = 0;
+				struct mum_idle_state st;
+				st.phase = MUM_IDLE_PHASE_NONE;
+
+				for (;;) {
+					uint32_m bell = mum_atomic_load32(&s->doorbell, MUM_SEQ_CST);
+					if (mum_shard_drain(s)) {
+						mum_idle_end(idle, &st);
+						continue;
+					}
+					if (mum_atomic_load32(&e->stopping, MUM_ACQUIRE)) {
+						break;
+					}
 
-				return; if (result) {}
-			}
+					// Keep polling for as long as the strategy spins or yields
+					if (st.phase == MUM_IDLE_PHASE_NONE) {
+						idle = (mum_idle*)mum_atomic_load_ptr(&e->idle, MUM_RELAXED);
+						if (idle) {
+							mum_shard_went_idle(e);
+						}
+					}
+					if (!mum_idle_step(idle, &st)) {
+						continue;
+					}
 
-	#endif
+					mum_atomic_store32(&s->sleeping, 1, MUM_SEQ_CST);
+					mum_shard_went_idle(e);
+					if (mum_atomic_load32(&s->doorbell, MUM_SEQ_CST) == bell) {
+						mum_futex_wait(&s->doorbell, bell, mum_idle_park_ns(idle));
+					}
+					mum_atomic_store32(&s->sleeping, 0, MUM_RELAXED);
+				}
 
-	/* Unix */
+				mum_idle_end(idle, &st);
+				mum_shard_self = 0;
+			}
 
-	#ifdef MU_UNIX
+			static muBool mum_shard_executor_quiet(mum_shard_executor* e) {
+				uint64_m run = 0;
+				for (uint32_m i = 0; i < e->count; i++) {
+					run += mum_atomic_load64(&e->shards[i].run, MUM_SEQ_CST);
+				}
+				uint64_m sent = mum_atomic_load64(&e->external_sent, MUM_SEQ_CST);
+				for (uint32_m i = 0; i < e->count; i++) {
+					sent += mum_atomic_load64(&e->shards[i].sent, MUM_SEQ_CST);
+				}
+				return run == sent;
+			}
 
-		#include <pthread.h>
+			static void mum_shard_executor_free(mum_shard_executor* e) {
+				mu_free(e->slots);
+				mu_free(e->rings);
+				mu_free(e->dirty);
+				mu_free(e->shards);
+				mu_free(e);
+			}
 
-		/* Thread */
+			static void mum_shard_executor_stop(mum_shard_executor* e, uint32_m started) {
+				mum_atomic_store32(&e->stopping, 1, MUM_SEQ_CST);
+				for (uint32_m i = 0; i < started; i++) {
+					mum_shard_ring_bell(&e->shards[i]);
+				}
+				for (uint32_m i = 0; i < started; i++) {
+					mumResult thread_result = MUM_SUCCESS;
+					mu_thread_destroy_mode_(&thread_result, e->shards[i].thread, MUM_THREAD_DESTROY_JOIN);
+				}
+			}
 
-			struct mum_unix_thread {
-				pthread_t thread;
-				void* ret;
-			};
-			typedef struct mum_unix_thread mum_unix_thread;
+			MUDEF muShardExecutor mu_shard_executor_create_(mumResult* result, const uint32_m* cpus, uint32_m shard_count, uint32_m ring_size) {
+				uint32_m cpu_count = mu_topology_cpu_count();
+				if (shard_count == 0) {
+					shard_count = cpus ? 0 : cpu_count;
+				}
+				for (uint32_m i = 0; i < shard_count; i++) {
+					if ((cpus ? cpus[i] : i) >= cpu_count) {
+						MU_SET_RESULT(result, MUM_INVALID_INDEX)
+						return 0;
+					}
+				}
 
-			MUDEF muThread mu_thread_create_(mumResult* result, void (*start)(void* args), void* args) {
-				mum_unix_thread* p = (mum_unix_thread*)mu_malloc(sizeof(mum_unix_thread));
-				if (!p) {
+				uint32_m size = 2;
+				while (size < (ring_size ? ring_size : MUM_SHARD_DEFAULT_RING)) {
+					size *= 2;
+				}
+
+				mum_shard_executor* e = (mum_shard_executor*)mu_malloc(sizeof(mum_shard_executor));
+				if (!e) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return 0;
+				}
+				size_m pairs = (size_m)shard_count * shard_count;
+				e->shards = (mum_shard_worker*)mu_malloc(sizeof(mum_shard_worker) * shard_count);
+				e->rings = (mum_shard_ring*)mu_malloc(sizeof(mum_shard_ring) * pairs);
+				e->slots = (struct mum_shard_message*)mu_malloc(sizeof(struct mum_shard_message) * pairs * size);
+				e->dirty = (uint32_m*)mu_malloc(sizeof(uint32_m) * pairs);
+				if (!e->shards || !e->rings || !e->slots || !e->dirty) {
 					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					mum_shard_executor_free(e);
 					return 0;
 				}
 
-				// Memcpy cuz C compilers are dumb
-				void* (*func)(void*);
-				mu_memcpy(&func, &start, sizeof(void*));
+				e->count = shard_count;
+				e->mask = size - 1;
+				e->stopping = 0;
+				e->idle_epoch = 0;
+				e->waiters = 0;
+				e->idle = 0;
+				e->external_sent = 0;
+				for (size_m i = 0; i < pairs; i++) {
+					e->rings[i].tail = 0;
+					e->rings[i].next_tail = 0;
+					e->rings[i].head_seen = 0;
+					e->rings[i].head = 0;
+				}
+				for (uint32_m i = 0; i < shard_count; i++) {
+					mum_shard_worker* s = &e->shards[i];
+					s->list = 0;
+					s->doorbell = 0;
+					s->sleeping = 0;
+					s->sent = 0;
+					s->run = 0;
+					s->unpublished = 0;
+					s->dirty_count = 0;
+					s->dirty = &e->dirty[(size_m)i * shard_count];
+					s->executor = e;
+					s->index = i;
+					s->thread = 0;
+				}
 
-				if (pthread_create(&p->thread, 0, func, args) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_CREATE)
-					mu_free(p);
-					return 0;
+				for (uint32_m i = 0; i < shard_count; i++) {
+					mumResult thread_result = MUM_SUCCESS;
+					e->shards[i].thread = mu_thread_create_on_cpu_(&thread_result, mum_shard_main, &e->shards[i], cpus ? cpus[i] : i);
+					// Pinning is only an optimization, so where it isn't available, the shard just
+					// runs unpinned
+					if (thread_result == MUM_FAILED_PTHREAD_SETAFFINITY) {
+						thread_result = MUM_SUCCESS;
+						e->shards[i].thread = mu_thread_create_(&thread_result, mum_shard_main, &e->shards[i]);
+					}
+					if (thread_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, thread_result)
+						mum_shard_executor_stop(e, i);
+						mum_shard_executor_free(e);
+						return 0;
+					}
 				}
 
-				return (muThread)p;
+				return e;
 			}
 
-			MUDEF muThread mu_thread_destroy_(mumResult* result, muThread thread) {
-				mum_unix_thread* p = (mum_unix_thread*)thread;
+			MUDEF void mu_shard_executor_set_idle(muShardExecutor executor, muIdleStrategy strategy) {
+				mum_atomic_store_ptr(&((mum_shard_executor*)executor)->idle, strategy, MUM_RELAXED);
+			}
 
-				if (pthread_cancel(p->thread) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_CANCEL)
-					return p;
-				}
+			MUDEF void mu_shard_executor_wait(muShardExecutor executor) {
+				mum_shard_executor* e = (mum_shard_executor*)executor;
 
-				mu_free(p);
-				return 0;
+				for (;;) {
+					uint32_m epoch = mum_atomic_load32(&e->idle_epoch, MUM_SEQ_CST);
+					if (mum_shard_executor_quiet(e)) {
+						return;
+					}
+					// A shard going idle in between changes the epoch, so the wait returns at once
+					mum_atomic_fetch_add32(&e->waiters, 1);
+					mum_futex_wait(&e->idle_epoch, epoch, MUM_NO_TIMEOUT);
+					mum_atomic_fetch_sub32(&e->waiters, 1);
+				}
 			}
 
-			MUDEF void mu_thread_exit(void* ret) {
-				pthread_exit(ret);
+			MUDEF muShardExecutor mu_shard_executor_destroy_(mumResult* result, muShardExecutor executor) {
+				mum_shard_executor* e = (mum_shard_executor*)executor;
+
+				mu_shard_executor_wait(executor);
+				mum_shard_executor_stop(e, e->count);
+				mum_shard_executor_free(e);
+
+				return 0; if (result) {}
 			}
 
-			MUDEF void mu_thread_wait_(mumResult* result, muThread thread) {
-				mum_unix_thread* p = (mum_unix_thread*)thread;
+			MUDEF void mu_shard_submit_(mumResult* result, muShardExecutor executor, uint32_m shard, void (*task)(void* args), void* args) {
+				mum_shard_executor* e = (mum_shard_executor*)executor;
+				if (shard >= e->count) {
+					MU_SET_RESULT(result, MUM_INVALID_INDEX)
+					return;
+				}
 
-				if (pthread_join(p->thread, &p->ret) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_JOIN)
+				mum_shard_worker* self = mum_shard_self;
+				if (self && self->executor == e) {
+					mum_shard_ring* r = &e->rings[self->index * e->count + shard];
+					if (r->next_tail - r->head_seen > e->mask) {
+						r->head_seen = mum_atomic_load32(&r->head, MUM_ACQUIRE);
+					}
+					if (r->next_tail - r->head_seen <= e->mask) {
+						if (r->next_tail == r->tail) {
+							self->dirty[self->dirty_count++] = shard;
+						}
+						struct mum_shard_message* m = &e->slots[(size_m)(self->index * e->count + shard) * (e->mask + 1) + (r->next_tail & e->mask)];
+						m->task = task;
+						m->args = args;
+						r->next_tail++;
+						self->unpublished++;
+						return;
+					}
+				}
+
+				// From outside, or the ring is full
+				mum_shard_task* t = (mum_shard_task*)mu_malloc(sizeof(mum_shard_task));
+				if (!t) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
 					return;
 				}
+				t->task = task;
+				t->args = args;
+
+				// Counted as sent before it can be run
+				if (self && self->executor == e) {
+					mum_atomic_store64(&self->sent, self->sent + 1, MUM_SEQ_CST);
+				} else {
+					mum_atomic_fetch_add64(&e->external_sent, 1);
+				}
+				mum_shard_list_push(&e->shards[shard], t);
+				mum_shard_ring_bell(&e->shards[shard]);
 			}
 
-			MUDEF void* mu_thread_get_return_value_(mumResult* result, muThread thread) {
-				return ((mum_unix_thread*)thread)->ret;
-				if (result) {}
+			MUDEF uint32_m mu_shard_current(muShardExecutor executor) {
+				mum_shard_worker* self = mum_shard_self;
+				if (self && self->executor == (mum_shard_executor*)executor) {
+					return self->index;
+				}
+				return 0xFFFFFFFF;
 			}
 
-		/* Mutex */
-
-			struct mum_unix_mutex {
-				pthread_mutex_t mutex;
+		/* RCU */
+
+			// Readers: each thread has a record on a global list, holding its read section nesting
+			// count in the low bits, and a copy of the grace period phase taken when entering the
+			// outermost section. A grace period flips the phase twice, each time waiting for every
+			// reader still in a section entered under the old phase (one flip isn't enough, as a
+			// reader could have read the phase right before the flip and stored it right after the
+			// wait checked it). This is liburcu's scheme; the fences on the reader's side are
+			// replaced by a process-wide barrier on the writer's side when one's available.
+			// Records of exited threads are reused rather than freed, since the list is walked
+			// without locks.
+
+			#define MUM_RCU_NEST 0xFFFF
+			#define MUM_RCU_PHASE 0x10000
+
+			struct mum_rcu_reader {
+				uint32_m ctr;
+				uint32_m in_use;
+				struct mum_rcu_reader* next;
+				uint8_m pad[MUM_CACHE_LINE];
 			};
-			typedef struct mum_unix_mutex mum_unix_mutex;
+			typedef struct mum_rcu_reader mum_rcu_reader;
 
-			MUDEF muMutex mu_mutex_create_(mumResult* result) {
-				mum_unix_mutex* p = (mum_unix_mutex*)mu_malloc(sizeof(mum_unix_mutex));
-				if (!p) {
-					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
-					return 0;
+			struct mum_rcu_callback {
+				struct mum_rcu_callback* next;
+				void (*func)(void* args);
+				void* args;
+			};
+			typedef struct mum_rcu_callback mum_rcu_callback;
+
+			static void* volatile mum_rcu_readers = 0;
+			static MUM_THREAD_LOCAL mum_rcu_reader* mum_rcu_self = 0;
+			// The count part is always 1, so that readers can copy it as is
+			static uint32_m mum_rcu_gp = 1;
+			static uint32_m mum_rcu_gp_lock = 0;
+
+			// 0 if not set up yet, 1 while being set up, 2 if readers need fences, 3 if not
+			static uint32_m mum_rcu_state = 0;
+
+			// Callbacks waiting for a grace period, the thread that runs them, and how many have
+			// been queued and run in total
+			static void* volatile mum_rcu_queue = 0;
+			static uint32_m mum_rcu_thread_state = 0;
+			static muThread mum_rcu_thread = 0;
+			static uint32_m mum_rcu_wake = 0;
+			static uint32_m mum_rcu_queued = 0;
+			static uint32_m mum_rcu_done = 0;
+
+			static void mum_rcu_init(void) {
+				uint32_m expected = 0;
+				if (mum_atomic_cas32(&mum_rcu_state, &expected, 1)) {
+					mum_atomic_store32(&mum_rcu_state, mum_process_barrier_init() ? 3 : 2, MUM_RELEASE);
+					mum_futex_wake(&mum_rcu_state, MU_TRUE);
+					return;
+				}
+				while (mum_atomic_load32(&mum_rcu_state, MUM_ACQUIRE) == 1) {
+					mum_futex_wait(&mum_rcu_state, 1, MUM_NO_TIMEOUT);
 				}
+			}
 
-				if (pthread_mutex_init(&p->mutex, 0) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_INIT)
-					mu_free(p);
-					return 0;
+			static inline void mum_rcu_reader_fence(void) {
+				if (mum_atomic_load32(&mum_rcu_state, MUM_RELAXED) == 3) {
+					mum_compiler_barrier();
+				} else {
+					mum_atomic_fence(MUM_SEQ_CST);
 				}
+			}
 
-				return (muMutex)p;
+			static void mum_rcu_thread_exit(void* value) {
+				mum_rcu_reader* r = (mum_rcu_reader*)value;
+				if (mum_rcu_self == r) {
+					mum_rcu_self = 0;
+				}
+				mum_atomic_store32(&r->ctr, 0, MUM_RELEASE);
+				mum_atomic_store32(&r->in_use, 0, MUM_RELEASE);
 			}
 
-			MUDEF muMutex mu_mutex_destroy_(mumResult* result, muMutex mutex) {
-				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+			static mum_rcu_reader* mum_rcu_register(void) {
+				mum_rcu_init();
 
-				if (pthread_mutex_destroy(&p->mutex) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_DESTROY)
-					return mutex;
+				mum_rcu_reader* r = (mum_rcu_reader*)mum_atomic_load_ptr(&mum_rcu_readers, MUM_ACQUIRE);
+				for (; r; r = r->next) {
+					uint32_m expected = 0;
+					if (mum_atomic_load32(&r->in_use, MUM_RELAXED) == 0 && mum_atomic_cas32(&r->in_use, &expected, 1)) {
+						break;
+					}
 				}
 
-				mu_free(p);
-				return 0;
+				if (!r) {
+					// With nowhere to record the reader, there's nothing safe to do but spin
+					while ((r = (mum_rcu_reader*)mu_malloc(sizeof(mum_rcu_reader))) == 0) {
+						mum_thread_yield();
+					}
+					r->ctr = 0;
+					r->in_use = 1;
+					void* head = mum_atomic_load_ptr(&mum_rcu_readers, MUM_RELAXED);
+					do {
+						r->next = (mum_rcu_reader*)head;
+					} while (!mum_atomic_cas_ptr(&mum_rcu_readers, &head, r));
+				}
+
+				mum_rcu_self = r;
+				mum_thread_exit_hook_set(MUM_EXIT_HOOK_RCU, r);
+				return r;
 			}
 
-			MUDEF void mu_mutex_lock_(mumResult* result, muMutex mutex) {
-				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+			MUDEF void mu_rcu_read_lock(void) {
+				mum_rcu_reader* r = mum_rcu_self;
+				if (!r) {
+					r = mum_rcu_register();
+				}
 
-				if (pthread_mutex_lock(&p->mutex) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_LOCK)
+				uint32_m ctr = mum_atomic_load32(&r->ctr, MUM_RELAXED);
+				if ((ctr & MUM_RCU_NEST) == 0) {
+					mum_atomic_store32(&r->ctr, mum_atomic_load32(&mum_rcu_gp, MUM_RELAXED), MUM_RELAXED);
+					mum_rcu_reader_fence();
+				} else {
+					mum_atomic_store32(&r->ctr, ctr + 1, MUM_RELAXED);
 				}
 			}
 
-			MUDEF void mu_mutex_unlock_(mumResult* result, muMutex mutex) {
-				mum_unix_mutex* p = (mum_unix_mutex*)mutex;
+			MUDEF void mu_rcu_read_unlock(void) {
+				mum_rcu_reader* r = mum_rcu_self;
+				mum_rcu_reader_fence();
+				mum_atomic_store32(&r->ctr, mum_atomic_load32(&r->ctr, MUM_RELAXED) - 1, MUM_RELAXED);
+			}
 
-				if (pthread_mutex_unlock(&p->mutex) != 0) {
-					MU_SET_RESULT(result, MUM_FAILED_PTHREAD_MUTEX_UNLOCK)
+			MUDEF void mu_rcu_synchronize(void) {
+				mum_rcu_init();
+				mum_lock_acquire(&mum_rcu_gp_lock);
+
+				// Whatever the caller unpublished must be seen before readers are looked at
+				mum_process_barrier();
+
+				for (uint32_m flip = 0; flip < 2; flip++) {
+					uint32_m gp = mum_atomic_load32(&mum_rcu_gp, MUM_RELAXED) ^ MUM_RCU_PHASE;
+					mum_atomic_store32(&mum_rcu_gp, gp, MUM_RELAXED);
+					mum_atomic_fence(MUM_SEQ_CST);
+
+					mum_rcu_reader* r = (mum_rcu_reader*)mum_atomic_load_ptr(&mum_rcu_readers, MUM_ACQUIRE);
+					for (; r; r = r->next) {
+						uint32_m spins = 0;
+						for (;;) {
+							uint32_m ctr = mum_atomic_load32(&r->ctr, MUM_RELAXED);
+							if ((ctr & MUM_RCU_NEST) == 0 || ((ctr ^ gp) & MUM_RCU_PHASE) == 0) {
+								break;
+							}
+							mum_spin_backoff(&spins);
+						}
+					}
+					mum_atomic_fence(MUM_SEQ_CST);
 				}
+
+				// And readers' accesses from before they left must be done before the caller frees
+				mum_process_barrier();
+				mum_lock_release(&mum_rcu_gp_lock);
 			}
 
-		/* Spinlock */
+			static void mum_rcu_thread_main(void* args) {
+				for (;;) {
+					uint32_m wake = mum_atomic_load32(&mum_rcu_wake, MUM_SEQ_CST);
+					mum_rcu_callback* list = (mum_rcu_callback*)mum_atomic_load_ptr(&mum_rcu_queue, MUM_RELAXED);
+					if (!list) {
+						mum_futex_wait(&mum_rcu_wake, wake, MUM_NO_TIMEOUT);
+						continue;
+					}
 
-			struct mum_unix_spinlock {
-				int locked;
-			};
-			typedef struct mum_unix_spinlock mum_unix_spinlock;
+					void* head = list;
+					while (!mum_atomic_cas_ptr(&mum_rcu_queue, &head, 0)) {}
+					list = (mum_rcu_callback*)head;
 
-			MUDEF muSpinlock mu_spinlock_create_(mumResult* result) {
-				mum_unix_spinlock* p = (mum_unix_spinlock*)mu_malloc(sizeof(mum_unix_spinlock));
-				if (!p) {
-					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
-					return 0;
-				}
+					mu_rcu_synchronize();
 
-				p->locked = 0;
-				return (muSpinlock)p;
-			}
+					uint32_m count = 0;
+					while (list) {
+						mum_rcu_callback* next = list->next;
+						list->func(list->args);
+						mu_free(list);
+						list = next;
+						count++;
+					}
 
-			MUDEF muSpinlock mu_spinlock_destroy_(mumResult* result, muSpinlock spinlock) {
-				mu_free(spinlock);
-				return 0; if (result) {}
+					mum_atomic_fetch_add32(&mum_rcu_done, count);
+					mum_futex_wake(&mum_rcu_done, MU_TRUE);
+				}
+				return; if (args) {}
 			}
 
-			static inline muBool mum_atomic_compare_exchange(int* ptr, int compare, int exchange) {
-				return __atomic_compare_exchange_n(ptr, &compare, exchange, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
-			}
+			// Starts the callback thread if it isn't already running
+			static void mum_rcu_thread_start(mumResult* result) {
+				if (mum_atomic_load32(&mum_rcu_thread_state, MUM_ACQUIRE) == 2) {
+					return;
+				}
 
-			MUDEF void mu_spinlock_lock_(mumResult* result, muSpinlock spinlock) {
-				mum_unix_spinlock* p = (mum_unix_spinlock*)spinlock;
+				uint32_m expected = 0;
+				if (mum_atomic_cas32(&mum_rcu_thread_state, &expected, 1)) {
+					mumResult thread_result = MUM_SUCCESS;
+					mum_rcu_thread = mu_thread_create_(&thread_result, mum_rcu_thread_main, 0);
+					if (thread_result != MUM_SUCCESS) {
+						MU_SET_RESULT(result, thread_result)
+						mum_atomic_store32(&mum_rcu_thread_state, 0, MUM_RELEASE);
+					} else {
+						mum_atomic_store32(&mum_rcu_thread_state, 2, MUM_RELEASE);
+					}
+					mum_futex_wake(&mum_rcu_thread_state, MU_TRUE);
+					return;
+				}
 
-				while (!mum_atomic_compare_exchange(&p->locked, 0, 1)) {}
+				while ((expected = mum_atomic_load32(&mum_rcu_thread_state, MUM_ACQUIRE)) == 1) {
+					mum_futex_wait(&mum_rcu_thread_state, 1, MUM_NO_TIMEOUT);
+				}
+				if (expected != 2) {
+					MU_SET_RESULT(result, MUM_FAILED_CREATE_THREAD)
+				}
+			}
 
-				return; if (result) {}
+			MUDEF void mu_rcu_call_(mumResult* result, void (*callback)(void* args), void* args) {
+				mumResult start_result = MUM_SUCCESS;
+				mum_rcu_thread_start(&start_result);
+				if (start_result != MUM_SUCCESS) {
+					MU_SET_RESULT(result, start_result)
+					return;
+				}
+
+				mum_rcu_callback* c = (mum_rcu_callback*)mu_malloc(sizeof(mum_rcu_callback));
+				if (!c) {
+					MU_SET_RESULT(result, MUM_FAILED_ALLOCATE)
+					return;
+				}
+				c->func = callback;
+				c->args = args;
+
+				mum_atomic_fetch_add32(&mum_rcu_queued, 1);
+				void* head = mum_atomic_load_ptr(&mum_rcu_queue, MUM_RELAXED);
+				do {
+					c->next = (mum_rcu_callback*)head;
+				} while (!mum_atomic_cas_ptr(&mum_rcu_queue, &head, c));
+
+				// Only the first callback of a batch needs to wake the thread
+				if (!head) {
+					mum_atomic_fetch_add32(&mum_rcu_wake, 1);
+					mum_futex_wake(&mum_rcu_wake, MU_FALSE);
+				}
 			}
 
-			static inline void mum_atomic_store(int* ptr, int value) {
-				if (value) {}
-				__atomic_store_n(ptr, 0, __ATOMIC_SEQ_CST);
+			static void mum_rcu_free_callback(void* args) {
+				mu_free(args);
 			}
 
-			MUDEF void mu_spinlock_unlock_(mumResult* result, muSpinlock spinlock) {
-				mum_unix_spinlock* p = (mum_unix_spinlock*)spinlock;
+			MUDEF void mu_rcu_free_(mumResult* result, void* ptr) {
+				mu_rcu_call_(result, mum_rcu_free_callback, ptr);
+			}
 
-				mum_atomic_store(&p->locked, 0);
+			MUDEF void mu_rcu_barrier(void) {
+				uint32_m target = mum_atomic_load32(&mum_rcu_queued, MUM_SEQ_CST);
 
-				return; if (result) {}
+				uint32_m done;
+				while ((int32_m)(target - (done = mum_atomic_load32(&mum_rcu_done, MUM_ACQUIRE))) > 0) {
+					mum_futex_wait(&mum_rcu_done, done, MUM_NO_TIMEOUT);
+				}
 			}
 
-	#endif
+			#if !defined(__GNUC__) && !defined(__clang__)
+				MUDEF void mum_rcu_assign(void* volatile* p, void* v) {
+					mum_atomic_store_ptr(p, v, MUM_RELEASE);
+				}
+			#endif
 
 	#ifdef __cplusplus
 	}